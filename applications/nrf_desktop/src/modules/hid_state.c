@@ -14,7 +14,6 @@
 #include <sys/types.h>
 
 #include <zephyr/types.h>
-#include <zephyr/sys/slist.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/byteorder.h>
 
@@ -81,15 +80,15 @@ struct items {
 
 /**@brief Enqueued HID state item. */
 struct item_event {
-	sys_snode_t node; /**< Event queue linked list node. */
 	struct item item; /**< HID state item which has been enqueued. */
 	uint32_t timestamp; /**< HID event timestamp. */
 };
 
 /**@brief Event queue. */
 struct eventq {
-	sys_slist_t root;
-	size_t len;
+	struct item_event events[CONFIG_DESKTOP_HID_EVENT_QUEUE_SIZE]; /**< Ring buffer. */
+	uint8_t head; /**< Index of the oldest event. */
+	uint8_t len; /**< Number of enqueued events. */
 };
 
 /**@brief Axis data. */
@@ -112,6 +111,9 @@ struct report_state {
 	struct subscriber *subscriber;
 	struct report_data *linked_rd;
 	bool update_needed;
+	bool last_report_valid;
+	/* Last submitted report, including report ID. */
+	uint8_t last_report[sizeof(uint8_t) + REPORT_BUFFER_SIZE_INPUT_REPORT];
 };
 
 struct output_report_state {
@@ -135,8 +137,7 @@ struct hid_state {
 };
 
 
-static const struct report_data empty_rd = {
-			.eventq.root = SYS_SLIST_STATIC_INIT(&empty_rd.eventq.root)};
+static const struct report_data empty_rd;
 
 static uint8_t report_data_index[REPORT_ID_COUNT];
 static uint8_t report_state_index[REPORT_ID_COUNT];
@@ -222,16 +223,7 @@ static int usage_id_compare(const void *a, const void *b)
 
 static void eventq_reset(struct eventq *eventq)
 {
-	struct item_event *event;
-	struct item_event *tmp;
-
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&eventq->root, event, tmp, node) {
-		sys_slist_remove(&eventq->root, NULL, &event->node);
-
-		k_free(event);
-	}
-
-	sys_slist_init(&eventq->root);
+	eventq->head = 0;
 	eventq->len = 0;
 }
 
@@ -241,180 +233,118 @@ static bool eventq_is_full(const struct eventq *eventq)
 }
 
 
-static bool eventq_is_empty(struct eventq *eventq)
+static bool eventq_is_empty(const struct eventq *eventq)
 {
-	bool empty = sys_slist_is_empty(&eventq->root);
+	return (eventq->len == 0);
+}
 
-	__ASSERT_NO_MSG(!empty == (eventq->len != 0));
+static struct item_event *eventq_peek(struct eventq *eventq, size_t pos)
+{
+	__ASSERT_NO_MSG(pos < eventq->len);
 
-	return empty;
+	return &eventq->events[(eventq->head + pos) % ARRAY_SIZE(eventq->events)];
 }
 
-static struct item_event *eventq_get(struct eventq *eventq)
+static bool eventq_get(struct eventq *eventq, struct item *item)
 {
-	sys_snode_t *node = sys_slist_get(&eventq->root);
-
-	if (!node) {
-		return NULL;
+	if (eventq_is_empty(eventq)) {
+		return false;
 	}
 
+	*item = eventq_peek(eventq, 0)->item;
+
+	eventq->head = (eventq->head + 1) % ARRAY_SIZE(eventq->events);
 	eventq->len--;
 
-	return CONTAINER_OF(node, struct item_event, node);
+	return true;
 }
 
 static void eventq_append(struct eventq *eventq, uint16_t usage_id, int16_t value)
 {
-	struct item_event *hid_event = k_malloc(sizeof(*hid_event));
-
-	if (!hid_event) {
-		LOG_ERR("Failed to allocate HID event");
+	if (eventq_is_full(eventq)) {
+		LOG_ERR("Failed to enqueue HID event");
 		/* Should never happen. */
 		__ASSERT_NO_MSG(false);
 		return;
 	}
 
+	struct item_event *hid_event = &eventq->events[(eventq->head + eventq->len) %
+						       ARRAY_SIZE(eventq->events)];
+
 	hid_event->item.usage_id = usage_id;
 	hid_event->item.value = value;
 	hid_event->timestamp = k_uptime_get_32();
 
-	/* Add a new event to the queue. */
-	sys_slist_append(&eventq->root, &hid_event->node);
-
 	eventq->len++;
 }
 
-static void eventq_region_purge(struct eventq *eventq,
-				sys_snode_t *last_to_purge)
+static void eventq_region_purge(struct eventq *eventq, size_t cnt)
 {
-	sys_snode_t *tmp;
-	sys_snode_t *tmp_safe;
-	size_t cnt = 0;
-
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&eventq->root, tmp, tmp_safe) {
-		sys_slist_remove(&eventq->root, NULL, tmp);
-
-		k_free(CONTAINER_OF(tmp, struct item_event, node));
-		cnt++;
-
-		if (tmp == last_to_purge) {
-			break;
-		}
-	}
+	__ASSERT_NO_MSG(cnt <= eventq->len);
 
+	eventq->head = (eventq->head + cnt) % ARRAY_SIZE(eventq->events);
 	eventq->len -= cnt;
 
-	LOG_WRN("%u stale events removed from the queue!", cnt);
+	LOG_WRN("%zu stale events removed from the queue!", cnt);
 }
 
 
 static void eventq_cleanup(struct eventq *eventq, uint32_t timestamp)
 {
-	/* Find timed out events. */
-
-	sys_snode_t *first_valid;
-
-	SYS_SLIST_FOR_EACH_NODE(&eventq->root, first_valid) {
-		uint32_t diff = timestamp - CONTAINER_OF(
-			first_valid, struct item_event, node)->timestamp;
+	/* Usages pressed within the scanned region and not released yet. */
+	struct {
+		uint16_t usage_id;
+		uint8_t cnt;
+	} open[ITEM_COUNT];
+	size_t open_cnt = 0;
+	size_t purge_cnt = 0;
+
+	/* Remove timed out events but only if key up was generated for each
+	 * removed key down. Single pass over the expired events keeps track of
+	 * unreleased keys. Events can be removed up to the last position with
+	 * no unreleased keys.
+	 */
+	for (size_t pos = 0; pos < eventq->len; pos++) {
+		const struct item_event *event = eventq_peek(eventq, pos);
 
-		if (diff < CONFIG_DESKTOP_HID_REPORT_EXPIRATION) {
+		if ((timestamp - event->timestamp) < CONFIG_DESKTOP_HID_REPORT_EXPIRATION) {
 			break;
 		}
-	}
-
-	/* Remove events but only if key up was generated for each removed
-	 * key down.
-	 */
-
-	sys_snode_t *maxfound = sys_slist_peek_head(&eventq->root);
-	size_t maxfound_pos = 0;
-
-	sys_snode_t *cur;
-	size_t cur_pos = 0;
-
-	sys_snode_t *tmp_safe;
-
-	SYS_SLIST_FOR_EACH_NODE_SAFE(&eventq->root, cur, tmp_safe) {
-		const struct item cur_item =
-			CONTAINER_OF(cur, struct item_event, node)->item;
-
-		if (cur_item.value > 0) {
-			/* Every key down must be paired with key up.
-			 * Set hit count to value as we just detected
-			 * first key down for this usage.
-			 */
-
-			unsigned int hit_count = cur_item.value;
-			sys_snode_t *j = cur;
-			size_t j_pos = cur_pos;
-
-			SYS_SLIST_ITERATE_FROM_NODE(&eventq->root, j) {
-				j_pos++;
-				if (j == first_valid) {
-					break;
-				}
-
-				const struct item item =
-					CONTAINER_OF(j,
-						     struct item_event,
-						     node)->item;
 
-				if (cur_item.usage_id == item.usage_id) {
-					hit_count += item.value;
+		size_t i;
 
-					if (hit_count == 0) {
-						/* All events with this usage
-						 * are paired.
-						 */
-						break;
-					}
-				}
+		for (i = 0; i < open_cnt; i++) {
+			if (open[i].usage_id == event->item.usage_id) {
+				break;
 			}
+		}
 
-			if (j == first_valid) {
-				/* Pair not found. */
+		if (event->item.value > 0) {
+			if (i < open_cnt) {
+				open[i].cnt++;
+			} else if (open_cnt < ARRAY_SIZE(open)) {
+				open[open_cnt].usage_id = event->item.usage_id;
+				open[open_cnt].cnt = 1;
+				open_cnt++;
+			} else {
+				/* Too many unreleased keys to track. */
 				break;
 			}
-
-			if (j_pos > maxfound_pos) {
-				maxfound = j;
-				maxfound_pos = j_pos;
+		} else if (i < open_cnt) {
+			open[i].cnt--;
+			if (open[i].cnt == 0) {
+				open_cnt--;
+				open[i] = open[open_cnt];
 			}
 		}
 
-
-		if (cur == first_valid) {
-			break;
-		}
-
-		if (cur == maxfound) {
-			/* All events up to this point have pairs and can
-			 * be deleted.
-			 */
-			eventq_region_purge(eventq, maxfound);
+		if (open_cnt == 0) {
+			purge_cnt = pos + 1;
 		}
-
-		cur_pos++;
 	}
-}
 
-static void sort_by_usage_id(struct item items[], size_t array_size)
-{
-	for (size_t k = 0; k < array_size; k++) {
-		size_t id = k;
-
-		for (size_t l = k + 1; l < array_size; l++) {
-			if (items[l].usage_id < items[id].usage_id) {
-				id = l;
-			}
-		}
-		if (id != k) {
-			struct item tmp = items[k];
-
-			items[k] = items[id];
-			items[id] = tmp;
-		}
+	if (purge_cnt > 0) {
+		eventq_region_purge(eventq, purge_cnt);
 	}
 }
 
@@ -500,8 +430,6 @@ static struct subscriber *get_linked_subscriber(uint8_t report_id)
 
 static bool key_value_set(struct items *items, uint16_t usage_id, int16_t value)
 {
-	const uint8_t prev_item_count = items->item_count;
-
 	bool update_needed = false;
 	struct item *p_item;
 
@@ -515,61 +443,101 @@ static bool key_value_set(struct items *items, uint16_t usage_id, int16_t value)
 		.usage_id = usage_id,
 	};
 
+	/* Items are kept sorted at the end of the array. Free slots (zeros)
+	 * are stored at the beginning of the array.
+	 */
+	struct item *first = &items->item[ARRAY_SIZE(items->item) - items->item_count];
+
 	p_item = bsearch(&i,
-			 (uint8_t *)items->item,
-			 ARRAY_SIZE(items->item),
+			 (uint8_t *)first,
+			 items->item_count,
 			 sizeof(items->item[0]),
 			 usage_id_compare);
 
 	if (p_item) {
-		/* Item is present in the array - update its value. */
+		/* Item is present in the array - update its value. The value is
+		 * used as a reference counter, so the report changes only if
+		 * the item is removed.
+		 */
 		p_item->value += value;
 		if (p_item->value == 0) {
 			__ASSERT_NO_MSG(items->item_count != 0);
+
+			/* Shift preceding items to keep the array sorted. */
+			memmove(first + 1, first, (p_item - first) * sizeof(*first));
+			first->usage_id = 0;
+			first->value = 0;
 			items->item_count -= 1;
-			p_item->usage_id = 0;
-		}
 
-		update_needed = true;
+			update_needed = true;
+		}
 	} else if (value < 0) {
 		/* For items with absolute value, the value is used as
 		 * a reference counter and must not fall below zero. This
 		 * could happen if a key up event is lost and the state
 		 * receives an unpaired key down event.
 		 */
-	} else if (prev_item_count >= items->item_count_max) {
+	} else if (items->item_count >= items->item_count_max) {
 		/* Configuration should allow the HID module to hold data
 		 * about the maximum number of simultaneously pressed keys.
 		 * Generate a warning if an item cannot be recorded.
 		 */
 		LOG_WRN("No place on the list to store HID item!");
 	} else {
-		/* After sort operation, free slots (zeros) are stored
-		 * at the beginning of the array.
-		 */
-		size_t const idx = ARRAY_SIZE(items->item) - prev_item_count - 1;
+		struct item *pos = first;
+
+		while ((pos < &items->item[ARRAY_SIZE(items->item)]) &&
+		       (pos->usage_id < usage_id)) {
+			pos++;
+		}
 
-		__ASSERT_NO_MSG(items->item[idx].usage_id == 0);
+		/* Shift preceding items to make room for the new one. */
+		__ASSERT_NO_MSG(first > items->item);
+		__ASSERT_NO_MSG((first - 1)->usage_id == 0);
+		memmove(first - 1, first, (pos - first) * sizeof(*first));
 
 		/* Record this value change. */
-		items->item[idx].usage_id = usage_id;
-		items->item[idx].value = value;
+		(pos - 1)->usage_id = usage_id;
+		(pos - 1)->value = value;
 		items->item_count += 1;
 
 		update_needed = true;
 	}
 
-	if (prev_item_count != items->item_count) {
-		/* Sort elements on the list. Use simple algorithm
-		 * with small footprint.
-		 */
-		sort_by_usage_id(items->item, ARRAY_SIZE(items->item));
+	return update_needed;
+}
+
+/**@brief Submit encoded report unless it brings no change to the host.
+ *
+ * Mouse reports are always submitted, even if they bring no change. Motion
+ * sources take the next sample only after the previous mouse report is sent
+ * (hid_report_sent_event), so skipping a report would stop the motion.
+ */
+static bool report_submit(struct report_state *rs, const uint8_t *data, size_t size,
+			  bool always)
+{
+	__ASSERT_NO_MSG(size <= sizeof(rs->last_report));
+
+	if (!always && rs->last_report_valid && !memcmp(rs->last_report, data, size)) {
+		LOG_DBG("Report %u not changed", rs->report_id);
+		return false;
 	}
 
-	return update_needed;
+	memcpy(rs->last_report, data, size);
+	rs->last_report_valid = true;
+
+	struct hid_report_event *event = new_hid_report_event(size);
+
+	event->source = &state;
+	event->subscriber = rs->subscriber->id;
+	memcpy(event->dyndata.data, data, size);
+
+	APP_EVENT_SUBMIT(event);
+
+	return true;
 }
 
-static void send_report_keyboard(struct report_state *rs, struct report_data *rd)
+static bool send_report_keyboard(struct report_state *rs, struct report_data *rd)
 {
 	__ASSERT_NO_MSG((IS_ENABLED(CONFIG_DESKTOP_HID_REPORT_KEYBOARD_SUPPORT) &&
 			 (rs->report_id == REPORT_ID_KEYBOARD_KEYS)) ||
@@ -580,7 +548,7 @@ static void send_report_keyboard(struct report_state *rs, struct report_data *rd
 	if (!IS_ENABLED(CONFIG_DESKTOP_HID_REPORT_KEYBOARD_SUPPORT)) {
 		/* Not supported. */
 		__ASSERT_NO_MSG(false);
-		return;
+		return false;
 	}
 
 	/* Keyboard report should contain keys plus one byte for modifier
@@ -590,17 +558,13 @@ static void send_report_keyboard(struct report_state *rs, struct report_data *rd
 			 "Incorrect keyboard report size");
 
 	/* Encode report. */
+	uint8_t report[sizeof(rs->report_id) + REPORT_SIZE_KEYBOARD_KEYS];
 
-	struct hid_report_event *event = new_hid_report_event(sizeof(rs->report_id)
-							+ REPORT_SIZE_KEYBOARD_KEYS);
-	event->source = &state;
-	event->subscriber = rs->subscriber->id;
-
-	event->dyndata.data[0] = rs->report_id;
-	event->dyndata.data[2] = 0; /* Reserved byte */
+	report[0] = rs->report_id;
+	report[2] = 0; /* Reserved byte */
 
 	uint8_t modifier_bm = 0;
-	uint8_t *keys = &event->dyndata.data[3];
+	uint8_t *keys = &report[3];
 
 	const size_t max = ARRAY_SIZE(rd->items.item);
 	size_t cnt = 0;
@@ -631,21 +595,21 @@ static void send_report_keyboard(struct report_state *rs, struct report_data *rd
 		keys[cnt] = 0;
 	}
 
-	event->dyndata.data[1] = modifier_bm;
-
-	APP_EVENT_SUBMIT(event);
+	report[1] = modifier_bm;
 
 	rs->update_needed = false;
+
+	return report_submit(rs, report, sizeof(report), false);
 }
 
-static void send_report_mouse(struct report_state *rs, struct report_data *rd)
+static bool send_report_mouse(struct report_state *rs, struct report_data *rd)
 {
 	__ASSERT_NO_MSG(rs->report_id == REPORT_ID_MOUSE);
 
 	if (!IS_ENABLED(CONFIG_DESKTOP_HID_REPORT_MOUSE_SUPPORT)) {
 		/* Not supported. */
 		__ASSERT_NO_MSG(false);
-		return;
+		return false;
 	}
 
 	/* X/Y axis */
@@ -686,11 +650,7 @@ static void send_report_mouse(struct report_state *rs, struct report_data *rd)
 	/* Encode report. */
 	BUILD_ASSERT(REPORT_SIZE_MOUSE == 5, "Invalid report size");
 
-	struct hid_report_event *event = new_hid_report_event(sizeof(rs->report_id)
-							+ REPORT_SIZE_MOUSE);
-
-	event->source = &state;
-	event->subscriber = rs->subscriber->id;
+	uint8_t report[sizeof(rs->report_id) + REPORT_SIZE_MOUSE];
 
 	/* Convert to little-endian. */
 	uint8_t x_buff[sizeof(dx)];
@@ -699,14 +659,12 @@ static void send_report_mouse(struct report_state *rs, struct report_data *rd)
 	sys_put_le16(dy, y_buff);
 
 
-	event->dyndata.data[0] = rs->report_id;
-	event->dyndata.data[1] = button_bm;
-	event->dyndata.data[2] = wheel;
-	event->dyndata.data[3] = x_buff[0];
-	event->dyndata.data[4] = (y_buff[0] << 4) | (x_buff[1] & 0x0f);
-	event->dyndata.data[5] = (y_buff[1] << 4) | (y_buff[0] >> 4);
-
-	APP_EVENT_SUBMIT(event);
+	report[0] = rs->report_id;
+	report[1] = button_bm;
+	report[2] = wheel;
+	report[3] = x_buff[0];
+	report[4] = (y_buff[0] << 4) | (x_buff[1] & 0x0f);
+	report[5] = (y_buff[1] << 4) | (y_buff[0] >> 4);
 
 	if ((rd->axes.axis[MOUSE_REPORT_AXIS_X] != 0) ||
 	    (rd->axes.axis[MOUSE_REPORT_AXIS_Y] != 0) ||
@@ -717,16 +675,18 @@ static void send_report_mouse(struct report_state *rs, struct report_data *rd)
 	} else {
 		rs->update_needed = false;
 	}
+
+	return report_submit(rs, report, sizeof(report), true);
 }
 
-static void send_report_boot_mouse(struct report_state *rs, struct report_data *rd)
+static bool send_report_boot_mouse(struct report_state *rs, struct report_data *rd)
 {
 	__ASSERT_NO_MSG(rs->report_id == REPORT_ID_BOOT_MOUSE);
 
 	if (!IS_ENABLED(CONFIG_DESKTOP_HID_BOOT_INTERFACE_MOUSE)) {
 		/* Not supported. */
 		__ASSERT_NO_MSG(false);
-		return;
+		return false;
 	}
 
 	/* X/Y axis */
@@ -759,19 +719,12 @@ static void send_report_boot_mouse(struct report_state *rs, struct report_data *
 	}
 
 
-	size_t report_size = sizeof(rs->report_id) + sizeof(dx) + sizeof(dy) +
-			     sizeof(button_bm);
-	struct hid_report_event *event = new_hid_report_event(report_size);
-
-	event->source = &state;
-	event->subscriber = rs->subscriber->id;
+	uint8_t report[sizeof(rs->report_id) + sizeof(dx) + sizeof(dy) + sizeof(button_bm)];
 
-	event->dyndata.data[0] = rs->report_id;
-	event->dyndata.data[1] = button_bm;
-	event->dyndata.data[2] = dx;
-	event->dyndata.data[3] = dy;
-
-	APP_EVENT_SUBMIT(event);
+	report[0] = rs->report_id;
+	report[1] = button_bm;
+	report[2] = dx;
+	report[3] = dy;
 
 	if ((rd->axes.axis[MOUSE_REPORT_AXIS_X] != 0) ||
 	    (rd->axes.axis[MOUSE_REPORT_AXIS_Y] != 0)) {
@@ -780,9 +733,11 @@ static void send_report_boot_mouse(struct report_state *rs, struct report_data *
 	} else {
 		rs->update_needed = false;
 	}
+
+	return report_submit(rs, report, sizeof(report), true);
 }
 
-static void send_report_ctrl(struct report_state *rs, struct report_data *rd)
+static bool send_report_ctrl(struct report_state *rs, struct report_data *rd)
 {
 	size_t report_size = sizeof(rs->report_id);
 
@@ -795,27 +750,24 @@ static void send_report_ctrl(struct report_state *rs, struct report_data *rd)
 	} else {
 		/* Not supported. */
 		__ASSERT_NO_MSG(false);
-		return;
+		return false;
 	}
 
-	struct hid_report_event *event = new_hid_report_event(report_size);
-
-	event->source = &state;
-	event->subscriber = rs->subscriber->id;
-
 	/* Only one item can fit in the consumer control report. */
 	__ASSERT_NO_MSG(report_size == sizeof(rs->report_id) +
 				       sizeof(rd->items.item[0].usage_id));
-	event->dyndata.data[0] = rs->report_id;
 
-	const size_t idx = ARRAY_SIZE(rd->items.item) - 1;
+	uint8_t report[sizeof(rs->report_id) + sizeof(rd->items.item[0].usage_id)];
 
-	sys_put_le16(rd->items.item[idx].usage_id,
-		     &event->dyndata.data[sizeof(rs->report_id)]);
+	report[0] = rs->report_id;
 
-	APP_EVENT_SUBMIT(event);
+	const size_t idx = ARRAY_SIZE(rd->items.item) - 1;
+
+	sys_put_le16(rd->items.item[idx].usage_id, &report[sizeof(rs->report_id)]);
 
 	rs->update_needed = false;
+
+	return report_submit(rs, report, sizeof(report), false);
 }
 
 static bool update_report(struct report_data *rd)
@@ -829,21 +781,14 @@ static bool update_report(struct report_data *rd)
 		return update_needed;
 	}
 
-	while (!update_needed && !eventq_is_empty(&rd->eventq)) {
-		/* There are enqueued events to handle. */
-		struct item_event *event = eventq_get(&rd->eventq);
+	struct item item;
 
-		__ASSERT_NO_MSG(event);
-
-		update_needed = key_value_set(&rd->items,
-					      event->item.usage_id,
-					      event->item.value);
+	while (!update_needed && eventq_get(&rd->eventq, &item)) {
+		/* There are enqueued events to handle. */
+		update_needed = key_value_set(&rd->items, item.usage_id, item.value);
 
 		rd->linked_rs->update_needed = rd->linked_rs->update_needed || update_needed;
 
-
-		k_free(event);
-
 		/* If no item was changed, try next event. */
 	}
 
@@ -879,26 +824,28 @@ static bool report_send(struct report_state *rs,
 		       (rs->subscriber->report_cnt < rs->subscriber->report_max) &&
 		       (update_report(rd) || rs->update_needed || send_always)) {
 
+			bool sent = false;
+
 			switch (rs->report_id) {
 			case REPORT_ID_KEYBOARD_KEYS:
-				send_report_keyboard(rs, rd);
+				sent = send_report_keyboard(rs, rd);
 				break;
 
 			case REPORT_ID_MOUSE:
-				send_report_mouse(rs, rd);
+				sent = send_report_mouse(rs, rd);
 				break;
 
 			case REPORT_ID_SYSTEM_CTRL:
 			case REPORT_ID_CONSUMER_CTRL:
-				send_report_ctrl(rs, rd);
+				sent = send_report_ctrl(rs, rd);
 				break;
 
 			case REPORT_ID_BOOT_KEYBOARD:
-				send_report_keyboard(rs, rd);
+				sent = send_report_keyboard(rs, rd);
 				break;
 
 			case REPORT_ID_BOOT_MOUSE:
-				send_report_boot_mouse(rs, rd);
+				sent = send_report_boot_mouse(rs, rd);
 				break;
 
 			default:
@@ -907,6 +854,14 @@ static bool report_send(struct report_state *rs,
 				break;
 			}
 
+			if (!sent) {
+				/* Host already has this report. Handle remaining
+				 * enqueued events, if any.
+				 */
+				send_always = false;
+				continue;
+			}
+
 			__ASSERT_NO_MSG(rs->cnt < UINT8_MAX);
 			rs->cnt++;
 			rs->subscriber->report_cnt++;
@@ -961,6 +916,7 @@ static void report_issued(const void *subscriber_id, uint8_t report_id, bool err
 			 */
 			LOG_WRN("Error while sending report");
 
+			rs->last_report_valid = false;
 			clear_report_data(rs->linked_rd);
 
 			return;
@@ -1112,6 +1068,7 @@ static void connect(const void *subscriber_id, uint8_t report_id)
 	rs->subscriber = subscriber;
 	rs->state = STATE_CONNECTED_IDLE;
 	rs->report_id = report_id;
+	rs->last_report_valid = false;
 
 	struct report_data *rd = get_used_rd(report_id);
 
@@ -1172,6 +1129,7 @@ static void disconnect(const void *subscriber_id, uint8_t report_id)
 	rs->subscriber = NULL;
 	rs->state = STATE_DISCONNECTED;
 	rs->cnt = 0;
+	rs->last_report_valid = false;
 
 	struct report_data *rd = rs->linked_rd;
 
@@ -1276,24 +1234,18 @@ static void enqueue(struct report_data *rd, uint16_t usage_id, int16_t value,
 			 * Try to remove queued items starting from the
 			 * oldest one.
 			 */
-			sys_snode_t *i;
-
-			SYS_SLIST_FOR_EACH_NODE(&rd->eventq.root, i) {
+			for (size_t i = 0; i < rd->eventq.len; i++) {
 				/* Initial cleanup was done above. Queue will
 				 * not contain events with expired timestamp.
 				 */
-				uint32_t timestamp =
-					CONTAINER_OF(i,
-						     struct item_event,
-						     node)->timestamp +
-					CONFIG_DESKTOP_HID_REPORT_EXPIRATION;
+				uint32_t timestamp = eventq_peek(&rd->eventq, i)->timestamp +
+						     CONFIG_DESKTOP_HID_REPORT_EXPIRATION;
 
 				eventq_cleanup(&rd->eventq, timestamp);
 
 				if (!eventq_is_full(&rd->eventq)) {
 					/* At least one element was removed
-					 * from the queue. Do not continue
-					 * list traverse, content was modified!
+					 * from the queue.
 					 */
 					break;
 				}
@@ -1417,6 +1369,27 @@ static void init(void)
 	__ASSERT_NO_MSG(state_id == INPUT_REPORT_STATE_COUNT);
 }
 
+static void latency_stats_update(uint32_t start)
+{
+	static uint32_t cnt;
+	static uint32_t max_ns;
+	static uint64_t total_ns;
+
+	uint32_t time_ns = k_cyc_to_ns_floor32(k_cycle_get_32() - start);
+
+	cnt++;
+	total_ns += time_ns;
+	max_ns = MAX(max_ns, time_ns);
+
+	if (cnt == CONFIG_DESKTOP_HID_STATE_LATENCY_STATS_INTERVAL) {
+		LOG_INF("Input event processing time [ns] avg: %u max: %u",
+			(unsigned int)(total_ns / cnt), (unsigned int)max_ns);
+		cnt = 0;
+		max_ns = 0;
+		total_ns = 0;
+	}
+}
+
 static bool handle_motion_event(const struct motion_event *event)
 {
 	if (!IS_ENABLED(CONFIG_DESKTOP_HID_REPORT_MOUSE_SUPPORT)) {
@@ -1559,8 +1532,39 @@ static bool handle_module_state_event(const struct module_state_event *event)
 	return false;
 }
 
+static bool is_input_event(const struct app_event_header *aeh)
+{
+	return (!IS_ENABLED(CONFIG_DESKTOP_MOTION_NONE) && is_motion_event(aeh)) ||
+	       (IS_ENABLED(CONFIG_DESKTOP_WHEEL_ENABLE) && is_wheel_event(aeh)) ||
+	       (IS_ENABLED(CONFIG_CAF_BUTTON_EVENTS) && is_button_event(aeh));
+}
+
+static bool handle_input_event(const struct app_event_header *aeh)
+{
+	uint32_t start = k_cycle_get_32();
+	bool consumed = false;
+
+	if (is_motion_event(aeh)) {
+		consumed = handle_motion_event(cast_motion_event(aeh));
+	} else if (is_wheel_event(aeh)) {
+		consumed = handle_wheel_event(cast_wheel_event(aeh));
+	} else if (is_button_event(aeh)) {
+		consumed = handle_button_event(cast_button_event(aeh));
+	} else {
+		__ASSERT_NO_MSG(false);
+	}
+
+	latency_stats_update(start);
+
+	return consumed;
+}
+
 static bool app_event_handler(const struct app_event_header *aeh)
 {
+	if (IS_ENABLED(CONFIG_DESKTOP_HID_STATE_LATENCY_STATS) && is_input_event(aeh)) {
+		return handle_input_event(aeh);
+	}
+
 	if (!IS_ENABLED(CONFIG_DESKTOP_MOTION_NONE) &&
 	    is_motion_event(aeh)) {
 		return handle_motion_event(cast_motion_event(aeh));
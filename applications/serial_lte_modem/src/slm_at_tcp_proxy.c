@@ -39,6 +39,15 @@ enum slm_tcp_role {
 	TCP_ROLE_SERVER
 };
 
+/**@brief Credit-based flow control operations. */
+enum slm_tcp_credit_operation {
+	CREDIT_DISABLE,
+	CREDIT_GRANT
+};
+
+/* Receive credit value when credit-based flow control is disabled. */
+#define RX_CREDIT_DISABLED -1
+
 /**@brief Commands conveyed to threads. */
 enum proxy_event {
 	PROXY_CLOSE = 0,
@@ -61,6 +70,9 @@ static struct tcp_proxy {
 	int efd;		/* Event file descriptor for signaling threads. */
 } proxy;
 
+/* Number of bytes that the host allows to be delivered to it in AT mode. */
+static atomic_t rx_credit = ATOMIC_INIT(RX_CREDIT_DISABLED);
+
 /** forward declaration of thread function **/
 static void tcpcli_thread_func(void *p1, void *p2, void *p3);
 static void tcpsvr_thread_func(void *p1, void *p2, void *p3);
@@ -360,6 +372,86 @@ static int tcp_datamode_callback(uint8_t op, const uint8_t *data, int len, uint8
 	return ret;
 }
 
+/* Wake up the proxy thread so that it takes the current receive credit into account. */
+static void proxy_wake(void)
+{
+	if (proxy.efd != INVALID_SOCKET) {
+		(void)eventfd_write(proxy.efd, 1);
+	}
+}
+
+/* @return The maximum number of bytes that can currently be delivered to the host. */
+static size_t rx_credit_get(void)
+{
+	const atomic_val_t credit = atomic_get(&rx_credit);
+
+	if (credit == RX_CREDIT_DISABLED || in_datamode()) {
+		return sizeof(slm_data_buf);
+	}
+
+	return MIN(credit, sizeof(slm_data_buf));
+}
+
+static void rx_credit_consume(size_t len)
+{
+	atomic_val_t credit;
+
+	if (in_datamode()) {
+		return;
+	}
+
+	do {
+		credit = atomic_get(&rx_credit);
+		if (credit == RX_CREDIT_DISABLED) {
+			return;
+		}
+	} while (!atomic_cas(&rx_credit, credit, (credit > (atomic_val_t)len) ? credit - len : 0));
+}
+
+/* Receive data into slm_data_buf, coalescing consecutive reads within the time budget
+ * so that the data is delivered to the host in large chunks.
+ *
+ * @return Number of received bytes, or -1 with errno set if no data could be received.
+ */
+static int tcp_receive(int sock, size_t max_len)
+{
+	const int64_t deadline = k_uptime_get() + CONFIG_SLM_TCP_RX_COALESCE_TIME;
+	struct pollfd fd = {
+		.fd = sock,
+		.events = POLLIN
+	};
+	int64_t timeout;
+	size_t len = 0;
+	int ret;
+
+	do {
+		ret = recv(sock, slm_data_buf + len, max_len - len, MSG_DONTWAIT);
+		if (ret > 0) {
+			len += ret;
+			continue;
+		}
+		if (ret == 0 || errno != EAGAIN) {
+			break;
+		}
+		/* No more data for now. Wait for some more within the time budget. */
+		timeout = deadline - k_uptime_get();
+		if (timeout <= 0 || poll(&fd, 1, timeout) <= 0 || !(fd.revents & POLLIN)) {
+			break;
+		}
+	} while (len < max_len);
+
+	return (len > 0) ? len : ret;
+}
+
+static void tcp_data_deliver(int len)
+{
+	if (!in_datamode()) {
+		rsp_send("\r\n#XTCPDATA: %d\r\n", len);
+	}
+	data_send(slm_data_buf, len);
+	rx_credit_consume(len);
+}
+
 /* Handle peer socket closure from the server side.
  * - Call only from TCP server thread.
  */
@@ -407,6 +499,8 @@ static void tcpsvr_thread_func(void *p1, void *p2, void *p3)
 	fds[EVENT_FD].fd = proxy.efd;
 	fds[EVENT_FD].events = POLLIN;
 	while (true) {
+		/* Stop receiving from the peer while the host has no credit left. */
+		fds[SOCK_PEER].events = rx_credit_get() ? POLLIN : 0;
 		ret = poll(fds, ARRAY_SIZE(fds), MSEC_PER_SEC * CONFIG_SLM_TCP_POLL_TIME);
 		if (ret < 0) { /* IO error */
 			LOG_WRN("poll() error: %d", -errno);
@@ -483,18 +577,14 @@ client_events:
 		if (fds[SOCK_PEER].revents) {
 			/* Process POLLIN first to get the data, even if there are errors. */
 			if ((fds[SOCK_PEER].revents & POLLIN) == POLLIN) {
-				ret = recv(fds[SOCK_PEER].fd, (void *)slm_data_buf,
-					   sizeof(slm_data_buf), MSG_DONTWAIT);
+				ret = tcp_receive(fds[SOCK_PEER].fd, rx_credit_get());
 				if (ret < 0 && errno != EAGAIN) {
 					LOG_ERR("recv() error: %d", -errno);
 					tcpsvr_terminate_connection(-errno);
 					fds[SOCK_PEER].fd = INVALID_SOCKET;
 				}
 				if (ret > 0) {
-					if (!in_datamode()) {
-						rsp_send("\r\n#XTCPDATA: %d\r\n", ret);
-					}
-					data_send(slm_data_buf, ret);
+					tcp_data_deliver(ret);
 				}
 			}
 			if ((fds[SOCK_PEER].revents & POLLERR) != 0) {
@@ -577,6 +667,8 @@ static void tcpcli_thread_func(void *p1, void *p2, void *p3)
 	fds[EVENT_FD].fd = proxy.efd;
 	fds[EVENT_FD].events = POLLIN;
 	while (true) {
+		/* Stop receiving from the server while the host has no credit left. */
+		fds[SOCK].events = rx_credit_get() ? POLLIN : 0;
 		ret = poll(fds, ARRAY_SIZE(fds), MSEC_PER_SEC * CONFIG_SLM_TCP_POLL_TIME);
 		if (ret < 0) {
 			LOG_WRN("poll() error: %d", ret);
@@ -590,15 +682,11 @@ static void tcpcli_thread_func(void *p1, void *p2, void *p3)
 		LOG_DBG("sock events 0x%08x", fds[SOCK].revents);
 		LOG_DBG("efd events 0x%08x", fds[EVENT_FD].revents);
 		if ((fds[SOCK].revents & POLLIN) != 0) {
-			ret = recv(fds[SOCK].fd, (void *)slm_data_buf, sizeof(slm_data_buf),
-				   MSG_DONTWAIT);
+			ret = tcp_receive(fds[SOCK].fd, rx_credit_get());
 			if (ret < 0 && errno != EAGAIN) {
 				LOG_WRN("recv() error: %d", -errno);
 			} else if (ret > 0) {
-				if (!in_datamode()) {
-					rsp_send("\r\n#XTCPDATA: %d\r\n", ret);
-				}
-				data_send(slm_data_buf, ret);
+				tcp_data_deliver(ret);
 			}
 		}
 		if ((fds[SOCK].revents & POLLERR) != 0) {
@@ -620,12 +708,18 @@ static void tcpcli_thread_func(void *p1, void *p2, void *p3)
 		/* Events from AT-commands. */
 		if ((fds[EVENT_FD].revents & POLLIN) != 0) {
 			eventfd_t value;
+			enum proxy_event event;
 
-			/* AT-command event can only close the client. */
-			LOG_DBG("Close proxy");
 			eventfd_read(fds[EVENT_FD].fd, &value);
-			ret = 0;
-			break;
+			/* AT-command event can only close the client.
+			 * Other wake-ups are for the receive credit to be reevaluated.
+			 */
+			if (k_msgq_get(&proxy_event_queue, &event, K_NO_WAIT) == 0 &&
+			    event == PROXY_CLOSE) {
+				LOG_DBG("Close proxy");
+				ret = 0;
+				break;
+			}
 		}
 		if (fds[EVENT_FD].revents & (POLLERR | POLLHUP | POLLNVAL)) {
 			LOG_ERR("efd: unexpected event: %d", fds[EVENT_FD].revents);
@@ -799,6 +893,10 @@ static int handle_at_tcp_send(enum at_parser_cmd_type cmd_type, struct at_parser
 			err = do_tcp_send(data, size);
 		} else {
 			err = enter_datamode(tcp_datamode_callback);
+			if (!err) {
+				/* The receive credit does not apply in data mode. */
+				proxy_wake();
+			}
 		}
 		break;
 
@@ -852,6 +950,61 @@ static int handle_at_tcp_hangup(enum at_parser_cmd_type cmd_type, struct at_pars
 	return err;
 }
 
+SLM_AT_CMD_CUSTOM(xtcpcredit, "AT#XTCPCREDIT", handle_at_tcp_credit);
+static int handle_at_tcp_credit(enum at_parser_cmd_type cmd_type, struct at_parser *parser,
+				uint32_t param_count)
+{
+	int err = -EINVAL;
+	int op;
+	int credit;
+	atomic_val_t old_credit;
+
+	switch (cmd_type) {
+	case AT_PARSER_CMD_TYPE_SET:
+		err = at_parser_num_get(parser, 1, &op);
+		if (err) {
+			return err;
+		}
+		if (op == CREDIT_DISABLE) {
+			atomic_set(&rx_credit, RX_CREDIT_DISABLED);
+		} else if (op == CREDIT_GRANT && param_count == 3) {
+			err = at_parser_num_get(parser, 2, &credit);
+			if (err) {
+				return err;
+			}
+			if (credit < 0) {
+				return -EINVAL;
+			}
+			do {
+				old_credit = atomic_get(&rx_credit);
+			} while (!atomic_cas(&rx_credit, old_credit,
+					     MAX(old_credit, 0) + credit));
+		} else {
+			return -EINVAL;
+		}
+		proxy_wake();
+		err = 0;
+		break;
+
+	case AT_PARSER_CMD_TYPE_READ:
+		old_credit = atomic_get(&rx_credit);
+		rsp_send("\r\n#XTCPCREDIT: %d,%d\r\n", old_credit != RX_CREDIT_DISABLED,
+			 (int)MAX(old_credit, 0));
+		err = 0;
+		break;
+
+	case AT_PARSER_CMD_TYPE_TEST:
+		rsp_send("\r\n#XTCPCREDIT: (%d,%d),<credit>\r\n", CREDIT_DISABLE, CREDIT_GRANT);
+		err = 0;
+		break;
+
+	default:
+		break;
+	}
+
+	return err;
+}
+
 /**@brief API to initialize TCP proxy AT commands handler
  */
 int slm_at_tcp_proxy_init(void)
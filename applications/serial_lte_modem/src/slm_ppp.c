@@ -5,6 +5,7 @@
  */
 
 #include "slm_ppp.h"
+#include "slm_ppp_fwd.h"
 #include "slm_at_host.h"
 #include "slm_util.h"
 #if defined(CONFIG_SLM_CMUX)
@@ -36,13 +37,8 @@ static const struct device *ppp_uart_dev = DEVICE_DT_GET(DT_CHOSEN(ncs_slm_ppp_u
 #endif
 static struct net_if *ppp_iface;
 
-static uint8_t ppp_data_buf[1500];
 static struct sockaddr_ll ppp_zephyr_dst_addr;
 
-static struct k_thread ppp_data_passing_thread_id;
-static K_THREAD_STACK_DEFINE(ppp_data_passing_thread_stack, KB(2));
-static void ppp_data_passing_thread(void*, void*, void*);
-
 static void ppp_controller(struct k_work *work);
 enum ppp_action {
 	PPP_START,
@@ -77,7 +73,7 @@ enum ppp_states {
 static atomic_t ppp_state;
 
 MODEM_PPP_DEFINE(ppp_module, NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
-		 sizeof(ppp_data_buf), sizeof(ppp_data_buf));
+		 SLM_PPP_FWD_BUF_SIZE, SLM_PPP_FWD_BUF_SIZE);
 
 static struct modem_pipe *ppp_pipe;
 
@@ -195,10 +191,19 @@ static void send_status_notification(void)
 static int ppp_start_failure(int ret)
 {
 	close_ppp_sockets();
+	slm_ppp_fwd_stop();
 	net_if_down(ppp_iface);
 	return ret;
 }
 
+/* Stops PPP when the data forwarding terminates on its own, i.e. not because of PPP stopping. */
+static void ppp_fwd_error_handler(void)
+{
+	if (ppp_is_running()) {
+		k_work_submit_to_queue(&slm_work_q, &ppp_stop_work.work);
+	}
+}
+
 static int ppp_start_internal(void)
 {
 	int ret;
@@ -217,11 +222,11 @@ static int ppp_start_internal(void)
 
 	if (mtu) {
 		/* Set the PPP MTU to that of the LTE link. */
-		mtu = MIN(mtu, sizeof(ppp_data_buf));
+		mtu = MIN(mtu, SLM_PPP_FWD_BUF_SIZE);
 	} else {
 		LOG_DBG("Could not retrieve MTU, using fallback value.");
 		mtu = CONFIG_SLM_PPP_FALLBACK_MTU;
-		BUILD_ASSERT(sizeof(ppp_data_buf) >= CONFIG_SLM_PPP_FALLBACK_MTU);
+		BUILD_ASSERT(SLM_PPP_FWD_BUF_SIZE >= CONFIG_SLM_PPP_FALLBACK_MTU);
 	}
 
 	net_if_set_mtu(ppp_iface, mtu);
@@ -237,6 +242,25 @@ static int ppp_start_internal(void)
 		return ppp_start_failure(-ENOTCONN);
 	}
 
+	{
+		const struct slm_ppp_fwd_endpoint zephyr_ep = {
+			.fd = ppp_fds[ZEPHYR_FD_IDX],
+			.name = ppp_socket_names[ZEPHYR_FD_IDX],
+			.addr = (const struct sockaddr *)&ppp_zephyr_dst_addr,
+			.addrlen = sizeof(ppp_zephyr_dst_addr)
+		};
+		const struct slm_ppp_fwd_endpoint modem_ep = {
+			.fd = ppp_fds[MODEM_FD_IDX],
+			.name = ppp_socket_names[MODEM_FD_IDX]
+		};
+
+		ret = slm_ppp_fwd_start(&zephyr_ep, &modem_ep, mtu, ppp_fwd_error_handler);
+		if (ret) {
+			LOG_ERR("Failed to start data forwarding (%d).", ret);
+			return ppp_start_failure(ret);
+		}
+	}
+
 #if defined(CONFIG_SLM_CMUX)
 	ppp_pipe = slm_cmux_reserve(CMUX_PPP_CHANNEL);
 	/* The pipe opening is managed by CMUX. */
@@ -256,12 +280,6 @@ static int ppp_start_internal(void)
 
 	LOG_INF("PPP started.");
 
-	k_thread_create(&ppp_data_passing_thread_id, ppp_data_passing_thread_stack,
-			K_THREAD_STACK_SIZEOF(ppp_data_passing_thread_stack),
-			ppp_data_passing_thread, NULL, NULL, NULL,
-			K_PRIO_COOP(10), 0, K_NO_WAIT);
-	k_thread_name_set(&ppp_data_passing_thread_id, "ppp_data_passing");
-
 	return 0;
 }
 
@@ -309,7 +327,7 @@ static void ppp_stop_internal(void)
 
 	close_ppp_sockets();
 
-	k_thread_join(&ppp_data_passing_thread_id, K_SECONDS(1));
+	slm_ppp_fwd_stop();
 
 	LOG_INF("PPP stopped.");
 }
@@ -485,8 +503,8 @@ int slm_ppp_init(void)
 
 	{
 		static struct modem_backend_uart ppp_uart_backend;
-		static uint8_t ppp_uart_backend_receive_buf[sizeof(ppp_data_buf)];
-		static uint8_t ppp_uart_backend_transmit_buf[sizeof(ppp_data_buf)];
+		static uint8_t ppp_uart_backend_receive_buf[SLM_PPP_FWD_BUF_SIZE];
+		static uint8_t ppp_uart_backend_transmit_buf[SLM_PPP_FWD_BUF_SIZE];
 
 		const struct modem_backend_uart_config uart_backend_config = {
 			.uart = ppp_uart_dev,
@@ -557,68 +575,3 @@ static int handle_at_ppp(enum at_parser_cmd_type cmd_type, struct at_parser *par
 	}
 	return -SILENT_AT_COMMAND_RET;
 }
-
-static void ppp_data_passing_thread(void*, void*, void*)
-{
-	const size_t mtu = net_if_get_mtu(ppp_iface);
-	struct pollfd fds[PPP_FDS_COUNT];
-
-	for (size_t i = 0; i != ARRAY_SIZE(fds); ++i) {
-		fds[i].fd = ppp_fds[i];
-		fds[i].events = POLLIN;
-	}
-
-	while (true) {
-		const int poll_ret = poll(fds, ARRAY_SIZE(fds), -1);
-
-		if (poll_ret <= 0) {
-			LOG_ERR("Sockets polling failed (%d, %d).", poll_ret, errno);
-			ppp_stop();
-			return;
-		}
-
-		for (size_t src = 0; src != ARRAY_SIZE(fds); ++src) {
-			const short revents = fds[src].revents;
-
-			if (!revents) {
-				continue;
-			}
-			if (!(revents & POLLIN)) {
-				/* POLLERR/POLLNVAL happen when the sockets are closed
-				 * or when the connection goes down.
-				 */
-				if ((revents ^ POLLERR) && (revents ^ POLLNVAL)) {
-					LOG_WRN("Unexpected event 0x%x on %s socket.",
-						revents, ppp_socket_names[src]);
-				}
-				ppp_stop();
-				return;
-			}
-			const ssize_t len = recv(fds[src].fd, ppp_data_buf, mtu, MSG_DONTWAIT);
-
-			if (len <= 0) {
-				if (len != -1 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
-					LOG_ERR("Failed to receive data from %s socket (%d, %d).",
-						ppp_socket_names[src], len, errno);
-				}
-				continue;
-			}
-			ssize_t send_ret;
-			const size_t dst = (src == ZEPHYR_FD_IDX) ? MODEM_FD_IDX : ZEPHYR_FD_IDX;
-			void *dst_addr = (dst == MODEM_FD_IDX) ? NULL : &ppp_zephyr_dst_addr;
-			socklen_t addrlen = (dst == MODEM_FD_IDX) ? 0 : sizeof(ppp_zephyr_dst_addr);
-
-			send_ret = sendto(fds[dst].fd, ppp_data_buf, len, 0, dst_addr, addrlen);
-			if (send_ret == -1) {
-				LOG_ERR("Failed to send %zd bytes to %s socket (%d).",
-					len, ppp_socket_names[dst], errno);
-			} else if (send_ret != len) {
-				LOG_ERR("Only sent %zd out of %zd bytes to %s socket.",
-					send_ret, len, ppp_socket_names[dst]);
-			} else {
-				LOG_DBG("Forwarded %zd bytes to %s socket.",
-					send_ret, ppp_socket_names[dst]);
-			}
-		}
-	}
-}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "slm_ppp_fwd.h"
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/posix/poll.h>
+#include <zephyr/posix/sys/socket.h>
+
+LOG_MODULE_REGISTER(slm_ppp_fwd, CONFIG_SLM_LOG_LEVEL);
+
+#define BUF_COUNT CONFIG_SLM_PPP_FWD_BUF_COUNT
+#define STACK_SIZE CONFIG_SLM_PPP_FWD_STACK_SIZE
+
+struct fwd_buf {
+	uint32_t rx_cycles;
+	uint32_t len;
+	uint8_t data[ROUND_UP(SLM_PPP_FWD_BUF_SIZE, sizeof(void *))];
+} __aligned(sizeof(void *));
+
+struct fwd_dir {
+	const struct slm_ppp_fwd_endpoint *src;
+	const struct slm_ppp_fwd_endpoint *dst;
+	struct k_mem_slab pool;
+	/* Received buffers waiting to be sent. NULL tells the sending thread to exit. */
+	struct k_msgq queue;
+	struct fwd_buf *queue_buf[BUF_COUNT + 1];
+	struct k_thread rx_thread;
+	struct k_thread tx_thread;
+	struct k_spinlock stats_lock;
+	struct slm_ppp_fwd_stats stats;
+};
+
+static struct fwd_buf fwd_bufs[SLM_PPP_FWD_DIR_COUNT][BUF_COUNT];
+static struct fwd_dir fwd_dirs[SLM_PPP_FWD_DIR_COUNT];
+static struct slm_ppp_fwd_endpoint fwd_endpoints[SLM_PPP_FWD_DIR_COUNT];
+
+static K_THREAD_STACK_ARRAY_DEFINE(fwd_rx_stacks, SLM_PPP_FWD_DIR_COUNT, STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(fwd_tx_stacks, SLM_PPP_FWD_DIR_COUNT, STACK_SIZE);
+
+static bool fwd_started;
+static size_t fwd_mtu;
+static int64_t fwd_start_time;
+static slm_ppp_fwd_error_cb_t fwd_error_cb;
+
+static const char *const dir_names[SLM_PPP_FWD_DIR_COUNT] = {
+	[SLM_PPP_FWD_UPLINK] = "uplink",
+	[SLM_PPP_FWD_DOWNLINK] = "downlink"
+};
+
+static void stats_update(struct fwd_dir *dir, const struct fwd_buf *buf, ssize_t sent)
+{
+	const uint32_t latency_us = k_cyc_to_us_floor32(k_cycle_get_32() - buf->rx_cycles);
+	k_spinlock_key_t key = k_spin_lock(&dir->stats_lock);
+
+	if (sent == buf->len) {
+		dir->stats.packets++;
+		dir->stats.bytes += sent;
+		dir->stats.latency_total_us += latency_us;
+		dir->stats.latency_max_us = MAX(dir->stats.latency_max_us, latency_us);
+	} else {
+		dir->stats.send_errors++;
+	}
+
+	k_spin_unlock(&dir->stats_lock, key);
+}
+
+static void fwd_tx_thread(void *arg1, void *, void *)
+{
+	struct fwd_dir *const dir = arg1;
+	struct fwd_buf *buf;
+	ssize_t send_ret;
+
+	while (true) {
+		k_msgq_get(&dir->queue, &buf, K_FOREVER);
+		if (!buf) {
+			return;
+		}
+
+		send_ret = sendto(dir->dst->fd, buf->data, buf->len, 0,
+				  dir->dst->addr, dir->dst->addrlen);
+		if (send_ret == -1) {
+			LOG_ERR("Failed to send %u bytes to %s socket (%d).",
+				buf->len, dir->dst->name, errno);
+		} else if (send_ret != buf->len) {
+			LOG_ERR("Only sent %zd out of %u bytes to %s socket.",
+				send_ret, buf->len, dir->dst->name);
+		} else {
+			LOG_DBG("Forwarded %zd bytes to %s socket.", send_ret, dir->dst->name);
+		}
+
+		stats_update(dir, buf, send_ret);
+		k_mem_slab_free(&dir->pool, buf);
+	}
+}
+
+/* @return Whether the receiving should go on. */
+static bool fwd_receive(struct fwd_dir *dir)
+{
+	struct pollfd fd = {
+		.fd = dir->src->fd,
+		.events = POLLIN
+	};
+	struct fwd_buf *buf;
+	ssize_t len;
+	int ret;
+
+	ret = poll(&fd, 1, -1);
+	if (ret <= 0) {
+		LOG_ERR("Polling of %s socket failed (%d, %d).", dir->src->name, ret, errno);
+		return false;
+	}
+	if (!(fd.revents & POLLIN)) {
+		/* POLLERR/POLLNVAL happen when the sockets are closed
+		 * or when the connection goes down.
+		 */
+		if ((fd.revents ^ POLLERR) && (fd.revents ^ POLLNVAL)) {
+			LOG_WRN("Unexpected event 0x%x on %s socket.", fd.revents, dir->src->name);
+		}
+		return false;
+	}
+
+	/* This blocks only while all the buffers of the direction are waiting to be sent. */
+	k_mem_slab_alloc(&dir->pool, (void **)&buf, K_FOREVER);
+
+	len = recv(dir->src->fd, buf->data, fwd_mtu, MSG_DONTWAIT);
+	if (len <= 0) {
+		k_mem_slab_free(&dir->pool, buf);
+		if (len == 0) {
+			LOG_DBG("The %s socket was shut down.", dir->src->name);
+			return false;
+		}
+		if (errno != EAGAIN && errno != EWOULDBLOCK) {
+			LOG_ERR("Failed to receive data from %s socket (%d).",
+				dir->src->name, errno);
+		}
+		return true;
+	}
+
+	buf->rx_cycles = k_cycle_get_32();
+	buf->len = len;
+	k_msgq_put(&dir->queue, &buf, K_FOREVER);
+
+	return true;
+}
+
+static void fwd_rx_thread(void *arg1, void *, void *)
+{
+	struct fwd_dir *const dir = arg1;
+	struct fwd_buf *const end = NULL;
+
+	while (fwd_receive(dir)) {
+	}
+
+	k_msgq_put(&dir->queue, &end, K_FOREVER);
+
+	if (fwd_error_cb) {
+		fwd_error_cb();
+	}
+}
+
+int slm_ppp_fwd_start(const struct slm_ppp_fwd_endpoint *ppp,
+		      const struct slm_ppp_fwd_endpoint *lte, size_t mtu,
+		      slm_ppp_fwd_error_cb_t error_cb)
+{
+	int ret;
+
+	if (mtu > SLM_PPP_FWD_BUF_SIZE) {
+		return -EINVAL;
+	}
+
+	fwd_endpoints[SLM_PPP_FWD_UPLINK] = *ppp;
+	fwd_endpoints[SLM_PPP_FWD_DOWNLINK] = *lte;
+	fwd_mtu = mtu;
+	fwd_error_cb = error_cb;
+	fwd_start_time = k_uptime_get();
+
+	for (size_t i = 0; i != ARRAY_SIZE(fwd_dirs); ++i) {
+		struct fwd_dir *const dir = &fwd_dirs[i];
+
+		dir->src = &fwd_endpoints[i];
+		dir->dst = &fwd_endpoints[(i == SLM_PPP_FWD_UPLINK) ?
+					  SLM_PPP_FWD_DOWNLINK : SLM_PPP_FWD_UPLINK];
+		memset(&dir->stats, 0, sizeof(dir->stats));
+
+		ret = k_mem_slab_init(&dir->pool, fwd_bufs[i], sizeof(fwd_bufs[i][0]), BUF_COUNT);
+		if (ret) {
+			return ret;
+		}
+		k_msgq_init(&dir->queue, (char *)dir->queue_buf, sizeof(dir->queue_buf[0]),
+			    ARRAY_SIZE(dir->queue_buf));
+	}
+
+	for (size_t i = 0; i != ARRAY_SIZE(fwd_dirs); ++i) {
+		struct fwd_dir *const dir = &fwd_dirs[i];
+
+		k_thread_create(&dir->tx_thread, fwd_tx_stacks[i],
+				K_THREAD_STACK_SIZEOF(fwd_tx_stacks[i]),
+				fwd_tx_thread, dir, NULL, NULL,
+				K_PRIO_COOP(10), 0, K_NO_WAIT);
+		k_thread_name_set(&dir->tx_thread, (i == SLM_PPP_FWD_UPLINK) ?
+				  "ppp_fwd_ul_tx" : "ppp_fwd_dl_tx");
+
+		k_thread_create(&dir->rx_thread, fwd_rx_stacks[i],
+				K_THREAD_STACK_SIZEOF(fwd_rx_stacks[i]),
+				fwd_rx_thread, dir, NULL, NULL,
+				K_PRIO_COOP(10), 0, K_NO_WAIT);
+		k_thread_name_set(&dir->rx_thread, (i == SLM_PPP_FWD_UPLINK) ?
+				  "ppp_fwd_ul_rx" : "ppp_fwd_dl_rx");
+	}
+
+	fwd_started = true;
+	return 0;
+}
+
+void slm_ppp_fwd_stop(void)
+{
+	struct slm_ppp_fwd_stats stats;
+
+	if (!fwd_started) {
+		return;
+	}
+	fwd_started = false;
+
+	for (size_t i = 0; i != ARRAY_SIZE(fwd_dirs); ++i) {
+		k_thread_join(&fwd_dirs[i].rx_thread, K_SECONDS(1));
+		k_thread_join(&fwd_dirs[i].tx_thread, K_SECONDS(1));
+
+		slm_ppp_fwd_stats_get(i, &stats);
+		LOG_INF("PPP %s: %u packets, %llu bytes, %u send errors, "
+			"average latency %llu us, maximum latency %u us.",
+			dir_names[i], stats.packets, stats.bytes, stats.send_errors,
+			stats.packets ? stats.latency_total_us / stats.packets : 0,
+			stats.latency_max_us);
+	}
+}
+
+void slm_ppp_fwd_stats_get(enum slm_ppp_fwd_dir dir, struct slm_ppp_fwd_stats *stats)
+{
+	struct fwd_dir *const fwd_dir = &fwd_dirs[dir];
+	k_spinlock_key_t key = k_spin_lock(&fwd_dir->stats_lock);
+
+	*stats = fwd_dir->stats;
+
+	k_spin_unlock(&fwd_dir->stats_lock, key);
+
+	stats->uptime_ms = k_uptime_get() - fwd_start_time;
+}
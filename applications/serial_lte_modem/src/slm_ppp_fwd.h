@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#ifndef SLM_PPP_FWD_
+#define SLM_PPP_FWD_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/net/socket.h>
+
+/* Maximum size of a forwarded packet. */
+#define SLM_PPP_FWD_BUF_SIZE 1500
+
+enum slm_ppp_fwd_dir {
+	SLM_PPP_FWD_UPLINK, /* From the PPP link to the LTE link. */
+	SLM_PPP_FWD_DOWNLINK, /* From the LTE link to the PPP link. */
+	SLM_PPP_FWD_DIR_COUNT
+};
+
+/* Socket at one end of the forwarding. */
+struct slm_ppp_fwd_endpoint {
+	int fd;
+	const char *name;
+	/* Destination address used when sending to this socket, if any. */
+	const struct sockaddr *addr;
+	socklen_t addrlen;
+};
+
+/* Forwarding statistics of one direction. */
+struct slm_ppp_fwd_stats {
+	uint32_t packets;
+	uint64_t bytes;
+	/* Packets that failed to be sent entirely. */
+	uint32_t send_errors;
+	/* Time spent by packets between their reception and the end of their sending. */
+	uint64_t latency_total_us;
+	uint32_t latency_max_us;
+	/* Time since the forwarding was started. */
+	uint32_t uptime_ms;
+};
+
+/* Called from a forwarding thread when it stops because of a socket error. */
+typedef void (*slm_ppp_fwd_error_cb_t)(void);
+
+/**
+ * @brief Start forwarding packets in both directions between the two sockets.
+ *
+ * Each direction is served by a receiving and a sending thread that exchange
+ * buffers through a pool, so that the reception of a packet overlaps
+ * the sending of the previous one and the two directions do not block each other.
+ *
+ * @retval 0 on success.
+ */
+int slm_ppp_fwd_start(const struct slm_ppp_fwd_endpoint *ppp,
+		      const struct slm_ppp_fwd_endpoint *lte, size_t mtu,
+		      slm_ppp_fwd_error_cb_t error_cb);
+
+/**
+ * @brief Wait for the forwarding threads to terminate.
+ *
+ * The sockets must have been closed or shut down beforehand for the threads to exit.
+ */
+void slm_ppp_fwd_stop(void);
+
+void slm_ppp_fwd_stats_get(enum slm_ppp_fwd_dir dir, struct slm_ppp_fwd_stats *stats);
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/posix/poll.h>
+#include <zephyr/posix/sys/socket.h>
+#include <zephyr/posix/unistd.h>
+#include "slm_ppp_fwd.h"
+
+#define PACKET_SIZE  1280
+#define PACKET_COUNT 500
+#define TIMEOUT_MS   1000
+
+/* The forwarding engine sits between the two socket pairs, whose other ends
+ * play the role of the PPP peer and of the LTE network.
+ */
+enum { APP_END, FWD_END };
+static int ppp_pair[2];
+static int lte_pair[2];
+
+static K_THREAD_STACK_ARRAY_DEFINE(sender_stacks, SLM_PPP_FWD_DIR_COUNT, 2048);
+static struct k_thread sender_threads[SLM_PPP_FWD_DIR_COUNT];
+
+static void fill_packet(uint8_t *packet, size_t len, uint8_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		packet[i] = seed + i;
+	}
+}
+
+static void send_all(int fd, const uint8_t *data, size_t len)
+{
+	while (len) {
+		const ssize_t ret = send(fd, data, len, 0);
+
+		zassert_true(ret > 0, "send() failed (%d)", errno);
+		data += ret;
+		len -= ret;
+	}
+}
+
+static void recv_all(int fd, uint8_t *data, size_t len)
+{
+	struct pollfd pfd = { .fd = fd, .events = POLLIN };
+
+	while (len) {
+		zassert_equal(poll(&pfd, 1, TIMEOUT_MS), 1, "Data not forwarded");
+
+		const ssize_t ret = recv(fd, data, len, 0);
+
+		zassert_true(ret > 0, "recv() failed (%d)", errno);
+		data += ret;
+		len -= ret;
+	}
+}
+
+static void sender(void *arg1, void *, void *)
+{
+	static uint8_t packets[SLM_PPP_FWD_DIR_COUNT][PACKET_SIZE];
+	const enum slm_ppp_fwd_dir dir = POINTER_TO_UINT(arg1);
+	const int fd = (dir == SLM_PPP_FWD_UPLINK) ? ppp_pair[APP_END] : lte_pair[APP_END];
+	uint8_t *const packet = packets[dir];
+
+	fill_packet(packet, PACKET_SIZE, 0);
+
+	for (size_t i = 0; i < PACKET_COUNT; i++) {
+		send_all(fd, packet, PACKET_SIZE);
+	}
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	zassert_ok(socketpair(AF_UNIX, SOCK_STREAM, 0, ppp_pair));
+	zassert_ok(socketpair(AF_UNIX, SOCK_STREAM, 0, lte_pair));
+
+	const struct slm_ppp_fwd_endpoint ppp = { .fd = ppp_pair[FWD_END], .name = "PPP" };
+	const struct slm_ppp_fwd_endpoint lte = { .fd = lte_pair[FWD_END], .name = "LTE" };
+
+	zassert_ok(slm_ppp_fwd_start(&ppp, &lte, PACKET_SIZE, NULL));
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Closing the application ends makes the forwarding threads exit. */
+	close(ppp_pair[APP_END]);
+	close(lte_pair[APP_END]);
+	slm_ppp_fwd_stop();
+	close(ppp_pair[FWD_END]);
+	close(lte_pair[FWD_END]);
+}
+
+ZTEST(slm_ppp_fwd, test_uplink)
+{
+	uint8_t packet[PACKET_SIZE];
+	uint8_t received[PACKET_SIZE];
+	struct slm_ppp_fwd_stats stats;
+
+	fill_packet(packet, sizeof(packet), 1);
+
+	send_all(ppp_pair[APP_END], packet, sizeof(packet));
+	recv_all(lte_pair[APP_END], received, sizeof(received));
+
+	zassert_mem_equal(packet, received, sizeof(packet));
+
+	slm_ppp_fwd_stats_get(SLM_PPP_FWD_UPLINK, &stats);
+	zassert_equal(stats.bytes, sizeof(packet));
+	zassert_equal(stats.send_errors, 0);
+}
+
+ZTEST(slm_ppp_fwd, test_downlink)
+{
+	uint8_t packet[PACKET_SIZE];
+	uint8_t received[PACKET_SIZE];
+	struct slm_ppp_fwd_stats stats;
+
+	fill_packet(packet, sizeof(packet), 2);
+
+	send_all(lte_pair[APP_END], packet, sizeof(packet));
+	recv_all(ppp_pair[APP_END], received, sizeof(received));
+
+	zassert_mem_equal(packet, received, sizeof(packet));
+
+	slm_ppp_fwd_stats_get(SLM_PPP_FWD_DOWNLINK, &stats);
+	zassert_equal(stats.bytes, sizeof(packet));
+	zassert_equal(stats.send_errors, 0);
+}
+
+ZTEST(slm_ppp_fwd, test_benchmark)
+{
+	uint8_t buf[PACKET_SIZE];
+	struct slm_ppp_fwd_stats stats[SLM_PPP_FWD_DIR_COUNT];
+	/* Indexed by the direction of the data received on them. */
+	struct pollfd fds[SLM_PPP_FWD_DIR_COUNT] = {
+		[SLM_PPP_FWD_UPLINK] = { .fd = lte_pair[APP_END], .events = POLLIN },
+		[SLM_PPP_FWD_DOWNLINK] = { .fd = ppp_pair[APP_END], .events = POLLIN },
+	};
+	size_t remaining[SLM_PPP_FWD_DIR_COUNT];
+
+	/* Both directions are loaded at the same time. */
+	for (size_t dir = 0; dir < SLM_PPP_FWD_DIR_COUNT; dir++) {
+		remaining[dir] = PACKET_SIZE * PACKET_COUNT;
+		k_thread_create(&sender_threads[dir], sender_stacks[dir],
+				K_THREAD_STACK_SIZEOF(sender_stacks[dir]),
+				sender, UINT_TO_POINTER(dir), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	while (remaining[SLM_PPP_FWD_UPLINK] || remaining[SLM_PPP_FWD_DOWNLINK]) {
+		zassert_true(poll(fds, ARRAY_SIZE(fds), TIMEOUT_MS) > 0, "Data not forwarded");
+
+		for (size_t dir = 0; dir < SLM_PPP_FWD_DIR_COUNT; dir++) {
+			if (!(fds[dir].revents & POLLIN)) {
+				continue;
+			}
+
+			const ssize_t ret = recv(fds[dir].fd, buf, sizeof(buf), MSG_DONTWAIT);
+
+			zassert_true(ret > 0 && ret <= remaining[dir], "Unexpected data");
+			remaining[dir] -= ret;
+		}
+	}
+
+	for (size_t dir = 0; dir < SLM_PPP_FWD_DIR_COUNT; dir++) {
+		zassert_ok(k_thread_join(&sender_threads[dir], K_SECONDS(1)));
+		slm_ppp_fwd_stats_get(dir, &stats[dir]);
+
+		zassert_equal(stats[dir].bytes, PACKET_SIZE * PACKET_COUNT);
+		zassert_equal(stats[dir].send_errors, 0);
+
+		TC_PRINT("%s: %u packets, %llu bytes in %u ms (%llu kbit/s), "
+			 "latency average %llu us, maximum %u us\n",
+			 dir == SLM_PPP_FWD_UPLINK ? "uplink" : "downlink",
+			 stats[dir].packets, stats[dir].bytes, stats[dir].uptime_ms,
+			 stats[dir].bytes * 8 / MAX(stats[dir].uptime_ms, 1),
+			 stats[dir].latency_total_us / MAX(stats[dir].packets, 1),
+			 stats[dir].latency_max_us);
+	}
+}
+
+ZTEST_SUITE(slm_ppp_fwd, NULL, NULL, before, after, NULL);
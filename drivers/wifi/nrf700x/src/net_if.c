@@ -24,6 +24,7 @@ LOG_MODULE_DECLARE(wifi_nrf, CONFIG_WIFI_NRF700X_LOG_LEVEL);
 #include "fmac_api.h"
 #include "fmac_util.h"
 #include "shim.h"
+#include "nwb.h"
 #include "fmac_main.h"
 #include "wpa_supp_if.h"
 #include "net_if.h"
@@ -316,12 +317,13 @@ int nrf_wifi_if_send(const struct device *dev,
 	if (!nbuf) {
 		LOG_DBG("Failed to allocate net_pkt");
 		host_stats->total_tx_drop_pkts++;
-		goto out;
+		goto unlock;
 	}
 
 #ifdef CONFIG_NRF700X_RAW_DATA_TX
 	if ((*(unsigned int *)pkt->frags->data) == NRF_WIFI_MAGIC_NUM_RAWTX) {
 		if (vif_ctx_zep->if_carr_state != NRF_WIFI_FMAC_IF_CARR_STATE_ON) {
+			zep_shim_nbuf_free(nbuf);
 			goto unlock;
 		}
 
@@ -332,6 +334,7 @@ int nrf_wifi_if_send(const struct device *dev,
 #endif /* CONFIG_NRF700X_RAW_DATA_TX */
 		if ((vif_ctx_zep->if_carr_state != NRF_WIFI_FMAC_IF_CARR_STATE_ON) ||
 		    (!vif_ctx_zep->authorized && !is_eapol(pkt))) {
+			zep_shim_nbuf_free(nbuf);
 			goto unlock;
 		}
 
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @brief File containing network buffer specific definitions for the
+ * Zephyr OS layer of the Wi-Fi driver.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "shim.h"
+#include "nwb.h"
+
+LOG_MODULE_DECLARE(wifi_nrf, CONFIG_WIFI_NRF700X_LOG_LEVEL);
+
+#ifdef CONFIG_NRF700X_NWB_POOL
+K_MEM_SLAB_DEFINE_STATIC(nwb_slab, WB_UP(sizeof(struct nwb)), CONFIG_NRF700X_NWB_POOL_CNT,
+			 sizeof(void *));
+
+NET_BUF_POOL_VAR_DEFINE(nwb_data_pool, CONFIG_NRF700X_NWB_POOL_CNT,
+			CONFIG_NRF700X_NWB_POOL_DATA_SIZE, 0, NULL);
+#endif /* CONFIG_NRF700X_NWB_POOL */
+
+static struct nwb *nwb_desc_alloc(void)
+{
+	struct nwb *nwb;
+
+#ifdef CONFIG_NRF700X_NWB_POOL
+	if (k_mem_slab_alloc(&nwb_slab, (void **)&nwb, K_NO_WAIT) == 0) {
+		memset(nwb, 0, sizeof(*nwb));
+		nwb->pooled = true;
+		return nwb;
+	}
+#endif /* CONFIG_NRF700X_NWB_POOL */
+
+	return (struct nwb *)k_calloc(sizeof(struct nwb), sizeof(char));
+}
+
+static void nwb_desc_free(struct nwb *nwb)
+{
+#ifdef CONFIG_NRF700X_NWB_POOL
+	if (nwb->pooled) {
+		k_mem_slab_free(&nwb_slab, (void *)nwb);
+		return;
+	}
+#endif /* CONFIG_NRF700X_NWB_POOL */
+
+	k_free(nwb);
+}
+
+/* The data area is not cleared, callers that need it zeroed must do it themselves. */
+static struct nwb *nwb_alloc(unsigned int size)
+{
+	struct nwb *nwb;
+
+	nwb = nwb_desc_alloc();
+
+	if (!nwb)
+		return NULL;
+
+#ifdef CONFIG_NRF700X_NWB_POOL
+	nwb->buf = net_buf_alloc_len(&nwb_data_pool, size, K_NO_WAIT);
+
+	if (nwb->buf)
+		nwb->data = nwb->buf->__buf;
+#endif /* CONFIG_NRF700X_NWB_POOL */
+
+	if (!nwb->buf) {
+		nwb->priv = k_malloc(size);
+
+		if (!nwb->priv) {
+			nwb_desc_free(nwb);
+			return NULL;
+		}
+
+		nwb->data = (unsigned char *)nwb->priv;
+	}
+
+	nwb->tail = nwb->data;
+	nwb->len = 0;
+	nwb->headroom = 0;
+	nwb->next = NULL;
+
+	return nwb;
+}
+
+void *zep_shim_nbuf_alloc(unsigned int size)
+{
+	struct nwb *nwb;
+
+	nwb = nwb_alloc(size);
+
+	if (!nwb)
+		return NULL;
+
+	memset(nwb->data, 0, size);
+
+	return nwb;
+}
+
+void zep_shim_nbuf_free(void *nbuf)
+{
+	struct nwb *nwb = nbuf;
+
+	if (nwb->pkt) {
+		net_pkt_unref(nwb->pkt);
+	}
+
+	if (nwb->buf) {
+		net_buf_unref(nwb->buf);
+	}
+
+	k_free(nwb->priv);
+
+	nwb_desc_free(nwb);
+}
+
+void zep_shim_nbuf_headroom_res(void *nbuf, unsigned int size)
+{
+	struct nwb *nwb = (struct nwb *)nbuf;
+
+	nwb->data += size;
+	nwb->tail += size;
+	nwb->headroom += size;
+}
+
+unsigned int zep_shim_nbuf_headroom_get(void *nbuf)
+{
+	return ((struct nwb *)nbuf)->headroom;
+}
+
+unsigned int zep_shim_nbuf_data_size(void *nbuf)
+{
+	return ((struct nwb *)nbuf)->len;
+}
+
+void *zep_shim_nbuf_data_get(void *nbuf)
+{
+	return ((struct nwb *)nbuf)->data;
+}
+
+void *zep_shim_nbuf_data_put(void *nbuf, unsigned int size)
+{
+	struct nwb *nwb = (struct nwb *)nbuf;
+	unsigned char *data = nwb->tail;
+
+	nwb->tail += size;
+	nwb->len += size;
+
+	return data;
+}
+
+void *zep_shim_nbuf_data_push(void *nbuf, unsigned int size)
+{
+	struct nwb *nwb = (struct nwb *)nbuf;
+
+	nwb->data -= size;
+	nwb->headroom -= size;
+	nwb->len += size;
+
+	return nwb->data;
+}
+
+void *zep_shim_nbuf_data_pull(void *nbuf, unsigned int size)
+{
+	struct nwb *nwb = (struct nwb *)nbuf;
+
+	nwb->data += size;
+	nwb->headroom += size;
+	nwb->len -= size;
+
+	return nwb->data;
+}
+
+unsigned char zep_shim_nbuf_get_priority(void *nbuf)
+{
+	struct nwb *nwb = (struct nwb *)nbuf;
+
+	return nwb->priority;
+}
+
+unsigned char zep_shim_nbuf_get_chksum_done(void *nbuf)
+{
+	struct nwb *nwb = (struct nwb *)nbuf;
+
+	return nwb->chksum_done;
+}
+
+void zep_shim_nbuf_set_chksum_done(void *nbuf, unsigned char chksum_done)
+{
+	struct nwb *nwb = (struct nwb *)nbuf;
+
+	nwb->chksum_done = (bool)chksum_done;
+}
+
+/* Use the only fragment of the packet as the data area. The packet stays
+ * referenced until the buffer is freed on TX done. The fragment must have
+ * at least NWB_TX_HEADROOM bytes of headroom.
+ */
+static struct nwb *nwb_wrap_pkt(struct net_pkt *pkt)
+{
+	struct net_buf *buf = pkt->buffer;
+	struct nwb *nwb;
+
+	nwb = nwb_desc_alloc();
+
+	if (!nwb)
+		return NULL;
+
+	nwb->data = buf->data;
+	nwb->len = buf->len;
+	nwb->tail = nwb->data + nwb->len;
+	nwb->headroom = net_buf_headroom(buf);
+	nwb->pkt = net_pkt_ref(pkt);
+
+	return nwb;
+}
+
+static struct nwb *nwb_copy_pkt(struct net_pkt *pkt)
+{
+	struct nwb *nwb;
+	unsigned char *data;
+	unsigned int len;
+
+	len = net_pkt_get_len(pkt);
+
+	nwb = nwb_alloc(len + NWB_TX_HEADROOM);
+
+	if (!nwb)
+		return NULL;
+
+	zep_shim_nbuf_headroom_res(nwb, NWB_TX_HEADROOM);
+
+	data = zep_shim_nbuf_data_put(nwb, len);
+
+	net_pkt_read(pkt, data, len);
+
+	return nwb;
+}
+
+void *net_pkt_to_nbuf(struct net_pkt *pkt)
+{
+	struct nwb *nwb;
+
+	if (IS_ENABLED(CONFIG_NRF700X_TX_ZERO_COPY) && pkt->buffer && !pkt->buffer->frags &&
+	    net_buf_headroom(pkt->buffer) >= NWB_TX_HEADROOM) {
+		nwb = nwb_wrap_pkt(pkt);
+	} else {
+		nwb = nwb_copy_pkt(pkt);
+	}
+
+	if (!nwb) {
+		return NULL;
+	}
+
+	nwb->priority = net_pkt_priority(pkt);
+	nwb->chksum_done = (bool)net_pkt_is_chksum_done(pkt);
+
+	return nwb;
+}
+
+void *net_pkt_from_nbuf(void *iface, void *frm)
+{
+	struct net_pkt *pkt = NULL;
+	unsigned char *data;
+	unsigned int len;
+	struct nwb *nwb = frm;
+
+	if (!nwb) {
+		return NULL;
+	}
+
+	len = zep_shim_nbuf_data_size(nwb);
+
+	data = zep_shim_nbuf_data_get(nwb);
+
+	if (nwb->buf) {
+		/* Hand the pooled data buffer over to the packet instead of copying it. */
+		pkt = net_pkt_rx_alloc_on_iface(iface, K_MSEC(100));
+
+		if (!pkt) {
+			goto out;
+		}
+
+		net_buf_reset(nwb->buf);
+		net_buf_reserve(nwb->buf, data - nwb->buf->__buf);
+		net_buf_add(nwb->buf, len);
+		net_pkt_append_buffer(pkt, nwb->buf);
+		nwb->buf = NULL;
+
+		goto out;
+	}
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, len, AF_UNSPEC, 0, K_MSEC(100));
+
+	if (!pkt) {
+		goto out;
+	}
+
+	if (net_pkt_write(pkt, data, len)) {
+		net_pkt_unref(pkt);
+		pkt = NULL;
+		goto out;
+	}
+
+out:
+	zep_shim_nbuf_free(nwb);
+	return pkt;
+}
+
+#if defined(CONFIG_NRF700X_RAW_DATA_RX) || defined(CONFIG_NRF700X_PROMISC_DATA_RX)
+void *net_raw_pkt_from_nbuf(void *iface, void *frm,
+			    unsigned short raw_hdr_len,
+			    void *raw_rx_hdr,
+			    bool pkt_free)
+{
+	struct net_pkt *pkt = NULL;
+	unsigned char *nwb_data;
+	unsigned char *data =  NULL;
+	unsigned int nwb_len;
+	unsigned int total_len;
+	struct nwb *nwb = frm;
+
+	if (!nwb) {
+		LOG_ERR("%s: Received network buffer is NULL", __func__);
+		return NULL;
+	}
+
+	nwb_len = zep_shim_nbuf_data_size(nwb);
+	nwb_data = zep_shim_nbuf_data_get(nwb);
+	total_len = raw_hdr_len + nwb_len;
+
+	data = (unsigned char *)k_malloc(total_len);
+	if (!data) {
+		LOG_ERR("%s: Unable to allocate memory for sniffer data packet", __func__);
+		goto out;
+	}
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, total_len, AF_PACKET, ETH_P_ALL, K_MSEC(100));
+	if (!pkt) {
+		LOG_ERR("%s: Unable to allocate net packet buffer", __func__);
+		goto out;
+	}
+
+	memcpy(data, raw_rx_hdr, raw_hdr_len);
+	memcpy((data+raw_hdr_len), nwb_data, nwb_len);
+
+	if (net_pkt_write(pkt, data, total_len)) {
+		net_pkt_unref(pkt);
+		pkt = NULL;
+		goto out;
+	}
+out:
+	if (data != NULL) {
+		k_free(data);
+	}
+
+	if (pkt_free) {
+		zep_shim_nbuf_free(nwb);
+	}
+
+	return pkt;
+}
+#endif /* CONFIG_NRF700X_RAW_DATA_RX || CONFIG_NRF700X_PROMISC_DATA_RX */
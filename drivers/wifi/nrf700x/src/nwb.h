@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/**
+ * @brief Header containing network buffer specific declarations for the
+ * Zephyr OS layer of the Wi-Fi driver.
+ */
+
+#ifndef __NWB_H__
+#define __NWB_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_pkt.h>
+
+/* Headroom the OS agnostic layer needs in front of TX data for its headers */
+#define NWB_TX_HEADROOM 100
+
+/**
+ * struct nwb - Network buffer exchanged with the OS agnostic layer.
+ * @priv: Heap allocated data area, if the data is not owned by @buf or @pkt.
+ * @buf: Network buffer from the driver pool that holds the data.
+ * @pkt: TX packet whose single fragment is used as the data area.
+ * @pooled: The structure itself is allocated from the descriptor pool.
+ *
+ * Exactly one of @priv, @buf and @pkt owns the data area, and it is released
+ * together with the structure.
+ */
+struct nwb {
+	unsigned char *data;
+	unsigned char *tail;
+	int len;
+	int headroom;
+	void *next;
+	void *priv;
+	int iftype;
+	void *ifaddr;
+	void *dev;
+	int hostbuffer;
+	void *cleanup_ctx;
+	void (*cleanup_cb)();
+	unsigned char priority;
+	bool chksum_done;
+	bool pooled;
+	struct net_buf *buf;
+	struct net_pkt *pkt;
+};
+
+void *zep_shim_nbuf_alloc(unsigned int size);
+void zep_shim_nbuf_free(void *nbuf);
+void zep_shim_nbuf_headroom_res(void *nbuf, unsigned int size);
+unsigned int zep_shim_nbuf_headroom_get(void *nbuf);
+unsigned int zep_shim_nbuf_data_size(void *nbuf);
+void *zep_shim_nbuf_data_get(void *nbuf);
+void *zep_shim_nbuf_data_put(void *nbuf, unsigned int size);
+void *zep_shim_nbuf_data_push(void *nbuf, unsigned int size);
+void *zep_shim_nbuf_data_pull(void *nbuf, unsigned int size);
+unsigned char zep_shim_nbuf_get_priority(void *nbuf);
+unsigned char zep_shim_nbuf_get_chksum_done(void *nbuf);
+void zep_shim_nbuf_set_chksum_done(void *nbuf, unsigned char chksum_done);
+
+#endif /* __NWB_H__ */
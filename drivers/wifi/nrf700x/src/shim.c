@@ -21,6 +21,7 @@
 
 #include "rpu_hw_if.h"
 #include "shim.h"
+#include "nwb.h"
 #include "work.h"
 #include "timer.h"
 #include "osal_ops.h"
@@ -194,257 +195,24 @@ static int zep_shim_pr_err(const char *fmt, va_list args)
 	return 0;
 }
 
-struct nwb {
-	unsigned char *data;
-	unsigned char *tail;
-	int len;
-	int headroom;
-	void *next;
-	void *priv;
-	int iftype;
-	void *ifaddr;
-	void *dev;
-	int hostbuffer;
-	void *cleanup_ctx;
-	void (*cleanup_cb)();
-	unsigned char priority;
-	bool chksum_done;
-};
-
-static void *zep_shim_nbuf_alloc(unsigned int size)
-{
-	struct nwb *nwb;
-
-	nwb = (struct nwb *)k_calloc(sizeof(struct nwb), sizeof(char));
-
-	if (!nwb)
-		return NULL;
-
-	nwb->priv = k_calloc(size, sizeof(char));
-
-	if (!nwb->priv) {
-		k_free(nwb);
-		return NULL;
-	}
-
-	nwb->data = (unsigned char *)nwb->priv;
-	nwb->tail = nwb->data;
-	nwb->len = 0;
-	nwb->headroom = 0;
-	nwb->next = NULL;
-
-	return nwb;
-}
-
-static void zep_shim_nbuf_free(void *nbuf)
-{
-	struct nwb *nwb;
-
-	nwb = nbuf;
-
-	k_free(((struct nwb *)nbuf)->priv);
-
-	k_free(nbuf);
-}
-
-static void zep_shim_nbuf_headroom_res(void *nbuf, unsigned int size)
-{
-	struct nwb *nwb = (struct nwb *)nbuf;
-
-	nwb->data += size;
-	nwb->tail += size;
-	nwb->headroom += size;
-}
-
-static unsigned int zep_shim_nbuf_headroom_get(void *nbuf)
-{
-	return ((struct nwb *)nbuf)->headroom;
-}
-
-static unsigned int zep_shim_nbuf_data_size(void *nbuf)
-{
-	return ((struct nwb *)nbuf)->len;
-}
-
-static void *zep_shim_nbuf_data_get(void *nbuf)
-{
-	return ((struct nwb *)nbuf)->data;
-}
-
-static void *zep_shim_nbuf_data_put(void *nbuf, unsigned int size)
-{
-	struct nwb *nwb = (struct nwb *)nbuf;
-	unsigned char *data = nwb->tail;
-
-	nwb->tail += size;
-	nwb->len += size;
-
-	return data;
-}
-
-static void *zep_shim_nbuf_data_push(void *nbuf, unsigned int size)
-{
-	struct nwb *nwb = (struct nwb *)nbuf;
-
-	nwb->data -= size;
-	nwb->headroom -= size;
-	nwb->len += size;
-
-	return nwb->data;
-}
-
-static void *zep_shim_nbuf_data_pull(void *nbuf, unsigned int size)
-{
-	struct nwb *nwb = (struct nwb *)nbuf;
-
-	nwb->data += size;
-	nwb->headroom += size;
-	nwb->len -= size;
-
-	return nwb->data;
-}
-
-static unsigned char zep_shim_nbuf_get_priority(void *nbuf)
-{
-	struct nwb *nwb = (struct nwb *)nbuf;
-
-	return nwb->priority;
-}
-
-static unsigned char zep_shim_nbuf_get_chksum_done(void *nbuf)
-{
-	struct nwb *nwb = (struct nwb *)nbuf;
-
-	return nwb->chksum_done;
-}
-
-static void zep_shim_nbuf_set_chksum_done(void *nbuf, unsigned char chksum_done)
-{
-	struct nwb *nwb = (struct nwb *)nbuf;
-
-	nwb->chksum_done = (bool)chksum_done;
-}
-
-#include <zephyr/net/ethernet.h>
-#include <zephyr/net/net_core.h>
-
-void *net_pkt_to_nbuf(struct net_pkt *pkt)
-{
-	struct nwb *nwb;
-	unsigned char *data;
-	unsigned int len;
-
-	len = net_pkt_get_len(pkt);
-
-	nwb = zep_shim_nbuf_alloc(len + 100);
-
-	if (!nwb) {
-		return NULL;
-	}
-
-	zep_shim_nbuf_headroom_res(nwb, 100);
-
-	data = zep_shim_nbuf_data_put(nwb, len);
-
-	net_pkt_read(pkt, data, len);
-
-	nwb->priority = net_pkt_priority(pkt);
-	nwb->chksum_done = (bool)net_pkt_is_chksum_done(pkt);
-
-	return nwb;
-}
-
-void *net_pkt_from_nbuf(void *iface, void *frm)
-{
-	struct net_pkt *pkt = NULL;
-	unsigned char *data;
-	unsigned int len;
-	struct nwb *nwb = frm;
-
-	if (!nwb) {
-		return NULL;
-	}
-
-	len = zep_shim_nbuf_data_size(nwb);
-
-	data = zep_shim_nbuf_data_get(nwb);
-
-	pkt = net_pkt_rx_alloc_with_buffer(iface, len, AF_UNSPEC, 0, K_MSEC(100));
-
-	if (!pkt) {
-		goto out;
-	}
-
-	if (net_pkt_write(pkt, data, len)) {
-		net_pkt_unref(pkt);
-		pkt = NULL;
-		goto out;
-	}
-
-out:
-	zep_shim_nbuf_free(nwb);
-	return pkt;
-}
-
-#if defined(CONFIG_NRF700X_RAW_DATA_RX) || defined(CONFIG_NRF700X_PROMISC_DATA_RX)
-void *net_raw_pkt_from_nbuf(void *iface, void *frm,
-			    unsigned short raw_hdr_len,
-			    void *raw_rx_hdr,
-			    bool pkt_free)
-{
-	struct net_pkt *pkt = NULL;
-	unsigned char *nwb_data;
-	unsigned char *data =  NULL;
-	unsigned int nwb_len;
-	unsigned int total_len;
-	struct nwb *nwb = frm;
-
-	if (!nwb) {
-		LOG_ERR("%s: Received network buffer is NULL", __func__);
-		return NULL;
-	}
-
-	nwb_len = zep_shim_nbuf_data_size(nwb);
-	nwb_data = zep_shim_nbuf_data_get(nwb);
-	total_len = raw_hdr_len + nwb_len;
-
-	data = (unsigned char *)k_malloc(total_len);
-	if (!data) {
-		LOG_ERR("%s: Unable to allocate memory for sniffer data packet", __func__);
-		goto out;
-	}
-
-	pkt = net_pkt_rx_alloc_with_buffer(iface, total_len, AF_PACKET, ETH_P_ALL, K_MSEC(100));
-	if (!pkt) {
-		LOG_ERR("%s: Unable to allocate net packet buffer", __func__);
-		goto out;
-	}
-
-	memcpy(data, raw_rx_hdr, raw_hdr_len);
-	memcpy((data+raw_hdr_len), nwb_data, nwb_len);
-
-	if (net_pkt_write(pkt, data, total_len)) {
-		net_pkt_unref(pkt);
-		pkt = NULL;
-		goto out;
-	}
-out:
-	if (data != NULL) {
-		k_free(data);
-	}
-
-	if (pkt_free) {
-		zep_shim_nbuf_free(nwb);
-	}
-
-	return pkt;
-}
-#endif /* CONFIG_NRF700X_RAW_DATA_RX || CONFIG_NRF700X_PROMISC_DATA_RX */
+#ifdef CONFIG_NRF700X_NWB_POOL
+K_MEM_SLAB_DEFINE_STATIC(llist_node_slab, WB_UP(sizeof(struct zep_shim_llist_node)),
+			 CONFIG_NRF700X_LLIST_NODE_POOL_CNT, sizeof(void *));
+#endif /* CONFIG_NRF700X_NWB_POOL */
 
 static void *zep_shim_llist_node_alloc(void)
 {
 	struct zep_shim_llist_node *llist_node = NULL;
 
+#ifdef CONFIG_NRF700X_NWB_POOL
+	if (k_mem_slab_alloc(&llist_node_slab, (void **)&llist_node, K_NO_WAIT) == 0) {
+		memset(llist_node, 0, sizeof(*llist_node));
+		llist_node->pooled = true;
+		sys_dnode_init(&llist_node->head);
+		return llist_node;
+	}
+#endif /* CONFIG_NRF700X_NWB_POOL */
+
 	llist_node = k_calloc(sizeof(*llist_node), sizeof(char));
 
 	if (!llist_node) {
@@ -459,6 +227,13 @@ static void *zep_shim_llist_node_alloc(void)
 
 static void zep_shim_llist_node_free(void *llist_node)
 {
+#ifdef CONFIG_NRF700X_NWB_POOL
+	if (((struct zep_shim_llist_node *)llist_node)->pooled) {
+		k_mem_slab_free(&llist_node_slab, llist_node);
+		return;
+	}
+#endif /* CONFIG_NRF700X_NWB_POOL */
+
 	k_free(llist_node);
 }
 
@@ -48,6 +48,7 @@ struct zep_shim_intr_priv {
 struct zep_shim_llist_node {
 	sys_dnode_t head;
 	void *data;
+	bool pooled;
 };
 
 struct zep_shim_llist {
@@ -372,6 +372,21 @@ static inline size_t app_event_manager_event_size(const struct app_event_header
 	const struct {} __event_hook_postprocess_last_sub_redefined = {};  \
 	_APP_EVENT_HOOK_POSTPROCESS_REGISTER(hook_fn, _APP_EM_MARKER_FINAL_ELEMENT)
 
+/**
+ * @brief Register event hook called after an event listener is notified.
+ *
+ * The event hook called after every listener notification, also for the listener
+ * that consumed the event.
+ * The hook function should have a form
+ * `void hook(const struct app_event_header *aeh, const struct event_subscriber *es,
+ * uint32_t cycles)`, where @p es is the notified subscriber and @p cycles is the number
+ * of cycles spent in the listener.
+ *
+ * @param hook_fn Hook function.
+ */
+#define APP_EVENT_HOOK_NOTIFY_REGISTER(hook_fn) \
+	_APP_EVENT_HOOK_NOTIFY_REGISTER(hook_fn, _APP_EM_SUBS_PRIO_ID(_APP_EM_SUBS_PRIO_NORMAL))
+
 
 /** @brief Initialize the Application Event Manager.
  *
@@ -380,6 +395,17 @@ static inline size_t app_event_manager_event_size(const struct app_event_header
  */
 int app_event_manager_init(void);
 
+/** @brief Find event type by name.
+ *
+ * The event types are placed in the event type section sorted by their names by the linker,
+ * so the lookup is done using binary search.
+ *
+ * @param name  Name of the event type, that is the name used to define the event type.
+ *
+ * @retval Pointer to the event type if found, otherwise NULL.
+ */
+const struct event_type *app_event_manager_event_type_find(const char *name);
+
 /** @brief Allocate event.
  *
  * The behavior of this function depends on the actual implementation.
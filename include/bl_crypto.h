@@ -170,6 +170,93 @@ typedef int (*bl_sha256_verify_t)(const uint8_t *data, uint32_t data_len,
 				const uint8_t *expected);
 
 
+/**
+ * @brief Read a part of the data to hash.
+ *
+ * @param[in]  ctx     User context passed to the streaming function.
+ * @param[in]  offset  Offset of the part from the start of the data.
+ * @param[out] buf     Where to put the data. Word aligned.
+ * @param[in]  len     Number of bytes to read.
+ *
+ * @retval 0  On success.
+ * @return Negative error code if the data could not be read.
+ */
+typedef int (*bl_sha256_read_t)(void *ctx, uint32_t offset, uint8_t *buf,
+				uint32_t len);
+
+
+/**
+ * @brief Calculate a digest over data provided by a read function.
+ *
+ * The data is read in chunks of @kconfig{CONFIG_SB_CRYPTO_STREAM_CHUNK_LEN}
+ * bytes into a stack buffer, and each chunk is hashed before the next one is
+ * read. The data does not need to be memory-mapped, so this can be used for
+ * images in external or encrypted storage.
+ *
+ * @param[in]  read      Function that reads the data.
+ * @param[in]  read_ctx  User context passed to @p read.
+ * @param[in]  data_len  Total length of the data.
+ * @param[out] output    Where to put the resulting digest. Must be at least
+ *                       32 bytes long.
+ *
+ * @retval 0         On success.
+ * @retval -EINVAL   If @p read or @p output was NULL.
+ * @return Any error code from @p read, @ref bl_sha256_init,
+ *         @ref bl_sha256_update, or @ref bl_sha256_finalize if something else
+ *         went wrong.
+ */
+int bl_sha256_stream(bl_sha256_read_t read, void *read_ctx, uint32_t data_len,
+		     uint8_t *output);
+
+
+/**
+ * @brief Calculate a digest over data provided by a read function and verify
+ *        it.
+ *
+ * See @ref bl_sha256_stream for how the data is read.
+ *
+ * @param[in]  read      Function that reads the data.
+ * @param[in]  read_ctx  User context passed to @p read.
+ * @param[in]  data_len  Total length of the data.
+ * @param[in]  expected  The expected digest over the data.
+ *
+ * @retval 0          If the procedure succeeded and the resulting digest is
+ *                    identical to @p expected.
+ * @retval -EHASHINV  If the procedure succeeded, but the digests don't match.
+ * @return Any error code from @ref bl_sha256_stream if something else went
+ *         wrong.
+ */
+int bl_sha256_verify_stream(bl_sha256_read_t read, void *read_ctx,
+			    uint32_t data_len, const uint8_t *expected);
+
+
+/**
+ * @brief Verify a signature over firmware provided by a read function.
+ *
+ * Same as @ref bl_root_of_trust_verify, but the firmware is hashed with
+ * @ref bl_sha256_stream instead of being accessed through a pointer.
+ *
+ * @param[in]  public_key       Public key.
+ * @param[in]  public_key_hash  Expected hash of the public key. This is the
+ *                              root of trust.
+ * @param[in]  signature        Firmware signature.
+ * @param[in]  read             Function that reads the firmware.
+ * @param[in]  read_ctx         User context passed to @p read.
+ * @param[in]  firmware_len     Length of firmware.
+ *
+ * @retval 0          On success.
+ * @retval -EHASHINV  If public_key_hash didn't match public_key.
+ * @retval -ESIGINV   If signature validation failed.
+ * @return Any error code from @ref bl_sha256_stream or
+ *         @ref bl_secp256r1_validate if something else went wrong.
+ */
+int bl_root_of_trust_verify_stream(const uint8_t *public_key,
+				   const uint8_t *public_key_hash,
+				   const uint8_t *signature,
+				   bl_sha256_read_t read, void *read_ctx,
+				   const uint32_t firmware_len);
+
+
 /**
  * @brief Validate a secp256r1 signature.
  *
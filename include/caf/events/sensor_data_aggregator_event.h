@@ -31,6 +31,8 @@ struct sensor_data_aggregator_event {
 	enum sensor_state sensor_state;
 	uint8_t sample_cnt;
 	uint8_t values_in_sample;
+	/** Number of samples dropped since the previous buffer was sent. */
+	uint32_t dropped_cnt;
 };
 
 /** @brief Sensor data aggregator release buffer event.
@@ -80,6 +80,11 @@ APP_EVENT_TYPE_DECLARE(sensor_state_event);
  * in X, Y and Z axis as three fixed-point values. @ref sensor_event_get_data_cnt and @ref
  * sensor_event_get_data_ptr can be used to access the sensor data provided by a given sensor event.
  *
+ * A single event may carry multiple consecutive samples of the sensor (for example, samples read
+ * from a sensor FIFO). The samples are stored one after another. The timestamp of the first sample
+ * and the period between the samples can be used to get the timestamp of every sample, see
+ * @ref sensor_event_get_sample_timestamp.
+ *
  * @note The sensor event related to the given sensor must use the same description as
  *       #sensor_state_event related to the sensor.
  */
@@ -87,6 +92,8 @@ struct sensor_event {
 	struct app_event_header header; /**< Event header. */
 
 	const char *descr; /**< Description of the sensor. */
+	int64_t timestamp_us; /**< Timestamp of the first sample. Zero if not provided. */
+	uint32_t sample_period_us; /**< Period between consecutive samples. */
 	struct event_dyndata dyndata; /**< Sensor data. Provided as fixed-point values. */
 };
 
@@ -137,6 +144,19 @@ static inline struct sensor_value *sensor_event_get_data_ptr(const struct sensor
 	return (struct sensor_value *)event->dyndata.data;
 }
 
+/** @brief Get timestamp of a sample.
+ *
+ * @param[in] event       Pointer to the sensor_event.
+ * @param[in] sample_idx  Index of the sample in the event.
+ *
+ * @return Timestamp of the sample in microseconds.
+ */
+static inline int64_t sensor_event_get_sample_timestamp(const struct sensor_event *event,
+							size_t sample_idx)
+{
+	return event->timestamp_us + (int64_t)sample_idx * event->sample_period_us;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SENSOR_DATA_AGGREGATOR_H_
+#define _SENSOR_DATA_AGGREGATOR_H_
+
+/**
+ * @file
+ * @defgroup caf_sensor_data_aggregator CAF Sensor Data Aggregator
+ * @{
+ * @brief CAF Sensor Data Aggregator direct data interface.
+ *
+ * The interface allows a sensor data source to write samples directly into the aggregator
+ * buffer, instead of submitting a sensor_event for every sample. Only the
+ * sensor_data_aggregator_event is submitted when the buffer is full.
+ *
+ * A single data source per sensor description is supported.
+ */
+
+#include <stddef.h>
+#include <zephyr/drivers/sensor.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Claim space for samples in the active aggregator buffer.
+ *
+ * Every claim must be followed by @ref sensor_data_aggregator_commit.
+ *
+ * @param[in]     sensor_descr Sensor description used by the aggregator.
+ * @param[in,out] sample_cnt   Number of requested samples. Set to the number of samples that
+ *                             can be written.
+ *
+ * @return Pointer to the first free sample in the buffer, or NULL if there is no aggregator
+ *         for the sensor or no free buffer is available.
+ */
+struct sensor_value *sensor_data_aggregator_claim(const char *sensor_descr, size_t *sample_cnt);
+
+/** @brief Commit samples written into the claimed space.
+ *
+ * If the buffer becomes full, it is passed to the subscribers using
+ * sensor_data_aggregator_event.
+ *
+ * @param sensor_descr Sensor description used by the aggregator.
+ * @param sample_cnt   Number of samples written, up to the claimed number.
+ *
+ * @retval 0       If the operation was successful.
+ * @retval -ENOENT If there is no aggregator for the sensor.
+ */
+int sensor_data_aggregator_commit(const char *sensor_descr, size_t sample_cnt);
+
+/** @brief Report samples dropped by the data source.
+ *
+ * The dropped samples are reported in the next sensor_data_aggregator_event.
+ *
+ * @param sensor_descr Sensor description used by the aggregator.
+ * @param sample_cnt   Number of dropped samples.
+ */
+void sensor_data_aggregator_drop(const char *sensor_descr, size_t sample_cnt);
+
+/** @brief Get the number of sensor values in a sample of an aggregated sensor.
+ *
+ * @param sensor_descr Sensor description.
+ *
+ * @return Number of sensor values in a sample if there is an aggregator for the sensor,
+ *         -ENOENT otherwise.
+ */
+int sensor_data_aggregator_sample_size_get(const char *sensor_descr);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _SENSOR_DATA_AGGREGATOR_H_ */
@@ -32,6 +32,40 @@ struct sm_trigger {
 	struct sm_trigger_activation activation;
 };
 
+/**
+ * @brief Batch sampling configuration
+ *
+ * Used by sensors with a hardware FIFO. Every call to sensor_sample_fetch must
+ * read the next sample from the sensor FIFO.
+ */
+struct sm_batch {
+	/**
+	 * @brief Number of samples read from the sensor on every wake up
+	 */
+	uint8_t sample_cnt;
+	/**
+	 * @brief FIFO watermark trigger
+	 *
+	 * If set, the FIFO is drained when the trigger fires. Otherwise the FIFO
+	 * is drained every sample_cnt sampling periods.
+	 */
+	const struct sensor_trigger *watermark;
+};
+
+/**
+ * @brief Sensor bus statistics
+ */
+struct sm_bus_stats {
+	/** Number of wake ups that read samples from the sensor. */
+	uint32_t read_cnt;
+	/** Number of samples read from the sensor. */
+	uint32_t sample_cnt;
+	/** Total time spent on reading the samples in microseconds. */
+	uint64_t total_us;
+	/** Longest time spent on a single wake up in microseconds. */
+	uint32_t max_us;
+};
+
 /**
  * @brief Sensor configuration
  *
@@ -81,12 +115,32 @@ struct sm_sensor_config {
 	 * from suspend.
 	 */
 	struct sm_trigger *trigger;
+	/**
+	 * @brief Batch sampling configuration
+	 *
+	 * Used only if :kconfig:option:`CONFIG_CAF_SENSOR_MANAGER_BATCH` is enabled.
+	 * Set to NULL to read a single sample every sampling period.
+	 */
+	const struct sm_batch *batch;
 	/**
 	 * @brief Flag to indicate whether sensor should be suspended or not.
 	 */
 	bool suspend;
 };
 
+/**
+ * @brief Get bus statistics of a sensor
+ *
+ * Requires :kconfig:option:`CONFIG_CAF_SENSOR_MANAGER_BUS_STATS`.
+ *
+ * @param[in]  event_descr Event descriptor of the sensor.
+ * @param[out] stats       Pointer to the structure filled with the statistics.
+ *
+ * @retval 0       If the operation was successful.
+ * @retval -ENOENT If there is no sensor with given descriptor.
+ */
+int sensor_manager_bus_stats_get(const char *event_descr, struct sm_bus_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,7 @@
 #ifndef __CPU_LOAD_H
 #define __CPU_LOAD_H
 
+#include <stdbool.h>
 #include <zephyr/types.h>
 
 #ifdef __cplusplus
@@ -47,6 +48,81 @@ void cpu_load_reset(void);
  */
 uint32_t cpu_load_get(void);
 
+/** @brief Busy time of a single thread or ISR measured by the CPU load profiler. */
+struct cpu_load_profiler_ctx {
+	/** Thread, or NULL for ISRs and for threads that are not tracked individually. */
+	const struct k_thread *thread;
+
+	/** Context name. Valid only during the callback. */
+	const char *name;
+
+	/** The context is an ISR. */
+	bool isr;
+
+	/** The context is the idle thread. */
+	bool idle;
+
+	/** Busy time since the last reset in microseconds. */
+	uint64_t busy_us;
+
+	/** Longest uninterrupted run since the last reset in microseconds. */
+	uint32_t max_run_us;
+};
+
+/** @brief CPU load distribution over the sliding window of the CPU load profiler. */
+struct cpu_load_profiler_window {
+	/** Number of load samples in the window. */
+	uint32_t samples;
+
+	/** Median load in percent. */
+	uint8_t p50;
+
+	/** 90th percentile of the load in percent. */
+	uint8_t p90;
+
+	/** 99th percentile of the load in percent. */
+	uint8_t p99;
+
+	/** Highest load in percent. */
+	uint8_t max;
+
+	/** Longest period without entering the idle thread since the last reset
+	 *  in microseconds.
+	 */
+	uint32_t max_burst_us;
+};
+
+/** @brief Callback used to iterate over the contexts of the CPU load profiler.
+ *
+ * @param ctx       Busy time of the context.
+ * @param user_data User data passed to @ref cpu_load_profiler_ctx_foreach.
+ */
+typedef void (*cpu_load_profiler_ctx_cb)(const struct cpu_load_profiler_ctx *ctx,
+					 void *user_data);
+
+/** @brief Iterate over the threads and ISRs that were busy since the last reset.
+ *
+ * Available when the @kconfig{CONFIG_CPU_LOAD_PROFILER} option is enabled.
+ *
+ * @param cb        Callback called for every context.
+ * @param user_data User data passed to the callback.
+ */
+void cpu_load_profiler_ctx_foreach(cpu_load_profiler_ctx_cb cb, void *user_data);
+
+/** @brief Get the CPU load distribution over the sliding window.
+ *
+ * Available when the @kconfig{CONFIG_CPU_LOAD_PROFILER} option is enabled.
+ *
+ * @param window Structure filled with the load distribution.
+ */
+void cpu_load_profiler_window_get(struct cpu_load_profiler_window *window);
+
+/** @brief Reset the busy times, the sliding window and the longest busy burst.
+ *
+ * Available when the @kconfig{CONFIG_CPU_LOAD_PROFILER} option is enabled.
+ */
+void cpu_load_profiler_reset(void);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -175,6 +175,9 @@ int ei_wrapper_get_anomaly(float *anomaly);
  * If calculating the anomaly value is not supported, anomaly_time is set to
  * the value of -1.
  *
+ * If @kconfig{CONFIG_EI_WRAPPER_CONTINUOUS} is enabled, dsp_time is the time spent
+ * on computing features of all the slices that were not cached for the prediction.
+ *
  * @param[out] dsp_time            Pointer to the variable that is used to store
  *                                 the dsp time.
  * @param[out] classification_time Pointer to the variable that is used to store
@@ -64,6 +64,17 @@ enum location_req_mode {
 	LOCATION_REQ_MODE_FALLBACK = 0,
 	/** All requested methods are used sequentially. */
 	LOCATION_REQ_MODE_ALL,
+	/**
+	 * All requested methods are started at the same time.
+	 *
+	 * Wi-Fi and cellular positioning are combined into a single cloud request that runs
+	 * in parallel with GNSS. The request completes with the first acceptable location,
+	 * see @ref location_config.parallel_accuracy, and the methods still running are
+	 * cancelled.
+	 *
+	 * Requires @kconfig{CONFIG_LOCATION_REQ_MODE_PARALLEL}.
+	 */
+	LOCATION_REQ_MODE_PARALLEL,
 };
 
 /** Event IDs. */
@@ -561,6 +572,9 @@ struct location_config {
 	 *   - Methods are one after the other in location request method list
 	 *   - @ref mode is @ref LOCATION_REQ_MODE_FALLBACK
 	 *   - Requested cloud service for Wi-Fi and cellular is the same
+	 *
+	 * If @ref mode is @ref LOCATION_REQ_MODE_PARALLEL, Wi-Fi and cellular are always
+	 * combined and they must use the same cloud service.
 	 */
 	struct location_method_config methods[CONFIG_LOCATION_METHODS_LIST_SIZE];
 
@@ -599,6 +613,45 @@ struct location_config {
 	 * location_config_defaults_set() function is called.
 	 */
 	enum location_req_mode mode;
+
+	/**
+	 * @brief Accuracy (in meters) of a location that completes the request when
+	 * @ref mode is @ref LOCATION_REQ_MODE_PARALLEL.
+	 *
+	 * @details The first location with this accuracy or better completes the request and
+	 * the methods still running are cancelled. A less accurate location is kept and
+	 * the request completes with the most accurate location once all methods are done.
+	 * If no method acquires a location, the request completes with the result of the
+	 * method with the highest priority.
+	 *
+	 * Set to 0 to complete the request with the first acquired location.
+	 *
+	 * Default value is 0. It is applied when location_config_defaults_set() function
+	 * is called.
+	 */
+	float parallel_accuracy;
+
+	/**
+	 * @brief Maximum age (in seconds) of a cached location that can be used as the result
+	 * of the request.
+	 *
+	 * @details A cached location is used when the device has been indicated to be stationary
+	 * with location_cache_stationary_set() since the location was acquired, or when the
+	 * Wi-Fi access points or, for requests where cellular positioning has the highest
+	 * priority, the serving cell match the ones seen when the location was acquired.
+	 * The accuracy of a location matched with the radio environment is reported as at least
+	 * @kconfig{CONFIG_LOCATION_CACHE_WIFI_ACCURACY} or
+	 * @kconfig{CONFIG_LOCATION_CACHE_CELL_ACCURACY}.
+	 *
+	 * Set to 0 to always acquire a new location.
+	 *
+	 * Ignored if @kconfig{CONFIG_LOCATION_CACHE} is not enabled.
+	 *
+	 * Default value is 0. It can be changed at build time with
+	 * @kconfig{CONFIG_LOCATION_REQUEST_DEFAULT_CACHE_MAX_AGE} configuration.
+	 * It is applied when location_config_defaults_set() function is called.
+	 */
+	uint32_t cache_max_age;
 };
 
 /**
@@ -783,6 +836,27 @@ void location_cloud_location_ext_result_set(
 	enum location_ext_result result,
 	struct location_data *location);
 
+/**
+ * @brief Indicate whether the device is stationary.
+ *
+ * @details Meant to be called from a motion sensor handler, for example. While the device is
+ * stationary, the latest location acquired since it became stationary is used for location
+ * requests, as long as it is not older than @ref location_config.cache_max_age.
+ * Indicating that the device is not stationary invalidates this until a new location is acquired.
+ *
+ * Requires @kconfig{CONFIG_LOCATION_CACHE} to be enabled.
+ *
+ * @param[in] stationary Whether the device is stationary.
+ */
+void location_cache_stationary_set(bool stationary);
+
+/**
+ * @brief Remove all locations from the location cache.
+ *
+ * Requires @kconfig{CONFIG_LOCATION_CACHE} to be enabled.
+ */
+void location_cache_clear(void);
+
 /** @} */
 
 #ifdef __cplusplus
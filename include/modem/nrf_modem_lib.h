@@ -249,6 +249,30 @@ struct nrf_modem_lib_diag_stats {
 int nrf_modem_lib_diag_stats_get(struct nrf_modem_lib_diag_stats *stats);
 #endif
 
+/** @brief Wakeup statistics of threads waiting for the Modem library events. */
+struct nrf_modem_lib_wakeup_stats {
+	/** Number of wakeups of threads waiting for the context of the event,
+	 *  or for any context.
+	 */
+	uint32_t targeted;
+	/** Number of wakeups of threads waiting for a specific context by an event
+	 *  not related to that context.
+	 */
+	uint32_t spurious;
+};
+
+/**
+ * @brief Retrieve wakeup statistics.
+ *
+ * @param[out] stats Wakeup statistics.
+ */
+void nrf_modem_lib_wakeup_stats_get(struct nrf_modem_lib_wakeup_stats *stats);
+
+/**
+ * @brief Reset wakeup statistics.
+ */
+void nrf_modem_lib_wakeup_stats_reset(void);
+
 /** @} */
 
 #ifdef __cplusplus
@@ -114,6 +114,17 @@ int nrf_modem_lib_trace_clear(void);
  * @return Rolling average bitrate of the trace backend
  */
 uint32_t nrf_modem_lib_trace_backend_bitrate_get(void);
+
+/** @brief Get the compression ratio of the trace backend.
+ *
+ * For trace backends that compress trace data, the amount of data that is actually stored
+ * is the bitrate returned by @ref nrf_modem_lib_trace_backend_bitrate_get divided by
+ * this ratio.
+ *
+ * @return Ratio of the size of the written trace data to the size of the stored trace data,
+ *         in percent. 100 if the trace backend does not compress trace data.
+ */
+uint32_t nrf_modem_lib_trace_backend_compression_ratio_get(void);
 #endif /* defined(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_BITRATE) || defined(__DOXYGEN__) */
 
 /** @} */
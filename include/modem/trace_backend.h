@@ -7,6 +7,9 @@
 #ifndef TRACE_BACKEND_H__
 #define TRACE_BACKEND_H__
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -122,6 +125,16 @@ struct nrf_modem_lib_trace_backend {
 	 * @return 0 on success, negative errno on failure.
 	 */
 	int (*resume)(void);
+
+	/**
+	 * @brief Get the compression ratio of the trace data stored by the backend.
+	 *
+	 * @note Set to @c NULL if the trace backend does not compress trace data.
+	 *
+	 * @return Ratio of the size of the written trace data to the size of the stored
+	 *         trace data, in percent.
+	 */
+	uint32_t (*compression_ratio)(void);
 };
 
 /**@} */ /* defgroup trace_backend */
@@ -15,6 +15,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <zephyr/types.h>
 #include <nfc/ndef/record_parser.h>
 #include <nfc/ndef/msg.h>
@@ -86,6 +87,69 @@ int nfc_ndef_msg_parse(uint8_t  *result_buf,
 		       const uint8_t *raw_data,
 		       uint32_t *raw_data_len);
 
+/** @brief Iterator over the records of a raw NDEF message.
+ *
+ *  The iterator walks the NFC data in place and does not need memory for
+ *  record descriptors. The NFC data can be provided incrementally, for
+ *  example as it is read from a tag, using @ref nfc_ndef_msg_iter_extend.
+ */
+struct nfc_ndef_msg_iter {
+	/** Pointer to the raw NDEF message. */
+	const uint8_t *data;
+	/** Size of the NFC data available in the @p data buffer. */
+	uint32_t len;
+	/** Offset of the next record. */
+	uint32_t offset;
+	/** Number of records returned so far. */
+	uint32_t record_count;
+	/** A chunked payload is in progress. */
+	bool in_chunk;
+	/** The last record of the message has been returned. */
+	bool done;
+};
+
+/** @brief Initialize an NDEF message iterator.
+ *
+ *  @param[out] iter Pointer to the iterator.
+ *  @param[in] raw_data Pointer to the data to be parsed.
+ *  @param[in] raw_data_len Size of the NFC data currently available in
+ *                          the @p raw_data buffer.
+ */
+void nfc_ndef_msg_iter_init(struct nfc_ndef_msg_iter *iter,
+			    const uint8_t *raw_data,
+			    uint32_t raw_data_len);
+
+/** @brief Update the size of the NFC data available to an NDEF message
+ *         iterator.
+ *
+ *  Use this function when more data has been written to the buffer
+ *  passed to @ref nfc_ndef_msg_iter_init.
+ *
+ *  @param[in,out] iter Pointer to the iterator.
+ *  @param[in] raw_data_len Size of the NFC data available in the buffer.
+ */
+void nfc_ndef_msg_iter_extend(struct nfc_ndef_msg_iter *iter,
+			      uint32_t raw_data_len);
+
+/** @brief Get the next record of an NDEF message.
+ *
+ *  The function checks the record location flags and the sequence of
+ *  chunked records.
+ *
+ *  @param[in,out] iter Pointer to the iterator.
+ *  @param[out] view Pointer to the record view to be filled.
+ *
+ *  @retval 0 If the record was parsed.
+ *  @retval -ENODATA If the last record of the message has already been
+ *                   returned.
+ *  @retval -EAGAIN If the available NFC data ends before the end of the next
+ *                  record. The iterator is not advanced.
+ *  @retval -EFAULT If the record location flags or the chunked record
+ *                  sequence are invalid.
+ */
+int nfc_ndef_msg_iter_next(struct nfc_ndef_msg_iter *iter,
+			   struct nfc_ndef_record_view *view);
+
 /** @brief Print the parsed contents of an NDEF message.
  *
  *  @param[in] msg_desc Pointer to the descriptor of the message that should
@@ -25,6 +25,10 @@ extern "C" {
 
 /** Mask of the ID field presence bit in the flags byte of an NDEF record. */
 #define NDEF_RECORD_IL_MASK                0x08
+/** Mask of the CF flag. If set, this flag indicates that the record is
+ *  a chunk of a chunked payload, and that it is not the last chunk.
+ */
+#define NDEF_RECORD_CF_MASK                0x20
 /** Mask of the TNF value field in the first byte of an NDEF record. */
 #define NDEF_RECORD_TNF_MASK               0x07
 /** Mask of the SR flag. If set, this flag indicates that the PAYLOAD_LENGTH
@@ -8,6 +8,7 @@
 #define NFC_NDEF_RECORD_PARSER_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <zephyr/types.h>
 #include <nfc/ndef/record.h>
 
@@ -22,6 +23,48 @@ extern "C" {
  */
 
 
+/** @brief View of an NDEF record.
+ *
+ *  The record fields are not copied. The pointers refer to the locations
+ *  of the fields in the parsed NFC data.
+ */
+struct nfc_ndef_record_view {
+	/** Type Name Format. */
+	enum nfc_ndef_record_tnf tnf;
+	/** Location of the record within the NDEF message. */
+	enum nfc_ndef_record_location location;
+	/** The record is a chunk of a chunked payload, but not the last one. */
+	bool chunk;
+	/** Length of the type field. */
+	uint8_t type_length;
+	/** Pointer to the type field data. NULL if type_length is 0. */
+	const uint8_t *type;
+	/** Length of the ID field. */
+	uint8_t id_length;
+	/** Pointer to the ID field data. NULL if id_length is 0. */
+	const uint8_t *id;
+	/** Length of the payload. */
+	uint32_t payload_length;
+	/** Pointer to the payload. NULL if payload_length is 0. */
+	const uint8_t *payload;
+};
+
+/** @brief Parse an NDEF record into a record view.
+ *
+ *  @param[out] view Pointer to the record view that will be filled with
+ *                   parsed data.
+ *  @param[in] nfc_data Pointer to the raw data to be parsed.
+ *  @param[in,out] nfc_data_len As input: size of the NFC data in the
+ *                              @p nfc_data buffer. As output: size of the
+ *                              parsed record.
+ *
+ *  @retval 0 If the operation was successful.
+ *  @retval -EAGAIN If the NFC data ends before the end of the record.
+ */
+int nfc_ndef_record_view_parse(struct nfc_ndef_record_view *view,
+			       const uint8_t *nfc_data,
+			       uint32_t *nfc_data_len);
+
 /** @brief Parse NDEF records.
  *
  *  This parsing implementation uses the binary payload descriptor
@@ -91,10 +91,14 @@ struct nfc_t4t_apdu_comm {
 	/** Parameters associated with the instruction code. */
 	uint16_t parameter;
 
-	/** Optional data fields (Lc + data bytes). */
+	/** Optional data fields (Lc + data bytes). Data longer than 255 bytes
+	 *  is encoded in the extended length format.
+	 */
 	struct nfc_t4t_apdu_data data;
 
-	/** Optional response length field (Le). */
+	/** Optional response length field (Le). Values above 256 are encoded
+	 *  in the extended length format.
+	 */
 	uint16_t resp_len;
 };
 
@@ -15,6 +15,7 @@
  */
 
 
+#include <errno.h>
 #include <zephyr/types.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/__assert.h>
@@ -99,6 +100,31 @@ void nrf_profiler_term(void);
 static inline void nrf_profiler_term(void) {}
 #endif
 
+/** @brief Statistics of the profiled events.
+ */
+struct nrf_profiler_stats {
+	/** Number of events passed to the backend. */
+	uint32_t events_sent;
+	/** Number of events dropped because the event buffer was full. */
+	uint32_t events_dropped;
+};
+
+/** @brief Get the statistics of the profiled events.
+ *
+ * @param stats Pointer to the structure for the statistics.
+ *
+ * @retval 0 If the operation was successful.
+ * @retval -EINVAL If @p stats is NULL.
+ */
+#ifdef CONFIG_NRF_PROFILER
+int nrf_profiler_stats_get(struct nrf_profiler_stats *stats);
+#else
+static inline int nrf_profiler_stats_get(struct nrf_profiler_stats *stats)
+{
+	return -ENOTSUP;
+}
+#endif
+
 /** @brief Retrieve the description of an event type.
  *
  * @param nrf_profiler_event_id Event ID.
@@ -293,6 +319,9 @@ static inline void nrf_profiler_log_add_mem_address(struct log_event_buf *buf,
 /** @brief Send data from the buffer to the host.
  *
  * This function only sends data that is already stored in the buffer.
+ * The event is queued without locking and passed to the backend later.
+ * If there is no space for it, the event is dropped and counted, see
+ * @ref nrf_profiler_stats_get.
  * Use @ref nrf_profiler_log_encode_uint32, @ref nrf_profiler_log_encode_int32,
  * @ref nrf_profiler_log_encode_uint16, @ref nrf_profiler_log_encode_int16,
  * @ref nrf_profiler_log_encode_uint8, @ref nrf_profiler_log_encode_int8,
@@ -39,6 +39,7 @@ extern "C" {
 	extern const struct nrf_rpc_tr NRF_RPC_UART_TRANSPORT(node_id);
 
 DT_FOREACH_STATUS_OKAY(nordic_nrf_uarte, _NRF_RPC_UART_TRANSPORT_DECLARE);
+DT_FOREACH_STATUS_OKAY(zephyr_uart_emul, _NRF_RPC_UART_TRANSPORT_DECLARE);
 
 #ifdef __cplusplus
 }
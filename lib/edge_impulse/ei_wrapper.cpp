@@ -33,6 +33,13 @@ BUILD_ASSERT(CONFIG_EI_WRAPPER_THREAD_STACK_SIZE > 0);
 #define THREAD_PRIORITY 	CONFIG_EI_WRAPPER_THREAD_PRIORITY
 #define DEBUG_MODE		IS_ENABLED(CONFIG_EI_WRAPPER_DEBUG_MODE)
 
+#ifdef CONFIG_EI_WRAPPER_CONTINUOUS
+#define SLICE_COUNT		EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW
+#else
+#define SLICE_COUNT		1
+#endif
+#define SLICE_SIZE		(INPUT_WINDOW_SIZE / SLICE_COUNT)
+
 enum state {
 	STATE_DISABLED,
 	STATE_WAITING_FOR_DATA,
@@ -45,6 +52,10 @@ struct data_buffer {
 	size_t process_idx;
 	size_t append_idx;
 	size_t wait_data_size;
+	/* Window shift done before the processing. */
+	size_t process_move;
+	/* Features cached by the library do not match the buffered data. */
+	bool features_reset;
 	struct k_spinlock lock;
 	enum state state;
 };
@@ -59,10 +70,13 @@ static struct data_buffer ei_input;
 static ei_impulse_result_t ei_result;
 static int cur_res_idx;
 static ei_wrapper_result_ready_cb user_cb;
+static size_t slice_offset;
 
 
 BUILD_ASSERT(DATA_BUFFER_SIZE > INPUT_WINDOW_SIZE);
 BUILD_ASSERT(INPUT_WINDOW_SIZE % INPUT_FRAME_SIZE == 0);
+BUILD_ASSERT(INPUT_WINDOW_SIZE % SLICE_COUNT == 0);
+BUILD_ASSERT(SLICE_SIZE % INPUT_FRAME_SIZE == 0);
 
 
 static size_t buf_get_collected_data_count(const struct data_buffer *b)
@@ -111,6 +125,8 @@ static int buf_cleanup(struct data_buffer *b, bool *cancelled)
 		b->process_idx = 0;
 		b->append_idx = 0;
 		b->wait_data_size = 0;
+		b->process_move = 0;
+		b->features_reset = true;
 		b->state = STATE_READY;
 	}
 
@@ -210,6 +226,7 @@ static int buf_processing_move(struct data_buffer *b, size_t move,
 
 	size_t max_move = buf_get_collected_data_count(b);
 
+	b->process_move = move;
 	b->process_idx += move;
 	if (b->process_idx >= ARRAY_SIZE(b->buf)) {
 		b->process_idx -= ARRAY_SIZE(b->buf);
@@ -303,7 +320,7 @@ int ei_wrapper_start_prediction(size_t window_shift, size_t frame_shift)
 
 static int raw_feature_get_data(size_t offset, size_t length, float *out_ptr)
 {
-	buf_get(&ei_input, out_ptr, offset, length);
+	buf_get(&ei_input, out_ptr, slice_offset + offset, length);
 
 	return 0;
 }
@@ -317,6 +334,63 @@ static void processing_finished(int err)
 	user_cb(err);
 }
 
+#ifdef CONFIG_EI_WRAPPER_CONTINUOUS
+static EI_IMPULSE_ERROR run_classifier_cached(signal_t *features_signal)
+{
+	struct data_buffer *b = &ei_input;
+	size_t first_slice = 0;
+	int dsp_time = 0;
+
+	/* Processing index and window shift cannot change while processing is done. */
+	__ASSERT_NO_MSG(b->state == STATE_PROCESSING);
+
+	/* Features of the previous window can be reused only if the window moved by
+	 * a single slice. Otherwise, features of all slices are computed again.
+	 */
+	if (!b->features_reset && (b->process_move == SLICE_SIZE)) {
+		first_slice = SLICE_COUNT - 1;
+	} else {
+		run_classifier_init();
+	}
+
+	b->features_reset = true;
+
+	for (size_t i = first_slice; i < SLICE_COUNT; i++) {
+		slice_offset = i * SLICE_SIZE;
+
+		EI_IMPULSE_ERROR err = run_classifier_continuous(features_signal, &ei_result,
+								 DEBUG_MODE, false);
+
+		if (err) {
+			return err;
+		}
+
+		dsp_time += ei_result.timing.dsp;
+	}
+
+	b->features_reset = false;
+
+	/* Report DSP time of all slices computed for this prediction. */
+	ei_result.timing.dsp = dsp_time;
+
+	if (IS_ENABLED(CONFIG_EI_WRAPPER_PROFILING)) {
+		LOG_INF("DSP features computed for %zu of %d slices",
+			SLICE_COUNT - first_slice, SLICE_COUNT);
+	}
+
+	return EI_IMPULSE_OK;
+}
+#endif /* CONFIG_EI_WRAPPER_CONTINUOUS */
+
+static EI_IMPULSE_ERROR run_impulse(signal_t *features_signal)
+{
+#ifdef CONFIG_EI_WRAPPER_CONTINUOUS
+	return run_classifier_cached(features_signal);
+#else
+	return run_classifier(features_signal, &ei_result, DEBUG_MODE);
+#endif
+}
+
 static void edge_impulse_thread_fn(void)
 {
 	signal_t features_signal;
@@ -326,15 +400,15 @@ static void edge_impulse_thread_fn(void)
 		k_sem_take(&ei_sem, K_FOREVER);
 
 		features_signal.get_data = &raw_feature_get_data;
-		features_signal.total_length = INPUT_WINDOW_SIZE;
+		features_signal.total_length = SLICE_SIZE;
+		slice_offset = 0;
 
 		if (IS_ENABLED(CONFIG_EI_WRAPPER_PROFILING)) {
 			start_time = k_uptime_get();
 		}
 
 		/* Invoke the impulse. */
-		EI_IMPULSE_ERROR err = run_classifier(&features_signal,
-						      &ei_result, DEBUG_MODE);
+		EI_IMPULSE_ERROR err = run_impulse(&features_signal);
 		if (IS_ENABLED(CONFIG_EI_WRAPPER_PROFILING)) {
 			int64_t delta = k_uptime_delta(&start_time);
 
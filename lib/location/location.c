@@ -150,6 +150,8 @@ int location_request(const struct location_config *config)
 			default_config.interval = config->interval;
 			default_config.timeout = config->timeout;
 			default_config.mode = config->mode;
+			default_config.parallel_accuracy = config->parallel_accuracy;
+			default_config.cache_max_age = config->cache_max_age;
 		} else {
 			LOG_DBG("No configuration given. Using default configuration.");
 		}
@@ -242,6 +244,9 @@ void location_config_defaults_set(
 	config->interval = CONFIG_LOCATION_REQUEST_DEFAULT_INTERVAL;
 	config->timeout = CONFIG_LOCATION_REQUEST_DEFAULT_TIMEOUT;
 	config->mode = LOCATION_REQ_MODE_FALLBACK;
+#if defined(CONFIG_LOCATION_CACHE)
+	config->cache_max_age = CONFIG_LOCATION_REQUEST_DEFAULT_CACHE_MAX_AGE;
+#endif
 
 	/* Handle Kconfig's for method priorities */
 	if (method_types == NULL) {
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <modem/location.h>
+#include <modem/lte_lc.h>
+
+#include "location_cache.h"
+
+LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
+
+#define BSSID_LEN 6
+
+/** Radio environment in which a location was acquired. */
+struct location_cache_fingerprint {
+	/** Serving cell, LTE_LC_CELL_EUTRAN_ID_INVALID if not known. */
+	uint32_t cell_id;
+	uint32_t tac;
+	uint8_t bssid_count;
+#if defined(CONFIG_LOCATION_METHOD_WIFI)
+	/** Strongest Wi-Fi access points. */
+	uint8_t bssids[CONFIG_LOCATION_CACHE_WIFI_AP_COUNT][BSSID_LEN];
+#endif
+};
+
+struct location_cache_entry {
+	/** Uptime when the location was stored. Zero if the entry is not in use. */
+	int64_t timestamp;
+	enum location_method method;
+	double latitude;
+	double longitude;
+	float accuracy;
+	struct location_datetime datetime;
+	struct location_cache_fingerprint fingerprint;
+};
+
+static struct location_cache_entry cache[CONFIG_LOCATION_CACHE_SIZE];
+
+/** Fingerprint of the ongoing location request. */
+static struct location_cache_fingerprint request_fingerprint;
+
+/** Current serving cell. */
+static uint32_t serving_cell_id = LTE_LC_CELL_EUTRAN_ID_INVALID;
+static uint32_t serving_tac;
+
+/** Whether the device is stationary according to the application. */
+static bool stationary;
+/** Whether the device has moved after the latest location was stored. */
+static bool moved = true;
+
+static K_MUTEX_DEFINE(cache_mutex);
+
+static void location_cache_lte_ind_handler(const struct lte_lc_evt *const evt)
+{
+	switch (evt->type) {
+	case LTE_LC_EVT_CELL_UPDATE:
+		k_mutex_lock(&cache_mutex, K_FOREVER);
+		serving_cell_id = evt->cell.id;
+		serving_tac = evt->cell.tac;
+		k_mutex_unlock(&cache_mutex);
+		break;
+
+	case LTE_LC_EVT_NEIGHBOR_CELL_MEAS:
+		if (evt->cells_info.current_cell.id != LTE_LC_CELL_EUTRAN_ID_INVALID) {
+			k_mutex_lock(&cache_mutex, K_FOREVER);
+			serving_cell_id = evt->cells_info.current_cell.id;
+			serving_tac = evt->cells_info.current_cell.tac;
+			k_mutex_unlock(&cache_mutex);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void location_cache_init(void)
+{
+	lte_lc_register_handler(location_cache_lte_ind_handler);
+}
+
+static bool location_cache_entry_fresh(const struct location_cache_entry *entry, uint32_t max_age)
+{
+	return entry->timestamp != 0 &&
+	       k_uptime_get() - entry->timestamp <= (int64_t)max_age * MSEC_PER_SEC;
+}
+
+static void location_cache_entry_to_location(
+	const struct location_cache_entry *entry,
+	float min_accuracy,
+	struct location_data *location)
+{
+	memset(location, 0, sizeof(*location));
+	location->latitude = entry->latitude;
+	location->longitude = entry->longitude;
+	location->accuracy = MAX(entry->accuracy, min_accuracy);
+	location->datetime = entry->datetime;
+}
+
+/** Get the most recently stored entry that is not older than max_age and matches. */
+static const struct location_cache_entry *location_cache_latest_get(
+	uint32_t max_age,
+	bool (*match)(const struct location_cache_entry *entry))
+{
+	const struct location_cache_entry *latest = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (!location_cache_entry_fresh(&cache[i], max_age)) {
+			continue;
+		}
+		if (match != NULL && !match(&cache[i])) {
+			continue;
+		}
+		if (latest == NULL || cache[i].timestamp > latest->timestamp) {
+			latest = &cache[i];
+		}
+	}
+
+	return latest;
+}
+
+static bool location_cache_cell_match(const struct location_cache_entry *entry)
+{
+	return serving_cell_id != LTE_LC_CELL_EUTRAN_ID_INVALID &&
+	       entry->fingerprint.cell_id == serving_cell_id &&
+	       entry->fingerprint.tac == serving_tac;
+}
+
+void location_cache_request_start(void)
+{
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+	request_fingerprint.bssid_count = 0;
+	k_mutex_unlock(&cache_mutex);
+}
+
+int location_cache_get(
+	uint32_t max_age,
+	bool cell_match,
+	struct location_data *location,
+	enum location_method *method)
+{
+	const struct location_cache_entry *entry = NULL;
+	float min_accuracy = 0;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	if (stationary && !moved) {
+		entry = location_cache_latest_get(max_age, NULL);
+		if (entry != NULL) {
+			LOG_DBG("Device is stationary, using cached location");
+		}
+	}
+
+	if (entry == NULL && cell_match) {
+		entry = location_cache_latest_get(max_age, location_cache_cell_match);
+		if (entry != NULL) {
+			LOG_DBG("Serving cell matches, using cached location");
+			min_accuracy = CONFIG_LOCATION_CACHE_CELL_ACCURACY;
+		}
+	}
+
+	if (entry != NULL) {
+		location_cache_entry_to_location(entry, min_accuracy, location);
+		*method = entry->method;
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	return (entry != NULL) ? 0 : -ENOENT;
+}
+
+#if defined(CONFIG_LOCATION_METHOD_WIFI)
+void location_cache_wifi_fingerprint_set(const struct wifi_scan_info *wifi)
+{
+	bool used[CONFIG_LOCATION_METHOD_WIFI_SCANNING_RESULTS_MAX_CNT] = { 0 };
+	int strongest;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	/* Pick the strongest access points, which are the most likely to be found again */
+	request_fingerprint.bssid_count = 0;
+	while (request_fingerprint.bssid_count < CONFIG_LOCATION_CACHE_WIFI_AP_COUNT) {
+		strongest = -1;
+		for (int i = 0; i < MIN(wifi->cnt, ARRAY_SIZE(used)); i++) {
+			if (!used[i] && wifi->ap_info[i].mac_length == BSSID_LEN &&
+			    (strongest < 0 || wifi->ap_info[i].rssi > wifi->ap_info[strongest].rssi)) {
+				strongest = i;
+			}
+		}
+		if (strongest < 0) {
+			break;
+		}
+
+		used[strongest] = true;
+		memcpy(request_fingerprint.bssids[request_fingerprint.bssid_count],
+		       wifi->ap_info[strongest].mac, BSSID_LEN);
+		request_fingerprint.bssid_count++;
+	}
+
+	k_mutex_unlock(&cache_mutex);
+}
+
+static int location_cache_bssid_match_count(
+	const struct location_cache_fingerprint *a,
+	const struct location_cache_fingerprint *b)
+{
+	int count = 0;
+
+	for (int i = 0; i < a->bssid_count; i++) {
+		for (int j = 0; j < b->bssid_count; j++) {
+			if (memcmp(a->bssids[i], b->bssids[j], BSSID_LEN) == 0) {
+				count++;
+				break;
+			}
+		}
+	}
+
+	return count;
+}
+
+static bool location_cache_wifi_match(const struct location_cache_entry *entry)
+{
+	return location_cache_bssid_match_count(&entry->fingerprint, &request_fingerprint) >=
+	       MIN(CONFIG_LOCATION_CACHE_WIFI_MATCH_COUNT, CONFIG_LOCATION_CACHE_WIFI_AP_COUNT);
+}
+
+int location_cache_wifi_get(uint32_t max_age, struct location_data *location)
+{
+	const struct location_cache_entry *entry = NULL;
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	if (request_fingerprint.bssid_count > 0) {
+		entry = location_cache_latest_get(max_age, location_cache_wifi_match);
+	}
+	if (entry != NULL) {
+		LOG_DBG("Wi-Fi access points match, using cached location");
+		location_cache_entry_to_location(
+			entry, CONFIG_LOCATION_CACHE_WIFI_ACCURACY, location);
+	}
+
+	k_mutex_unlock(&cache_mutex);
+
+	return (entry != NULL) ? 0 : -ENOENT;
+}
+#endif /* CONFIG_LOCATION_METHOD_WIFI */
+
+void location_cache_store(enum location_method method, const struct location_data *location)
+{
+	struct location_cache_entry *entry = &cache[0];
+
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(cache); i++) {
+		if (cache[i].timestamp != 0 &&
+		    cache[i].latitude == location->latitude &&
+		    cache[i].longitude == location->longitude) {
+			/* Location taken from the cache. Storing it again would extend its age. */
+			k_mutex_unlock(&cache_mutex);
+			return;
+		}
+
+		/* Replace the oldest entry */
+		if (cache[i].timestamp < entry->timestamp) {
+			entry = &cache[i];
+		}
+	}
+
+	entry->timestamp = k_uptime_get();
+	entry->method = method;
+	entry->latitude = location->latitude;
+	entry->longitude = location->longitude;
+	entry->accuracy = location->accuracy;
+	entry->datetime = location->datetime;
+	entry->fingerprint = request_fingerprint;
+	entry->fingerprint.cell_id = serving_cell_id;
+	entry->fingerprint.tac = serving_tac;
+
+	/* The device has not moved after acquiring this location if it is stationary now */
+	moved = !stationary;
+
+	LOG_DBG("Location stored in cache: cell 0x%08X, %d Wi-Fi access points",
+		entry->fingerprint.cell_id, entry->fingerprint.bssid_count);
+
+	k_mutex_unlock(&cache_mutex);
+}
+
+void location_cache_stationary_set(bool is_stationary)
+{
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	stationary = is_stationary;
+	if (!is_stationary) {
+		moved = true;
+	}
+
+	k_mutex_unlock(&cache_mutex);
+}
+
+void location_cache_clear(void)
+{
+	k_mutex_lock(&cache_mutex, K_FOREVER);
+
+	memset(cache, 0, sizeof(cache));
+	moved = true;
+
+	k_mutex_unlock(&cache_mutex);
+}
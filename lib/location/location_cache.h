@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef LOCATION_CACHE_H
+#define LOCATION_CACHE_H
+
+#include <modem/location.h>
+#if defined(CONFIG_LOCATION_METHOD_WIFI)
+#include <net/wifi_location_common.h>
+#endif
+
+void location_cache_init(void);
+
+/**
+ * @brief Start collecting the fingerprint of a new location request.
+ */
+void location_cache_request_start(void);
+
+/**
+ * @brief Get a cached location without scanning anything.
+ *
+ * @details A cached location is returned if the device has been indicated to be stationary
+ * since the latest location was stored, or, if allowed, if the device is still in the cell
+ * where a cached location was acquired.
+ *
+ * @param[in]  max_age    Maximum age of the cached location in seconds.
+ * @param[in]  cell_match Whether a location matching the serving cell may be returned.
+ * @param[out] location   Cached location.
+ * @param[out] method     Method with which the cached location was acquired.
+ *
+ * @retval 0        A cached location was found.
+ * @retval -ENOENT  No suitable cached location.
+ */
+int location_cache_get(
+	uint32_t max_age,
+	bool cell_match,
+	struct location_data *location,
+	enum location_method *method);
+
+#if defined(CONFIG_LOCATION_METHOD_WIFI)
+/**
+ * @brief Record the strongest access points found by the Wi-Fi scan of the current request.
+ */
+void location_cache_wifi_fingerprint_set(const struct wifi_scan_info *wifi);
+
+/**
+ * @brief Get a cached location acquired with the access points of the current request around.
+ *
+ * @retval 0        A cached location was found.
+ * @retval -ENOENT  No suitable cached location.
+ */
+int location_cache_wifi_get(uint32_t max_age, struct location_data *location);
+#endif
+
+/**
+ * @brief Store a location with the fingerprint of the current request.
+ */
+void location_cache_store(enum location_method method, const struct location_data *location);
+
+#endif /* LOCATION_CACHE_H */
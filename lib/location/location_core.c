@@ -24,6 +24,9 @@
 #if defined(CONFIG_LOCATION_METHOD_CELLULAR) || defined(CONFIG_LOCATION_METHOD_WIFI)
 #include "method_cloud_location.h"
 #endif
+#if defined(CONFIG_LOCATION_CACHE)
+#include "location_cache.h"
+#endif
 
 LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
 
@@ -67,6 +70,30 @@ K_WORK_DEFINE(location_event_cb_work, location_core_event_cb_fn);
 /** Semaphore protecting the use of location requests. */
 K_SEM_DEFINE(location_core_sem, 1, 1);
 
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+K_THREAD_STACK_DEFINE(location_core_cloud_stack, LOCATION_CORE_STACK_SIZE);
+
+/**
+ * Work queue for cloud location methods in LOCATION_REQ_MODE_PARALLEL mode so that
+ * their blocking operations do not hold back GNSS, which runs in location_core_work_q.
+ */
+static struct k_work_q location_core_cloud_work_q;
+
+/** Handler for results of methods running in parallel. */
+static void location_core_parallel_event_work_fn(struct k_work *work);
+
+/** Work item for results of methods running in parallel. */
+K_WORK_DEFINE(location_parallel_event_work, location_core_parallel_event_work_fn);
+#endif
+
+#if defined(CONFIG_LOCATION_CACHE)
+/** Handler for completing a location request with a cached location. */
+static void location_core_cache_hit_work_fn(struct k_work *work);
+
+/** Work item for completing a location request with a cached location. */
+K_WORK_DEFINE(location_cache_hit_work, location_core_cache_hit_work_fn);
+#endif
+
 /***** Location method configurations *****/
 
 #if defined(CONFIG_LOCATION_METHOD_GNSS)
@@ -178,6 +205,19 @@ static const struct location_method_api *location_method_api_get(enum location_m
 	return method_api;
 }
 
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+static int location_core_method_index_get(enum location_method method)
+{
+	for (int i = 0; i < loc_req_info.methods_count; i++) {
+		if (loc_req_info.methods[i] == method) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+#endif
+
 #if defined(CONFIG_LOG)
 
 static const char LOCATION_ACCURACY_LOW_STR[] = "low";
@@ -258,6 +298,10 @@ int location_core_init(void)
 			methods_supported[i]->method_string);
 	}
 
+#if defined(CONFIG_LOCATION_CACHE)
+	location_cache_init();
+#endif
+
 	k_work_queue_start(
 		&location_core_work_q,
 		location_core_stack,
@@ -265,6 +309,60 @@ int location_core_init(void)
 		LOCATION_CORE_PRIORITY,
 		&cfg);
 
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+	struct k_work_queue_config cloud_cfg = {
+		.name = "location_api_cloud_workq",
+	};
+
+	k_work_queue_start(
+		&location_core_cloud_work_q,
+		location_core_cloud_stack,
+		K_THREAD_STACK_SIZEOF(location_core_cloud_stack),
+		LOCATION_CORE_PRIORITY,
+		&cloud_cfg);
+#endif
+
+	return 0;
+}
+
+static int location_core_validate_parallel_params(const struct location_config *config)
+{
+	const struct location_cellular_config *cellular = NULL;
+	const struct location_wifi_config *wifi = NULL;
+	uint32_t methods_used = 0;
+
+	if (!IS_ENABLED(CONFIG_LOCATION_REQ_MODE_PARALLEL)) {
+		LOG_ERR("LOCATION_REQ_MODE_PARALLEL requires CONFIG_LOCATION_REQ_MODE_PARALLEL");
+		return -EINVAL;
+	}
+
+	if (config->parallel_accuracy < 0) {
+		LOG_ERR("Invalid accuracy for parallel location request");
+		return -EINVAL;
+	}
+
+	for (int i = 0; i < config->methods_count; i++) {
+		if (methods_used & BIT(config->methods[i].method)) {
+			LOG_ERR("Location method (%d) given more than once with "
+				"LOCATION_REQ_MODE_PARALLEL", config->methods[i].method);
+			return -EINVAL;
+		}
+		methods_used |= BIT(config->methods[i].method);
+
+		if (config->methods[i].method == LOCATION_METHOD_CELLULAR) {
+			cellular = &config->methods[i].cellular;
+		} else if (config->methods[i].method == LOCATION_METHOD_WIFI) {
+			wifi = &config->methods[i].wifi;
+		}
+	}
+
+	/* Wi-Fi and cellular are always combined into a single cloud request */
+	if (cellular != NULL && wifi != NULL && cellular->service != wifi->service) {
+		LOG_ERR("Wi-Fi and cellular methods must use the same service with "
+			"LOCATION_REQ_MODE_PARALLEL");
+		return -EINVAL;
+	}
+
 	return 0;
 }
 
@@ -292,6 +390,11 @@ int location_core_validate_params(const struct location_config *config)
 			return -EINVAL;
 		}
 	}
+
+	if (config->mode == LOCATION_REQ_MODE_PARALLEL) {
+		return location_core_validate_parallel_params(config);
+	}
+
 	return 0;
 }
 
@@ -307,6 +410,12 @@ void location_core_config_log(const struct location_config *config)
 	LOG_DBG("  Interval: %d", config->interval);
 	LOG_DBG("  Timeout: %dms", config->timeout);
 	LOG_DBG("  Mode: %d", config->mode);
+	if (config->mode == LOCATION_REQ_MODE_PARALLEL) {
+		LOG_DBG("  Parallel accuracy: %dm", (int)config->parallel_accuracy);
+	}
+	if (IS_ENABLED(CONFIG_LOCATION_CACHE)) {
+		LOG_DBG("  Cache max age: %ds", config->cache_max_age);
+	}
 	LOG_DBG("  List of methods:");
 
 	for (uint8_t i = 0; i < config->methods_count; i++) {
@@ -356,15 +465,79 @@ static void location_core_current_config_set(const struct location_config *confi
 	memcpy(&loc_req_info.config, config, sizeof(loc_req_info.config));
 }
 
-static int location_core_location_get_pos(void)
+static void location_core_started_event_dispatch(enum location_method method)
+{
+	if (IS_ENABLED(CONFIG_LOCATION_DATA_DETAILS)) {
+		struct location_event_data request_started = {
+			.id = LOCATION_EVT_STARTED,
+			.method = method
+		};
+
+		location_utils_event_dispatch(&request_started);
+	}
+}
+
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+static void location_core_parallel_cancel(void)
+{
+	enum location_method method;
+
+	for (int i = 0; i < loc_req_info.methods_count; i++) {
+		if (!atomic_test_and_clear_bit(&loc_req_info.parallel_running, i)) {
+			continue;
+		}
+		method = loc_req_info.methods[i];
+
+		LOG_DBG("Cancelling location method for '%s' method",
+			(char *)location_method_api_get(method)->method_string);
+		(void)location_method_api_get(method)->cancel();
+	}
+}
+
+static int location_core_parallel_start(void)
+{
+	enum location_method method;
+	int err;
+
+	atomic_clear(&loc_req_info.parallel_running);
+	atomic_clear(&loc_req_info.parallel_reported);
+	memset(loc_req_info.parallel_events, 0, sizeof(loc_req_info.parallel_events));
+	loc_req_info.parallel_pending = BIT_MASK(loc_req_info.methods_count);
+	loc_req_info.parallel_best_index = -1;
+	loc_req_info.current_method_index = 0;
+	loc_req_info.execute_fallback = false;
+
+	for (int i = 0; i < loc_req_info.methods_count; i++) {
+		method = loc_req_info.methods[i];
+		LOG_DBG("Requesting location with '%s' method in parallel",
+			(char *)location_method_api_get(method)->method_string);
+
+		/* Methods read their configuration based on the current method */
+		location_core_current_event_data_init(method);
+
+		/* Marked as running before starting as the result may come right away */
+		atomic_set_bit(&loc_req_info.parallel_running, i);
+
+		err = location_method_api_get(method)->location_get(&loc_req_info);
+		if (err) {
+			atomic_clear_bit(&loc_req_info.parallel_running, i);
+			location_core_parallel_cancel();
+			return err;
+		}
+
+		location_core_started_event_dispatch(method);
+	}
+
+	return 0;
+}
+#endif
+
+static int location_core_first_method_start(void)
 {
 	int err;
 	enum location_method requested_method;
 
-	location_core_current_config_set(&loc_req_info.config);
 	/* Location request starts from the first method */
-	loc_req_info.timeout_uptime = (loc_req_info.config.timeout != SYS_FOREVER_MS) ?
-		k_uptime_get() + loc_req_info.config.timeout : SYS_FOREVER_MS;
 	loc_req_info.execute_fallback = true;
 	loc_req_info.current_method_index = 0;
 	requested_method = loc_req_info.methods[loc_req_info.current_method_index];
@@ -377,13 +550,79 @@ static int location_core_location_get_pos(void)
 		return err;
 	}
 
-	if (IS_ENABLED(CONFIG_LOCATION_DATA_DETAILS)) {
-		struct location_event_data request_started = {
-			.id = LOCATION_EVT_STARTED,
-			.method = requested_method
-		};
+	location_core_started_event_dispatch(requested_method);
 
-		location_utils_event_dispatch(&request_started);
+	return 0;
+}
+
+#if defined(CONFIG_LOCATION_CACHE)
+/** @return Whether the request is completed with a cached location. */
+static bool location_core_cache_hit(void)
+{
+	struct location_data location;
+	enum location_method method;
+	int err;
+
+	location_cache_request_start();
+
+	if (loc_req_info.config.cache_max_age == 0) {
+		return false;
+	}
+
+	/* The serving cell is as good as a cellular positioning result only if cellular
+	 * positioning is what the application asks for first.
+	 */
+	err = location_cache_get(
+		loc_req_info.config.cache_max_age,
+		loc_req_info.methods[0] == LOCATION_METHOD_CELLULAR,
+		&location,
+		&method);
+	if (err) {
+		return false;
+	}
+
+	LOG_DBG("Using cached location acquired with '%s' method",
+		(char *)location_method_api_get(method)->method_string);
+
+	loc_req_info.current_method_index = 0;
+	loc_req_info.execute_fallback = false;
+	location_core_current_event_data_init(method);
+	loc_req_info.current_event_data.id = LOCATION_EVT_LOCATION;
+	loc_req_info.current_event_data.method = method;
+	loc_req_info.current_event_data.location = location;
+
+	/* Completed in the work queue like any other request to keep the event order */
+	k_work_submit_to_queue(location_core_work_queue_get(), &location_cache_hit_work);
+
+	return true;
+}
+#endif
+
+static int location_core_location_get_pos(void)
+{
+	int err;
+
+	location_core_current_config_set(&loc_req_info.config);
+	loc_req_info.timeout_uptime = (loc_req_info.config.timeout != SYS_FOREVER_MS) ?
+		k_uptime_get() + loc_req_info.config.timeout : SYS_FOREVER_MS;
+
+#if defined(CONFIG_LOCATION_CACHE)
+	if (location_core_cache_hit()) {
+		return 0;
+	}
+#endif
+
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+	if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL) {
+		err = location_core_parallel_start();
+	} else {
+		err = location_core_first_method_start();
+	}
+#else
+	err = location_core_first_method_start();
+#endif
+	if (err != 0) {
+		return err;
 	}
 
 	if (loc_req_info.config.timeout != SYS_FOREVER_MS &&
@@ -440,6 +679,12 @@ static void location_request_info_create(const struct location_config *config)
 			LOG_DBG("Wi-Fi and cellular methods are not one after the other "
 				"in method list so they are not combined");
 		}
+	} else if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL &&
+		   loc_req_info.cellular != NULL && loc_req_info.wifi != NULL) {
+		/* All methods are started at the same time, so their order does not matter.
+		 * Services have been checked to be the same when validating the configuration.
+		 */
+		combine_wifi_cell = true;
 	}
 
 	/* Compose a list of methods that are really used, including combined internal method */
@@ -498,18 +743,90 @@ int location_core_location_get(const struct location_config *config)
 	return location_core_location_get_pos();
 }
 
-void location_core_event_cb_error(void)
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+static void location_core_parallel_event_store(
+	int index,
+	enum location_event_id id,
+	const struct location_data *location)
+{
+	struct location_event_data *event = &loc_req_info.parallel_events[index];
+
+	event->id = id;
+	event->method = loc_req_info.methods[index];
+	if (location != NULL) {
+		event->location = *location;
+	}
+
+	atomic_set_bit(&loc_req_info.parallel_reported, index);
+	k_work_submit_to_queue(location_core_work_queue_get(), &location_parallel_event_work);
+}
+
+static void location_core_parallel_method_timeout(int index)
+{
+	if (index < 0 || !atomic_test_and_clear_bit(&loc_req_info.parallel_running, index)) {
+		return;
+	}
+
+	location_method_api_get(loc_req_info.methods[index])->timeout();
+	location_core_parallel_event_store(index, LOCATION_EVT_TIMEOUT, NULL);
+}
+#endif
+
+/**
+ * Store the result of a method running in LOCATION_REQ_MODE_PARALLEL mode.
+ *
+ * @return true if the location request is in LOCATION_REQ_MODE_PARALLEL mode.
+ */
+static bool location_core_parallel_event_set(
+	enum location_method method,
+	enum location_event_id id,
+	const struct location_data *location)
 {
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+	int index;
+
+	if (loc_req_info.config.mode != LOCATION_REQ_MODE_PARALLEL) {
+		return false;
+	}
+
+	index = location_core_method_index_get(method);
+	if (index < 0 || !atomic_test_and_clear_bit(&loc_req_info.parallel_running, index)) {
+		LOG_DBG("Ignoring event %d from method %d that is not running", id, method);
+		return true;
+	}
+
+	location_core_parallel_event_store(index, id, location);
+
+	return true;
+#else
+	ARG_UNUSED(method);
+	ARG_UNUSED(id);
+	ARG_UNUSED(location);
+
+	return false;
+#endif
+}
+
+void location_core_event_cb_error(enum location_method method)
+{
+	if (location_core_parallel_event_set(method, LOCATION_EVT_ERROR, NULL)) {
+		return;
+	}
+
 	loc_req_info.current_event_data.id = LOCATION_EVT_ERROR;
 
-	location_core_event_cb(NULL);
+	location_core_event_cb(method, NULL);
 }
 
-void location_core_event_cb_timeout(void)
+void location_core_event_cb_timeout(enum location_method method)
 {
+	if (location_core_parallel_event_set(method, LOCATION_EVT_TIMEOUT, NULL)) {
+		return;
+	}
+
 	loc_req_info.current_event_data.id = LOCATION_EVT_TIMEOUT;
 
-	location_core_event_cb(NULL);
+	location_core_event_cb(method, NULL);
 }
 
 #if defined(CONFIG_LOCATION_SERVICE_EXTERNAL) && defined(CONFIG_NRF_CLOUD_AGNSS)
@@ -571,10 +888,24 @@ void location_core_event_cb_cloud_location_request(struct location_data_cloud *r
 	location_utils_event_dispatch(&cloud_location_request_event_data);
 }
 
+/** Get the cloud location method of the request, that is, the method other than GNSS. */
+static enum location_method location_core_cloud_method_get(void)
+{
+	for (int i = 0; i < loc_req_info.methods_count; i++) {
+		if (loc_req_info.methods[i] != LOCATION_METHOD_GNSS) {
+			return loc_req_info.methods[i];
+		}
+	}
+
+	return 0;
+}
+
 void location_core_cloud_location_ext_result_set(
 	enum location_ext_result result,
 	struct location_data *location)
 {
+	enum location_event_id id;
+
 	if (k_sem_count_get(&location_core_sem) > 0) {
 		LOG_WRN("Cloud positioning result set called but no location request pending");
 		return;
@@ -586,18 +917,27 @@ void location_core_cloud_location_ext_result_set(
 
 	switch (result) {
 	case LOCATION_EXT_RESULT_SUCCESS:
-		loc_req_info.current_event_data.id = LOCATION_EVT_LOCATION;
-		loc_req_info.current_event_data.location = *location;
+		id = LOCATION_EVT_LOCATION;
 		break;
 	case LOCATION_EXT_RESULT_UNKNOWN:
-		loc_req_info.current_event_data.id = LOCATION_EVT_RESULT_UNKNOWN;
+		id = LOCATION_EVT_RESULT_UNKNOWN;
 		break;
 	case LOCATION_EXT_RESULT_ERROR:
 	default:
-		loc_req_info.current_event_data.id = LOCATION_EVT_ERROR;
+		id = LOCATION_EVT_ERROR;
 		break;
 	}
 
+	if (location_core_parallel_event_set(location_core_cloud_method_get(), id,
+					     (id == LOCATION_EVT_LOCATION) ? location : NULL)) {
+		return;
+	}
+
+	loc_req_info.current_event_data.id = id;
+	if (id == LOCATION_EVT_LOCATION) {
+		loc_req_info.current_event_data.location = *location;
+	}
+
 	k_work_submit_to_queue(
 		location_core_work_queue_get(),
 		&location_event_cb_work);
@@ -625,6 +965,123 @@ static void location_core_event_details_get(struct location_event_data *event)
 #endif
 }
 
+/** Dispatch the final event of the location request and schedule the next one if periodic. */
+static void location_core_request_complete(void)
+{
+#if defined(CONFIG_LOCATION_CACHE)
+	if (loc_req_info.current_event_data.id == LOCATION_EVT_LOCATION) {
+		location_cache_store(
+			loc_req_info.current_event_data.method,
+			&loc_req_info.current_event_data.location);
+	}
+#endif
+
+	location_utils_event_dispatch(&loc_req_info.current_event_data);
+
+	k_work_cancel_delayable(&location_core_timeout_work);
+
+	if (loc_req_info.config.interval > 0) {
+		k_work_schedule_for_queue(
+			location_core_work_queue_get(),
+			&location_periodic_work,
+			K_SECONDS(loc_req_info.config.interval));
+	} else {
+		location_core_current_config_clear();
+
+		k_sem_give(&location_core_sem);
+	}
+}
+
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+static void location_core_parallel_complete(void)
+{
+	int index = loc_req_info.parallel_best_index;
+
+	/* Cancel the methods that are still running */
+	location_core_parallel_cancel();
+	loc_req_info.parallel_pending = 0;
+	k_work_cancel_delayable(&location_core_method_timeout_work);
+
+	if (index < 0) {
+		/* No location, report the result of the method with the highest priority */
+		index = 0;
+	}
+
+	loc_req_info.current_method_index = index;
+	loc_req_info.current_method = loc_req_info.methods[index];
+	loc_req_info.current_event_data = loc_req_info.parallel_events[index];
+
+	if (loc_req_info.current_event_data.id == LOCATION_EVT_LOCATION) {
+		LOG_INF("LOCATION_REQ_MODE_PARALLEL: completed with location from '%s'",
+			(char *)location_method_api_get(
+				loc_req_info.current_method)->method_string);
+	} else {
+		LOG_ERR("LOCATION_REQ_MODE_PARALLEL: location acquisition failed for all methods");
+	}
+
+	location_core_request_complete();
+}
+
+static void location_core_parallel_event_work_fn(struct k_work *work)
+{
+	const atomic_val_t reported = atomic_clear(&loc_req_info.parallel_reported);
+	const struct location_event_data *best;
+	struct location_event_data *event;
+	bool processed = false;
+
+	ARG_UNUSED(work);
+
+	for (int i = 0; i < loc_req_info.methods_count; i++) {
+		if (!(reported & BIT(i)) || !(loc_req_info.parallel_pending & BIT(i))) {
+			/* No result, or it arrived after the request completed */
+			continue;
+		}
+		loc_req_info.parallel_pending &= ~BIT(i);
+		processed = true;
+
+		event = &loc_req_info.parallel_events[i];
+
+		/* Details are taken from the method that produced the result */
+		loc_req_info.current_method = event->method;
+		location_core_event_details_get(event);
+
+		if (event->id != LOCATION_EVT_LOCATION) {
+			LOG_INF("LOCATION_REQ_MODE_PARALLEL: location retrieval %s using '%s'",
+				event->id != LOCATION_EVT_RESULT_UNKNOWN ? "failed" : "completed",
+				(char *)location_method_api_get(event->method)->method_string);
+			continue;
+		}
+
+		LOG_INF("LOCATION_REQ_MODE_PARALLEL: acquired location using '%s'",
+			(char *)location_method_api_get(event->method)->method_string);
+
+		if (loc_req_info.parallel_best_index < 0 ||
+		    event->location.accuracy <
+		    loc_req_info.parallel_events[loc_req_info.parallel_best_index].location.accuracy) {
+			loc_req_info.parallel_best_index = i;
+		}
+	}
+
+	if (!processed) {
+		return;
+	}
+
+	if (loc_req_info.parallel_best_index >= 0) {
+		best = &loc_req_info.parallel_events[loc_req_info.parallel_best_index];
+
+		if (loc_req_info.config.parallel_accuracy == 0 ||
+		    best->location.accuracy <= loc_req_info.config.parallel_accuracy) {
+			location_core_parallel_complete();
+			return;
+		}
+	}
+
+	if (loc_req_info.parallel_pending == 0) {
+		location_core_parallel_complete();
+	}
+}
+#endif /* CONFIG_LOCATION_REQ_MODE_PARALLEL */
+
 static void location_core_event_cb_fn(struct k_work *work)
 {
 	char latitude_str[12];
@@ -748,24 +1205,16 @@ static void location_core_event_cb_fn(struct k_work *work)
 		}
 	}
 
-	location_utils_event_dispatch(&loc_req_info.current_event_data);
-
-	k_work_cancel_delayable(&location_core_timeout_work);
-
-	if (loc_req_info.config.interval > 0) {
-		k_work_schedule_for_queue(
-			location_core_work_queue_get(),
-			&location_periodic_work,
-			K_SECONDS(loc_req_info.config.interval));
-	} else {
-		location_core_current_config_clear();
-
-		k_sem_give(&location_core_sem);
-	}
+	location_core_request_complete();
 }
 
-void location_core_event_cb(const struct location_data *location)
+void location_core_event_cb(enum location_method method, const struct location_data *location)
 {
+	if (location != NULL &&
+	    location_core_parallel_event_set(method, LOCATION_EVT_LOCATION, location)) {
+		return;
+	}
+
 	if (location) {
 		loc_req_info.current_event_data.id = LOCATION_EVT_LOCATION;
 		loc_req_info.current_event_data.location = *location;
@@ -787,6 +1236,24 @@ struct k_work_q *location_core_work_queue_get(void)
 	return &location_core_work_q;
 }
 
+struct k_work_q *location_core_cloud_work_queue_get(void)
+{
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+	if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL) {
+		return &location_core_cloud_work_q;
+	}
+#endif
+	return &location_core_work_q;
+}
+
+#if defined(CONFIG_LOCATION_CACHE)
+static void location_core_cache_hit_work_fn(struct k_work *work)
+{
+	ARG_UNUSED(work);
+	location_core_request_complete();
+}
+#endif
+
 static void location_core_periodic_work_fn(struct k_work *work)
 {
 	ARG_UNUSED(work);
@@ -802,8 +1269,17 @@ static void location_core_method_timeout_work_fn(struct k_work *work)
 
 	LOG_INF("Method specific timeout expired");
 
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+	if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL) {
+		/* GNSS is the only method using the method specific timer */
+		location_core_parallel_method_timeout(
+			location_core_method_index_get(LOCATION_METHOD_GNSS));
+		return;
+	}
+#endif
+
 	location_method_api_get(current_method)->timeout();
-	location_core_event_cb_timeout();
+	location_core_event_cb_timeout(current_method);
 }
 
 static void location_core_timeout_work_fn(struct k_work *work)
@@ -815,13 +1291,22 @@ static void location_core_timeout_work_fn(struct k_work *work)
 
 	LOG_INF("Timeout for entire location request expired");
 
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+	if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL) {
+		for (int i = 0; i < loc_req_info.methods_count; i++) {
+			location_core_parallel_method_timeout(i);
+		}
+		return;
+	}
+#endif
+
 	location_method_api_get(current_method)->timeout();
 	/* config->timeout needs to expire without fallbacks */
 
 	loc_req_info.current_event_data.id = LOCATION_EVT_TIMEOUT;
 	loc_req_info.execute_fallback = false;
 
-	location_core_event_cb(NULL);
+	location_core_event_cb(current_method, NULL);
 }
 
 void location_core_timer_start(int32_t timeout)
@@ -849,6 +1334,23 @@ int location_core_cancel(void)
 	k_work_cancel_delayable(&location_core_timeout_work);
 	k_work_cancel_delayable(&location_periodic_work);
 	k_work_cancel(&location_event_cb_work);
+#if defined(CONFIG_LOCATION_CACHE)
+	k_work_cancel(&location_cache_hit_work);
+#endif
+
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+	if (loc_req_info.config.mode == LOCATION_REQ_MODE_PARALLEL) {
+		k_work_cancel(&location_parallel_event_work);
+		location_core_parallel_cancel();
+		loc_req_info.parallel_pending = 0;
+
+		location_core_current_config_clear();
+
+		k_sem_give(&location_core_sem);
+
+		return 0;
+	}
+#endif
 
 	/* Check if location has been requested using one of the methods */
 	if (current_method != 0) {
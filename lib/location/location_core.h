@@ -43,6 +43,27 @@ struct location_request_info {
 	 * This is used in cloud location method to calculate timeout for the cloud operation.
 	 */
 	int64_t timeout_uptime;
+
+#if defined(CONFIG_LOCATION_REQ_MODE_PARALLEL)
+	/**
+	 * Methods that have not reported a result in LOCATION_REQ_MODE_PARALLEL mode,
+	 * as bits of their indices. The result of a method is stored only by the one
+	 * clearing its bit.
+	 */
+	atomic_t parallel_running;
+
+	/** Methods with a stored result that has not been processed yet. */
+	atomic_t parallel_reported;
+
+	/** Methods whose result has not been processed yet. Only used in the work queue. */
+	uint32_t parallel_pending;
+
+	/** Results of the methods in LOCATION_REQ_MODE_PARALLEL mode. */
+	struct location_event_data parallel_events[CONFIG_LOCATION_METHODS_LIST_SIZE];
+
+	/** Index of the method with the most accurate location so far, or -1 if none. */
+	int parallel_best_index;
+#endif
 };
 
 struct location_method_api {
@@ -63,9 +84,9 @@ int location_core_validate_params(const struct location_config *config);
 int location_core_location_get(const struct location_config *config);
 int location_core_cancel(void);
 
-void location_core_event_cb(const struct location_data *location);
-void location_core_event_cb_error(void);
-void location_core_event_cb_timeout(void);
+void location_core_event_cb(enum location_method method, const struct location_data *location);
+void location_core_event_cb_error(enum location_method method);
+void location_core_event_cb_timeout(enum location_method method);
 #if defined(CONFIG_LOCATION_SERVICE_EXTERNAL) && defined(CONFIG_NRF_CLOUD_AGNSS)
 void location_core_event_cb_agnss_request(const struct nrf_modem_gnss_agnss_data_frame *request);
 #endif
@@ -83,5 +104,6 @@ void location_core_cloud_location_ext_result_set(
 void location_core_config_log(const struct location_config *config);
 void location_core_timer_start(int32_t timeout);
 struct k_work_q *location_core_work_queue_get(void);
+struct k_work_q *location_core_cloud_work_queue_get(void);
 
 #endif /* LOCATION_CORE_H */
@@ -16,6 +16,9 @@
 #include "scan_cellular.h"
 #include "scan_wifi.h"
 #include "cloud_service/cloud_service.h"
+#if defined(CONFIG_LOCATION_CACHE)
+#include "location_cache.h"
+#endif
 
 LOG_MODULE_DECLARE(location, CONFIG_LOCATION_LOG_LEVEL);
 
@@ -28,9 +31,11 @@ BUILD_ASSERT(
 /* Common for both */
 struct method_cloud_location_start_work_args {
 	struct k_work work_item;
+	enum location_method method;
 	const struct location_wifi_config *wifi_config;
 	const struct location_cellular_config *cell_config;
 	int64_t locreq_timeout_uptime;
+	uint32_t cache_max_age;
 };
 
 static struct method_cloud_location_start_work_args method_cloud_location_start_work;
@@ -82,6 +87,21 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 		goto end;
 	}
 
+#if defined(CONFIG_LOCATION_CACHE) && defined(CONFIG_LOCATION_METHOD_WIFI)
+	if (scan_wifi_info != NULL) {
+		struct location_data cached_location;
+
+		location_cache_wifi_fingerprint_set(scan_wifi_info);
+
+		if (work_data->cache_max_age > 0 &&
+		    location_cache_wifi_get(work_data->cache_max_age, &cached_location) == 0) {
+			/* Same access points around, no need to ask the cloud */
+			location_core_event_cb(work_data->method, &cached_location);
+			goto end;
+		}
+	}
+#endif
+
 #if defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
 	ARG_UNUSED(wifi_config);
 
@@ -132,22 +152,26 @@ static void method_cloud_location_positioning_work_fn(struct k_work *work)
 
 	/* Request location from the cloud */
 	err = cloud_service_location_get(&params, &location);
+	if (!running) {
+		/* Cancelled during the cloud request, e.g. when another method got a location */
+		return;
+	}
 	if (err) {
 		LOG_ERR("Failed to acquire location using cloud location, error: %d", err);
 	} else {
 		location_result.latitude = location.latitude;
 		location_result.longitude = location.longitude;
 		location_result.accuracy = location.accuracy;
-		location_core_event_cb(&location_result);
+		location_core_event_cb(work_data->method, &location_result);
 	}
 
 #endif /* defined(CONFIG_LOCATION_SERVICE_EXTERNAL) */
 
 end:
 	if (err == -ETIMEDOUT) {
-		location_core_event_cb_timeout();
+		location_core_event_cb_timeout(work_data->method);
 	} else if (err) {
-		location_core_event_cb_error();
+		location_core_event_cb_error(work_data->method);
 	}
 	running = false;
 }
@@ -179,6 +203,7 @@ int method_cloud_location_get(const struct location_request_info *request)
 		method_cloud_location_positioning_work_fn);
 
 	/* Select configurations based on requested method */
+	method_cloud_location_start_work.method = request->current_method;
 	method_cloud_location_start_work.wifi_config = NULL;
 	method_cloud_location_start_work.cell_config = NULL;
 	if (request->current_method == LOCATION_METHOD_CELLULAR ||
@@ -191,12 +216,15 @@ int method_cloud_location_get(const struct location_request_info *request)
 	}
 
 	method_cloud_location_start_work.locreq_timeout_uptime = request->timeout_uptime;
-	k_work_submit_to_queue(
-		location_core_work_queue_get(),
-		&method_cloud_location_start_work.work_item);
+	method_cloud_location_start_work.cache_max_age = request->config.cache_max_age;
 
+	/* Set before submitting because the work may run in another work queue right away */
 	running = true;
 
+	k_work_submit_to_queue(
+		location_core_cloud_work_queue_get(),
+		&method_cloud_location_start_work.work_item);
+
 	return 0;
 }
 
@@ -993,7 +993,7 @@ static void method_gnss_pvt_work_fn(struct k_work *item)
 
 	if (nrf_modem_gnss_read(&pvt_data, sizeof(pvt_data), NRF_MODEM_GNSS_DATA_PVT) != 0) {
 		LOG_ERR("Failed to read PVT data from GNSS");
-		location_core_event_cb_error();
+		location_core_event_cb_error(LOCATION_METHOD_GNSS);
 		return;
 	}
 
@@ -1026,7 +1026,7 @@ static void method_gnss_pvt_work_fn(struct k_work *item)
 		if (fixes_remaining <= 0) {
 			/* We are done, stop GNSS and publish the fix. */
 			method_gnss_cancel();
-			location_core_event_cb(&location_result);
+			location_core_event_cb(LOCATION_METHOD_GNSS, &location_result);
 #if defined(CONFIG_LOCATION_SERVICE_NRF_CLOUD_GNSS_POS_SEND)
 			method_gnss_nrf_cloud_pos_send(&pvt_data);
 #endif
@@ -1037,7 +1037,7 @@ static void method_gnss_pvt_work_fn(struct k_work *item)
 		if (method_gnss_tracked_satellites(&pvt_data) < VISIBILITY_DETECTION_SAT_LIMIT) {
 			LOG_DBG("GNSS visibility obstructed, canceling");
 			method_gnss_cancel();
-			location_core_event_cb_error();
+			location_core_event_cb_error(LOCATION_METHOD_GNSS);
 		}
 
 		visibility_detection_done = true;
@@ -1338,7 +1338,7 @@ static void method_gnss_start_work_fn(struct k_work *work)
 
 	if (err) {
 		LOG_ERR("Failed to configure GNSS");
-		location_core_event_cb_error();
+		location_core_event_cb_error(LOCATION_METHOD_GNSS);
 		running = false;
 		return;
 	}
@@ -1351,7 +1351,7 @@ static void method_gnss_start_work_fn(struct k_work *work)
 		 */
 		if (running) {
 			LOG_WRN("GNSS not allowed to start");
-			location_core_event_cb_error();
+			location_core_event_cb_error(LOCATION_METHOD_GNSS);
 			running = false;
 		}
 		return;
@@ -1360,7 +1360,7 @@ static void method_gnss_start_work_fn(struct k_work *work)
 	err = nrf_modem_gnss_start();
 	if (err) {
 		LOG_ERR("Failed to start GNSS, error: %d", err);
-		location_core_event_cb_error();
+		location_core_event_cb_error(LOCATION_METHOD_GNSS);
 		running = false;
 		return;
 	}
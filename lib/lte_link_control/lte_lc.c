@@ -86,8 +86,20 @@ static const char cscon[] = "AT+CSCON=1";
 
 /* Requested NCELLMEAS params */
 static struct lte_lc_ncellmeas_params ncellmeas_params;
-/* Sempahore value 1 means ncellmeas is not ongoing, and 0 means it's ongoing. */
+/* Sempahore value 1 means ncellmeas is not ongoing, and 0 means it's ongoing.
+ * The measurement is ongoing until its results have been delivered to the event handlers
+ * because the event refers to the cell buffers below.
+ */
 K_SEM_DEFINE(ncellmeas_idle_sem, 1, 1);
+/* Set when the cell buffers below are in use by an NCELLMEAS notification. The semaphore is
+ * then given once the results have been delivered, so cancelling must not give it.
+ */
+static bool ncellmeas_evt_pending;
+static struct k_spinlock ncellmeas_lock;
+/* Neighbor cells parsed from the latest NCELLMEAS notification */
+static struct lte_lc_ncell ncellmeas_neighbor_cells[CONFIG_LTE_NEIGHBOR_CELLS_MAX];
+/* GCI cells parsed from the latest NCELLMEAS notification */
+static struct lte_lc_cell ncellmeas_gci_cells[AT_NCELLMEAS_GCI_COUNT_MAX];
 /* Network attach semaphore */
 static K_SEM_DEFINE(link, 0, 1);
 
@@ -454,26 +466,20 @@ static void at_handler_xt3412(const char *response)
 	event_handler_list_dispatch(&evt);
 }
 
-static void at_handler_ncellmeas_gci(const char *response)
+/* @return Whether the measurement results were handed over for delivery. */
+static bool at_handler_ncellmeas_gci(const char *response)
 {
 	int err;
 	struct lte_lc_evt evt = {0};
-	const char *resp = response;
-	struct lte_lc_cell *cells = NULL;
 
 	__ASSERT_NO_MSG(response != NULL);
 	__ASSERT_NO_MSG(ncellmeas_params.gci_count != 0);
 
 	LOG_DBG("%%NCELLMEAS GCI notification parsing starts");
 
-	cells = k_calloc(ncellmeas_params.gci_count, sizeof(struct lte_lc_cell));
-	if (cells == NULL) {
-		LOG_ERR("Failed to allocate memory for the GCI cells");
-		return;
-	}
-
-	evt.cells_info.gci_cells = cells;
-	err = parse_ncellmeas_gci(&ncellmeas_params, resp, &evt.cells_info);
+	evt.cells_info.gci_cells = ncellmeas_gci_cells;
+	evt.cells_info.neighbor_cells = ncellmeas_neighbor_cells;
+	err = parse_ncellmeas_gci(&ncellmeas_params, response, &evt.cells_info);
 	LOG_DBG("parse_ncellmeas_gci returned %d", err);
 	switch (err) {
 	case -E2BIG:
@@ -487,15 +493,12 @@ static void at_handler_ncellmeas_gci(const char *response)
 			evt.cells_info.ncells_count,
 			evt.cells_info.gci_cells_count);
 		evt.type = LTE_LC_EVT_NEIGHBOR_CELL_MEAS;
-		event_handler_list_dispatch(&evt);
-		break;
+		event_handler_list_dispatch_with_sem(&evt, &ncellmeas_idle_sem);
+		return true;
 	default:
 		LOG_ERR("Parsing of neighbor cells failed, err: %d", err);
-		break;
+		return false;
 	}
-
-	k_free(cells);
-	k_free(evt.cells_info.neighbor_cells);
 }
 
 static void at_handler_ncellmeas(const char *response)
@@ -505,6 +508,10 @@ static void at_handler_ncellmeas(const char *response)
 
 	__ASSERT_NO_MSG(response != NULL);
 
+	K_SPINLOCK(&ncellmeas_lock) {
+		ncellmeas_evt_pending = true;
+	}
+
 	if (event_handler_list_is_empty()) {
 		/* No need to parse the response if there is no handler
 		 * to receive the parsed data.
@@ -513,27 +520,19 @@ static void at_handler_ncellmeas(const char *response)
 	}
 
 	if (ncellmeas_params.search_type > LTE_LC_NEIGHBOR_SEARCH_TYPE_EXTENDED_COMPLETE) {
-		at_handler_ncellmeas_gci(response);
-		goto exit;
-	}
-
-	int ncell_count = neighborcell_count_get(response);
-	struct lte_lc_ncell *neighbor_cells = NULL;
-
-	LOG_DBG("%%NCELLMEAS notification: neighbor cell count: %d", ncell_count);
-
-	if (ncell_count != 0) {
-		neighbor_cells = k_calloc(ncell_count, sizeof(struct lte_lc_ncell));
-		if (neighbor_cells == NULL) {
-			LOG_ERR("Failed to allocate memory for neighbor cells");
-			goto exit;
+		if (at_handler_ncellmeas_gci(response)) {
+			return;
 		}
+		goto exit;
 	}
 
-	evt.cells_info.neighbor_cells = neighbor_cells;
+	evt.cells_info.neighbor_cells = ncellmeas_neighbor_cells;
 
 	err = parse_ncellmeas(response, &evt.cells_info);
 
+	LOG_DBG("%%NCELLMEAS notification: neighbor cell count: %d",
+		evt.cells_info.ncells_count);
+
 	switch (err) {
 	case -E2BIG:
 		LOG_WRN("Not all neighbor cells could be parsed");
@@ -543,17 +542,18 @@ static void at_handler_ncellmeas(const char *response)
 	case 0: /* Fall through */
 	case 1:
 		evt.type = LTE_LC_EVT_NEIGHBOR_CELL_MEAS;
-		event_handler_list_dispatch(&evt);
-		break;
+		/* The semaphore is given once the event has been delivered */
+		event_handler_list_dispatch_with_sem(&evt, &ncellmeas_idle_sem);
+		return;
 	default:
 		LOG_ERR("Parsing of neighbor cells failed, err: %d", err);
 		break;
 	}
 
-	if (neighbor_cells) {
-		k_free(neighbor_cells);
-	}
 exit:
+	K_SPINLOCK(&ncellmeas_lock) {
+		ncellmeas_evt_pending = false;
+	}
 	k_sem_give(&ncellmeas_idle_sem);
 }
 
@@ -1448,7 +1448,7 @@ int lte_lc_neighbor_cell_measurement(struct lte_lc_ncellmeas_params *params)
 	    (params->search_type == LTE_LC_NEIGHBOR_SEARCH_TYPE_GCI_DEFAULT ||
 	     params->search_type == LTE_LC_NEIGHBOR_SEARCH_TYPE_GCI_EXTENDED_LIGHT ||
 	     params->search_type == LTE_LC_NEIGHBOR_SEARCH_TYPE_GCI_EXTENDED_COMPLETE)) {
-		if (params->gci_count < 2 || params->gci_count > 15) {
+		if (params->gci_count < 2 || params->gci_count > AT_NCELLMEAS_GCI_COUNT_MAX) {
 			LOG_ERR("Invalid GCI count, must be in range 2-15");
 			return -EINVAL;
 		}
@@ -1459,6 +1459,10 @@ int lte_lc_neighbor_cell_measurement(struct lte_lc_ncellmeas_params *params)
 		return -EINPROGRESS;
 	}
 
+	K_SPINLOCK(&ncellmeas_lock) {
+		ncellmeas_evt_pending = false;
+	}
+
 	if (params != NULL) {
 		used_params = *params;
 	}
@@ -1505,7 +1509,14 @@ int lte_lc_neighbor_cell_measurement_cancel(void)
 		err = -EFAULT;
 	}
 
-	k_sem_give(&ncellmeas_idle_sem);
+	/* Results that are waiting for delivery refer to the cell buffers. The semaphore is
+	 * given once they have been delivered.
+	 */
+	K_SPINLOCK(&ncellmeas_lock) {
+		if (!ncellmeas_evt_pending) {
+			k_sem_give(&ncellmeas_idle_sem);
+		}
+	}
 
 	return err;
 }
@@ -107,15 +107,10 @@ int event_handler_list_remove_handler(lte_lc_evt_handler_t handler)
 	return 0;
 }
 
-/**@brief dispatch events. */
-void event_handler_list_dispatch(const struct lte_lc_evt *const evt)
+static void event_handler_list_call(const struct lte_lc_evt *const evt)
 {
 	struct event_handler *curr, *tmp;
 
-	if (event_handler_list_is_empty()) {
-		return;
-	}
-
 	k_mutex_lock(&list_mtx, K_FOREVER);
 
 	/* Dispatch events to all registered handlers */
@@ -129,6 +124,91 @@ void event_handler_list_dispatch(const struct lte_lc_evt *const evt)
 	k_mutex_unlock(&list_mtx);
 }
 
+#if defined(CONFIG_LTE_LC_EVENT_QUEUE)
+/**@brief Element of the event queue. */
+struct queued_event {
+	struct lte_lc_evt evt;
+	/* Given after the event has been delivered. */
+	struct k_sem *done_sem;
+};
+
+K_MSGQ_DEFINE(event_queue, sizeof(struct queued_event), CONFIG_LTE_LC_EVENT_QUEUE_SIZE, 4);
+
+K_THREAD_STACK_DEFINE(event_work_q_stack, CONFIG_LTE_LC_EVENT_QUEUE_STACK_SIZE);
+
+static struct k_work_q event_work_q;
+
+static void event_queue_work_fn(struct k_work *work_item)
+{
+	struct queued_event item;
+
+	while (k_msgq_get(&event_queue, &item, K_NO_WAIT) == 0) {
+		event_handler_list_call(&item.evt);
+
+		if (item.done_sem != NULL) {
+			k_sem_give(item.done_sem);
+		}
+	}
+}
+
+static K_WORK_DEFINE(event_queue_work, event_queue_work_fn);
+
+static int event_queue_init(void)
+{
+	struct k_work_queue_config cfg = {
+		.name = "lte_lc_evt_work_q",
+	};
+
+	k_work_queue_start(
+		&event_work_q,
+		event_work_q_stack,
+		K_THREAD_STACK_SIZEOF(event_work_q_stack),
+		CONFIG_LTE_LC_EVENT_QUEUE_THREAD_PRIORITY,
+		&cfg);
+
+	return 0;
+}
+
+SYS_INIT(event_queue_init, APPLICATION, 0);
+#endif /* CONFIG_LTE_LC_EVENT_QUEUE */
+
+void event_handler_list_dispatch_with_sem(
+	const struct lte_lc_evt *const evt,
+	struct k_sem *done_sem)
+{
+	if (event_handler_list_is_empty()) {
+		goto done;
+	}
+
+#if defined(CONFIG_LTE_LC_EVENT_QUEUE)
+	struct queued_event item = {
+		.evt = *evt,
+		.done_sem = done_sem,
+	};
+
+	if (k_msgq_put(&event_queue, &item, K_NO_WAIT) != 0) {
+		LOG_WRN("Event queue full, dropping event: type=%d", evt->type);
+		goto done;
+	}
+
+	k_work_submit_to_queue(&event_work_q, &event_queue_work);
+	return;
+#else
+	event_handler_list_call(evt);
+#endif
+
+done:
+	if (done_sem != NULL) {
+		k_sem_give(done_sem);
+	}
+}
+
+/**@brief dispatch events. */
+void event_handler_list_dispatch(const struct lte_lc_evt *const evt)
+{
+	event_handler_list_dispatch_with_sem(evt, NULL);
+}
+
 
 /* Converts integer on string format to integer type.
  * Returns zero on success, otherwise negative error on failure.
@@ -859,7 +939,6 @@ int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *cells)
 {
 	int err, status, tmp;
 	struct at_parser parser;
-	size_t count = 0;
 	bool incomplete = false;
 
 	__ASSERT_NO_MSG(at_response != NULL);
@@ -967,29 +1046,6 @@ int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *cells)
 	size_t ta_meas_time_index = AT_NCELLMEAS_PRE_NCELLS_PARAMS_COUNT +
 			cells->ncells_count * AT_NCELLMEAS_N_PARAMS_COUNT;
 
-	err = at_parser_cmd_count_get(&parser, &count);
-	if (err) {
-		LOG_ERR("Could not get NCELLMEAS param count, "
-			"potentially malformed notification, error: %d", err);
-		goto clean_exit;
-	}
-
-	if (count > ta_meas_time_index) {
-		err = at_parser_num_get(&parser, ta_meas_time_index,
-					&cells->current_cell.timing_advance_meas_time);
-		if (err) {
-			goto clean_exit;
-		}
-	} else {
-		cells->current_cell.timing_advance_meas_time = 0;
-	}
-
-	if (cells->ncells_count == 0) {
-		goto clean_exit;
-	}
-
-	__ASSERT_NO_MSG(cells->neighbor_cells != NULL);
-
 	if (cells->ncells_count > CONFIG_LTE_NEIGHBOR_CELLS_MAX) {
 		cells->ncells_count = CONFIG_LTE_NEIGHBOR_CELLS_MAX;
 		incomplete = true;
@@ -998,7 +1054,11 @@ int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *cells)
 			CONFIG_LTE_NEIGHBOR_CELLS_MAX);
 	}
 
-	/* Neighboring cells */
+	__ASSERT_NO_MSG(cells->ncells_count == 0 || cells->neighbor_cells != NULL);
+
+	/* Neighboring cells. The parameters are read in the order in which they appear in
+	 * the notification so that the parser never has to rewind.
+	 */
 	for (size_t i = 0; i < cells->ncells_count; i++) {
 		size_t start_idx = AT_NCELLMEAS_PRE_NCELLS_PARAMS_COUNT +
 				   i * AT_NCELLMEAS_N_PARAMS_COUNT;
@@ -1048,6 +1108,20 @@ int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *cells)
 		}
 	}
 
+	/* Timing advance measurement time. The parser returns -EIO or -EAGAIN
+	 * when the notification ends before the parameter.
+	 */
+	err = at_parser_num_get(&parser, ta_meas_time_index,
+				&cells->current_cell.timing_advance_meas_time);
+	if (err == -EIO || err == -EAGAIN) {
+		cells->current_cell.timing_advance_meas_time = 0;
+		err = 0;
+	} else if (err) {
+		LOG_ERR("Could not parse NCELLMEAS timing advance measurement time, "
+			"potentially malformed notification, error: %d", err);
+		goto clean_exit;
+	}
+
 	if (incomplete) {
 		err = -E2BIG;
 		LOG_WRN("Buffer is too small; results incomplete: %d", err);
@@ -1063,16 +1137,13 @@ int parse_ncellmeas_gci(
 	struct lte_lc_cells_info *cells)
 {
 	struct at_parser parser;
-	struct lte_lc_ncell *ncells = NULL;
 	int err, status, tmp_int;
 	int16_t tmp_short;
 	bool incomplete = false;
 	int curr_index;
 	size_t i = 0, j = 0, k = 0;
 
-	/* Count the actual number of parameters in the AT response before
-	 * allocating heap for it. This may save quite a bit of heap as the
-	 * worst case scenario is 96 elements.
+	/* Count the actual number of parameters in the AT response to know when to stop.
 	 * 3 is added to account for the parameters that do not have a trailing
 	 * comma.
 	 */
@@ -1256,7 +1327,8 @@ int parse_ncellmeas_gci(
 			 */
 			cells->current_cell = parsed_cell;
 			if (parsed_ncells_count != 0) {
-				/* Allocate room for the parsed neighbor info. */
+				__ASSERT_NO_MSG(cells->neighbor_cells != NULL);
+
 				if (parsed_ncells_count > CONFIG_LTE_NEIGHBOR_CELLS_MAX) {
 					to_be_parsed_ncell_count = CONFIG_LTE_NEIGHBOR_CELLS_MAX;
 					incomplete = true;
@@ -1267,15 +1339,6 @@ int parse_ncellmeas_gci(
 				} else {
 					to_be_parsed_ncell_count = parsed_ncells_count;
 				}
-				ncells = k_calloc(
-						to_be_parsed_ncell_count,
-						sizeof(struct lte_lc_ncell));
-				if (ncells == NULL) {
-					LOG_WRN("Failed to allocate memory for the ncells"
-						" (continue)");
-					continue;
-				}
-				cells->neighbor_cells = ncells;
 				cells->ncells_count = to_be_parsed_ncell_count;
 			}
 
@@ -83,6 +83,8 @@
 	 AT_NCELLMEAS_N_PARAMS_COUNT * CONFIG_LTE_NEIGHBOR_CELLS_MAX)
 
 #define AT_NCELLMEAS_GCI_CELL_PARAMS_COUNT	12
+/* Maximum number of GCI cells that can be requested */
+#define AT_NCELLMEAS_GCI_COUNT_MAX		15
 
 /* XMODEMSLEEP command parameters. */
 #define AT_XMODEMSLEEP_SUB			"AT%%XMODEMSLEEP=1,%d,%d"
@@ -331,6 +333,19 @@ int event_handler_list_remove_handler(lte_lc_evt_handler_t handler);
  */
 void event_handler_list_dispatch(const struct lte_lc_evt *const evt);
 
+/* @brief Dispatch events for the registered event handlers and signal when done.
+ *
+ * With CONFIG_LTE_LC_EVENT_QUEUE, the event is delivered later from the event queue,
+ * so data that the event points to must stay valid until @p done_sem is given.
+ * The semaphore is also given if the event is not delivered at all.
+ *
+ *  @param evt Event.
+ *  @param done_sem Semaphore given after the event has been delivered, or NULL.
+ */
+void event_handler_list_dispatch_with_sem(
+	const struct lte_lc_evt *const evt,
+	struct k_sem *done_sem);
+
 /* @brief Test if the handler list is empty.
  *
  * @return a boolean, true if it's empty, false otherwise
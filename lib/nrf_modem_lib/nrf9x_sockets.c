@@ -53,6 +53,13 @@ static struct nrf_sock_ctx {
 	struct k_poll_signal poll; /* poll() signal. */
 } offload_ctx[NRF_MODEM_MAX_SOCKET_COUNT];
 
+/* Lookup table from nRF socket descriptor to its offloading context.
+ * The Modem library hands out small descriptors, so in practice all of them
+ * are mapped here, and out-of-range descriptors fall back to a linear search.
+ */
+#define FD_MAP_SIZE (2 * NRF_MODEM_MAX_SOCKET_COUNT)
+static struct nrf_sock_ctx *fd_map[FD_MAP_SIZE];
+
 static K_MUTEX_DEFINE(ctx_lock);
 
 static const struct socket_op_vtable nrf9x_socket_fd_op_vtable;
@@ -72,6 +79,9 @@ static struct nrf_sock_ctx *allocate_ctx(int nrf_fd)
 		if (offload_ctx[i].nrf_fd == -1) {
 			ctx = &offload_ctx[i];
 			ctx->nrf_fd = nrf_fd;
+			if (nrf_fd >= 0 && nrf_fd < FD_MAP_SIZE) {
+				fd_map[nrf_fd] = ctx;
+			}
 			break;
 		}
 	}
@@ -85,6 +95,10 @@ static void release_ctx(struct nrf_sock_ctx *ctx)
 {
 	k_mutex_lock(&ctx_lock, K_FOREVER);
 
+	if (ctx->nrf_fd >= 0 && ctx->nrf_fd < FD_MAP_SIZE) {
+		fd_map[ctx->nrf_fd] = NULL;
+	}
+
 	ctx->nrf_fd = -1;
 	ctx->lock = NULL;
 
@@ -661,78 +675,100 @@ static ssize_t nrf9x_socket_offload_sendto(void *obj, const void *buf,
 	return retval;
 }
 
+static ssize_t sendmsg_buf_send(void *obj, const uint8_t *buf, size_t len, int flags,
+				const struct msghdr *msg)
+{
+	size_t offset = 0;
+	ssize_t ret;
+
+	while (offset < len) {
+		ret = nrf9x_socket_offload_sendto(obj, buf + offset, len - offset, flags,
+						  msg->msg_name, msg->msg_namelen);
+		if (ret < 0) {
+			return ret;
+		}
+		offset += ret;
+	}
+
+	return offset;
+}
+
+static void sendmsg_gather(uint8_t *buf, const struct msghdr *msg)
+{
+	size_t len = 0;
+
+	for (int i = 0; i < msg->msg_iovlen; i++) {
+		memcpy(buf + len, msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len);
+		len += msg->msg_iov[i].iov_len;
+	}
+}
+
 static ssize_t nrf9x_socket_offload_sendmsg(void *obj, const struct msghdr *msg,
 					    int flags)
 {
-	ssize_t len = 0;
+	size_t len = 0;
 	ssize_t ret;
-	ssize_t offset;
-	int i;
-	static K_MUTEX_DEFINE(sendmsg_lock);
-	static uint8_t buf[CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE];
+	int iov_cnt = 0;
+	int iov_idx = 0;
+	uint8_t *heap_buf;
 
 	if (msg == NULL) {
 		errno = EINVAL;
 		return -1;
 	}
 
-	/* Try to reduce number of `sendto` calls - copy data if they fit into
-	 * a single buffer
-	 */
+	for (int i = 0; i < msg->msg_iovlen; i++) {
+		if (msg->msg_iov[i].iov_len > 0) {
+			len += msg->msg_iov[i].iov_len;
+			iov_idx = i;
+			iov_cnt++;
+		}
+	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		len += msg->msg_iov[i].iov_len;
+	/* A single data part is passed to the Modem library as is, which copies it into
+	 * the shared memory in one go.
+	 */
+	if (iov_cnt <= 1) {
+		return sendmsg_buf_send(obj, iov_cnt ? msg->msg_iov[iov_idx].iov_base : NULL,
+					len, flags, msg);
 	}
 
-	if (len <= sizeof(buf)) {
-		/* Protect `buf` access with a mutex. */
-		k_mutex_lock(&sendmsg_lock, K_FOREVER);
-		len = 0;
+	/* Otherwise, gather the data parts so that the whole message is sent with
+	 * a single request to the modem. This keeps datagrams and DTLS records intact.
+	 * Small messages are gathered on the stack, so that concurrent senders
+	 * do not need to be serialized.
+	 */
+	if (len <= CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE) {
+		uint8_t buf[CONFIG_NRF_MODEM_LIB_SENDMSG_BUF_SIZE];
 
-		for (i = 0; i < msg->msg_iovlen; i++) {
-			memcpy(buf + len, msg->msg_iov[i].iov_base,
-			       msg->msg_iov[i].iov_len);
-			len += msg->msg_iov[i].iov_len;
-		}
+		sendmsg_gather(buf, msg);
 
-		offset = 0;
-		ret = 0;
-		while ((offset < len) && (ret >= 0)) {
-			ret = nrf9x_socket_offload_sendto(obj,
-				(buf + offset), (len - offset), flags,
-				msg->msg_name, msg->msg_namelen);
-			if (ret > 0) {
-				offset += ret;
-			}
-		}
+		return sendmsg_buf_send(obj, buf, len, flags, msg);
+	}
+
+	heap_buf = k_malloc(len);
+	if (heap_buf) {
+		sendmsg_gather(heap_buf, msg);
+		ret = sendmsg_buf_send(obj, heap_buf, len, flags, msg);
+		k_free(heap_buf);
 
-		k_mutex_unlock(&sendmsg_lock);
 		return ret;
 	}
 
-	/* If the data won't fit into intermediate buffer, send the buffers
-	 * separately
-	 */
-
+	/* Out of memory, send the data parts separately. */
 	len = 0;
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
+	for (int i = 0; i < msg->msg_iovlen; i++) {
 		if (msg->msg_iov[i].iov_len == 0) {
 			continue;
 		}
 
-		offset = 0;
-		while (offset < msg->msg_iov[i].iov_len) {
-			ret = nrf9x_socket_offload_sendto(obj,
-				(((uint8_t *) msg->msg_iov[i].iov_base) + offset),
-				(msg->msg_iov[i].iov_len - offset), flags,
-				msg->msg_name, msg->msg_namelen);
-			if (ret < 0) {
-				return ret;
-			}
-			offset += ret;
-			len += ret;
+		ret = sendmsg_buf_send(obj, msg->msg_iov[i].iov_base, msg->msg_iov[i].iov_len,
+				       flags, msg);
+		if (ret < 0) {
+			return ret;
 		}
+		len += ret;
 	}
 
 	return len;
@@ -858,6 +894,10 @@ static int nrf9x_socket_offload_fcntl(int fd, int cmd, va_list args)
 
 static struct nrf_sock_ctx *find_ctx(int fd)
 {
+	if (fd >= 0 && fd < FD_MAP_SIZE) {
+		return fd_map[fd];
+	}
+
 	for (size_t i = 0; i < ARRAY_SIZE(offload_ctx); i++) {
 		if (offload_ctx[i].nrf_fd == fd) {
 			return &offload_ctx[i];
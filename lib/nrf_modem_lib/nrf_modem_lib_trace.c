@@ -119,6 +119,15 @@ uint32_t nrf_modem_lib_trace_backend_bitrate_get(void)
 	return backend_bps_avg;
 }
 
+uint32_t nrf_modem_lib_trace_backend_compression_ratio_get(void)
+{
+	if (!trace_backend.compression_ratio) {
+		return 100;
+	}
+
+	return trace_backend.compression_ratio();
+}
+
 static void trace_backend_bitrate_perf_start(void)
 {
 	backend_measurement_start = k_uptime_ticks();
@@ -160,6 +169,13 @@ static void backend_bps_log(struct k_work *item)
 {
 	LOG_INF("Trace backend bitrate (bps): %u", backend_bps_avg);
 
+	if (trace_backend.compression_ratio) {
+		const uint32_t ratio = trace_backend.compression_ratio();
+
+		LOG_INF("Trace backend compression ratio: %u.%02u, stored bitrate (bps): %u",
+			ratio / 100, ratio % 100, backend_bps_avg * 100 / MAX(ratio, 1));
+	}
+
 	k_work_schedule(&backend_bps_log_work, BACKEND_BPS_LOG_PERIOD);
 }
 #endif
@@ -13,10 +13,12 @@
 #include <nrf_errno.h>
 #include <errno.h>
 #include <pm_config.h>
+#include <modem/nrf_modem_lib.h>
 #include <zephyr/logging/log.h>
 
 #define UNUSED_FLAGS 0
-#define THREAD_MONITOR_ENTRIES 10
+#define THREAD_MONITOR_ENTRIES 16
+#define WAITER_BUCKETS 16
 
 LOG_MODULE_REGISTER(nrf_modem, CONFIG_NRF_MODEM_LIB_LOG_LEVEL);
 
@@ -42,42 +44,54 @@ static struct thread_monitor_entry {
 	int cnt; /* Last RPC event count. */
 } thread_event_monitor[THREAD_MONITOR_ENTRIES];
 
-/* A list of threads that are sleeping and should be woken up on next event. */
-static sys_slist_t sleeping_threads;
+/* Lists of threads that are sleeping, hashed by the context they wait for.
+ * Threads waiting with context 0 are woken up on every event and are kept
+ * on a separate list.
+ */
+static sys_slist_t sleeping_threads[WAITER_BUCKETS];
+static sys_slist_t sleeping_threads_any;
 
 /* RPC event counter, incremented on each RPC event. */
 static atomic_t rpc_event_cnt;
 
+/* Wakeup statistics. */
+static atomic_t wakeups_targeted;
+static atomic_t wakeups_spurious;
+
+static uint32_t hash32(uint32_t val)
+{
+	/* Fibonacci hashing, the upper bits are the best distributed. */
+	return (val * 2654435761U) >> 16;
+}
+
+static sys_slist_t *sleeping_threads_list_get(uint32_t context)
+{
+	if (context == 0) {
+		return &sleeping_threads_any;
+	}
+
+	return &sleeping_threads[hash32(context) % ARRAY_SIZE(sleeping_threads)];
+}
+
 /* Get thread monitor structure assigned to a specific thread id, with a RPC
  * counter value at which nrf_modem_lib last checked the 'readiness' of a thread
  */
 static struct thread_monitor_entry *thread_monitor_entry_get(k_tid_t id)
 {
-	struct thread_monitor_entry *entry = thread_event_monitor;
-	struct thread_monitor_entry *new_entry = thread_event_monitor;
-	int entry_age, oldest_entry_age = 0;
-
-	for ( ; PART_OF_ARRAY(thread_event_monitor, entry); entry++) {
-		if (entry->id == id) {
-			return entry;
-		} else if (entry->id == 0) {
-			/* Uninitialized field. */
-			new_entry = entry;
-			break;
-		}
-
-		/* Identify oldest entry. */
-		entry_age = rpc_event_cnt - entry->cnt;
-		if (entry_age > oldest_entry_age) {
-			oldest_entry_age = entry_age;
-			new_entry = entry;
-		}
+	struct thread_monitor_entry *entry =
+		&thread_event_monitor[hash32((uint32_t)(uintptr_t)id) %
+				      ARRAY_SIZE(thread_event_monitor)];
+
+	if (entry->id != id) {
+		/* Entry is unused or assigned to another thread. Taking it over
+		 * makes the thread re-verify if a sleep is needed, which is
+		 * always safe.
+		 */
+		entry->id = id;
+		entry->cnt = rpc_event_cnt - 1;
 	}
 
-	new_entry->id = id;
-	new_entry->cnt = rpc_event_cnt - 1;
-
-	return new_entry;
+	return entry;
 }
 
 /* Update thread monitor entry RPC counter. */
@@ -123,7 +137,7 @@ static bool sleeping_thread_add(struct sleeping_thread *thread)
 
 	if (can_thread_sleep(entry)) {
 		allow_to_sleep = true;
-		sys_slist_append(&sleeping_threads, &thread->node);
+		sys_slist_append(sleeping_threads_list_get(thread->context), &thread->node);
 	}
 
 	irq_unlock(key);
@@ -138,7 +152,7 @@ static void sleeping_thread_remove(struct sleeping_thread *thread)
 
 	uint32_t key = irq_lock();
 
-	sys_slist_find_and_remove(&sleeping_threads, &thread->node);
+	sys_slist_find_and_remove(sleeping_threads_list_get(thread->context), &thread->node);
 
 	entry = thread_monitor_entry_get(k_current_get());
 	thread_monitor_entry_update(entry);
@@ -344,15 +358,52 @@ void nrf_modem_os_event_notify(uint32_t context)
 	atomic_inc(&rpc_event_cnt);
 
 	struct sleeping_thread *thread;
+	atomic_val_t targeted = 0;
+	atomic_val_t spurious = 0;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&sleeping_threads, thread, node) {
-		/* Wake sleeping thread if context of the thread matches, is 0 or the notify
-		 * context is 0.
-		 */
-		if ((thread->context == context) || (context == 0) || (thread->context == 0)) {
-			k_sem_give(&thread->sem);
+	/* Wake sleeping threads if context of the thread matches, is 0 or the notify
+	 * context is 0.
+	 */
+	if (context == 0) {
+		for (size_t i = 0; i < ARRAY_SIZE(sleeping_threads); i++) {
+			SYS_SLIST_FOR_EACH_CONTAINER(&sleeping_threads[i], thread, node) {
+				k_sem_give(&thread->sem);
+				spurious++;
+			}
+		}
+	} else {
+		SYS_SLIST_FOR_EACH_CONTAINER(sleeping_threads_list_get(context), thread, node) {
+			if (thread->context == context) {
+				k_sem_give(&thread->sem);
+				targeted++;
+			}
 		}
 	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&sleeping_threads_any, thread, node) {
+		k_sem_give(&thread->sem);
+		targeted++;
+	}
+
+	if (targeted) {
+		atomic_add(&wakeups_targeted, targeted);
+	}
+
+	if (spurious) {
+		atomic_add(&wakeups_spurious, spurious);
+	}
+}
+
+void nrf_modem_lib_wakeup_stats_get(struct nrf_modem_lib_wakeup_stats *stats)
+{
+	stats->targeted = atomic_get(&wakeups_targeted);
+	stats->spurious = atomic_get(&wakeups_spurious);
+}
+
+void nrf_modem_lib_wakeup_stats_reset(void)
+{
+	atomic_clear(&wakeups_targeted);
+	atomic_clear(&wakeups_spurious);
 }
 
 void *nrf_modem_os_alloc(size_t bytes)
@@ -474,7 +525,10 @@ static int on_init(void)
 	 * initialization. This is because we want to keep the list intact regardless of modem
 	 * reinitialization to wake sleeping threads on modem initialization.
 	 */
-	sys_slist_init(&sleeping_threads);
+	for (size_t i = 0; i < ARRAY_SIZE(sleeping_threads); i++) {
+		sys_slist_init(&sleeping_threads[i]);
+	}
+	sys_slist_init(&sleeping_threads_any);
 	atomic_clear(&rpc_event_cnt);
 
 	return 0;
@@ -496,7 +550,13 @@ void nrf_modem_os_shutdown(void)
 	struct sleeping_thread *thread;
 
 	/* Wake up all sleeping threads. */
-	SYS_SLIST_FOR_EACH_CONTAINER(&sleeping_threads, thread, node) {
+	for (size_t i = 0; i < ARRAY_SIZE(sleeping_threads); i++) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&sleeping_threads[i], thread, node) {
+			k_sem_give(&thread->sem);
+		}
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&sleeping_threads_any, thread, node) {
 		k_sem_give(&thread->sem);
 	}
 }
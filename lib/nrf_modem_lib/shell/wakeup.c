@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <modem/nrf_modem_lib.h>
+
+static int modem_wakeup_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+	struct nrf_modem_lib_wakeup_stats stats;
+
+	nrf_modem_lib_wakeup_stats_get(&stats);
+
+	shell_print(sh, "Targeted wakeups: %u", stats.targeted);
+	shell_print(sh, "Spurious wakeups: %u", stats.spurious);
+
+	return 0;
+}
+
+static int modem_wakeup_reset(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	nrf_modem_lib_wakeup_stats_reset();
+
+	shell_print(sh, "Wakeup statistics reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(modem_wakeup_cmd,
+	SHELL_CMD(stats, NULL,
+		"Print the number of threads woken up on Modem library events.",
+		modem_wakeup_stats),
+	SHELL_CMD(reset, NULL,
+		"Reset wakeup statistics.", modem_wakeup_reset),
+	SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(modem_wakeup, &modem_wakeup_cmd,
+	"Commands for Modem library wakeup statistics.", NULL);
@@ -16,6 +16,8 @@
 
 #include <modem/trace_backend.h>
 
+#include "trace_lz.h"
+
 LOG_MODULE_REGISTER(modem_trace_backend, CONFIG_MODEM_TRACE_BACKEND_LOG_LEVEL);
 
 #define EXT_FLASH_DEVICE DEVICE_DT_GET(DT_ALIAS(ext_flash))
@@ -26,6 +28,15 @@ LOG_MODULE_REGISTER(modem_trace_backend, CONFIG_MODEM_TRACE_BACKEND_LOG_LEVEL);
 
 #define TRACE_MAGIC_INITIALIZED 0x152ac523
 
+#define COMPRESSION_ENABLED IS_ENABLED(CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESSION)
+
+/* Header of each FCB entry when compression is enabled. */
+struct block_hdr {
+	uint16_t raw_len; /* Size of the trace data before compression. */
+	uint8_t compressed; /* Whether the block is compressed or stored as is. */
+	uint8_t reserved;
+};
+
 static trace_backend_processed_cb trace_processed_callback;
 
 static const struct flash_area *modem_trace_area;
@@ -46,6 +57,21 @@ static size_t trace_bytes_unread;
 static size_t flash_buf_written;
 static uint8_t flash_buf[BUF_SIZE];
 
+/* Size of the trace data in the FCB entry being read. */
+static __noinit size_t read_len;
+
+#if CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESSION
+BUILD_ASSERT(BUF_SIZE <= UINT16_MAX);
+
+/* Compressed block being written to or read from flash. */
+static uint8_t block_buf[sizeof(struct block_hdr) + TRACE_LZ_BOUND(BUF_SIZE)];
+/* Decompressed trace data of the FCB entry being read. */
+static __noinit uint8_t read_buf[BUF_SIZE];
+
+static uint32_t raw_bytes_total;
+static uint32_t stored_bytes_total;
+#endif
+
 static bool is_initialized;
 
 static int trace_backend_clear(void);
@@ -64,20 +90,113 @@ static size_t buffer_append(const void *data, size_t len)
 	return append_len;
 }
 
+/* Get the size of the trace data stored in an FCB entry. */
+static size_t entry_trace_len(const struct fcb_entry *entry)
+{
+	struct block_hdr hdr;
+
+	if (!COMPRESSION_ENABLED) {
+		return entry->fe_data_len;
+	}
+
+	if (flash_area_read(trace_fcb.fap, FCB_ENTRY_FA_DATA_OFF(*entry), &hdr, sizeof(hdr))) {
+		return 0;
+	}
+
+	return hdr.raw_len;
+}
+
 static int fcb_walk_callback(struct fcb_entry_ctx *loc_ctx, void *arg)
 {
 	if ((loc_ctx->loc.fe_sector == sector) && (loc_ctx->loc.fe_elem_off < loc.fe_elem_off)) {
 		return 0;
 	}
 
-	trace_bytes_unread -= loc_ctx->loc.fe_data_len;
+	trace_bytes_unread -= entry_trace_len(&loc_ctx->loc);
 	return 0;
 }
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESSION
+/* Compress the flash buffer into the block buffer.
+ * The data is stored as is if it does not compress.
+ */
+static size_t block_compress(void)
+{
+	struct block_hdr hdr = {
+		.raw_len = flash_buf_written,
+		.compressed = 1,
+	};
+	size_t len;
+
+	len = trace_lz_compress(flash_buf, flash_buf_written, &block_buf[sizeof(hdr)],
+				sizeof(block_buf) - sizeof(hdr));
+	if (len == 0 || len >= flash_buf_written) {
+		hdr.compressed = 0;
+		len = flash_buf_written;
+		memcpy(&block_buf[sizeof(hdr)], flash_buf, len);
+	}
+
+	memcpy(block_buf, &hdr, sizeof(hdr));
+	len += sizeof(hdr);
+
+	raw_bytes_total += flash_buf_written;
+	stored_bytes_total += len;
+
+	return len;
+}
+
+/* Read the current FCB entry and decompress it into the read buffer. */
+static int block_load(void)
+{
+	struct block_hdr hdr;
+	int err;
+
+	if (loc.fe_data_len < sizeof(hdr) || loc.fe_data_len > sizeof(block_buf)) {
+		return -EBADMSG;
+	}
+
+	err = flash_area_read(trace_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), block_buf,
+			      loc.fe_data_len);
+	if (err) {
+		LOG_ERR("Flash_area_read failed, err %d", err);
+		return err;
+	}
+
+	memcpy(&hdr, block_buf, sizeof(hdr));
+
+	if (!hdr.compressed) {
+		read_len = MIN(loc.fe_data_len - sizeof(hdr), sizeof(read_buf));
+		memcpy(read_buf, &block_buf[sizeof(hdr)], read_len);
+		return 0;
+	}
+
+	err = trace_lz_decompress(&block_buf[sizeof(hdr)], loc.fe_data_len - sizeof(hdr),
+				  read_buf, sizeof(read_buf));
+	if (err < 0) {
+		LOG_ERR("Corrupted trace block, err %d", err);
+		return err;
+	}
+	read_len = err;
+
+	return 0;
+}
+
+static uint32_t trace_backend_compression_ratio(void)
+{
+	if (stored_bytes_total == 0) {
+		return 100;
+	}
+
+	return (uint64_t)raw_bytes_total * 100 / stored_bytes_total;
+}
+#endif /* CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESSION */
+
 static int buffer_flush_to_flash(void)
 {
 	int err;
 	struct fcb_entry loc_flush;
+	const uint8_t *data = flash_buf;
+	size_t data_len = flash_buf_written;
 
 	if (!is_initialized) {
 		return -EPERM;
@@ -87,7 +206,12 @@ static int buffer_flush_to_flash(void)
 		return -ENODATA;
 	}
 
-	err = fcb_append(&trace_fcb, flash_buf_written, &loc_flush);
+#if CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESSION
+	data = block_buf;
+	data_len = block_compress();
+#endif
+
+	err = fcb_append(&trace_fcb, data_len, &loc_flush);
 	if (err) {
 		if (IS_ENABLED(CONFIG_NRF_MODEM_TRACE_FLASH_NOSPACE_ERASE_OLDEST)) {
 			/* Find the number of trace bytes in oldest sector (that is not read). */
@@ -110,7 +234,7 @@ static int buffer_flush_to_flash(void)
 				LOG_ERR("fcb_rotate failed, err %d", err);
 				return err;
 			}
-			err = fcb_append(&trace_fcb, flash_buf_written, &loc_flush);
+			err = fcb_append(&trace_fcb, data_len, &loc_flush);
 		}
 
 		if (err) {
@@ -120,7 +244,7 @@ static int buffer_flush_to_flash(void)
 	}
 
 	err = flash_area_write(
-		trace_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc_flush), flash_buf, flash_buf_written);
+		trace_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc_flush), data, data_len);
 	if (err) {
 		LOG_ERR("flash_area_write failed, err %d", err);
 		return err;
@@ -218,7 +342,7 @@ int trace_backend_init(trace_backend_processed_cb trace_processed_cb)
 	/* Get trace size */
 	err = fcb_getnext(&trace_fcb, &loc);
 	while (!err) {
-		trace_bytes_unread += loc.fe_data_len;
+		trace_bytes_unread += entry_trace_len(&loc);
 		err = fcb_getnext(&trace_fcb, &loc);
 	}
 
@@ -242,18 +366,22 @@ static int read_from_offset(void *buf, size_t len)
 	int err;
 	size_t to_read;
 
-	to_read = MIN(len, loc.fe_data_len - read_offset);
+	to_read = MIN(len, read_len - read_offset);
+#if CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESSION
+	memcpy(buf, &read_buf[read_offset], to_read);
+#else
 	err = flash_area_read(
 		trace_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc) + read_offset, buf, to_read);
 	if (err) {
 		LOG_ERR("Flash_area_read failed, err %d", err);
 		return err;
 	}
+#endif
 
 	trace_bytes_unread -= to_read;
 
 	read_offset += to_read;
-	if (read_offset >= loc.fe_data_len) {
+	if (read_offset >= read_len) {
 		read_offset = 0;
 	}
 
@@ -320,6 +448,15 @@ int trace_backend_read(void *buf, size_t len)
 		return err;
 	}
 
+#if CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESSION
+	err = block_load();
+	if (err) {
+		return err;
+	}
+#else
+	read_len = loc.fe_data_len;
+#endif
+
 	return read_from_offset(buf, len);
 }
 
@@ -402,4 +539,7 @@ struct nrf_modem_lib_trace_backend trace_backend = {
 	.data_size = trace_backend_data_size,
 	.read = trace_backend_read,
 	.clear = trace_backend_clear,
+#if CONFIG_NRF_MODEM_LIB_TRACE_BACKEND_FLASH_COMPRESSION
+	.compression_ratio = trace_backend_compression_ratio,
+#endif
 };
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "trace_lz.h"
+
+#define HASH_BITS 10
+#define LITERAL_RUN_MAX 128
+#define MATCH_MAX (0x7f + TRACE_LZ_MIN_MATCH)
+#define DISTANCE_MAX UINT16_MAX
+
+/* Positions of the last occurrences of 4-byte sequences, plus one (0 means none). */
+static uint16_t hash_table[1 << HASH_BITS];
+
+static uint32_t hash(const uint8_t *p)
+{
+	const uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+
+	return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static size_t literals_emit(const uint8_t *lit, size_t len, uint8_t *dst, size_t out,
+			    size_t dst_cap)
+{
+	while (len) {
+		const size_t run = MIN(len, LITERAL_RUN_MAX);
+
+		if (out + 1 + run > dst_cap) {
+			return 0;
+		}
+		dst[out++] = run - 1;
+		memcpy(&dst[out], lit, run);
+		out += run;
+		lit += run;
+		len -= run;
+	}
+
+	return out;
+}
+
+size_t trace_lz_compress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap)
+{
+	size_t pos = 0;
+	size_t lit_start = 0;
+	size_t out = 0;
+
+	if (src_len > UINT16_MAX) {
+		return 0;
+	}
+
+	memset(hash_table, 0, sizeof(hash_table));
+
+	while (pos + TRACE_LZ_MIN_MATCH <= src_len) {
+		const uint32_t h = hash(&src[pos]);
+		const size_t cand = hash_table[h];
+		size_t len = 0;
+
+		hash_table[h] = pos + 1;
+
+		if (cand && (pos - (cand - 1)) <= DISTANCE_MAX) {
+			const size_t max = MIN(src_len - pos, MATCH_MAX);
+			const uint8_t *ref = &src[cand - 1];
+
+			while (len < max && ref[len] == src[pos + len]) {
+				len++;
+			}
+		}
+
+		if (len < TRACE_LZ_MIN_MATCH) {
+			pos++;
+			continue;
+		}
+
+		if (pos != lit_start) {
+			out = literals_emit(&src[lit_start], pos - lit_start, dst, out, dst_cap);
+			if (!out) {
+				return 0;
+			}
+		}
+		if (out + 3 > dst_cap) {
+			return 0;
+		}
+
+		const size_t distance = pos - (cand - 1);
+
+		dst[out++] = 0x80 | (len - TRACE_LZ_MIN_MATCH);
+		dst[out++] = distance & 0xff;
+		dst[out++] = distance >> 8;
+
+		pos += len;
+		lit_start = pos;
+	}
+
+	if (src_len != lit_start) {
+		out = literals_emit(&src[lit_start], src_len - lit_start, dst, out, dst_cap);
+	}
+
+	return out;
+}
+
+int trace_lz_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap)
+{
+	size_t in = 0;
+	size_t out = 0;
+
+	while (in < src_len) {
+		const uint8_t token = src[in++];
+
+		if (token < 0x80) {
+			const size_t run = token + 1;
+
+			if (in + run > src_len || out + run > dst_cap) {
+				return -EBADMSG;
+			}
+			memcpy(&dst[out], &src[in], run);
+			in += run;
+			out += run;
+		} else {
+			const size_t len = (token & 0x7f) + TRACE_LZ_MIN_MATCH;
+			size_t distance;
+
+			if (in + 2 > src_len) {
+				return -EBADMSG;
+			}
+			distance = src[in] | (src[in + 1] << 8);
+			in += 2;
+
+			if (distance == 0 || distance > out || out + len > dst_cap) {
+				return -EBADMSG;
+			}
+			/* The match may overlap with its own output, copy byte by byte. */
+			for (size_t i = 0; i < len; i++, out++) {
+				dst[out] = dst[out - distance];
+			}
+		}
+	}
+
+	return out;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TRACE_LZ_H__
+#define TRACE_LZ_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+/* Light LZ77 codec used to compress blocks of modem traces before storing them in flash.
+ *
+ * A compressed block is a sequence of tokens. A token starting with a byte below 0x80
+ * is a run of (byte + 1) literals that follow it. A token starting with a byte of 0x80
+ * or above is a match of ((byte & 0x7f) + TRACE_LZ_MIN_MATCH) bytes, whose distance
+ * back in the output follows as a little-endian 16-bit value.
+ */
+
+#define TRACE_LZ_MIN_MATCH 4
+
+/* Worst case size of a compressed block. */
+#define TRACE_LZ_BOUND(len) ((len) + DIV_ROUND_UP(len, 128))
+
+/**
+ * @brief Compress a block.
+ *
+ * @param src     Data to compress, at most 65535 bytes.
+ * @param src_len Size of the data to compress.
+ * @param dst     Output buffer.
+ * @param dst_cap Size of the output buffer.
+ *
+ * @return Size of the compressed block, or 0 if it does not fit in the output buffer.
+ */
+size_t trace_lz_compress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap);
+
+/**
+ * @brief Decompress a block.
+ *
+ * @param src     Compressed block.
+ * @param src_len Size of the compressed block.
+ * @param dst     Output buffer.
+ * @param dst_cap Size of the output buffer.
+ *
+ * @return Size of the decompressed data, or a negative error code if the block is invalid.
+ */
+int trace_lz_decompress(const uint8_t *src, size_t src_len, uint8_t *dst, size_t dst_cap);
+
+#endif /* TRACE_LZ_H__ */
@@ -541,6 +541,14 @@ static void t4t_isodep_received(const uint8_t *data, size_t data_len)
 	err = nfc_t4t_hl_procedure_on_data_received(data, data_len);
 	if (err) {
 		printk("NFC Type 4 Tag HL data received error: %d.\n", err);
+
+		/* The procedure failed and no command is pending, end the session. */
+		t4t.tlv_index = 0;
+
+		err = nfc_t4t_isodep_tag_deselect();
+		if (err) {
+			printk("NFC T4T Deselect error: %d.\n", err);
+		}
 	}
 }
 
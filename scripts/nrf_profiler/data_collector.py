@@ -9,7 +9,6 @@ import time
 import logging
 import signal
 from stream import Stream
-from rtt2stream import Rtt2Stream
 from model_creator import ModelCreator
 
 is_waiting = True
@@ -17,10 +16,20 @@ def signal_handler(sig, frame):
     global is_waiting
     is_waiting = False
 
-def rtt2stream(stream, event, event_close, log_lvl_number):
+def rtt2stream(stream, event, event_close, args, log_lvl_number):
     signal.signal(signal.SIGINT, signal.SIG_IGN)
     try:
-        rtt2s = Rtt2Stream(stream, event_close, log_lvl=log_lvl_number)
+        # Backend modules are imported only when used, as they require different packages.
+        if args.uart is not None:
+            from uart2stream import Uart2Stream
+            rtt2s = Uart2Stream(stream, event_close, args.uart, args.baudrate,
+                                log_lvl=log_lvl_number)
+        elif args.files is not None:
+            from file2stream import File2Stream
+            rtt2s = File2Stream(stream, event_close, args.files, log_lvl=log_lvl_number)
+        else:
+            from rtt2stream import Rtt2Stream
+            rtt2s = Rtt2Stream(stream, event_close, log_lvl=log_lvl_number)
         event.wait()
         rtt2s.read_and_transmit_data()
     except Exception as e:
@@ -50,6 +59,14 @@ def main():
     parser.add_argument('time', type=int, help='Time of collecting data [s]')
     parser.add_argument('dataset_name', help='Name of dataset')
     parser.add_argument('--log', help='Log level')
+    backend = parser.add_mutually_exclusive_group()
+    backend.add_argument('--uart', metavar='PORT',
+                         help='Collect data from the UART backend at the given serial port')
+    backend.add_argument('--files', metavar='PREFIX',
+                         help='Collect data written by the host file backend with the given '
+                              'path prefix')
+    parser.add_argument('--baudrate', type=int, default=115200,
+                        help='Baudrate of the UART backend')
     args = parser.parse_args()
 
     if args.log is not None:
@@ -67,7 +84,8 @@ def main():
 
     processes = []
     processes.append((Process(target=rtt2stream,
-                                args=(streams[0], event, event_close_rtt2stream, log_lvl_number),
+                                args=(streams[0], event, event_close_rtt2stream, args,
+                                      log_lvl_number),
                                 daemon=True),
                         event_close_rtt2stream))
     processes.append((Process(target=model_creator,
@@ -0,0 +1,62 @@
+#
+# Copyright (c) 2024 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+import sys
+import logging
+from stream import StreamError
+
+class File2Stream:
+    READ_CHUNK_SIZE = 8192
+
+    def __init__(self, out_stream, event_close, prefix, log_lvl=logging.INFO):
+        self.out_stream = out_stream
+        self.event_close = event_close
+        self.data_filename = prefix + '_data.bin'
+        self.info_filename = prefix + '_info.txt'
+
+        self.logger = logging.getLogger('Profiler file to stream')
+        self.logger_console = logging.StreamHandler()
+        self.logger.setLevel(log_lvl)
+        self.log_format = logging.Formatter('[%(levelname)s] %(name)s: %(message)s')
+        self.logger_console.setFormatter(self.log_format)
+        self.logger.addHandler(self.logger_console)
+
+    def _read_all_events_descriptions(self):
+        try:
+            with open(self.info_filename, 'rb') as f:
+                info = f.read()
+        except IOError as err:
+            self.logger.error("Cannot read event descriptions: {}".format(err))
+            sys.exit()
+
+        # The device writes the descriptions of all event types each time a new type is
+        # registered. Every set ends with an empty line, the last set is the complete one.
+        desc_sets = [d for d in info.split(b'\n\n') if len(d) > 0]
+        if len(desc_sets) == 0:
+            self.logger.error("No event descriptions in {}".format(self.info_filename))
+            sys.exit()
+
+        return bytearray(desc_sets[-1] + b'\n\n')
+
+    def read_and_transmit_data(self):
+        try:
+            self.out_stream.send_desc(self._read_all_events_descriptions())
+
+            with open(self.data_filename, 'rb') as f:
+                while not self.event_close.is_set():
+                    buf = f.read(self.READ_CHUNK_SIZE)
+                    if len(buf) == 0:
+                        break
+
+                    self.out_stream.send_ev(bytearray(buf))
+
+        except StreamError as err:
+            self.logger.error("Error: {}. Unable to send data".format(err))
+            sys.exit()
+        except IOError as err:
+            self.logger.error("Cannot read events: {}".format(err))
+            sys.exit()
+
+        self.logger.info("All events read from {}".format(self.data_filename))
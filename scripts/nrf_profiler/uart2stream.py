@@ -0,0 +1,132 @@
+#
+# Copyright (c) 2024 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+
+import sys
+import logging
+import serial
+from enum import Enum
+from stream import StreamError
+
+class Command(Enum):
+    START = 1
+    STOP = 2
+    INFO = 3
+
+# Stream IDs of the frames sent by the nrf_profiler UART backend.
+FRAME_STREAM_DATA = 0x01
+FRAME_STREAM_INFO = 0x02
+FRAME_HEADER_SIZE = 2
+
+class Uart2Stream:
+    def __init__(self, out_stream, event_close, port, baudrate=115200, log_lvl=logging.INFO):
+        self.out_stream = out_stream
+        self.event_close = event_close
+        self.rx_buf = bytearray()
+
+        self.logger = logging.getLogger('Profiler UART to stream')
+        self.logger_console = logging.StreamHandler()
+        self.logger.setLevel(log_lvl)
+        self.log_format = logging.Formatter('[%(levelname)s] %(name)s: %(message)s')
+        self.logger_console.setFormatter(self.log_format)
+        self.logger.addHandler(self.logger_console)
+
+        try:
+            self.uart = serial.Serial(port, baudrate, timeout=0.1)
+        except serial.SerialException as err:
+            self.logger.error("Cannot open {}: {}".format(port, err))
+            sys.exit()
+
+        self.logger.info("Connected to device via {}".format(port))
+
+    def _read_frames(self):
+        # Returns the payloads of the frames received so far, split by the stream.
+        frames = {FRAME_STREAM_DATA: bytearray(), FRAME_STREAM_INFO: bytearray()}
+
+        try:
+            self.rx_buf.extend(self.uart.read(max(1, self.uart.in_waiting)))
+        except serial.SerialException:
+            self.logger.error("Problem with reading UART data")
+            self._disconnect()
+            sys.exit()
+
+        while len(self.rx_buf) >= FRAME_HEADER_SIZE:
+            stream_id = self.rx_buf[0]
+            frame_len = FRAME_HEADER_SIZE + self.rx_buf[1]
+
+            if len(self.rx_buf) < frame_len:
+                break
+
+            if stream_id in frames:
+                frames[stream_id].extend(self.rx_buf[FRAME_HEADER_SIZE:frame_len])
+            else:
+                self.logger.warning("Unknown stream ID: {}".format(stream_id))
+
+            del self.rx_buf[:frame_len]
+
+        return frames
+
+    def _read_all_events_descriptions(self):
+        self._send_command(Command.INFO)
+        desc_buf = bytearray()
+        # Empty field is sent after last event description
+        while True:
+            if self.event_close.is_set():
+                self.logger.info("Module closed before receiving event descriptions.")
+                self._disconnect()
+                sys.exit()
+
+            desc_buf.extend(self._read_frames()[FRAME_STREAM_INFO])
+            if desc_buf[-2:] == bytearray('\n\n', 'utf-8'):
+                return desc_buf
+
+    def _send_data(self, buf):
+        if len(buf) == 0:
+            return
+
+        try:
+            self.out_stream.send_ev(buf)
+        except StreamError as err:
+            self.logger.error("Error: {}. Unable to send data".format(err))
+            self._disconnect()
+            sys.exit()
+
+    def read_and_transmit_data(self):
+        desc_buf = self._read_all_events_descriptions()
+        try:
+            self.out_stream.send_desc(desc_buf)
+        except StreamError as err:
+            self.logger.error("Error: {}. Unable to send data".format(err))
+            self._disconnect()
+            sys.exit()
+
+        self._send_command(Command.START)
+        while True:
+            if self.event_close.is_set():
+                self.close()
+
+            self._send_data(self._read_frames()[FRAME_STREAM_DATA])
+
+    def _send_command(self, command_type):
+        try:
+            self.uart.write(bytes([command_type.value]))
+        except serial.SerialException:
+            self.logger.error("Problem with writing UART data")
+
+    def _disconnect(self):
+        self.uart.close()
+        self.logger.info("Disconnected from device")
+
+    def close(self):
+        self.logger.info("Real time transmission closed")
+        self._send_command(Command.STOP)
+
+        # Read remaining data from device and send it.
+        buf = self._read_frames()[FRAME_STREAM_DATA]
+        while len(buf) > 0:
+            self._send_data(buf)
+            buf = self._read_frames()[FRAME_STREAM_DATA]
+
+        self._disconnect()
+        sys.exit()
@@ -5,6 +5,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/slist.h>
@@ -22,6 +23,7 @@ struct app_event_manager_event_display_bm _app_event_manager_event_display_bm;
 static K_WORK_DEFINE(event_processor, event_processor_fn);
 static sys_slist_t eventq = SYS_SLIST_STATIC_INIT(&eventq);
 static struct k_spinlock lock;
+static bool event_types_sorted;
 
 static bool log_is_event_displayed(const struct event_type *et)
 {
@@ -187,7 +189,19 @@ static void event_processor_fn(struct k_work *work)
 
 			log_event_progress(et, el);
 
-			consumed = el->notification(aeh);
+			if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_NOTIFY_HOOKS)) {
+				uint32_t start = k_cycle_get_32();
+
+				consumed = el->notification(aeh);
+
+				uint32_t cycles = k_cycle_get_32() - start;
+
+				STRUCT_SECTION_FOREACH(event_notify_hook, h) {
+					h->hook(aeh, es, cycles);
+				}
+			} else {
+				consumed = el->notification(aeh);
+			}
 
 			if (consumed) {
 				log_event_consumed(et);
@@ -209,6 +223,10 @@ void _event_submit(struct app_event_header *aeh)
 	__ASSERT_NO_MSG(aeh);
 	APP_EVENT_ASSERT_ID(aeh->type_id);
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_TIMESTAMP)
+	aeh->submit_time = k_cycle_get_32();
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS)) {
@@ -222,6 +240,53 @@ void _event_submit(struct app_event_header *aeh)
 	k_work_submit(&event_processor);
 }
 
+static bool event_types_sorted_check(void)
+{
+	for (const struct event_type *et = _event_type_list_start + 1;
+	     et < _event_type_list_end; et++) {
+		if (strcmp((et - 1)->name, et->name) >= 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+const struct event_type *app_event_manager_event_type_find(const char *name)
+{
+	__ASSERT_NO_MSG(name);
+
+	if (!event_types_sorted) {
+		/* Not initialized yet or unexpected section order. */
+		STRUCT_SECTION_FOREACH(event_type, et) {
+			if (!strcmp(et->name, name)) {
+				return et;
+			}
+		}
+
+		return NULL;
+	}
+
+	size_t low = 0;
+	size_t high = _event_type_list_end - _event_type_list_start;
+
+	while (low < high) {
+		size_t mid = low + (high - low) / 2;
+		const struct event_type *et = &_event_type_list_start[mid];
+		int cmp = strcmp(name, et->name);
+
+		if (cmp == 0) {
+			return et;
+		} else if (cmp < 0) {
+			high = mid;
+		} else {
+			low = mid + 1;
+		}
+	}
+
+	return NULL;
+}
+
 int app_event_manager_init(void)
 {
 	int ret = 0;
@@ -229,6 +294,12 @@ int app_event_manager_init(void)
 	__ASSERT_NO_MSG(_event_type_list_end - _event_type_list_start <=
 			CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT);
 
+	/* The linker sorts the event type section by event names. */
+	event_types_sorted = event_types_sorted_check();
+	if (!event_types_sorted) {
+		LOG_WRN("Event types are not sorted by name, using linear lookup");
+	}
+
 	log_event_init();
 
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTINIT_HOOK)) {
@@ -230,6 +230,11 @@ struct app_event_header {
 
 	/** Pointer to the event type object. */
 	const struct event_type *type_id;
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_TIMESTAMP)
+	/** Cycle count at the event submission. */
+	uint32_t submit_time;
+#endif
 };
 
 /** Function to log data from this event. */
@@ -354,6 +359,11 @@ extern struct app_event_manager_event_display_bm _app_event_manager_event_displa
 		     "Enable APP_EVENT_MANAGER_POSTPROCESS_HOOKS before usage"); \
 	_APP_EVENT_HOOK_REGISTER(event_postprocess_hook, hook_fn, prio)
 
+#define _APP_EVENT_HOOK_NOTIFY_REGISTER(hook_fn, prio)                      \
+	BUILD_ASSERT(IS_ENABLED(CONFIG_APP_EVENT_MANAGER_NOTIFY_HOOKS),     \
+		     "Enable APP_EVENT_MANAGER_NOTIFY_HOOKS before usage"); \
+	_APP_EVENT_HOOK_REGISTER(event_notify_hook, hook_fn, prio)
+
 /**
  * @brief Joining together event type flags.
  */
@@ -425,6 +435,14 @@ struct event_postprocess_hook {
 	void (*hook)(const struct app_event_header *aeh);
 };
 
+/** @brief Structure used to register event notify hook
+ */
+struct event_notify_hook {
+	/** @brief Hook function */
+	void (*hook)(const struct app_event_header *aeh, const struct event_subscriber *es,
+		     uint32_t cycles);
+};
+
 
 
 /** @brief Submit an event to the Application Event Manager.
@@ -107,9 +107,16 @@ static void set_event_displaying(const struct shell *shell, size_t argc,
 
 			event_indexes[i] = strtol(argv[i + 1], &end, 10);
 
+			if (*end != '\0') {
+				/* Not a number, try to find the event by name. */
+				const struct event_type *et =
+					app_event_manager_event_type_find(argv[i + 1]);
+
+				event_indexes[i] = et ? (et - _event_type_list_start) : -1;
+			}
+
 			if ((event_indexes[i] < 0)
-			    || (event_indexes[i] >= _event_type_list_end - _event_type_list_start)
-			    || (*end != '\0')) {
+			    || (event_indexes[i] >= _event_type_list_end - _event_type_list_start)) {
 
 				shell_error(shell, "Invalid event ID: %s",
 					    argv[i + 1]);
@@ -149,20 +156,21 @@ static int disable_event_displaying(const struct shell *shell, size_t argc,
 }
 
 
-SHELL_STATIC_SUBCMD_SET_CREATE(sub_app_event_manager,
-	SHELL_CMD_ARG(show_listeners, NULL, "Show listeners",
-		      show_listeners, 0, 0),
-	SHELL_CMD_ARG(show_subscribers, NULL, "Show subscribers",
-		      show_subscribers, 0, 0),
-	SHELL_CMD_ARG(show_events, NULL, "Show events", show_events, 0, 0),
-	SHELL_CMD_ARG(disable, NULL, "Disable displaying event with given ID",
-		      disable_event_displaying, 0,
-		      sizeof(_app_event_manager_event_display_bm) * 8 - 1),
-	SHELL_CMD_ARG(enable, NULL, "Enable displaying event with given ID",
-		      enable_event_displaying, 0,
-		      sizeof(_app_event_manager_event_display_bm) * 8 - 1),
-	SHELL_SUBCMD_SET_END
-);
+SHELL_SUBCMD_SET_CREATE(sub_app_event_manager, (app_event_manager));
+SHELL_SUBCMD_ADD((app_event_manager), show_listeners, NULL, "Show listeners",
+		 show_listeners, 0, 0);
+SHELL_SUBCMD_ADD((app_event_manager), show_subscribers, NULL, "Show subscribers",
+		 show_subscribers, 0, 0);
+SHELL_SUBCMD_ADD((app_event_manager), show_events, NULL, "Show events",
+		 show_events, 0, 0);
+SHELL_SUBCMD_ADD((app_event_manager), disable, NULL,
+		 "Disable displaying event with given ID or name",
+		 disable_event_displaying, 0,
+		 sizeof(_app_event_manager_event_display_bm) * 8 - 1);
+SHELL_SUBCMD_ADD((app_event_manager), enable, NULL,
+		 "Enable displaying event with given ID or name",
+		 enable_event_displaying, 0,
+		 sizeof(_app_event_manager_event_display_bm) * 8 - 1);
 
 SHELL_CMD_REGISTER(app_event_manager, &sub_app_event_manager,
 		   "Application Event Manager commands", NULL);
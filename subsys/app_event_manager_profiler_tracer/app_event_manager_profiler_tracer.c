@@ -148,9 +148,11 @@ static int app_event_manager_trace_event_init(void)
 {
 	/* Every profiled Application Event Manager event registers a single nrf_profiler event.
 	 * Apart from that 2 additional nrf_profiler events are used to indicate processing
-	 * start and end of an Application Event Manager event.
+	 * start and end of an Application Event Manager event and one more reports the latency
+	 * histograms.
 	 */
-	__ASSERT_NO_MSG(_nrf_profiler_info_list_end - _nrf_profiler_info_list_start + 2 <=
+	__ASSERT_NO_MSG(_nrf_profiler_info_list_end - _nrf_profiler_info_list_start + 2 +
+			IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_LATENCY_STATS) <=
 			CONFIG_NRF_PROFILER_MAX_NUMBER_OF_APP_EVENTS);
 
 	if (nrf_profiler_init()) {
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <app_event_manager.h>
+#include <app_event_manager_profiler_tracer.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(app_event_manager_profiler_tracer, CONFIG_APP_EVENT_MANAGER_LOG_LEVEL);
+
+#define LATENCY_BUCKETS		CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_LATENCY_BUCKETS
+#define LATENCY_MAX_SUBSCRIBERS	CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_LATENCY_MAX_SUBSCRIBERS
+#define LATENCY_REPORT_INTERVAL	CONFIG_APP_EVENT_MANAGER_PROFILER_TRACER_LATENCY_REPORT_INTERVAL_MS
+
+/* The report event carries two names and four 32-bit values after the event type ID and
+ * the timestamp. Names are truncated so that the event fits into the nrf_profiler buffer.
+ */
+#define LATENCY_REPORT_VALUES_SIZE (4 * sizeof(uint32_t))
+#define LATENCY_NAME_MAX_LEN							\
+	((CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN - sizeof(uint8_t) - sizeof(uint32_t) -	\
+	  LATENCY_REPORT_VALUES_SIZE) / 2 - sizeof(uint8_t))
+
+BUILD_ASSERT(LATENCY_NAME_MAX_LEN >= 8,
+	     "CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN too small for latency reports");
+
+struct latency_hist {
+	uint32_t buckets[LATENCY_BUCKETS];
+	/* Longest duration in cycles */
+	uint32_t max;
+	/* Number of samples sent in the last nrf_profiler report */
+	uint32_t reported;
+};
+
+extern const struct event_subscriber __start_event_subscribers_all[];
+extern const struct event_subscriber __stop_event_subscribers_all[];
+
+/* Histograms are updated from the Application Event Manager work and reported from
+ * the system workqueue, so updates and reports never run concurrently.
+ */
+static struct latency_hist queue_hist[CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT];
+static struct latency_hist handler_hist[LATENCY_MAX_SUBSCRIBERS];
+
+static uint16_t latency_event_id;
+
+static void hist_add(struct latency_hist *hist, uint32_t cycles)
+{
+	size_t idx = MIN(find_msb_set(cycles), LATENCY_BUCKETS - 1);
+
+	hist->buckets[idx]++;
+	hist->max = MAX(hist->max, cycles);
+}
+
+static uint32_t hist_count(const struct latency_hist *hist)
+{
+	uint32_t count = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(hist->buckets); i++) {
+		count += hist->buckets[i];
+	}
+
+	return count;
+}
+
+static uint32_t bucket_upper_us(const struct latency_hist *hist, size_t idx)
+{
+	uint32_t cycles = (idx == 0) ? 0 : (uint32_t)(BIT(idx) - 1);
+
+	if ((idx == LATENCY_BUCKETS - 1) || (cycles > hist->max)) {
+		cycles = hist->max;
+	}
+
+	return k_cyc_to_us_ceil32(cycles);
+}
+
+/* Upper bound of the bucket that contains the given fraction (in permille) of samples. */
+static uint32_t hist_percentile_us(const struct latency_hist *hist, uint32_t count,
+				   uint32_t permille)
+{
+	uint64_t target = DIV_ROUND_UP((uint64_t)count * permille, 1000);
+	uint64_t sum = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(hist->buckets); i++) {
+		sum += hist->buckets[i];
+		if ((sum > 0) && (sum >= target)) {
+			return bucket_upper_us(hist, i);
+		}
+	}
+
+	return 0;
+}
+
+static struct latency_hist *subscriber_hist_get(const struct event_subscriber *es)
+{
+	size_t idx = es - __start_event_subscribers_all;
+
+	return (idx < ARRAY_SIZE(handler_hist)) ? &handler_hist[idx] : NULL;
+}
+
+static void latency_queue_record(const struct app_event_header *aeh)
+{
+	size_t idx = aeh->type_id - _event_type_list_start;
+
+	hist_add(&queue_hist[idx], k_cycle_get_32() - aeh->submit_time);
+}
+
+APP_EVENT_HOOK_PREPROCESS_REGISTER(latency_queue_record);
+
+static void latency_handler_record(const struct app_event_header *aeh,
+				   const struct event_subscriber *es, uint32_t cycles)
+{
+	struct latency_hist *hist = subscriber_hist_get(es);
+
+	if (hist) {
+		hist_add(hist, cycles);
+	}
+}
+
+APP_EVENT_HOOK_NOTIFY_REGISTER(latency_handler_record);
+
+static void encode_name(struct log_event_buf *buf, const char *name)
+{
+	char truncated[LATENCY_NAME_MAX_LEN + 1];
+
+	strncpy(truncated, name, LATENCY_NAME_MAX_LEN);
+	truncated[LATENCY_NAME_MAX_LEN] = '\0';
+
+	nrf_profiler_log_encode_string(buf, truncated);
+}
+
+static void hist_report(struct latency_hist *hist, const char *event_name,
+			const char *listener_name)
+{
+	uint32_t count = hist_count(hist);
+
+	if (count == hist->reported) {
+		return;
+	}
+	hist->reported = count;
+
+	struct log_event_buf buf;
+
+	nrf_profiler_log_start(&buf);
+	encode_name(&buf, event_name);
+	encode_name(&buf, listener_name);
+	nrf_profiler_log_encode_uint32(&buf, count);
+	nrf_profiler_log_encode_uint32(&buf, hist_percentile_us(hist, count, 500));
+	nrf_profiler_log_encode_uint32(&buf, hist_percentile_us(hist, count, 990));
+	nrf_profiler_log_encode_uint32(&buf, k_cyc_to_us_ceil32(hist->max));
+	nrf_profiler_log_send(&buf, latency_event_id);
+}
+
+static void latency_report_fn(struct k_work *work)
+{
+	if (is_profiling_enabled(latency_event_id)) {
+		STRUCT_SECTION_FOREACH(event_type, et) {
+			/* Queue wait time is reported with an empty listener name. */
+			hist_report(&queue_hist[et - _event_type_list_start], et->name, "");
+
+			for (const struct event_subscriber *es = et->subs_start;
+			     es != et->subs_stop;
+			     es++) {
+				struct latency_hist *hist = subscriber_hist_get(es);
+
+				if (hist) {
+					hist_report(hist, et->name, es->listener->name);
+				}
+			}
+		}
+	}
+
+	(void)k_work_schedule(k_work_delayable_from_work(work), K_MSEC(LATENCY_REPORT_INTERVAL));
+}
+
+static K_WORK_DELAYABLE_DEFINE(latency_report, latency_report_fn);
+
+static void latency_reset_fn(struct k_work *work)
+{
+	memset(queue_hist, 0, sizeof(queue_hist));
+	memset(handler_hist, 0, sizeof(handler_hist));
+}
+
+static K_WORK_DEFINE(latency_reset, latency_reset_fn);
+
+static int latency_init(void)
+{
+	static const char * const labels[] = {"event", "listener", "count", "p50_us", "p99_us",
+					      "max_us"};
+	static const enum nrf_profiler_arg types[] = {NRF_PROFILER_ARG_STRING,
+						      NRF_PROFILER_ARG_STRING,
+						      NRF_PROFILER_ARG_U32, NRF_PROFILER_ARG_U32,
+						      NRF_PROFILER_ARG_U32, NRF_PROFILER_ARG_U32};
+	size_t subscriber_cnt = __stop_event_subscribers_all - __start_event_subscribers_all;
+
+	if (subscriber_cnt > LATENCY_MAX_SUBSCRIBERS) {
+		LOG_WRN("Handler latency tracked for %d of %zu subscribers",
+			LATENCY_MAX_SUBSCRIBERS, subscriber_cnt);
+	}
+
+	/* Profiler initialization is shared with the tracer and done only once. */
+	if (nrf_profiler_init()) {
+		LOG_ERR("System nrf_profiler: initialization problem\n");
+		return -EFAULT;
+	}
+
+	latency_event_id = nrf_profiler_register_event_type("event_latency", labels, types,
+							    ARRAY_SIZE(labels));
+
+	if (LATENCY_REPORT_INTERVAL > 0) {
+		(void)k_work_schedule(&latency_report, K_MSEC(LATENCY_REPORT_INTERVAL));
+	}
+
+	return 0;
+}
+
+APP_EVENT_MANAGER_HOOK_POSTINIT_REGISTER(latency_init);
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SHELL)
+static void hist_print(const struct shell *shell, const char *prefix,
+		       const struct latency_hist *hist, bool verbose)
+{
+	uint32_t count = hist_count(hist);
+
+	if (count == 0) {
+		return;
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "%s n=%u p50<=%uus p99<=%uus max=%uus\n",
+		      prefix, count, hist_percentile_us(hist, count, 500),
+		      hist_percentile_us(hist, count, 990), k_cyc_to_us_ceil32(hist->max));
+
+	if (!verbose) {
+		return;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(hist->buckets); i++) {
+		if (hist->buckets[i] > 0) {
+			shell_fprintf(shell, SHELL_NORMAL, "|\t\t<=%uus: %u\n",
+				      bucket_upper_us(hist, i), hist->buckets[i]);
+		}
+	}
+}
+
+static int show_latency(const struct shell *shell, size_t argc, char **argv)
+{
+	const struct event_type *only = NULL;
+
+	if (argc > 1) {
+		only = app_event_manager_event_type_find(argv[1]);
+		if (!only) {
+			shell_error(shell, "Invalid event name: %s", argv[1]);
+			return -EINVAL;
+		}
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "Event latency (queue wait and handler time):\n");
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		if (only && (et != only)) {
+			continue;
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL, "[E:%s]\n", et->name);
+		hist_print(shell, "|\tqueue", &queue_hist[et - _event_type_list_start],
+			   only != NULL);
+
+		for (const struct event_subscriber *es = et->subs_start;
+		     es != et->subs_stop;
+		     es++) {
+			const struct latency_hist *hist = subscriber_hist_get(es);
+			char prefix[64];
+
+			if (!hist) {
+				continue;
+			}
+
+			snprintf(prefix, sizeof(prefix), "|\t[L:%s]", es->listener->name);
+			hist_print(shell, prefix, hist, only != NULL);
+		}
+	}
+
+	return 0;
+}
+
+static int reset_latency(const struct shell *shell, size_t argc, char **argv)
+{
+	/* Reset from the workqueue that updates the histograms. */
+	(void)k_work_submit(&latency_reset);
+	shell_fprintf(shell, SHELL_NORMAL, "Event latency statistics reset\n");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_latency,
+	SHELL_CMD_ARG(show, NULL, "Show latency of all events or histograms of given event",
+		      show_latency, 1, 1),
+	SHELL_CMD_ARG(reset, NULL, "Reset latency statistics", reset_latency, 0, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_SUBCMD_ADD((app_event_manager), latency, &sub_latency, "Event latency statistics",
+		 NULL, 0, 0);
+#endif /* CONFIG_APP_EVENT_MANAGER_SHELL */
@@ -5,6 +5,7 @@
  */
 
 #include <zephyr/types.h>
+#include <zephyr/sys/util.h>
 #include <bl_crypto.h>
 #include <bl_storage.h>
 #include <fw_info.h>
@@ -86,6 +87,37 @@ static int root_of_trust_verify(
 	return verify_signature(firmware, firmware_len, signature, public_key,
 			external);
 }
+
+int bl_root_of_trust_verify_stream(const uint8_t *public_key,
+				   const uint8_t *public_key_hash,
+				   const uint8_t *signature,
+				   bl_sha256_read_t read, void *read_ctx,
+				   const uint32_t firmware_len)
+{
+	uint8_t hash1[CONFIG_SB_HASH_LEN];
+	uint8_t hash2[CONFIG_SB_HASH_LEN];
+
+	__ASSERT(public_key && public_key_hash && signature && read,
+			"A parameter was NULL.");
+	int retval = verify_truncated_hash(public_key, CONFIG_SB_PUBLIC_KEY_LEN,
+			public_key_hash, SB_PUBLIC_KEY_HASH_LEN, true);
+
+	if (retval != 0) {
+		return retval;
+	}
+
+	retval = bl_sha256_stream(read, read_ctx, firmware_len, hash1);
+	if (retval != 0) {
+		return retval;
+	}
+
+	retval = get_hash(hash2, hash1, CONFIG_SB_HASH_LEN, true);
+	if (retval != 0) {
+		return retval;
+	}
+
+	return bl_secp256r1_validate(hash2, CONFIG_SB_HASH_LEN, public_key, signature);
+}
 #endif
 
 
@@ -122,6 +154,66 @@ int bl_sha256_verify(const uint8_t *data, uint32_t data_len, const uint8_t *expe
 }
 #endif
 
+#ifndef CONFIG_SB_CRYPTO_NO_SHA256
+#include <ocrypto_constant_time.h>
+
+/* CryptoCell only accepts whole SHA-256 blocks before the last update. */
+BUILD_ASSERT((CONFIG_SB_CRYPTO_STREAM_CHUNK_LEN % 64) == 0,
+	     "Chunk length must be a multiple of the SHA-256 block size.");
+
+int bl_sha256_stream(bl_sha256_read_t read, void *read_ctx, uint32_t data_len,
+		     uint8_t *output)
+{
+	/* Word aligned for storage drivers. Being in RAM, the chunk can be
+	 * hashed by CryptoCell without an intermediate copy.
+	 */
+	__aligned(4) uint8_t chunk[CONFIG_SB_CRYPTO_STREAM_CHUNK_LEN];
+	bl_sha256_ctx_t ctx;
+	uint32_t chunk_len;
+	int retval;
+
+	if (!read || !output) {
+		return -EINVAL;
+	}
+
+	retval = bl_sha256_init(&ctx);
+	if (retval != 0) {
+		return retval;
+	}
+
+	for (uint32_t offset = 0; offset < data_len; offset += chunk_len) {
+		chunk_len = MIN(data_len - offset, sizeof(chunk));
+
+		retval = read(read_ctx, offset, chunk, chunk_len);
+		if (retval != 0) {
+			return retval;
+		}
+
+		retval = bl_sha256_update(&ctx, chunk, chunk_len);
+		if (retval != 0) {
+			return retval;
+		}
+	}
+
+	return bl_sha256_finalize(&ctx, output);
+}
+
+int bl_sha256_verify_stream(bl_sha256_read_t read, void *read_ctx,
+			    uint32_t data_len, const uint8_t *expected)
+{
+	uint8_t hash[CONFIG_SB_HASH_LEN];
+
+	int retval = bl_sha256_stream(read, read_ctx, data_len, hash);
+	if (retval != 0) {
+		return retval;
+	}
+	if (!ocrypto_constant_time_equal(expected, hash, CONFIG_SB_HASH_LEN)) {
+		return -EHASHINV;
+	}
+	return 0;
+}
+#endif
+
 #ifdef CONFIG_BL_ROT_VERIFY_EXT_API_ENABLED
 EXT_API(BL_ROT_VERIFY, struct bl_rot_verify_ext_api, bl_rot_verify_ext_api) = {
 		.bl_root_of_trust_verify = bl_root_of_trust_verify_external,
@@ -193,6 +193,16 @@ validation_info_find(uint32_t start_address, uint32_t search_distance)
 	return NULL;
 }
 
+#ifdef CONFIG_SB_VALIDATION_TIME_REPORT
+static void validation_time_report(uint32_t start_cycles, uint32_t fw_size)
+{
+	uint32_t time_ms = k_cyc_to_ms_floor32(k_cycle_get_32() - start_cycles);
+
+	LOG_INF("Validated %u KiB in %u ms (%u ms/MiB).", fw_size / 1024, time_ms,
+		(uint32_t)(((uint64_t)time_ms * 1024 * 1024) / MAX(fw_size, 1)));
+}
+#endif
+
 #ifdef CONFIG_SB_VALIDATE_FW_SIGNATURE
 static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_size,
 			       const struct fw_validation_info *fw_val_info,
@@ -242,12 +252,19 @@ static bool validate_signature(const uint32_t fw_src_address, const uint32_t fw_
 		LOG_INF("Verifying signature against key %d.", key_data_idx);
 		LOG_INF("Hash: 0x%02x...%02x", key_data[0],
 			key_data[SB_PUBLIC_KEY_HASH_LEN-1]);
+#ifdef CONFIG_SB_VALIDATION_TIME_REPORT
+		uint32_t start_cycles = k_cycle_get_32();
+#endif
 		int retval = rot_verify(fw_val_info->public_key,
 					key_data,
 					fw_val_info->signature,
 					(const uint8_t *)fw_src_address,
 					fw_size);
 
+#ifdef CONFIG_SB_VALIDATION_TIME_REPORT
+		validation_time_report(start_cycles, fw_size);
+#endif
+
 		if (retval == 0) {
 			for (uint32_t i = 0; i < key_data_idx; i++) {
 				LOG_INF("Invalidating key %d.", i);
@@ -282,9 +299,16 @@ static bool validate_hash(const uint32_t fw_src_address, const uint32_t fw_size,
 		return false;
 	}
 
+#ifdef CONFIG_SB_VALIDATION_TIME_REPORT
+	uint32_t start_cycles = k_cycle_get_32();
+#endif
 	retval = bl_sha256_verify((const uint8_t *)fw_src_address, fw_size,
 			fw_val_info->hash);
 
+#ifdef CONFIG_SB_VALIDATION_TIME_REPORT
+	validation_time_report(start_cycles, fw_size);
+#endif
+
 	if (retval != 0) {
 		LOG_ERR("Firmware validation failed with error %d.",
 			retval);
@@ -13,8 +13,9 @@ static void log_sensor_data_aggregator_event(const struct app_event_header *aeh)
 	const struct sensor_data_aggregator_event *event = cast_sensor_data_aggregator_event(aeh);
 
 	APP_EVENT_MANAGER_LOG(aeh,
-			      "Send sensor buffer desc address: %p",
-			      (void *)event->sensor_descr);
+			      "Send sensor buffer desc address: %p, samples: %" PRIu8
+			      ", dropped: %" PRIu32,
+			      (void *)event->sensor_descr, event->sample_cnt, event->dropped_cnt);
 }
 
 static void profile_sensor_data_aggregator_event(struct log_event_buf *buf,
@@ -11,6 +11,7 @@
 #include <caf/events/sensor_event.h>
 #include <caf/events/sensor_data_aggregator_event.h>
 #include <caf/sensor_manager.h>
+#include <caf/sensor_data_aggregator.h>
 
 #define MODULE sensor_data_aggregator
 #include <caf/events/module_state_event.h>
@@ -77,6 +78,9 @@ struct aggregator {
 	const uint8_t values_in_sample;		/* Number of sensor values in a sample. */
 	const uint8_t buf_count;		/* Number of buffers. */
 	const uint8_t buf_len;			/* Size of buffor data in bytes. */
+	bool claimed;				/* Active buffer is being written directly. */
+	bool send_pending;			/* Send active buffer once the claim is committed. */
+	uint32_t dropped_cnt;			/* Samples dropped since the last sent buffer. */
 };
 
 
@@ -85,6 +89,9 @@ static struct aggregator aggregators[] = {
 	DT_INST_FOREACH_STATUS_OKAY(__DEFINE_AGGREGATOR)
 };
 
+/* Protects aggregator state accessed both by the event handler and by direct data sources. */
+static struct k_spinlock agg_lock;
+
 
 static struct aggregator_buffer *get_free_buffer(struct aggregator *agg)
 {
@@ -117,49 +124,186 @@ static void release_buffer(struct aggregator *agg, struct aggregator_buffer *ab)
 	}
 }
 
-static void send_buffer(struct aggregator *agg, struct aggregator_buffer *ab)
+static size_t sample_bytes(const struct aggregator *agg)
+{
+	return agg->values_in_sample * sizeof(struct sensor_value);
+}
+
+static size_t free_samples(const struct aggregator *agg, const struct aggregator_buffer *ab)
+{
+	return (agg->buf_len / sample_bytes(agg)) - ab->sample_cnt;
+}
+
+/* Mark the active buffer as busy and switch to the next free one.
+ * Must be called with agg_lock held. Returns the buffer to be sent.
+ * If there is no active buffer, the dropped samples are reported with the next sent buffer.
+ */
+static struct aggregator_buffer *detach_active_buffer(struct aggregator *agg,
+						       uint32_t *dropped_cnt)
+{
+	struct aggregator_buffer *ab = agg->active_buf;
+
+	if (ab) {
+		ab->busy = true;
+		agg->active_buf = get_free_buffer(agg);
+
+		*dropped_cnt = agg->dropped_cnt;
+		agg->dropped_cnt = 0;
+	}
+
+	return ab;
+}
+
+static void send_buffer(struct aggregator *agg, struct aggregator_buffer *ab, uint32_t dropped_cnt)
 {
-	ab->busy = true;
+	if (!ab) {
+		return;
+	}
+
 	struct sensor_data_aggregator_event *event = new_sensor_data_aggregator_event();
 	event->values_in_sample = agg->values_in_sample;
 	event->samples = ab->samples;
 	event->sample_cnt = ab->sample_cnt;
 	event->sensor_state = agg->sensor_state;
 	event->sensor_descr = agg->sensor_descr;
+	event->dropped_cnt = dropped_cnt;
 	APP_EVENT_SUBMIT(event);
 }
 
-static int enqueue_sample(struct aggregator *agg, struct sensor_event *event)
+static int enqueue_sample(struct aggregator *agg, const uint8_t *sample)
+{
+	size_t chunk_bytes = sample_bytes(agg);
+	struct aggregator_buffer *to_send = NULL;
+	uint32_t dropped_cnt = 0;
+	int err = 0;
+
+	k_spinlock_key_t key = k_spin_lock(&agg_lock);
+	struct aggregator_buffer *ab = agg->active_buf;
+
+	if (!ab || agg->claimed) {
+		agg->dropped_cnt++;
+		err = -ENOMEM;
+	} else if (free_samples(agg, ab) == 0) {
+		__ASSERT_NO_MSG(false);
+		agg->dropped_cnt++;
+		err = -ENOMEM;
+	} else {
+		memcpy(&ab->samples[ab->sample_cnt * agg->values_in_sample], sample, chunk_bytes);
+		ab->sample_cnt++;
+
+		if (free_samples(agg, ab) == 0) {
+			to_send = detach_active_buffer(agg, &dropped_cnt);
+		}
+	}
+
+	k_spin_unlock(&agg_lock, key);
+
+	send_buffer(agg, to_send, dropped_cnt);
+
+	return err;
+}
+
+static int enqueue_samples(struct aggregator *agg, struct sensor_event *event)
 {
-	size_t chunk_bytes = agg->values_in_sample * sizeof(struct sensor_value);
+	size_t chunk_bytes = sample_bytes(agg);
+	int err = 0;
 
-	if ((event->dyndata.size) != chunk_bytes) {
+	/* A sensor event may carry multiple samples read from the sensor FIFO. */
+	if ((event->dyndata.size == 0) || ((event->dyndata.size % chunk_bytes) != 0)) {
 		return -EBADMSG;
 	}
-	if (!agg->active_buf) {
-		return -ENOMEM;
+
+	for (size_t offset = 0; offset < event->dyndata.size; offset += chunk_bytes) {
+		int ret = enqueue_sample(agg, &event->dyndata.data[offset]);
+
+		if (ret) {
+			err = ret;
+		}
+	}
+
+	return err;
+}
+
+struct sensor_value *sensor_data_aggregator_claim(const char *sensor_descr, size_t *sample_cnt)
+{
+	struct aggregator *agg = get_aggregator(sensor_descr);
+	struct sensor_value *slot = NULL;
+
+	__ASSERT_NO_MSG(sample_cnt);
+
+	if (!agg) {
+		*sample_cnt = 0;
+		return NULL;
 	}
 
+	k_spinlock_key_t key = k_spin_lock(&agg_lock);
 	struct aggregator_buffer *ab = agg->active_buf;
-	size_t pos_values = ab->sample_cnt * agg->values_in_sample;
-	size_t avail_bytes = agg->buf_len - pos_values * sizeof(struct sensor_value);
 
-	if (avail_bytes < chunk_bytes) {
-		__ASSERT_NO_MSG(false);
-		return -ENOMEM;
+	__ASSERT(!agg->claimed, "Only one claim at a time is allowed");
+
+	if (ab) {
+		*sample_cnt = MIN(*sample_cnt, free_samples(agg, ab));
+		slot = &ab->samples[ab->sample_cnt * agg->values_in_sample];
+		agg->claimed = true;
+	} else {
+		*sample_cnt = 0;
 	}
-	memcpy(&ab->samples[pos_values], (uint8_t *)event->dyndata.data, chunk_bytes);
-	ab->sample_cnt++;
-	avail_bytes -= chunk_bytes;
 
-	if (avail_bytes < chunk_bytes) {
-		send_buffer(agg, ab);
-		agg->active_buf = get_free_buffer(agg);
+	k_spin_unlock(&agg_lock, key);
+
+	return slot;
+}
+
+int sensor_data_aggregator_commit(const char *sensor_descr, size_t sample_cnt)
+{
+	struct aggregator *agg = get_aggregator(sensor_descr);
+	struct aggregator_buffer *to_send = NULL;
+	uint32_t dropped_cnt = 0;
+
+	if (!agg) {
+		return -ENOENT;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&agg_lock);
+	struct aggregator_buffer *ab = agg->active_buf;
+
+	__ASSERT_NO_MSG(agg->claimed);
+	__ASSERT_NO_MSG(ab && (sample_cnt <= free_samples(agg, ab)));
+
+	ab->sample_cnt += sample_cnt;
+	agg->claimed = false;
+
+	if (agg->send_pending || (free_samples(agg, ab) == 0)) {
+		agg->send_pending = false;
+		to_send = detach_active_buffer(agg, &dropped_cnt);
 	}
 
+	k_spin_unlock(&agg_lock, key);
+
+	send_buffer(agg, to_send, dropped_cnt);
+
 	return 0;
 }
 
+void sensor_data_aggregator_drop(const char *sensor_descr, size_t sample_cnt)
+{
+	struct aggregator *agg = get_aggregator(sensor_descr);
+
+	if (agg) {
+		k_spinlock_key_t key = k_spin_lock(&agg_lock);
+
+		agg->dropped_cnt += sample_cnt;
+		k_spin_unlock(&agg_lock, key);
+	}
+}
+
+int sensor_data_aggregator_sample_size_get(const char *sensor_descr)
+{
+	const struct aggregator *agg = get_aggregator(sensor_descr);
+
+	return agg ? agg->values_in_sample : -ENOENT;
+}
+
 static bool event_handler(const struct app_event_header *aeh)
 {
 	if (is_sensor_event(aeh)) {
@@ -167,7 +311,7 @@ static bool event_handler(const struct app_event_header *aeh)
 		struct aggregator *agg = get_aggregator(event->descr);
 
 		if (agg) {
-			int err = enqueue_sample(agg, event);
+			int err = enqueue_samples(agg, event);
 
 			if (err) {
 				LOG_ERR("Error code: %d", err);
@@ -186,6 +330,8 @@ static bool event_handler(const struct app_event_header *aeh)
 
 		__ASSERT_NO_MSG(agg);
 
+		k_spinlock_key_t key = k_spin_lock(&agg_lock);
+
 		for (size_t i = 0; i < agg->buf_count; i++) {
 			if (agg->agg_buffers[i].samples == event->samples) {
 				release_buffer(agg, &agg->agg_buffers[i]);
@@ -193,6 +339,8 @@ static bool event_handler(const struct app_event_header *aeh)
 			}
 		}
 
+		k_spin_unlock(&agg_lock, key);
+
 		return false;
 	}
 
@@ -201,11 +349,21 @@ static bool event_handler(const struct app_event_header *aeh)
 		struct aggregator *agg = get_aggregator(event->descr);
 
 		if (agg) {
-			struct aggregator_buffer *ab = agg->active_buf;
+			struct aggregator_buffer *to_send = NULL;
+			uint32_t dropped_cnt = 0;
+			k_spinlock_key_t key = k_spin_lock(&agg_lock);
 
 			agg->sensor_state = event->state;
-			send_buffer(agg, ab);
-			agg->active_buf = get_free_buffer(agg);
+			if (agg->claimed) {
+				/* Buffer is being written, it will be sent on commit. */
+				agg->send_pending = true;
+			} else {
+				to_send = detach_active_buffer(agg, &dropped_cnt);
+			}
+
+			k_spin_unlock(&agg_lock, key);
+
+			send_buffer(agg, to_send, dropped_cnt);
 		}
 
 		return false;
@@ -10,6 +10,7 @@
 
 #include <caf/events/sensor_event.h>
 #include <caf/sensor_manager.h>
+#include <caf/sensor_data_aggregator.h>
 
 #include CONFIG_CAF_SENSOR_MANAGER_DEF_PATH
 
@@ -31,9 +32,14 @@ struct sensor_data {
 	atomic_t state;
 	unsigned int sleep_cntd;
 	atomic_t event_cnt;
+	bool aggregated;
+	atomic_t fifo_ready;
+	int64_t last_sample_us;
+	struct sm_bus_stats bus_stats;
 };
 
 static struct sensor_data sensor_data[ARRAY_SIZE(sensor_configs)];
+static struct k_spinlock bus_stats_lock;
 
 static K_THREAD_STACK_DEFINE(sample_thread_stack, SAMPLE_THREAD_STACK_SIZE);
 static struct k_thread sample_thread;
@@ -53,12 +59,14 @@ static void update_sensor_state(const struct sm_sensor_config *sc, struct sensor
 }
 
 static void send_sensor_event(const char *descr, const struct sensor_value *data, const size_t data_cnt,
-			      atomic_t *event_cnt)
+			      int64_t timestamp_us, uint32_t sample_period_us, atomic_t *event_cnt)
 {
 	struct sensor_event *event = new_sensor_event(sizeof(struct sensor_value) * data_cnt);
 	struct sensor_value *data_ptr = sensor_event_get_data_ptr(event);
 
 	event->descr = descr;
+	event->timestamp_us = timestamp_us;
+	event->sample_period_us = sample_period_us;
 
 	__ASSERT_NO_MSG(sensor_event_get_data_cnt(event) == data_cnt);
 	memcpy(data_ptr, data, sizeof(struct sensor_value) * data_cnt);
@@ -105,6 +113,20 @@ static size_t get_sensor_data_cnt(const struct sm_sensor_config *sc)
 	return data_cnt;
 }
 
+static size_t get_batch_size(const struct sm_sensor_config *sc)
+{
+	if (IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_BATCH) && sc->batch) {
+		return sc->batch->sample_cnt;
+	}
+
+	return 1;
+}
+
+static bool is_fifo_triggered(const struct sm_sensor_config *sc)
+{
+	return IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_BATCH) && sc->batch && sc->batch->watermark;
+}
+
 static void reset_sensor_sleep_cnt(const struct sm_sensor_config *sc,
 				   struct sensor_data *sd)
 {
@@ -168,6 +190,7 @@ static bool is_sensor_active(const struct sensor_data *sd)
 static void sensor_wake_up_post(const struct sm_sensor_config *sc, struct sensor_data *sd)
 {
 	sd->sample_timeout = k_uptime_get();
+	sd->last_sample_us = 0;
 	if (sc->trigger) {
 		reset_sensor_sleep_cnt(sc, sd);
 	}
@@ -200,6 +223,14 @@ static void trigger_handler(const struct device *dev, const struct sensor_trigge
 	k_sem_give(&can_sample);
 }
 
+static void fifo_trigger_handler(const struct device *dev, const struct sensor_trigger *trigger)
+{
+	struct sensor_data *sd = get_sensor_data(dev);
+
+	atomic_set(&sd->fifo_ready, true);
+	k_sem_give(&can_sample);
+}
+
 static void enter_sleep(const struct sm_sensor_config *sc,
 			struct sensor_data *sd)
 {
@@ -215,12 +246,9 @@ static void enter_sleep(const struct sm_sensor_config *sc,
 	k_sched_unlock();
 }
 
-static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config *sc)
+static int fetch_sensor_data(const struct sm_sensor_config *sc, struct sensor_value *data)
 {
 	size_t data_idx = 0;
-	size_t data_cnt = get_sensor_data_cnt(sc);
-	struct sensor_value data[data_cnt];
-
 	int err = sensor_sample_fetch(sc->dev);
 
 	for (size_t i = 0; !err && (i < sc->chan_cnt); i++) {
@@ -230,26 +258,113 @@ static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config
 		data_idx += sampled_chan->data_cnt;
 	}
 
+	return err;
+}
+
+static void update_bus_stats(struct sensor_data *sd, size_t sample_cnt, uint32_t time_us)
+{
+	k_spinlock_key_t key = k_spin_lock(&bus_stats_lock);
+	struct sm_bus_stats *stats = &sd->bus_stats;
+
+	stats->read_cnt++;
+	stats->sample_cnt += sample_cnt;
+	stats->total_us += time_us;
+	stats->max_us = MAX(stats->max_us, time_us);
+
+	k_spin_unlock(&bus_stats_lock, key);
+}
+
+static void interpolate_timestamps(struct sensor_data *sd, size_t sample_cnt, int64_t now_us,
+				   int64_t *first_us, uint32_t *period_us)
+{
+	/* Samples are assumed to be evenly spread between the last sample
+	 * read on the previous wake up and the time of the current wake up.
+	 */
+	if ((sd->last_sample_us > 0) && (now_us > sd->last_sample_us)) {
+		*period_us = (now_us - sd->last_sample_us) / sample_cnt;
+	} else {
+		*period_us = sd->sampling_period * USEC_PER_MSEC;
+	}
+
+	*first_us = now_us - (int64_t)(*period_us) * (sample_cnt - 1);
+	sd->last_sample_us = now_us;
+}
+
+static struct sensor_value *get_sample_ptr(struct sensor_value *slot, size_t slot_cnt,
+					   struct sensor_value *local_data, size_t data_cnt,
+					   size_t idx)
+{
+	return ((idx < slot_cnt) ? slot : local_data) + (idx * data_cnt);
+}
+
+static void sample_sensor(struct sensor_data *sd, const struct sm_sensor_config *sc)
+{
+	size_t data_cnt = get_sensor_data_cnt(sc);
+	size_t sample_cnt = get_batch_size(sc);
+	struct sensor_value local_data[data_cnt * sample_cnt];
+	struct sensor_value *slot = NULL;
+	size_t slot_cnt = 0;
+	int64_t timestamp_us = k_ticks_to_us_floor64(k_uptime_ticks());
+	uint32_t start = k_cycle_get_32();
+	int err = 0;
+
+	if (IS_ENABLED(CONFIG_CAF_SENSOR_DATA_AGGREGATOR_DIRECT) && sd->aggregated) {
+		slot_cnt = sample_cnt;
+		slot = sensor_data_aggregator_claim(sc->event_descr, &slot_cnt);
+
+		/* Fetch the samples directly into the aggregator buffer. Samples that do
+		 * not fit into the buffer are still read to drain the sensor FIFO.
+		 */
+		if (!slot) {
+			slot_cnt = 0;
+		}
+	}
+
+	for (size_t i = 0; !err && (i < sample_cnt); i++) {
+		err = fetch_sensor_data(sc, get_sample_ptr(slot, slot_cnt, local_data, data_cnt, i));
+	}
+
+	if (IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_BUS_STATS)) {
+		update_bus_stats(sd, sample_cnt, k_cyc_to_us_floor32(k_cycle_get_32() - start));
+	}
+
 	if (err) {
 		LOG_ERR("Sensor sampling error (err %d)", err);
 		update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
 	} else {
-		if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
-			send_sensor_event(sc->event_descr, data, ARRAY_SIZE(data),
-					  &sd->event_cnt);
+		uint32_t period_us;
+
+		interpolate_timestamps(sd, sample_cnt, timestamp_us, &timestamp_us, &period_us);
+
+		if (IS_ENABLED(CONFIG_CAF_SENSOR_DATA_AGGREGATOR_DIRECT) && sd->aggregated) {
+			if (slot_cnt < sample_cnt) {
+				sensor_data_aggregator_drop(sc->event_descr, sample_cnt - slot_cnt);
+			}
+		} else if (atomic_get(&sd->event_cnt) < sc->active_events_limit) {
+			send_sensor_event(sc->event_descr, local_data, data_cnt * sample_cnt,
+					  timestamp_us, period_us, &sd->event_cnt);
 		} else {
 			LOG_WRN("Did not send event due to too many active events on sensor: %s",
 				sc->dev->name);
 		}
 
 		if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
-			process_sensor_activity(sc, sd, data);
+			for (size_t i = 0; i < sample_cnt; i++) {
+				process_sensor_activity(sc, sd, get_sample_ptr(slot, slot_cnt,
+									       local_data, data_cnt,
+									       i));
+			}
+
 			if (!is_sensor_active(sd)) {
 				enter_sleep(sc, sd);
 			}
 
 		}
 	}
+
+	if (slot) {
+		(void)sensor_data_aggregator_commit(sc->event_descr, err ? 0 : slot_cnt);
+	}
 }
 
 static size_t sample_sensors(int64_t *next_timeout)
@@ -264,24 +379,33 @@ static size_t sample_sensors(int64_t *next_timeout)
 		const struct sm_sensor_config *sc = &sensor_configs[i];
 
 		if (atomic_get(&sd->state) == SENSOR_STATE_ACTIVE) {
-			if (sd->sample_timeout <= cur_uptime) {
-				sample_sensor(sd, sc);
-			}
+			if (is_fifo_triggered(sc)) {
+				if (atomic_cas(&sd->fifo_ready, true, false)) {
+					sample_sensor(sd, sc);
+				}
+			} else {
+				int period = sd->sampling_period * get_batch_size(sc);
 
-			int drops = -1;
-			while (sd->sample_timeout <= cur_uptime) {
-				sd->sample_timeout += sd->sampling_period;
-				drops++;
-			}
+				if (sd->sample_timeout <= cur_uptime) {
+					sample_sensor(sd, sc);
+				}
 
-			if (drops > 0) {
-				LOG_WRN("%d sample dropped", drops);
+				int drops = -1;
+				while (sd->sample_timeout <= cur_uptime) {
+					sd->sample_timeout += period;
+					drops++;
+				}
+
+				if (drops > 0) {
+					LOG_WRN("%d sample dropped", drops);
+				}
 			}
 		}
 
 		if (atomic_get(&sd->state) != SENSOR_STATE_ERROR) {
 			alive_sensors++;
-			if (atomic_get(&sd->state) == SENSOR_STATE_ACTIVE) {
+			if ((atomic_get(&sd->state) == SENSOR_STATE_ACTIVE) &&
+			    !is_fifo_triggered(sc)) {
 				if (*next_timeout > sd->sample_timeout) {
 					*next_timeout = sd->sample_timeout;
 				}
@@ -387,8 +511,20 @@ static size_t sensor_init(void)
 			LOG_ERR("%s sensor not ready", sc->dev->name);
 			continue;
 		}
+		__ASSERT(!IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_BATCH) || !sc->batch ||
+			 (sc->batch->sample_cnt > 0), "Invalid batch configuration");
+
 		sd->sampling_period = sc->sampling_period_ms;
-		sd->sample_timeout = cur_uptime + sc->sampling_period_ms;
+		sd->sample_timeout = cur_uptime + sc->sampling_period_ms * get_batch_size(sc);
+
+		if (IS_ENABLED(CONFIG_CAF_SENSOR_DATA_AGGREGATOR_DIRECT)) {
+			int sample_size = sensor_data_aggregator_sample_size_get(sc->event_descr);
+
+			sd->aggregated = (sample_size == get_sensor_data_cnt(sc));
+			if ((sample_size >= 0) && !sd->aggregated) {
+				LOG_ERR("%s aggregator sample size mismatch", sc->dev->name);
+			}
+		}
 
 		if (sc->trigger && IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_PM)) {
 			int err = sensor_trigger_init(sc, sd);
@@ -400,6 +536,18 @@ static size_t sensor_init(void)
 			}
 		}
 
+		if (is_fifo_triggered(sc)) {
+			int err = sensor_trigger_set(sc->dev, sc->batch->watermark,
+						     fifo_trigger_handler);
+
+			if (err) {
+				update_sensor_state(sc, sd, SENSOR_STATE_ERROR);
+				LOG_ERR("%s sensor cannot set FIFO trigger (err:%d)",
+					sc->dev->name, err);
+				continue;
+			}
+		}
+
 		update_sensor_state(sc, sd, SENSOR_STATE_ACTIVE);
 		alive_sensors++;
 	}
@@ -535,7 +683,8 @@ static bool handle_set_sensor_period_event(const struct app_event_header *aeh)
 			struct sensor_data *sd = &sensor_data[i];
 
 			sd->sampling_period = event->sampling_period;
-			sd->sample_timeout = k_uptime_get() + event->sampling_period;
+			sd->sample_timeout = k_uptime_get() +
+					     event->sampling_period * get_batch_size(sc);
 			if (sd->state == SENSOR_STATE_ACTIVE) {
 				k_sem_give(&can_sample);
 			}
@@ -547,6 +696,23 @@ static bool handle_set_sensor_period_event(const struct app_event_header *aeh)
 	return false;
 }
 
+int sensor_manager_bus_stats_get(const char *event_descr, struct sm_bus_stats *stats)
+{
+	__ASSERT_NO_MSG(IS_ENABLED(CONFIG_CAF_SENSOR_MANAGER_BUS_STATS));
+
+	for (size_t i = 0; i < ARRAY_SIZE(sensor_configs); i++) {
+		if (!strcmp(event_descr, sensor_configs[i].event_descr)) {
+			k_spinlock_key_t key = k_spin_lock(&bus_stats_lock);
+
+			*stats = sensor_data[i].bus_stats;
+			k_spin_unlock(&bus_stats_lock, key);
+			return 0;
+		}
+	}
+
+	return -ENOENT;
+}
+
 static bool app_event_handler(const struct app_event_header *aeh)
 {
 	if (is_module_state_event(aeh)) {
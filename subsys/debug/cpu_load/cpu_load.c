@@ -250,6 +250,7 @@ uint32_t cpu_load_get(void)
 	return (uint32_t)load;
 }
 
+#if defined(CONFIG_CPU_LOAD_CMDS)
 static int cmd_cpu_load_get(const struct shell *shell, size_t argc, char **argv)
 {
 	uint32_t load;
@@ -286,14 +287,11 @@ static int cmd_cpu_load_reset(const struct shell *shell,
 	return 0;
 }
 
-SHELL_STATIC_SUBCMD_SET_CREATE(sub_cmd_cpu_load,
-	SHELL_CMD_ARG(get, NULL, "Get load", cmd_cpu_load_get, 1, 0),
-	SHELL_CMD_ARG(reset, NULL, "Reset measurement",
-			cmd_cpu_load_reset, 1, 0),
-	SHELL_CMD_ARG(init, NULL, "Init",
-			cmd_cpu_load_reset, 1, 0),
-	SHELL_SUBCMD_SET_END
-);
-
-SHELL_COND_CMD_ARG_REGISTER(CONFIG_CPU_LOAD_CMDS, cpu_load, &sub_cmd_cpu_load,
-			"CPU load", cmd_cpu_load_get, 1, 1);
+SHELL_SUBCMD_SET_CREATE(sub_cmd_cpu_load, (cpu_load));
+SHELL_SUBCMD_ADD((cpu_load), get, NULL, "Get load", cmd_cpu_load_get, 1, 0);
+SHELL_SUBCMD_ADD((cpu_load), reset, NULL, "Reset measurement",
+		 cmd_cpu_load_reset, 1, 0);
+SHELL_SUBCMD_ADD((cpu_load), init, NULL, "Init", cmd_cpu_load_reset, 1, 0);
+
+SHELL_CMD_ARG_REGISTER(cpu_load, &sub_cmd_cpu_load, "CPU load", cmd_cpu_load_get, 1, 1);
+#endif /* CONFIG_CPU_LOAD_CMDS */
@@ -0,0 +1,558 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/tracing/tracing.h>
+#include <debug/cpu_load.h>
+#ifdef CONFIG_CPU_CORTEX_M
+#include <cmsis_core.h>
+#endif
+
+#define MAX_THREADS	CONFIG_CPU_LOAD_PROFILER_MAX_THREADS
+#define SAMPLE_INTERVAL	CONFIG_CPU_LOAD_PROFILER_SAMPLE_INTERVAL_MS
+#define WINDOW_SAMPLES	CONFIG_CPU_LOAD_PROFILER_WINDOW_SAMPLES
+
+/* Deeper ISR nesting is charged to the innermost tracked ISR. */
+#define ISR_NEST_MAX	8
+
+#ifdef CONFIG_THREAD_NAME
+#define NAME_LEN	CONFIG_THREAD_MAX_NAME_LEN
+#else
+#define NAME_LEN	1
+#endif
+
+/* On Cortex-M, ISRs are told apart by the active exception number. Exceptions
+ * below the first external interrupt share the last entry.
+ */
+#ifdef CONFIG_CPU_CORTEX_M
+#define ISR_CNT		(CONFIG_NUM_IRQS + 1)
+#else
+#define ISR_CNT		1
+#endif
+
+/* Busy time of a context, in cycles of the cycle source. */
+struct ctx {
+	uint64_t busy;
+	uint32_t max_run;
+	bool idle;
+};
+
+struct thread_ctx {
+	struct ctx ctx;
+	const struct k_thread *thread;
+	char name[NAME_LEN];
+};
+
+/* The last entry collects the threads above the limit and the aborted ones. */
+static struct thread_ctx threads[MAX_THREADS + 1];
+static struct ctx isrs[ISR_CNT];
+
+#define OTHER_CTX (&threads[MAX_THREADS].ctx)
+
+/* State below is updated from the tracing hooks, which are called with
+ * interrupts locked. Other accesses lock interrupts as well.
+ */
+static struct ctx *cur;
+static uint32_t last_cyc;
+static uint32_t run_start;
+static uint32_t burst_start;
+static uint32_t max_burst;
+static uint64_t slot_busy;
+
+static struct ctx *isr_stack[ISR_NEST_MAX];
+static uint8_t isr_depth;
+/* Nesting levels beyond ISR_NEST_MAX, charged to the innermost tracked ISR. */
+static uint32_t isr_untracked;
+
+static int64_t reset_ticks;
+static int64_t slot_start_ticks;
+
+/* Sliding window of load samples in percent and its histogram. */
+static uint8_t window[WINDOW_SAMPLES];
+static uint16_t window_hist[101];
+static uint32_t window_cnt;
+static uint32_t window_head;
+
+static void sample_fn(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(sample_work, sample_fn);
+
+static inline uint32_t cycles_get(void)
+{
+#ifdef CONFIG_CPU_LOAD_PROFILER_CYCLE_SOURCE_DWT
+	return DWT->CYCCNT;
+#else
+	return k_cycle_get_32();
+#endif
+}
+
+static uint64_t cyc_to_us(uint64_t cycles)
+{
+#ifdef CONFIG_CPU_LOAD_PROFILER_CYCLE_SOURCE_DWT
+	return cycles * USEC_PER_SEC / SystemCoreClock;
+#else
+	return k_cyc_to_us_floor64(cycles);
+#endif
+}
+
+static void charge(uint32_t now)
+{
+	uint32_t delta = now - last_cyc;
+
+	last_cyc = now;
+
+	if (!cur) {
+		return;
+	}
+
+	cur->busy += delta;
+	if (!cur->idle) {
+		slot_busy += delta;
+	}
+}
+
+static void burst_end(uint32_t now)
+{
+	max_burst = MAX(max_burst, now - burst_start);
+}
+
+static void ctx_switch(struct ctx *next)
+{
+	uint32_t now = cycles_get();
+
+	charge(now);
+
+	if (cur) {
+		cur->max_run = MAX(cur->max_run, now - run_start);
+
+		if (cur->idle && !next->idle) {
+			burst_start = now;
+		} else if (!cur->idle && next->idle) {
+			burst_end(now);
+		}
+	} else {
+		burst_start = now;
+	}
+
+	cur = next;
+	run_start = now;
+}
+
+static void thread_name_copy(struct thread_ctx *tc, struct k_thread *thread)
+{
+	const char *name = k_thread_name_get(thread);
+
+	if (name) {
+		strncpy(tc->name, name, sizeof(tc->name) - 1);
+		tc->name[sizeof(tc->name) - 1] = '\0';
+	} else {
+		tc->name[0] = '\0';
+	}
+}
+
+static struct thread_ctx *thread_ctx_find(const struct k_thread *thread)
+{
+	for (size_t i = 0; i < MAX_THREADS; i++) {
+		if (threads[i].thread == thread) {
+			return &threads[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct ctx *thread_ctx_get(struct k_thread *thread)
+{
+	struct thread_ctx *tc = thread_ctx_find(thread);
+
+	if (tc) {
+		return &tc->ctx;
+	}
+
+	tc = thread_ctx_find(NULL);
+	if (!tc) {
+		return OTHER_CTX;
+	}
+
+	memset(&tc->ctx, 0, sizeof(tc->ctx));
+	tc->thread = thread;
+	thread_name_copy(tc, thread);
+
+	return &tc->ctx;
+}
+
+static struct ctx *isr_ctx_get(void)
+{
+#ifdef CONFIG_CPU_CORTEX_M
+	uint32_t ipsr = __get_IPSR();
+
+	if ((ipsr >= 16) && (ipsr - 16 < CONFIG_NUM_IRQS)) {
+		return &isrs[ipsr - 16];
+	}
+#endif
+	return &isrs[ISR_CNT - 1];
+}
+
+void sys_trace_thread_switched_in_user(void)
+{
+	struct ctx *next = thread_ctx_get(k_current_get());
+
+	if (isr_depth > 0) {
+		/* Switch requested from an ISR, the thread runs after the ISR returns. */
+		isr_stack[0] = next;
+		return;
+	}
+
+	ctx_switch(next);
+}
+
+void sys_trace_isr_enter_user(int nested_interrupts)
+{
+	ARG_UNUSED(nested_interrupts);
+
+	if (isr_depth < ISR_NEST_MAX) {
+		isr_stack[isr_depth] = cur;
+		isr_depth++;
+		ctx_switch(isr_ctx_get());
+	} else {
+		isr_untracked++;
+	}
+}
+
+void sys_trace_isr_exit_user(int nested_interrupts)
+{
+	ARG_UNUSED(nested_interrupts);
+
+	/* The exit of an untracked level must not pop a tracked one. */
+	if (isr_untracked > 0) {
+		isr_untracked--;
+		return;
+	}
+
+	if (isr_depth > 0) {
+		isr_depth--;
+		if (isr_stack[isr_depth]) {
+			ctx_switch(isr_stack[isr_depth]);
+		}
+	}
+}
+
+void sys_trace_idle_user(void)
+{
+	uint32_t now;
+
+	if (!cur || cur->idle || (isr_depth > 0)) {
+		return;
+	}
+
+	/* The idle thread is recognized the first time it goes to sleep. */
+	now = cycles_get();
+	charge(now);
+	burst_end(now);
+	cur->idle = true;
+}
+
+void sys_trace_thread_abort_user(struct k_thread *thread)
+{
+	struct thread_ctx *tc = thread_ctx_find(thread);
+
+	if (!tc) {
+		return;
+	}
+
+	if (cur == &tc->ctx) {
+		charge(cycles_get());
+		cur = OTHER_CTX;
+	}
+
+	for (size_t i = 0; i < isr_depth; i++) {
+		if (isr_stack[i] == &tc->ctx) {
+			isr_stack[i] = OTHER_CTX;
+		}
+	}
+
+	OTHER_CTX->busy += tc->ctx.busy;
+	OTHER_CTX->max_run = MAX(OTHER_CTX->max_run, tc->ctx.max_run);
+	tc->thread = NULL;
+}
+
+void sys_trace_thread_name_set_user(struct k_thread *thread)
+{
+	struct thread_ctx *tc = thread_ctx_find(thread);
+
+	if (tc) {
+		thread_name_copy(tc, thread);
+	}
+}
+
+static void window_add(uint8_t load)
+{
+	if (window_cnt == WINDOW_SAMPLES) {
+		window_hist[window[window_head]]--;
+	} else {
+		window_cnt++;
+	}
+
+	window[window_head] = load;
+	window_hist[load]++;
+	window_head = (window_head + 1) % WINDOW_SAMPLES;
+}
+
+static void sample_fn(struct k_work *work)
+{
+	int64_t now_ticks = k_uptime_ticks();
+	uint64_t elapsed_us;
+	uint64_t busy_us;
+	unsigned int key;
+
+	key = irq_lock();
+	charge(cycles_get());
+	busy_us = cyc_to_us(slot_busy);
+	elapsed_us = k_ticks_to_us_floor64(now_ticks - slot_start_ticks);
+	slot_busy = 0;
+	slot_start_ticks = now_ticks;
+
+	if (elapsed_us > 0) {
+		window_add(MIN(busy_us * 100 / elapsed_us, 100));
+	}
+	irq_unlock(key);
+
+	(void)k_work_schedule(k_work_delayable_from_work(work), K_MSEC(SAMPLE_INTERVAL));
+}
+
+static uint8_t window_percentile(uint32_t permille)
+{
+	uint32_t target = DIV_ROUND_UP(window_cnt * permille, 1000);
+	uint32_t sum = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(window_hist); i++) {
+		sum += window_hist[i];
+		if ((sum > 0) && (sum >= target)) {
+			return i;
+		}
+	}
+
+	return 0;
+}
+
+void cpu_load_profiler_window_get(struct cpu_load_profiler_window *w)
+{
+	unsigned int key = irq_lock();
+	uint32_t burst = max_burst;
+
+	if (cur && !cur->idle) {
+		burst = MAX(burst, cycles_get() - burst_start);
+	}
+
+	w->samples = window_cnt;
+	w->p50 = window_percentile(500);
+	w->p90 = window_percentile(900);
+	w->p99 = window_percentile(990);
+	w->max = window_percentile(1000);
+	irq_unlock(key);
+
+	w->max_burst_us = cyc_to_us(burst);
+}
+
+/* Copy of a context, including the run that is in progress. */
+static struct ctx ctx_snapshot(const struct ctx *ctx, uint32_t now)
+{
+	struct ctx copy = *ctx;
+
+	if (ctx == cur) {
+		copy.max_run = MAX(copy.max_run, now - run_start);
+	}
+
+	return copy;
+}
+
+static void ctx_report(const struct ctx *ctx, const struct k_thread *thread, const char *name,
+		       bool isr, cpu_load_profiler_ctx_cb cb, void *user_data)
+{
+	struct cpu_load_profiler_ctx info = {
+		.thread = thread,
+		.name = name,
+		.isr = isr,
+		.idle = ctx->idle,
+		.busy_us = cyc_to_us(ctx->busy),
+		.max_run_us = cyc_to_us(ctx->max_run),
+	};
+
+	cb(&info, user_data);
+}
+
+void cpu_load_profiler_ctx_foreach(cpu_load_profiler_ctx_cb cb, void *user_data)
+{
+	const struct k_thread *thread;
+	/* Large enough for a thread name, an IRQ name and a pointer printed with "%p". */
+	char name[MAX(MAX(NAME_LEN, sizeof("irq 65535")), sizeof("0x") + 2 * sizeof(void *))];
+	unsigned int key;
+	struct ctx ctx;
+
+	for (size_t i = 0; i < ARRAY_SIZE(threads); i++) {
+		key = irq_lock();
+		charge(cycles_get());
+		ctx = ctx_snapshot(&threads[i].ctx, last_cyc);
+		thread = threads[i].thread;
+		strcpy(name, threads[i].name);
+		irq_unlock(key);
+
+		if (i == MAX_THREADS) {
+			if (ctx.busy > 0) {
+				ctx_report(&ctx, NULL, "other", false, cb, user_data);
+			}
+			continue;
+		}
+
+		if (!thread) {
+			continue;
+		}
+
+		if (name[0] == '\0') {
+			snprintf(name, sizeof(name), "%p", (void *)thread);
+		}
+
+		ctx_report(&ctx, thread, name, false, cb, user_data);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(isrs); i++) {
+		key = irq_lock();
+		charge(cycles_get());
+		ctx = ctx_snapshot(&isrs[i], last_cyc);
+		irq_unlock(key);
+
+		if (ctx.busy == 0) {
+			continue;
+		}
+
+		if (i == ISR_CNT - 1) {
+			strcpy(name, "isr");
+		} else {
+			snprintf(name, sizeof(name), "irq %u", (unsigned int)i);
+		}
+
+		ctx_report(&ctx, NULL, name, true, cb, user_data);
+	}
+}
+
+void cpu_load_profiler_reset(void)
+{
+	unsigned int key = irq_lock();
+	uint32_t now = cycles_get();
+
+	charge(now);
+
+	for (size_t i = 0; i < ARRAY_SIZE(threads); i++) {
+		threads[i].ctx.busy = 0;
+		threads[i].ctx.max_run = 0;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(isrs); i++) {
+		isrs[i].busy = 0;
+		isrs[i].max_run = 0;
+	}
+
+	memset(window, 0, sizeof(window));
+	memset(window_hist, 0, sizeof(window_hist));
+	window_cnt = 0;
+	window_head = 0;
+
+	run_start = now;
+	burst_start = now;
+	max_burst = 0;
+	slot_busy = 0;
+	reset_ticks = k_uptime_ticks();
+	slot_start_ticks = reset_ticks;
+	irq_unlock(key);
+}
+
+static int cpu_load_profiler_init(void)
+{
+#ifdef CONFIG_CPU_LOAD_PROFILER_CYCLE_SOURCE_DWT
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	cpu_load_profiler_reset();
+	(void)k_work_schedule(&sample_work, K_MSEC(SAMPLE_INTERVAL));
+
+	return 0;
+}
+
+SYS_INIT(cpu_load_profiler_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#if defined(CONFIG_CPU_LOAD_PROFILER_CMDS)
+struct stats_print_ctx {
+	const struct shell *shell;
+	uint64_t elapsed_us;
+};
+
+static void ctx_print(const struct cpu_load_profiler_ctx *ctx, void *user_data)
+{
+	struct stats_print_ctx *print_ctx = user_data;
+	uint32_t load = (uint32_t)MIN(ctx->busy_us * 100000 / MAX(print_ctx->elapsed_us, 1),
+				      100000);
+
+	shell_print(print_ctx->shell, "%-24s %3d,%03d%% %12llu %10u%s", ctx->name,
+		    load / 1000, load % 1000, (unsigned long long)ctx->busy_us, ctx->max_run_us,
+		    ctx->idle ? " (idle)" : "");
+}
+
+static int cmd_stats_show(const struct shell *shell, size_t argc, char **argv)
+{
+	struct cpu_load_profiler_window w;
+	struct stats_print_ctx print_ctx = {
+		.shell = shell,
+		.elapsed_us = k_ticks_to_us_floor64(k_uptime_ticks() - reset_ticks),
+	};
+
+	cpu_load_profiler_window_get(&w);
+
+	shell_print(shell, "Window of %u samples: p50:%u%% p90:%u%% p99:%u%% max:%u%%",
+		    w.samples, w.p50, w.p90, w.p99, w.max);
+	shell_print(shell, "Longest busy burst: %u us", w.max_burst_us);
+
+#if defined(CONFIG_CPU_LOAD)
+	if (cpu_load_init() == 0) {
+		uint32_t load = cpu_load_get();
+
+		shell_print(shell, "Sleep timer load: %d,%03d%%", load / 1000, load % 1000);
+	}
+#endif
+
+	shell_print(shell, "%-24s %9s %12s %10s", "Context", "Load", "Busy [us]", "Run [us]");
+	cpu_load_profiler_ctx_foreach(ctx_print, &print_ctx);
+
+	return 0;
+}
+
+static int cmd_stats_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	cpu_load_profiler_reset();
+	shell_print(shell, "CPU load profiler reset");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_stats,
+	SHELL_CMD_ARG(show, NULL, "Show per-context load and load distribution",
+		      cmd_stats_show, 1, 0),
+	SHELL_CMD_ARG(reset, NULL, "Reset profiler statistics", cmd_stats_reset, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+#if !defined(CONFIG_CPU_LOAD_CMDS)
+SHELL_SUBCMD_SET_CREATE(sub_cmd_cpu_load, (cpu_load));
+SHELL_CMD_REGISTER(cpu_load, &sub_cmd_cpu_load, "CPU load", NULL);
+#endif
+
+SHELL_SUBCMD_ADD((cpu_load), stats, &sub_stats, "CPU load profiler statistics",
+		 cmd_stats_show, 1, 0);
+#endif /* CONFIG_CPU_LOAD_PROFILER_CMDS */
@@ -6,6 +6,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
+#include <zephyr/sys/byteorder.h>
 #include <app_event_manager.h>
 #include <event_manager_proxy.h>
 #include <zephyr/logging/log.h>
@@ -16,6 +17,12 @@ LOG_MODULE_REGISTER(event_manager_proxy, CONFIG_APP_EVENT_MANAGER_LOG_LEVEL);
 
 #define EMP_BIND_TIMEOUT K_MSEC(CONFIG_EVENT_MANAGER_PROXY_BIND_TIMEOUT_MS)
 
+#define EMP_BATCH_FLUSH_DELAY K_USEC(CONFIG_EVENT_MANAGER_PROXY_BATCH_FLUSH_DELAY_US)
+#define EMP_BATCH_SEND_TIMEOUT K_MSEC(CONFIG_EVENT_MANAGER_PROXY_BATCH_SEND_TIMEOUT_MS)
+#define EMP_BATCH_REC_HDR_SIZE sizeof(uint32_t)
+#define EMP_BATCH_BACKOFF_MIN_US 10
+#define EMP_BATCH_BACKOFF_MAX_US 1000
+
 /* Helpers - allow linker to get information about these structure sizes. */
 static struct event_type _emp_event_type_size_check
 	__used __attribute__((__section__("event_manager_proxy_event_type_size")));
@@ -51,6 +58,26 @@ struct emp_cmd_subscribe {
 	char name[];
 };
 
+#ifdef CONFIG_EVENT_MANAGER_PROXY_BATCHING
+/**
+ * @brief Batch of events waiting to be sent to a remote in a single IPC message.
+ *
+ * Every event in the batch is preceded by a 32-bit length and padded to a 32-bit boundary.
+ */
+struct emp_batch {
+	struct k_mutex lock;
+	struct k_work_delayable flush_work;
+	uint8_t *buf;
+	size_t size;
+	size_t len;
+	bool nocopy;
+	bool nocopy_unsupported;
+	uint32_t backoff_us;
+	uint32_t dropped;
+	uint32_t local_buf[CONFIG_EVENT_MANAGER_PROXY_BATCH_SIZE / sizeof(uint32_t)];
+};
+#endif
+
 /** @brief Inter-core communication data. */
 struct emp_ipc_data {
 	struct ipc_ept ept;
@@ -59,6 +86,9 @@ struct emp_ipc_data {
 	bool started;
 	struct k_event bound;
 	const struct event_type **event_type_map;
+#ifdef CONFIG_EVENT_MANAGER_PROXY_BATCHING
+	struct emp_batch batch;
+#endif
 };
 
 
@@ -92,25 +122,6 @@ static struct emp_ipc_data *find_ipc_by_instance(const struct device *instance)
 	return NULL;
 }
 
-/**
- * @brief Find event type by name.
- *
- * @param name The name of the event.
- *
- * @retval NULL    Cannot find event.
- * @retval pointer Pointer to the event type structure.
- */
-static struct event_type *find_event_by_name(const char *name)
-{
-	STRUCT_SECTION_FOREACH(event_type, et) {
-		if (!strcmp(et->name, name)) {
-			return et;
-		}
-	}
-
-	return NULL;
-}
-
 /**
  * @brief Get event type position index on the event type array.
  *
@@ -159,6 +170,25 @@ static void handle_remote_event(struct emp_ipc_data *ipc, const void *data, size
 	_event_submit(event);
 }
 
+static void handle_remote_batch(struct emp_ipc_data *ipc, const uint8_t *data, size_t len)
+{
+	while (len >= EMP_BATCH_REC_HDR_SIZE) {
+		uint32_t rec_len = sys_get_le32(data);
+		size_t rec_size = ROUND_UP(EMP_BATCH_REC_HDR_SIZE + rec_len, sizeof(uint32_t));
+
+		if ((rec_len < sizeof(struct app_event_header)) || (rec_size > len)) {
+			LOG_ERR("Malformed event batch record: %" PRIu32, rec_len);
+			__ASSERT_NO_MSG(false);
+			return;
+		}
+
+		handle_remote_event(ipc, data + EMP_BATCH_REC_HDR_SIZE, rec_len);
+
+		data += rec_size;
+		len -= rec_size;
+	}
+}
+
 static void handle_remote_command_subscribe(struct emp_ipc_data *ipc, const void *data, size_t len)
 {
 	if (ipc->started) {
@@ -176,7 +206,7 @@ static void handle_remote_command_subscribe(struct emp_ipc_data *ipc, const void
 		return;
 	}
 
-	struct event_type *et = find_event_by_name(cmd->name);
+	const struct event_type *et = app_event_manager_event_type_find(cmd->name);
 
 	if (!et) {
 		LOG_ERR("Cannot register event: %s", cmd->name);
@@ -256,7 +286,11 @@ static void handle_ipc_data_receive(const void *data, size_t len, void *priv)
 	__ASSERT_NO_MSG(!k_is_in_isr());
 
 	if (ipc->started && emp_started) {
-		handle_remote_event(ipc, data, len);
+		if (IS_ENABLED(CONFIG_EVENT_MANAGER_PROXY_BATCHING)) {
+			handle_remote_batch(ipc, data, len);
+		} else {
+			handle_remote_event(ipc, data, len);
+		}
 	} else {
 		handle_remote_command(ipc, data, len);
 	}
@@ -274,6 +308,212 @@ static void handle_ipc_endpoint_error(const char *message, void *priv)
 	__ASSERT_NO_MSG(false);
 }
 
+#ifdef CONFIG_EVENT_MANAGER_PROXY_BATCHING
+/**
+ * @brief Get a buffer for a new batch.
+ *
+ * The buffer is taken directly from the IPC backend if it supports the no-copy API.
+ * Otherwise, the local batch buffer is used.
+ *
+ * @note Must be called with the batch lock held.
+ *
+ * @param ipc      Element of the @ref emp_ipc_data array.
+ * @param min_size Minimum size of the new batch buffer.
+ *
+ * @retval 0     The batch buffer is available.
+ * @retval other No TX buffer of at least @p min_size is available in the IPC backend.
+ */
+static int batch_open(struct emp_ipc_data *ipc, size_t min_size)
+{
+	struct emp_batch *batch = &ipc->batch;
+
+	if (batch->buf) {
+		return 0;
+	}
+
+	if (!batch->nocopy_unsupported) {
+		void *buf;
+		uint32_t size = sizeof(batch->local_buf);
+		int ret = ipc_service_get_tx_buffer(&ipc->ept, &buf, &size, K_NO_WAIT);
+
+		if (ret == -ENOMEM) {
+			/* Requested size too big, size holds the maximum available one. */
+			ret = ipc_service_get_tx_buffer(&ipc->ept, &buf, &size, K_NO_WAIT);
+		}
+
+		if (!ret && (size < min_size)) {
+			/* The buffer cannot hold the event, wait for the remote to free a bigger one. */
+			ret = ipc_service_drop_tx_buffer(&ipc->ept, buf);
+			if (ret) {
+				LOG_ERR("Cannot drop TX buffer on ipc %zu, err: %d", ipc2idx(ipc), ret);
+			}
+
+			return -ENOMEM;
+		}
+
+		if (!ret) {
+			batch->buf = buf;
+			batch->size = MIN(size, sizeof(batch->local_buf));
+			batch->nocopy = true;
+			return 0;
+		}
+
+		if ((ret != -ENOTSUP) && (ret != -EIO)) {
+			return ret;
+		}
+
+		LOG_DBG("No-copy TX not supported on ipc %zu", ipc2idx(ipc));
+		batch->nocopy_unsupported = true;
+	}
+
+	batch->buf = (uint8_t *)batch->local_buf;
+	batch->size = sizeof(batch->local_buf);
+	batch->nocopy = false;
+
+	return 0;
+}
+
+/**
+ * @brief Send the pending batch to the remote.
+ *
+ * On failure, the batch is kept and can be sent again later.
+ *
+ * @note Must be called with the batch lock held.
+ *
+ * @param ipc Element of the @ref emp_ipc_data array.
+ *
+ * @retval 0     The batch was sent or there was nothing to send.
+ * @retval other Error code returned by the IPC service.
+ */
+static int batch_flush(struct emp_ipc_data *ipc)
+{
+	struct emp_batch *batch = &ipc->batch;
+	int ret;
+
+	if (batch->len == 0) {
+		return 0;
+	}
+
+	if (batch->nocopy) {
+		ret = ipc_service_send_nocopy(&ipc->ept, batch->buf, batch->len);
+	} else {
+		ret = ipc_service_send(&ipc->ept, batch->buf, batch->len);
+	}
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	batch->buf = NULL;
+	batch->len = 0;
+	batch->backoff_us = EMP_BATCH_BACKOFF_MIN_US;
+
+	return 0;
+}
+
+/* Must be called with the batch lock held. */
+static void batch_backoff_update(struct emp_batch *batch)
+{
+	batch->backoff_us = MIN(2 * batch->backoff_us, EMP_BATCH_BACKOFF_MAX_US);
+}
+
+static void batch_flush_work_fn(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct emp_batch *batch = CONTAINER_OF(dwork, struct emp_batch, flush_work);
+	struct emp_ipc_data *ipc = CONTAINER_OF(batch, struct emp_ipc_data, batch);
+
+	k_mutex_lock(&batch->lock, K_FOREVER);
+
+	if (batch_flush(ipc) < 0) {
+		/* The remote did not consume the previous messages yet, try again later. */
+		k_work_reschedule(&batch->flush_work, K_USEC(batch->backoff_us));
+		batch_backoff_update(batch);
+	}
+
+	k_mutex_unlock(&batch->lock);
+}
+
+static int send_event_to_remote(struct emp_ipc_data *ipc, const struct app_event_header *eh)
+{
+	const struct event_type *remote_ev = ipc->event_type_map[et2idx(eh->type_id)];
+	struct emp_batch *batch = &ipc->batch;
+	k_timepoint_t timeout;
+	int ret;
+
+	if (remote_ev == NULL) {
+		return 0;
+	}
+
+	size_t size = app_event_manager_event_size(eh);
+	size_t rec_size = ROUND_UP(EMP_BATCH_REC_HDR_SIZE + size, sizeof(uint32_t));
+
+	if (rec_size > sizeof(batch->local_buf)) {
+		LOG_ERR("Event %s too big for a batch: %zu", eh->type_id->name, size);
+		__ASSERT_NO_MSG(false);
+		return -EMSGSIZE;
+	}
+
+	timeout = sys_timepoint_calc(EMP_BATCH_SEND_TIMEOUT);
+
+	k_mutex_lock(&batch->lock, K_FOREVER);
+
+	/* Apply backpressure if the remote does not keep up with the events. */
+	while (true) {
+		ret = batch_open(ipc, rec_size);
+		if (!ret) {
+			if ((batch->size - batch->len) >= rec_size) {
+				break;
+			}
+
+			ret = batch_flush(ipc);
+			if (!ret) {
+				continue;
+			}
+		}
+
+		if (sys_timepoint_expired(timeout)) {
+			batch->dropped++;
+			LOG_ERR("Cannot send event to remote %p, err: %d, dropped: %" PRIu32,
+				ipc, ret, batch->dropped);
+			k_mutex_unlock(&batch->lock);
+			return ret;
+		}
+
+		uint32_t backoff_us = batch->backoff_us;
+
+		batch_backoff_update(batch);
+		k_mutex_unlock(&batch->lock);
+		k_sleep(K_USEC(backoff_us));
+		k_mutex_lock(&batch->lock, K_FOREVER);
+	}
+
+	uint8_t *rec = &batch->buf[batch->len];
+
+	sys_put_le32(size, rec);
+	memcpy(rec + EMP_BATCH_REC_HDR_SIZE, eh, size);
+	memcpy(rec + EMP_BATCH_REC_HDR_SIZE + offsetof(struct app_event_header, type_id),
+	       &remote_ev, sizeof(remote_ev));
+	batch->len += rec_size;
+
+	if ((batch->size - batch->len) < (EMP_BATCH_REC_HDR_SIZE + sizeof(*eh))) {
+		/* No space for another event. */
+		ret = batch_flush(ipc);
+		if (ret < 0) {
+			k_work_reschedule(&batch->flush_work, K_USEC(batch->backoff_us));
+		} else {
+			k_work_cancel_delayable(&batch->flush_work);
+		}
+	} else if (batch->len == rec_size) {
+		/* First event in the batch. */
+		k_work_schedule(&batch->flush_work, EMP_BATCH_FLUSH_DELAY);
+	}
+
+	k_mutex_unlock(&batch->lock);
+
+	return 0;
+}
+#else
 static int send_event_to_remote(struct emp_ipc_data *ipc, const struct app_event_header *eh)
 {
 	const struct event_type *remote_ev = ipc->event_type_map[et2idx(eh->type_id)];
@@ -305,6 +545,7 @@ static int send_event_to_remote(struct emp_ipc_data *ipc, const struct app_event
 
 	return ret;
 }
+#endif /* CONFIG_EVENT_MANAGER_PROXY_BATCHING */
 
 static void event_manager_proxy_on_event_process(const struct app_event_header *eh)
 {
@@ -356,6 +597,14 @@ static int add_ipc_instace(struct emp_ipc_data *ipc, const struct device *instan
 
 	k_event_init(&ipc->bound);
 
+#ifdef CONFIG_EVENT_MANAGER_PROXY_BATCHING
+	k_mutex_init(&ipc->batch.lock);
+	k_work_init_delayable(&ipc->batch.flush_work, batch_flush_work_fn);
+	ipc->batch.buf = NULL;
+	ipc->batch.len = 0;
+	ipc->batch.backoff_us = EMP_BATCH_BACKOFF_MIN_US;
+#endif
+
 	ret = ipc_service_register_endpoint(instance, &ipc->ept, &ipc->ept_cfg);
 	if (ret) {
 		LOG_ERR("Error registering endpoint in ipc service (%d)", ret);
@@ -3,8 +3,11 @@
  *
  * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
  */
+#include <errno.h>
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <nfc/ndef/msg_parser.h>
 #include "msg_parser_local.h"
 
 LOG_MODULE_REGISTER(nfc_ndef_parser, CONFIG_NFC_NDEF_PARSER_LOG_LEVEL);
@@ -35,6 +38,87 @@ int nfc_ndef_msg_parse(uint8_t *result_buf,
 	return err;
 }
 
+void nfc_ndef_msg_iter_init(struct nfc_ndef_msg_iter *iter,
+			    const uint8_t *raw_data,
+			    uint32_t raw_data_len)
+{
+	__ASSERT_NO_MSG(iter);
+
+	memset(iter, 0, sizeof(*iter));
+
+	iter->data = raw_data;
+	iter->len = raw_data_len;
+}
+
+void nfc_ndef_msg_iter_extend(struct nfc_ndef_msg_iter *iter,
+			      uint32_t raw_data_len)
+{
+	__ASSERT_NO_MSG(iter);
+	__ASSERT_NO_MSG(raw_data_len >= iter->len);
+
+	iter->len = raw_data_len;
+}
+
+static int record_sequence_check(const struct nfc_ndef_msg_iter *iter,
+				 const struct nfc_ndef_record_view *view)
+{
+	bool message_begin = (view->location & NDEF_FIRST_RECORD) != 0;
+	bool message_end = (view->location & NDEF_LAST_RECORD) != 0;
+
+	/* Only the first record has the Message Begin flag set. */
+	if (message_begin != (iter->record_count == 0)) {
+		return -EFAULT;
+	}
+
+	/* Chunked payload ends with a record without the CF flag
+	 * in the same message. See NFCForum-TS-NDEF_1.0
+	 */
+	if (view->chunk && message_end) {
+		return -EFAULT;
+	}
+
+	if (iter->in_chunk) {
+		if ((view->tnf != TNF_UNCHANGED) || (view->type_length > 0) ||
+		    (view->id_length > 0)) {
+			return -EFAULT;
+		}
+	} else if (view->tnf == TNF_UNCHANGED) {
+		return -EFAULT;
+	}
+
+	return 0;
+}
+
+int nfc_ndef_msg_iter_next(struct nfc_ndef_msg_iter *iter,
+			   struct nfc_ndef_record_view *view)
+{
+	__ASSERT_NO_MSG(iter);
+	__ASSERT_NO_MSG(view);
+
+	int err;
+	uint32_t rec_len = iter->len - iter->offset;
+
+	if (iter->done) {
+		return -ENODATA;
+	}
+
+	err = nfc_ndef_record_view_parse(view, iter->data + iter->offset, &rec_len);
+	if (err) {
+		return err;
+	}
+
+	err = record_sequence_check(iter, view);
+	if (err) {
+		return err;
+	}
+
+	iter->offset += rec_len;
+	iter->record_count++;
+	iter->in_chunk = view->chunk;
+	iter->done = (view->location & NDEF_LAST_RECORD) != 0;
+
+	return 0;
+}
 
 void nfc_ndef_msg_printout(const struct nfc_ndef_msg_desc *msg_desc)
 {
@@ -19,47 +19,43 @@ LOG_MODULE_DECLARE(nfc_ndef_parser, CONFIG_NFC_NDEF_PARSER_LOG_LEVEL);
 #define NDEF_RECORD_BASE_SHORT_LEN (2 + NDEF_RECORD_PAYLOAD_LEN_SHORT_SIZE)
 
 
-int nfc_ndef_record_parse(struct nfc_ndef_bin_payload_desc *bin_pay_desc,
-			  struct nfc_ndef_record_desc *rec_desc,
-			  enum nfc_ndef_record_location *record_location,
-			  const uint8_t *nfc_data,
-			  uint32_t *nfc_data_len)
+int nfc_ndef_record_view_parse(struct nfc_ndef_record_view *view,
+			       const uint8_t *nfc_data,
+			       uint32_t *nfc_data_len)
 {
 	uint32_t expected_rec_size = NDEF_RECORD_BASE_SHORT_LEN;
 
 	if (expected_rec_size > *nfc_data_len) {
-		return -EINVAL;
+		return -EAGAIN;
 	}
 
-	rec_desc->tnf = (enum nfc_ndef_record_tnf) ((*nfc_data) & NDEF_RECORD_TNF_MASK);
+	uint8_t flags = *(nfc_data++);
+
+	view->tnf = (enum nfc_ndef_record_tnf) (flags & NDEF_RECORD_TNF_MASK);
 
 	/* An NDEF parser that receives an NDEF record with an unknown
 	 * or unsupported TNF field value
 	 * SHOULD treat it as Unknown. See NFCForum-TS-NDEF_1.0
 	 */
-	if (rec_desc->tnf == TNF_RESERVED) {
-		rec_desc->tnf = TNF_UNKNOWN_TYPE;
+	if (view->tnf == TNF_RESERVED) {
+		view->tnf = TNF_UNKNOWN_TYPE;
 	}
 
-	*record_location = (enum nfc_ndef_record_location) ((*nfc_data) & NDEF_RECORD_LOCATION_MASK);
-
-	uint8_t flags = *(nfc_data++);
-
-	rec_desc->type_length = *(nfc_data++);
-
-	uint32_t payload_length;
+	view->location = (enum nfc_ndef_record_location) (flags & NDEF_RECORD_LOCATION_MASK);
+	view->chunk = (flags & NDEF_RECORD_CF_MASK) != 0;
+	view->type_length = *(nfc_data++);
 
 	if (flags & NDEF_RECORD_SR_MASK) {
-		payload_length = *(nfc_data++);
+		view->payload_length = *(nfc_data++);
 	} else {
 		expected_rec_size +=
 			NDEF_RECORD_PAYLOAD_LEN_LONG_SIZE - NDEF_RECORD_PAYLOAD_LEN_SHORT_SIZE;
 
 		if (expected_rec_size > *nfc_data_len) {
-			return -EINVAL;
+			return -EAGAIN;
 		}
 
-		payload_length = sys_get_be32(nfc_data);
+		view->payload_length = sys_get_be32(nfc_data);
 		nfc_data += NDEF_RECORD_PAYLOAD_LEN_LONG_SIZE;
 	}
 
@@ -67,46 +63,65 @@ int nfc_ndef_record_parse(struct nfc_ndef_bin_payload_desc *bin_pay_desc,
 		expected_rec_size += NDEF_RECORD_ID_LEN_SIZE;
 
 		if (expected_rec_size > *nfc_data_len) {
-			return -EINVAL;
+			return -EAGAIN;
 		}
 
-		rec_desc->id_length = *(nfc_data++);
+		view->id_length = *(nfc_data++);
 	} else {
-		rec_desc->id_length = 0;
-		rec_desc->id        = NULL;
+		view->id_length = 0;
 	}
 
-	expected_rec_size += rec_desc->type_length + rec_desc->id_length + payload_length;
+	expected_rec_size += view->type_length + view->id_length;
 
-	if (expected_rec_size > *nfc_data_len) {
-		return -EINVAL;
+	/* Compare the payload length separately, as it can be close to UINT32_MAX. */
+	if ((expected_rec_size > *nfc_data_len) ||
+	    (view->payload_length > *nfc_data_len - expected_rec_size)) {
+		return -EAGAIN;
 	}
 
-	if (rec_desc->type_length > 0) {
-		rec_desc->type = nfc_data;
-		nfc_data += rec_desc->type_length;
-	} else {
-		rec_desc->type = NULL;
-	}
+	expected_rec_size += view->payload_length;
 
-	if (rec_desc->id_length > 0) {
-		rec_desc->id = nfc_data;
-		nfc_data += rec_desc->id_length;
-	}
+	view->type = (view->type_length > 0) ? nfc_data : NULL;
+	nfc_data += view->type_length;
 
-	if (payload_length == 0) {
-		bin_pay_desc->payload = NULL;
-	} else {
-		bin_pay_desc->payload = nfc_data;
+	view->id = (view->id_length > 0) ? nfc_data : NULL;
+	nfc_data += view->id_length;
+
+	view->payload = (view->payload_length > 0) ? nfc_data : NULL;
+
+	*nfc_data_len = expected_rec_size;
+
+	return 0;
+}
+
+int nfc_ndef_record_parse(struct nfc_ndef_bin_payload_desc *bin_pay_desc,
+			  struct nfc_ndef_record_desc *rec_desc,
+			  enum nfc_ndef_record_location *record_location,
+			  const uint8_t *nfc_data,
+			  uint32_t *nfc_data_len)
+{
+	int err;
+	struct nfc_ndef_record_view view;
+
+	err = nfc_ndef_record_view_parse(&view, nfc_data, nfc_data_len);
+	if (err) {
+		return -EINVAL;
 	}
 
-	bin_pay_desc->payload_length = payload_length;
+	*record_location = view.location;
+
+	rec_desc->tnf = view.tnf;
+	rec_desc->type_length = view.type_length;
+	rec_desc->type = view.type;
+	rec_desc->id_length = view.id_length;
+	rec_desc->id = view.id;
+
+	bin_pay_desc->payload = view.payload;
+	bin_pay_desc->payload_length = view.payload_length;
 
 	rec_desc->payload_descriptor = bin_pay_desc;
 	rec_desc->payload_constructor  = (payload_constructor_t) nfc_ndef_bin_payload_memcopy;
 
-	*nfc_data_len = expected_rec_size;
-
 	return 0;
 }
 
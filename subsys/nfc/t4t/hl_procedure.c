@@ -13,6 +13,9 @@
 #include <nfc/t4t/apdu.h>
 #include <nfc/t4t/hl_procedure.h>
 #include <nfc/t4t/isodep.h>
+#if defined(CONFIG_NFC_T4T_HL_PROCEDURE_NDEF_VALIDATE)
+#include <nfc/ndef/msg_parser.h>
+#endif
 
 LOG_MODULE_REGISTER(nfc_t4t_hl_procedure,
 		    CONFIG_NFC_T4T_HL_PROCEDURE_LOG_LEVEL);
@@ -24,7 +27,10 @@ LOG_MODULE_REGISTER(nfc_t4t_hl_procedure,
 #define CC_MIN_RAPDU_SIZE 0x0F
 #define CC_RAPDU_MAX_SIZE_OFFSET 0x03
 #define NFC_T4T_APDU_SELECT_DATA {0xD2, 0x76, 0x00, 0x00, 0x85, 0x01, 0x01}
-#define APDU_LE_MAP_2_MAX_VALUE 0xFF
+#define CAPDU_HEADER_SIZE 4
+#define CAPDU_LC_SHORT_SIZE 1
+#define CAPDU_LC_LONG_SIZE 3
+#define CAPDU_LC_SHORT_MAX_VALUE 0xFF
 #define NFC_T4T_APDU_RSP_ALL 256
 
 enum nfc_t4t_hl_transaction_type {
@@ -43,6 +49,9 @@ struct t4t_hl_ndef {
 	uint16_t buff_size;
 	uint16_t nlen;
 	uint8_t file_id[FILE_ID_SIZE];
+#if defined(CONFIG_NFC_T4T_HL_PROCEDURE_NDEF_VALIDATE)
+	struct nfc_ndef_msg_iter msg_iter;
+#endif
 };
 
 struct t4t_hl_cc {
@@ -63,6 +72,32 @@ struct t4t_hl_procedure {
 static struct t4t_hl_procedure t4t_hl;
 static const struct nfc_t4t_hl_procedure_cb *hl_cb;
 
+BUILD_ASSERT(CONFIG_NFC_T4T_HL_PROCEDURE_APDU_BUF_SIZE > CAPDU_HEADER_SIZE + CAPDU_LC_SHORT_SIZE,
+	     "APDU buffer too small for an UPDATE BINARY command");
+
+/* Maximum data size of an UPDATE BINARY command that fits in the APDU buffer and
+ * in the MLc limit of the tag. Longer data needs the extended Lc field.
+ */
+static uint16_t capdu_data_max_len(void)
+{
+	size_t space = sizeof(t4t_hl.apdu_buff) - CAPDU_HEADER_SIZE;
+	size_t max_len;
+
+	if (space > (CAPDU_LC_LONG_SIZE + CAPDU_LC_SHORT_MAX_VALUE)) {
+		max_len = MIN(space - CAPDU_LC_LONG_SIZE, UINT16_MAX);
+	} else {
+		max_len = MIN(space - CAPDU_LC_SHORT_SIZE, CAPDU_LC_SHORT_MAX_VALUE);
+	}
+
+	return MIN(max_len, t4t_hl.ndef.cc->max_capdu_size);
+}
+
+/* Maximum data size of a READ BINARY response within the MLe limit of the tag. */
+static uint16_t rapdu_data_max_len(void)
+{
+	return MIN(CONFIG_NFC_T4T_HL_PROCEDURE_RAPDU_MAX_SIZE, t4t_hl.ndef.cc->max_rapdu_size);
+}
+
 static int t4t_hl_data_exchange(struct nfc_t4t_apdu_comm *comm)
 {
 	int err;
@@ -141,9 +176,52 @@ static int on_ndef_nlen_read(const struct nfc_t4t_apdu_resp *resp)
 
 	t4t_hl.ndef.nlen = sys_get_be16(data);
 
+#if defined(CONFIG_NFC_T4T_HL_PROCEDURE_NDEF_VALIDATE)
+	nfc_ndef_msg_iter_init(&t4t_hl.ndef.msg_iter,
+			       t4t_hl.ndef.buff + NDEF_FILE_NLEN_SIZE, 0);
+#endif
+
 	return 0;
 }
 
+#if defined(CONFIG_NFC_T4T_HL_PROCEDURE_NDEF_VALIDATE)
+static int ndef_msg_validate(void)
+{
+	int err;
+	struct nfc_ndef_record_view view;
+	uint32_t msg_len = MIN(t4t_hl.file_offset - NDEF_FILE_NLEN_SIZE, t4t_hl.ndef.nlen);
+
+	if (t4t_hl.ndef.nlen == 0) {
+		return 0;
+	}
+
+	nfc_ndef_msg_iter_extend(&t4t_hl.ndef.msg_iter, msg_len);
+
+	/* Check the records that are complete in the data read so far. */
+	do {
+		err = nfc_ndef_msg_iter_next(&t4t_hl.ndef.msg_iter, &view);
+	} while (!err);
+
+	switch (err) {
+	case -ENODATA:
+		return 0;
+
+	case -EAGAIN:
+		/* Wait for the next chunk, unless the NDEF file ended. */
+		if (msg_len < t4t_hl.ndef.nlen) {
+			return 0;
+		}
+
+		LOG_ERR("NDEF message truncated.");
+		return -EINVAL;
+
+	default:
+		LOG_ERR("Invalid NDEF record %u.", t4t_hl.ndef.msg_iter.record_count);
+		return err;
+	}
+}
+#endif /* CONFIG_NFC_T4T_HL_PROCEDURE_NDEF_VALIDATE */
+
 static int t4t_file_assign(uint16_t id)
 {
 	struct nfc_t4t_tlv_block_file file;
@@ -156,15 +234,31 @@ static int t4t_file_assign(uint16_t id)
 	return nfc_t4t_cc_file_content_set(t4t_hl.ndef.cc, &file, id);
 }
 
+static int ndef_file_chunk_read_request(void)
+{
+	struct nfc_t4t_apdu_comm apdu_comm;
+	uint32_t file_len = t4t_hl.ndef.nlen + NDEF_FILE_NLEN_SIZE;
+
+	nfc_t4t_apdu_comm_clear(&apdu_comm);
+
+	apdu_comm.instruction = NFC_T4T_APDU_COMM_INS_READ;
+	apdu_comm.parameter = t4t_hl.file_offset;
+	apdu_comm.resp_len = MIN(file_len - t4t_hl.file_offset, rapdu_data_max_len());
+
+	t4t_hl.transaction_type = NFC_T4T_HL_NDEF_READ;
+
+	return t4t_hl_data_exchange(&apdu_comm);
+}
+
 static int ndef_file_chunk_read(const struct nfc_t4t_apdu_resp *resp)
 {
 	__ASSERT_NO_MSG(resp);
 
 	int err;
 	uint16_t file_id;
-	struct nfc_t4t_apdu_comm apdu_comm;
 	const uint8_t *data = resp->data.buff;
 	uint16_t len = resp->data.len;
+	bool last_chunk;
 
 	if (t4t_hl.ndef.buff_size < t4t_hl.file_offset + len) {
 		return -ENOMEM;
@@ -174,17 +268,17 @@ static int ndef_file_chunk_read(const struct nfc_t4t_apdu_resp *resp)
 
 	t4t_hl.file_offset += len;
 
-	if (t4t_hl.file_offset < (t4t_hl.ndef.nlen + NDEF_FILE_NLEN_SIZE)) {
-		nfc_t4t_apdu_comm_clear(&apdu_comm);
-
-		apdu_comm.instruction = NFC_T4T_APDU_COMM_INS_READ;
-		apdu_comm.parameter = t4t_hl.file_offset;
-		apdu_comm.resp_len = MIN(t4t_hl.ndef.nlen - (t4t_hl.file_offset - NDEF_FILE_NLEN_SIZE),
-				MIN(APDU_LE_MAP_2_MAX_VALUE, t4t_hl.ndef.cc->max_rapdu_size));
+	last_chunk = (t4t_hl.file_offset >= (t4t_hl.ndef.nlen + NDEF_FILE_NLEN_SIZE));
 
-		t4t_hl.transaction_type = NFC_T4T_HL_NDEF_READ;
+#if defined(CONFIG_NFC_T4T_HL_PROCEDURE_NDEF_VALIDATE)
+	err = ndef_msg_validate();
+	if (err) {
+		return err;
+	}
+#endif
 
-		return t4t_hl_data_exchange(&apdu_comm);
+	if (!last_chunk) {
+		return ndef_file_chunk_read_request();
 	}
 
 	file_id = sys_get_be16(t4t_hl.ndef.file_id);
@@ -215,7 +309,7 @@ static int ndef_file_chunk_update(void)
 		apdu_comm.parameter = t4t_hl.file_offset;
 		apdu_comm.data.buff = t4t_hl.ndef.buff + t4t_hl.file_offset;
 		apdu_comm.data.len = MIN(t4t_hl.ndef.buff_size - t4t_hl.file_offset,
-				MIN(APDU_LE_MAP_2_MAX_VALUE, t4t_hl.ndef.cc->max_capdu_size));
+					 capdu_data_max_len());
 
 		t4t_hl.file_offset += apdu_comm.data.len;
 		t4t_hl.transaction_type = NFC_T4T_HL_NDEF_UPDATE;
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+
+#include "profiler_backend.h"
+#include "file_bottom.h"
+
+#define DATA_FILE_PATH CONFIG_NRF_PROFILER_NORDIC_BACKEND_FILE_PREFIX "_data.bin"
+#define INFO_FILE_PATH CONFIG_NRF_PROFILER_NORDIC_BACKEND_FILE_PREFIX "_info.txt"
+
+static int data_fd = -1;
+static int info_fd = -1;
+
+static int file_init(void)
+{
+	data_fd = nrf_profiler_file_open(DATA_FILE_PATH);
+	info_fd = nrf_profiler_file_open(INFO_FILE_PATH);
+
+	if ((data_fd < 0) || (info_fd < 0)) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int file_write(int fd, const uint8_t *data, size_t len)
+{
+	if (nrf_profiler_file_write(fd, data, len)) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int file_data_write(const uint8_t *data, size_t len)
+{
+	return file_write(data_fd, data, len);
+}
+
+static int file_info_write(const uint8_t *data, size_t len)
+{
+	return file_write(info_fd, data, len);
+}
+
+const struct nrf_profiler_backend nrf_profiler_backend = {
+	.init = file_init,
+	.data_write = file_data_write,
+	.info_write = file_info_write,
+	/* Descriptions are written on each new event type instead. */
+	.command_read = NULL,
+};
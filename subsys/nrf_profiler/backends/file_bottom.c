@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "file_bottom.h"
+
+int nrf_profiler_file_open(const char *path)
+{
+	return open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+int nrf_profiler_file_write(int fd, const void *data, size_t len)
+{
+	const char *pos = data;
+
+	while (len > 0) {
+		ssize_t ret = write(fd, pos, len);
+
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -1;
+		}
+
+		pos += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
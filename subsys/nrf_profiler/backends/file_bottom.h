@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Host side of the nrf_profiler file backend. It is built with the host C
+ * library, so it must not use Zephyr headers.
+ */
+
+#ifndef _NRF_PROFILER_FILE_BOTTOM_H_
+#define _NRF_PROFILER_FILE_BOTTOM_H_
+
+#include <stddef.h>
+
+/* Opens and truncates the file for writing. Returns a file descriptor or -1. */
+int nrf_profiler_file_open(const char *path);
+
+/* Writes the whole data to the file. Returns 0 on success or -1. */
+int nrf_profiler_file_write(int fd, const void *data, size_t len);
+
+#endif /* _NRF_PROFILER_FILE_BOTTOM_H_ */
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _NRF_PROFILER_BACKEND_H_
+#define _NRF_PROFILER_BACKEND_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Transport of the Nordic nrf_profiler, implemented by the
+ *        compile-time selected backend.
+ *
+ * All functions except @c init are called only from the nrf_profiler thread.
+ */
+struct nrf_profiler_backend {
+	/**
+	 * @brief Initialize the backend.
+	 *
+	 * @return 0 If the operation was successful.
+	 *         Otherwise, a (negative) error code is returned.
+	 */
+	int (*init)(void);
+
+	/**
+	 * @brief Write the profiled events.
+	 *
+	 * The data is written in whole or not at all.
+	 *
+	 * @param data Encoded events.
+	 * @param len  Data length.
+	 *
+	 * @return 0 If the operation was successful.
+	 *         -EAGAIN if there is no space for the data at the moment.
+	 *         Otherwise, a (negative) error code is returned.
+	 */
+	int (*data_write)(const uint8_t *data, size_t len);
+
+	/**
+	 * @brief Write the event descriptions.
+	 *
+	 * The data is written in whole or not at all.
+	 *
+	 * @param data Event descriptions.
+	 * @param len  Data length.
+	 *
+	 * @return 0 If the operation was successful.
+	 *         -EAGAIN if there is no space for the data at the moment.
+	 *         Otherwise, a (negative) error code is returned.
+	 */
+	int (*info_write)(const uint8_t *data, size_t len);
+
+	/**
+	 * @brief Read a command from the host.
+	 *
+	 * Set to @c NULL if the backend does not receive commands. The event
+	 * descriptions are then written each time a new event type is registered.
+	 *
+	 * @param command Buffer for the command.
+	 *
+	 * @return 1 If a command was read, 0 if there is no command.
+	 */
+	int (*command_read)(uint8_t *command);
+};
+
+/** The compile-time selected backend. */
+extern const struct nrf_profiler_backend nrf_profiler_backend;
+
+#endif /* _NRF_PROFILER_BACKEND_H_ */
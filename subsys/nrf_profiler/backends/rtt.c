@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <SEGGER_RTT.h>
+
+#include "profiler_backend.h"
+
+static uint8_t buffer_data[CONFIG_NRF_PROFILER_NORDIC_DATA_BUFFER_SIZE];
+static uint8_t buffer_info[CONFIG_NRF_PROFILER_NORDIC_INFO_BUFFER_SIZE];
+static uint8_t buffer_commands[CONFIG_NRF_PROFILER_NORDIC_COMMAND_BUFFER_SIZE];
+
+static int rtt_init(void)
+{
+	int ret;
+
+	ret = SEGGER_RTT_ConfigUpBuffer(
+		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_DATA,
+		"Nordic nrf_profiler data",
+		buffer_data,
+		CONFIG_NRF_PROFILER_NORDIC_DATA_BUFFER_SIZE,
+		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	if (ret < 0) {
+		return -EINVAL;
+	}
+
+	ret = SEGGER_RTT_ConfigUpBuffer(
+		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
+		"Nordic nrf_profiler info",
+		buffer_info,
+		CONFIG_NRF_PROFILER_NORDIC_INFO_BUFFER_SIZE,
+		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	if (ret < 0) {
+		return -EINVAL;
+	}
+
+	ret = SEGGER_RTT_ConfigDownBuffer(
+		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
+		"Nordic nrf_profiler command",
+		buffer_commands,
+		CONFIG_NRF_PROFILER_NORDIC_COMMAND_BUFFER_SIZE,
+		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+	if (ret < 0) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int rtt_write(unsigned int channel, const uint8_t *data, size_t len)
+{
+	/* In the skip mode, the data is written in whole or not at all. */
+	if (SEGGER_RTT_WriteNoLock(channel, data, len) != len) {
+		return -EAGAIN;
+	}
+
+	return 0;
+}
+
+static int rtt_data_write(const uint8_t *data, size_t len)
+{
+	return rtt_write(CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_DATA, data, len);
+}
+
+static int rtt_info_write(const uint8_t *data, size_t len)
+{
+	return rtt_write(CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO, data, len);
+}
+
+static int rtt_command_read(uint8_t *command)
+{
+	return SEGGER_RTT_Read(CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
+			       command, sizeof(*command));
+}
+
+const struct nrf_profiler_backend nrf_profiler_backend = {
+	.init = rtt_init,
+	.data_write = rtt_data_write,
+	.info_write = rtt_info_write,
+	.command_read = rtt_command_read,
+};
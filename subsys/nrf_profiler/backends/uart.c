@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/sys/util.h>
+
+#include "profiler_backend.h"
+
+/* The events and their descriptions share the UART, so both are sent in frames
+ * made of the stream ID, the payload length and up to 255 bytes of payload.
+ */
+#define FRAME_STREAM_DATA 0x01
+#define FRAME_STREAM_INFO 0x02
+#define FRAME_PAYLOAD_MAX_LEN UINT8_MAX
+
+static const struct device *const uart_dev = DEVICE_DT_GET(DT_CHOSEN(ncs_nrf_profiler_uart));
+
+static int uart_init(void)
+{
+	if (!device_is_ready(uart_dev)) {
+		return -ENODEV;
+	}
+
+	return 0;
+}
+
+static int uart_frames_send(uint8_t stream, const uint8_t *data, size_t len)
+{
+	while (len > 0) {
+		uint8_t payload_len = MIN(len, FRAME_PAYLOAD_MAX_LEN);
+
+		uart_poll_out(uart_dev, stream);
+		uart_poll_out(uart_dev, payload_len);
+
+		for (size_t i = 0; i < payload_len; i++) {
+			uart_poll_out(uart_dev, data[i]);
+		}
+
+		data += payload_len;
+		len -= payload_len;
+	}
+
+	return 0;
+}
+
+static int uart_data_write(const uint8_t *data, size_t len)
+{
+	return uart_frames_send(FRAME_STREAM_DATA, data, len);
+}
+
+static int uart_info_write(const uint8_t *data, size_t len)
+{
+	return uart_frames_send(FRAME_STREAM_INFO, data, len);
+}
+
+static int uart_command_read(uint8_t *command)
+{
+	return (uart_poll_in(uart_dev, command) == 0) ? 1 : 0;
+}
+
+const struct nrf_profiler_backend nrf_profiler_backend = {
+	.init = uart_init,
+	.data_write = uart_data_write,
+	.info_write = uart_info_write,
+	.command_read = uart_command_read,
+};
@@ -94,6 +94,22 @@ static int disable_event_profiling(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+static int display_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	struct nrf_profiler_stats stats;
+	int err = nrf_profiler_stats_get(&stats);
+
+	if (err) {
+		shell_error(shell, "Cannot get statistics: %d", err);
+		return err;
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "Events sent: %u\n", stats.events_sent);
+	shell_fprintf(shell, SHELL_NORMAL, "Events dropped: %u\n", stats.events_dropped);
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_nrf_profiler,
 	SHELL_CMD_ARG(list, NULL, "Display list of events",
 			display_registered_events, 0, 0),
@@ -103,6 +119,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_nrf_profiler,
 	SHELL_CMD_ARG(disable, NULL, "Disable profiling of event with given ID",
 			disable_event_profiling, 1,
 			sizeof(_nrf_profiler_event_enabled_bm) * 8),
+	SHELL_CMD_ARG(stats, NULL, "Display number of sent and dropped events",
+			display_stats, 0, 0),
 	SHELL_SUBCMD_SET_END
 );
 SHELL_CMD_REGISTER(nrf_profiler, &sub_nrf_profiler, "Profiler commands", NULL);
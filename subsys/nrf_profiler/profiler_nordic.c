@@ -8,12 +8,12 @@
 #include <zephyr/kernel_structs.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/kernel.h>
-#include <SEGGER_RTT.h>
 #include <nrf_profiler.h>
 #include <string.h>
-#include <nrfx.h>
 
+#include "backends/profiler_backend.h"
 
 enum state {
 	STATE_DISABLED,
@@ -25,10 +25,45 @@ enum state {
 /* By default, when there is no shell, all events are profiled. */
 struct nrf_profiler_event_enabled_bm _nrf_profiler_event_enabled_bm;
 
+#define RING_SIZE CONFIG_NRF_PROFILER_NORDIC_RING_BUFFER_SIZE
+#define RING_MASK (RING_SIZE - 1)
+
+/* Each event in the ring is preceded by a header word with the event length and flags.
+ * Padding fills the end of the ring when the next event does not fit there.
+ */
+#define RECORD_HDR_SIZE sizeof(atomic_t)
+#define RECORD_COMMITTED BIT(31)
+#define RECORD_PADDING BIT(30)
+#define RECORD_LEN_MASK BIT_MASK(30)
+#define RECORD_SIZE(len) (ROUND_UP(len, RECORD_HDR_SIZE) + RECORD_HDR_SIZE)
+
+#define DRAIN_BUF_SIZE MAX(256, CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN)
+#define COMMAND_POLL_INTERVAL K_MSEC(500)
+
+BUILD_ASSERT(IS_POWER_OF_TWO(RING_SIZE), "Ring buffer size must be a power of two");
+BUILD_ASSERT(RING_SIZE >= 2 * RECORD_SIZE(CONFIG_NRF_PROFILER_CUSTOM_EVENT_BUF_LEN),
+	     "Ring buffer too small for the custom event buffer length");
+
+/* Multi-producer, single-consumer ring. Producers reserve space by moving the head
+ * and then commit the event in its header, so that the nrf_profiler thread drains
+ * only complete events. Positions are free-running and wrap around the buffer.
+ */
+struct event_ring {
+	atomic_t head;
+	atomic_t tail;
+	atomic_t dropped;
+	atomic_t buf[RING_SIZE / sizeof(atomic_t)];
+};
+
+static struct event_ring rings[CONFIG_MP_MAX_NUM_CPUS];
+
 static K_SEM_DEFINE(nrf_profiler_sem, 0, 1);
+static K_SEM_DEFINE(drain_sem, 0, 1);
 static atomic_t nrf_profiler_state;
-static uint16_t fatal_error_event_id;
-static struct k_spinlock lock;
+static uint16_t drop_event_id;
+static atomic_t events_sent;
+static uint32_t drops_reported;
+static const struct nrf_profiler_backend *const backend = &nrf_profiler_backend;
 
 enum nordic_command {
 	NORDIC_COMMAND_START	= 1,
@@ -51,12 +86,6 @@ static char *arg_types_encodings[] = {
 
 uint8_t nrf_profiler_num_events;
 
-static uint8_t buffer_data[CONFIG_NRF_PROFILER_NORDIC_DATA_BUFFER_SIZE];
-static uint8_t buffer_info[CONFIG_NRF_PROFILER_NORDIC_INFO_BUFFER_SIZE];
-static uint8_t buffer_commands[CONFIG_NRF_PROFILER_NORDIC_COMMAND_BUFFER_SIZE];
-
-static k_tid_t protocol_thread_id;
-
 static K_THREAD_STACK_DEFINE(nrf_profiler_nordic_stack,
 			     CONFIG_NRF_PROFILER_NORDIC_STACK_SIZE);
 static struct k_thread nrf_profiler_nordic_thread;
@@ -66,22 +95,18 @@ static int send_info_data(const char *data, size_t data_len)
 	uint8_t retry_cnt = 0;
 	static const uint8_t retry_cnt_max = 100;
 
-	size_t num_bytes_send;
+	int err;
 
-	num_bytes_send = SEGGER_RTT_WriteNoLock(
-				  CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-				  data, data_len);
+	err = backend->info_write((const uint8_t *)data, data_len);
 
-	while (num_bytes_send != data_len) {
+	while (err == -EAGAIN) {
 		/* Give host time to read the data and free some space
 		 * in the buffer. */
 		k_sleep(K_MSEC(100));
-		num_bytes_send = SEGGER_RTT_WriteNoLock(
-				  CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-				  data, data_len);
+		err = backend->info_write((const uint8_t *)data, data_len);
 
 		/* Avoid being blocked in while loop if host does not read
-		 * the RTT data.
+		 * the data.
 		 */
 		retry_cnt++;
 		if (retry_cnt > retry_cnt_max) {
@@ -89,7 +114,7 @@ static int send_info_data(const char *data, size_t data_len)
 		}
 	}
 
-	return 0;
+	return err;
 }
 
 static void send_system_description(void)
@@ -99,7 +124,7 @@ static void send_system_description(void)
 	 */
 	uint8_t ne = nrf_profiler_num_events;
 
-	__DMB();
+	barrier_dmem_fence_full();
 	char end_line = '\n';
 	int err = 0;
 
@@ -114,33 +139,219 @@ static void send_system_description(void)
 	}
 }
 
-static void nrf_profiler_nordic_thread_fn(void)
+static struct event_ring *ring_get(void)
 {
-	while (atomic_get(&nrf_profiler_state) != STATE_TERMINATED) {
-		uint8_t read_data;
-		enum nordic_command command;
-
-		if (SEGGER_RTT_Read(
-		     CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
-		     &read_data, sizeof(read_data))) {
-			command = (enum nordic_command)read_data;
-			switch (command) {
-			case NORDIC_COMMAND_START:
-				atomic_cas(&nrf_profiler_state, STATE_INACTIVE, STATE_ACTIVE);
-				break;
-			case NORDIC_COMMAND_STOP:
-				atomic_cas(&nrf_profiler_state, STATE_ACTIVE, STATE_INACTIVE);
-				break;
-			case NORDIC_COMMAND_INFO:
-				send_system_description();
-				break;
-			default:
-				__ASSERT_NO_MSG(false);
+#if defined(CONFIG_SMP)
+	return &rings[arch_curr_cpu()->id];
+#else
+	return &rings[0];
+#endif
+}
+
+static bool ring_put(struct event_ring *ring, const uint8_t *data, size_t len)
+{
+	size_t rec_size = RECORD_SIZE(len);
+	unsigned long head;
+	unsigned long tail;
+	unsigned long used;
+	size_t offset;
+	size_t pad;
+
+	do {
+		/* Read the tail first, so that it cannot pass the head read after it. */
+		tail = (unsigned long)atomic_get(&ring->tail);
+		head = (unsigned long)atomic_get(&ring->head);
+		used = head - tail;
+		offset = head & RING_MASK;
+		pad = (offset + rec_size > RING_SIZE) ? (RING_SIZE - offset) : 0;
+
+		if (used + pad + rec_size > RING_SIZE) {
+			atomic_inc(&ring->dropped);
+			return false;
+		}
+	} while (!atomic_cas(&ring->head, head, head + pad + rec_size));
+
+	if (pad > 0) {
+		atomic_set(&ring->buf[offset / RECORD_HDR_SIZE],
+			   RECORD_COMMITTED | RECORD_PADDING | (pad - RECORD_HDR_SIZE));
+		offset = 0;
+	}
+
+	memcpy(&ring->buf[offset / RECORD_HDR_SIZE + 1], data, len);
+	atomic_set(&ring->buf[offset / RECORD_HDR_SIZE], RECORD_COMMITTED | len);
+
+	/* Wake up the nrf_profiler thread when the ring gets half full. */
+	if ((used < RING_SIZE / 2) && (used + pad + rec_size >= RING_SIZE / 2)) {
+		k_sem_give(&drain_sem);
+	}
+
+	return true;
+}
+
+static void ring_release(struct event_ring *ring, unsigned long tail, unsigned long end)
+{
+	uint8_t *buf = (uint8_t *)ring->buf;
+	size_t start = tail & RING_MASK;
+	size_t len = end - tail;
+	size_t first = MIN(len, RING_SIZE - start);
+
+	/* Clear the headers before the space can be reserved again. */
+	memset(&buf[start], 0, first);
+	memset(buf, 0, len - first);
+
+	atomic_set(&ring->tail, end);
+}
+
+static int ring_drain(struct event_ring *ring)
+{
+	static uint8_t drain_buf[DRAIN_BUF_SIZE];
+	unsigned long tail = (unsigned long)atomic_get(&ring->tail);
+	unsigned long head = (unsigned long)atomic_get(&ring->head);
+
+	while (tail != head) {
+		unsigned long end = tail;
+		size_t batch_len = 0;
+		uint32_t batch_events = 0;
+
+		/* Gather committed events into one backend write. */
+		while (end != head) {
+			atomic_t *hdr = &ring->buf[(end & RING_MASK) / RECORD_HDR_SIZE];
+			atomic_val_t val = atomic_get(hdr);
+			size_t len = val & RECORD_LEN_MASK;
+
+			if (!(val & RECORD_COMMITTED)) {
 				break;
 			}
+
+			if (!(val & RECORD_PADDING)) {
+				if (batch_len + len > sizeof(drain_buf)) {
+					break;
+				}
+
+				memcpy(&drain_buf[batch_len], hdr + 1, len);
+				batch_len += len;
+				batch_events++;
+			}
+
+			end += RECORD_SIZE(len);
+		}
+
+		if (end == tail) {
+			/* The oldest event is still being written. */
+			break;
+		}
+
+		if (batch_len > 0) {
+			int err = backend->data_write(drain_buf, batch_len);
+
+			if (err) {
+				/* Keep the events in the ring until the backend has space. */
+				return err;
+			}
+		}
+
+		ring_release(ring, tail, end);
+		atomic_add(&events_sent, batch_events);
+		tail = end;
+	}
+
+	return 0;
+}
+
+static uint32_t dropped_events_count(void)
+{
+	uint32_t dropped = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(rings); i++) {
+		dropped += (uint32_t)atomic_get(&rings[i].dropped);
+	}
+
+	return dropped;
+}
+
+static void drops_report(void)
+{
+	struct log_event_buf buf;
+	uint32_t dropped = dropped_events_count();
+
+	if (dropped == drops_reported) {
+		return;
+	}
+
+	/* Report the number of events dropped since the last report, after the events
+	 * that were stored before them.
+	 */
+	nrf_profiler_log_start(&buf);
+	nrf_profiler_log_encode_uint32(&buf, dropped - drops_reported);
+	buf.payload_start[0] = (uint8_t)drop_event_id;
+
+	if (!backend->data_write(buf.payload_start, buf.payload - buf.payload_start)) {
+		drops_reported = dropped;
+	}
+}
+
+static void data_drain(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(rings); i++) {
+		if (ring_drain(&rings[i])) {
+			return;
+		}
+	}
+
+	drops_report();
+}
+
+static void command_handle(void)
+{
+	uint8_t read_data;
+	enum nordic_command command;
+
+	while (backend->command_read(&read_data) > 0) {
+		command = (enum nordic_command)read_data;
+		switch (command) {
+		case NORDIC_COMMAND_START:
+			atomic_cas(&nrf_profiler_state, STATE_INACTIVE, STATE_ACTIVE);
+			break;
+		case NORDIC_COMMAND_STOP:
+			atomic_cas(&nrf_profiler_state, STATE_ACTIVE, STATE_INACTIVE);
+			break;
+		case NORDIC_COMMAND_INFO:
+			send_system_description();
+			break;
+		default:
+			__ASSERT_NO_MSG(false);
+			break;
 		}
-		k_sleep(K_MSEC(500));
 	}
+}
+
+static void nrf_profiler_nordic_thread_fn(void)
+{
+	uint8_t described_events = 0;
+
+	while (atomic_get(&nrf_profiler_state) != STATE_TERMINATED) {
+		k_timeout_t timeout = COMMAND_POLL_INTERVAL;
+
+		if (backend->command_read) {
+			command_handle();
+		} else if (described_events != nrf_profiler_num_events) {
+			/* Without host commands, send the descriptions of all event types
+			 * each time a new type is registered. The host uses the last ones.
+			 */
+			described_events = nrf_profiler_num_events;
+			send_system_description();
+		}
+
+		data_drain();
+
+		if (atomic_get(&nrf_profiler_state) == STATE_ACTIVE) {
+			timeout = K_MSEC(CONFIG_NRF_PROFILER_NORDIC_DRAIN_INTERVAL_MS);
+		}
+
+		(void)k_sem_take(&drain_sem, timeout);
+	}
+
+	data_drain();
 	k_sem_give(&nrf_profiler_sem);
 }
 
@@ -166,40 +377,27 @@ int nrf_profiler_init(void)
 
 	int ret;
 
-	ret = SEGGER_RTT_ConfigUpBuffer(
-		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_DATA,
-		"Nordic nrf_profiler data",
-		buffer_data,
-		CONFIG_NRF_PROFILER_NORDIC_DATA_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
-
-	ret = SEGGER_RTT_ConfigUpBuffer(
-		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_INFO,
-		"Nordic nrf_profiler info",
-		buffer_info,
-		CONFIG_NRF_PROFILER_NORDIC_INFO_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
-
-	ret = SEGGER_RTT_ConfigDownBuffer(
-		CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_COMMANDS,
-		"Nordic nrf_profiler command",
-		buffer_commands,
-		CONFIG_NRF_PROFILER_NORDIC_COMMAND_BUFFER_SIZE,
-		SEGGER_RTT_MODE_NO_BLOCK_SKIP);
-	__ASSERT_NO_MSG(ret >= 0);
-
-	protocol_thread_id =  k_thread_create(&nrf_profiler_nordic_thread,
+	ret = backend->init();
+	if (ret) {
+		atomic_set(&nrf_profiler_state, STATE_DISABLED);
+		k_sched_unlock();
+		return ret;
+	}
+
+	k_thread_create(&nrf_profiler_nordic_thread,
 			nrf_profiler_nordic_stack,
 			K_THREAD_STACK_SIZEOF(nrf_profiler_nordic_stack),
 			(k_thread_entry_t) nrf_profiler_nordic_thread_fn,
 			NULL, NULL, NULL,
 			CONFIG_NRF_PROFILER_NORDIC_THREAD_PRIORITY, 0, K_NO_WAIT);
 
-	/* Registering fatal error event */
-	fatal_error_event_id = nrf_profiler_register_event_type("_nrf_profiler_fatal_error_event_",
-							    NULL, NULL, 0);
+	/* Registering the event reporting the number of dropped events */
+	static const char * const drop_event_args[] = {"count"};
+	static const enum nrf_profiler_arg drop_event_arg_types[] = {NRF_PROFILER_ARG_U32};
+
+	drop_event_id = nrf_profiler_register_event_type("_nrf_profiler_dropped_events_",
+							 drop_event_args, drop_event_arg_types,
+							 ARRAY_SIZE(drop_event_args));
 
 	k_sched_unlock();
 	return 0;
@@ -212,10 +410,22 @@ void nrf_profiler_term(void)
 		return;
 	}
 
-	k_wakeup(protocol_thread_id);
+	k_sem_give(&drain_sem);
 	k_sem_take(&nrf_profiler_sem, K_FOREVER);
 }
 
+int nrf_profiler_stats_get(struct nrf_profiler_stats *stats)
+{
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	stats->events_sent = (uint32_t)atomic_get(&events_sent);
+	stats->events_dropped = dropped_events_count();
+
+	return 0;
+}
+
 const char *nrf_profiler_get_event_descr(size_t nrf_profiler_event_id)
 {
 	return descr[nrf_profiler_event_id];
@@ -262,7 +472,7 @@ uint16_t nrf_profiler_register_event_type(const char *name, const char * const *
 	/* Memory barrier to make sure that data is visible
 	 * before being accessed
 	 */
-	__DMB();
+	barrier_dmem_fence_full();
 	nrf_profiler_num_events++;
 	k_sched_unlock();
 
@@ -340,43 +550,14 @@ void nrf_profiler_log_add_mem_address(struct log_event_buf *buf,
 	nrf_profiler_log_encode_uint32(buf, (uint32_t)mem_address);
 }
 
-static bool nrf_profiler_RTT_send(struct log_event_buf *buf, uint8_t type_id)
-{
-	buf->payload_start[0] = type_id;
-	size_t data_len = buf->payload - buf->payload_start;
-
-	size_t num_bytes_send = SEGGER_RTT_WriteNoLock(
-			CONFIG_NRF_PROFILER_NORDIC_RTT_CHANNEL_DATA,
-			buf->payload_start, data_len);
-	return (num_bytes_send == data_len);
-}
-
-static void nrf_profiler_fatal_error(void)
-{
-	struct log_event_buf buf;
-
-	nrf_profiler_log_start(&buf);
-	while (true) {
-		/* Sending Fatal Error event */
-		if (nrf_profiler_RTT_send(&buf, (uint8_t)fatal_error_event_id)) {
-			break;
-		}
-	}
-	k_oops();
-}
-
 void nrf_profiler_log_send(struct log_event_buf *buf, uint16_t event_type_id)
 {
 	__ASSERT_NO_MSG(event_type_id <= UINT8_MAX);
 
 	if (atomic_get(&nrf_profiler_state) == STATE_ACTIVE) {
-		uint8_t type_id = event_type_id & UINT8_MAX;
-
-		k_spinlock_key_t key = k_spin_lock(&lock);
+		buf->payload_start[0] = event_type_id & UINT8_MAX;
 
-		if (!nrf_profiler_RTT_send(buf, type_id)) {
-			nrf_profiler_fatal_error();
-		}
-		k_spin_unlock(&lock, key);
+		(void)ring_put(ring_get(), buf->payload_start,
+			       buf->payload - buf->payload_start);
 	}
 }
@@ -27,8 +27,11 @@ typedef enum {
 	HDLC_STATE_FRAME_START,
 	HDLC_STATE_FRAME_FOUND,
 	HDLC_STATE_ESCAPE,
+	HDLC_STATE_DROP,
 } hdlc_state_t;
 
+#define CRC_SIZE sizeof(uint16_t)
+
 struct nrf_rpc_uart {
 	const struct device *uart;
 	nrf_rpc_tr_receive_handler_t receive_callback;
@@ -45,20 +48,96 @@ struct nrf_rpc_uart {
 
 	K_KERNEL_STACK_MEMBER(rx_workq_stack, CONFIG_NRF_RPC_UART_RX_THREAD_STACK_SIZE);
 
+#ifdef CONFIG_NRF_RPC_UART_ASYNC_API
+	/* RX buffers handed over to the UART driver in turns */
+	uint8_t rx_dbuf[2][CONFIG_NRF_RPC_UART_ASYNC_RX_BUF_SIZE];
+	uint8_t rx_dbuf_next;
+
+	/* TX buffers: one is filled with the encoded frame while the other is transmitted */
+	uint8_t tx_dbuf[2][CONFIG_NRF_RPC_UART_ASYNC_TX_BUF_SIZE];
+	uint8_t tx_dbuf_idx;
+	size_t tx_dbuf_len;
+	struct k_sem tx_done;
+#endif
+
 	/* HDLC frame parsing state */
 	hdlc_state_t hdlc_state;
-	uint8_t rx_packet[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE];
+	/* Decoded frame: packet followed by its CRC */
+	uint8_t rx_packet[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE + CRC_SIZE];
 	size_t rx_packet_len;
 
 	/* TX lock */
 	struct k_mutex tx_lock;
 };
 
-#define CRC_SIZE sizeof(uint16_t)
+/* Word-at-a-time helpers used to find HDLC control characters. */
+#define HDLC_WORD_ONES  ((uintptr_t)-1 / 0xff)
+#define HDLC_WORD_HIGHS (HDLC_WORD_ONES * 0x80)
+
+static inline bool hdlc_word_has_byte(uintptr_t word, uint8_t byte)
+{
+	uintptr_t x = word ^ (HDLC_WORD_ONES * byte);
+
+	return ((x - HDLC_WORD_ONES) & ~x & HDLC_WORD_HIGHS) != 0;
+}
+
+static inline bool hdlc_is_ctrl(uint8_t byte)
+{
+	return byte == HDLC_CHAR_DELIMITER || byte == HDLC_CHAR_ESCAPE;
+}
+
+/* Returns the length of the leading run of bytes that need no HDLC escaping. */
+static size_t hdlc_plain_run_len(const uint8_t *data, size_t length)
+{
+	size_t i = 0;
+
+	while (i < length && !IS_ALIGNED(&data[i], sizeof(uintptr_t))) {
+		if (hdlc_is_ctrl(data[i])) {
+			return i;
+		}
+		i++;
+	}
+
+	while (length - i >= sizeof(uintptr_t)) {
+		uintptr_t word = *(const uintptr_t *)&data[i];
+
+		if (hdlc_word_has_byte(word, HDLC_CHAR_DELIMITER) ||
+		    hdlc_word_has_byte(word, HDLC_CHAR_ESCAPE)) {
+			break;
+		}
+		i += sizeof(uintptr_t);
+	}
+
+	while (i < length && !hdlc_is_ctrl(data[i])) {
+		i++;
+	}
+
+	return i;
+}
+
+static void hdlc_drop_frame(struct nrf_rpc_uart *uart_tr)
+{
+	LOG_WRN("RX frame too long, dropping");
+
+	uart_tr->rx_packet_len = 0;
+	uart_tr->hdlc_state = HDLC_STATE_DROP;
+}
 
 static int hdlc_decode_byte(struct nrf_rpc_uart *uart_tr, uint8_t byte)
 {
-	/* TODO: handle frame buffer overflow */
+	if (uart_tr->hdlc_state == HDLC_STATE_DROP) {
+		/* Discard the rest of the oversized frame. */
+		if (byte == HDLC_CHAR_DELIMITER) {
+			uart_tr->hdlc_state = HDLC_STATE_UNSYNC;
+		}
+		return 0;
+	}
+
+	if (byte != HDLC_CHAR_ESCAPE && byte != HDLC_CHAR_DELIMITER &&
+	    uart_tr->rx_packet_len >= sizeof(uart_tr->rx_packet)) {
+		hdlc_drop_frame(uart_tr);
+		return -NRF_ENOMEM;
+	}
 
 	if (uart_tr->hdlc_state == HDLC_STATE_ESCAPE) {
 		uart_tr->rx_packet[uart_tr->rx_packet_len++] = byte ^ 0x20;
@@ -87,43 +166,83 @@ static int hdlc_decode_byte(struct nrf_rpc_uart *uart_tr, uint8_t byte)
 	return 0;
 }
 
+/*
+ * Decodes the input until a complete frame is found or the input is exhausted.
+ * Runs of bytes that need no unescaping are copied in bulk.
+ * Returns the number of bytes consumed.
+ */
+static size_t hdlc_decode(struct nrf_rpc_uart *uart_tr, const uint8_t *data, size_t length)
+{
+	size_t consumed = 0;
+
+	while (consumed < length) {
+		if (uart_tr->hdlc_state != HDLC_STATE_ESCAPE) {
+			size_t run = hdlc_plain_run_len(&data[consumed], length - consumed);
+
+			if (run > 0) {
+				if (uart_tr->hdlc_state != HDLC_STATE_DROP) {
+					if (run > sizeof(uart_tr->rx_packet) - uart_tr->rx_packet_len) {
+						hdlc_drop_frame(uart_tr);
+					} else {
+						memcpy(&uart_tr->rx_packet[uart_tr->rx_packet_len],
+						       &data[consumed], run);
+						uart_tr->rx_packet_len += run;
+						uart_tr->hdlc_state = HDLC_STATE_FRAME_START;
+					}
+				}
+
+				consumed += run;
+				continue;
+			}
+		}
+
+		(void)hdlc_decode_byte(uart_tr, data[consumed++]);
+
+		if (uart_tr->hdlc_state == HDLC_STATE_FRAME_FOUND) {
+			break;
+		}
+	}
+
+	return consumed;
+}
+
+static void frame_process(struct nrf_rpc_uart *uart_tr)
+{
+	uint16_t crc_received;
+	uint16_t crc_calculated;
+
+	crc_received = sys_get_le16(uart_tr->rx_packet + uart_tr->rx_packet_len);
+	crc_calculated = crc16_ccitt(0xffff, uart_tr->rx_packet, uart_tr->rx_packet_len);
+
+	if (crc_calculated != crc_received) {
+		LOG_ERR("Invalid CRC, calculated %x received %x", crc_calculated, crc_received);
+	} else {
+		uart_tr->receive_callback(uart_tr->transport, uart_tr->rx_packet,
+					  uart_tr->rx_packet_len, uart_tr->receive_ctx);
+	}
+
+	uart_tr->rx_packet_len = 0;
+	uart_tr->hdlc_state = HDLC_STATE_UNSYNC;
+}
+
 static void work_handler(struct k_work *work)
 {
 	struct nrf_rpc_uart *uart_tr = CONTAINER_OF(work, struct nrf_rpc_uart, rx_work);
-	const struct nrf_rpc_tr *transport = uart_tr->transport;
 	uint8_t *data;
 	size_t len;
+	size_t consumed;
 	int ret;
-	uint16_t crc_received = 0;
-	uint16_t crc_calculated = 0;
 
 	while (!ring_buf_is_empty(&uart_tr->rx_ringbuf)) {
 		len = ring_buf_get_claim(&uart_tr->rx_ringbuf, &data,
 					 CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE);
-		for (size_t i = 0; i < len; i++) {
-			if (hdlc_decode_byte(uart_tr, data[i]) != 0) {
-				continue;
-			}
 
-			if (uart_tr->hdlc_state != HDLC_STATE_FRAME_FOUND) {
-				continue;
-			}
+		for (consumed = 0; consumed < len;) {
+			consumed += hdlc_decode(uart_tr, &data[consumed], len - consumed);
 
-			crc_received = sys_get_le16(uart_tr->rx_packet + uart_tr->rx_packet_len);
-			crc_calculated =
-				crc16_ccitt(0xffff, uart_tr->rx_packet, uart_tr->rx_packet_len);
-			if (crc_calculated != crc_received) {
-				LOG_ERR("Invalid CRC, calculated %x received %x", crc_calculated,
-					crc_received);
-				uart_tr->rx_packet_len = 0;
-				uart_tr->hdlc_state = HDLC_STATE_UNSYNC;
-				return;
+			if (uart_tr->hdlc_state == HDLC_STATE_FRAME_FOUND) {
+				frame_process(uart_tr);
 			}
-
-			uart_tr->receive_callback(transport, uart_tr->rx_packet,
-						  uart_tr->rx_packet_len, uart_tr->receive_ctx);
-			uart_tr->rx_packet_len = 0;
-			uart_tr->hdlc_state = HDLC_STATE_UNSYNC;
 		}
 
 		ret = ring_buf_get_finish(&uart_tr->rx_ringbuf, len);
@@ -133,6 +252,78 @@ static void work_handler(struct k_work *work)
 	}
 }
 
+#ifdef CONFIG_NRF_RPC_UART_ASYNC_API
+static int rx_enable(struct nrf_rpc_uart *uart_tr)
+{
+	uart_tr->rx_dbuf_next = 1;
+
+	return uart_rx_enable(uart_tr->uart, uart_tr->rx_dbuf[0], sizeof(uart_tr->rx_dbuf[0]),
+			      CONFIG_NRF_RPC_UART_ASYNC_RX_TIMEOUT_US);
+}
+
+static void async_cb(const struct device *uart, struct uart_event *evt, void *user_data)
+{
+	struct nrf_rpc_uart *uart_tr = user_data;
+	uint32_t written;
+	int err;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+	case UART_TX_ABORTED:
+		k_sem_give(&uart_tr->tx_done);
+		break;
+	case UART_RX_RDY:
+		written = ring_buf_put(&uart_tr->rx_ringbuf,
+				       evt->data.rx.buf + evt->data.rx.offset, evt->data.rx.len);
+		if (written < evt->data.rx.len) {
+			LOG_WRN("RX ring buffer full, dropped %u bytes",
+				evt->data.rx.len - written);
+		}
+		k_work_submit_to_queue(&uart_tr->rx_workq, &uart_tr->rx_work);
+		break;
+	case UART_RX_BUF_REQUEST:
+		err = uart_rx_buf_rsp(uart, uart_tr->rx_dbuf[uart_tr->rx_dbuf_next],
+				      sizeof(uart_tr->rx_dbuf[0]));
+		if (err) {
+			LOG_ERR("Failed to provide RX buffer (%d)", err);
+		}
+		uart_tr->rx_dbuf_next ^= 1;
+		break;
+	case UART_RX_STOPPED:
+		LOG_WRN("RX stopped, reason %d", evt->data.rx_stop.reason);
+		break;
+	case UART_RX_DISABLED:
+		err = rx_enable(uart_tr);
+		if (err) {
+			LOG_ERR("Failed to re-enable RX (%d)", err);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static int uart_setup(struct nrf_rpc_uart *uart_tr)
+{
+	int ret = uart_callback_set(uart_tr->uart, async_cb, uart_tr);
+
+	if (ret < 0) {
+		LOG_ERR("Error setting UART async callback: %d", ret);
+		return ret;
+	}
+
+	k_sem_init(&uart_tr->tx_done, 1, 1);
+	uart_tr->tx_dbuf_idx = 0;
+	uart_tr->tx_dbuf_len = 0;
+
+	return 0;
+}
+
+static int uart_rx_start(struct nrf_rpc_uart *uart_tr)
+{
+	return rx_enable(uart_tr);
+}
+#else
 static void serial_cb(const struct device *uart, void *user_data)
 {
 	struct nrf_rpc_uart *uart_tr = user_data;
@@ -168,10 +359,37 @@ static void serial_cb(const struct device *uart, void *user_data)
 	}
 }
 
+static int uart_setup(struct nrf_rpc_uart *uart_tr)
+{
+	/* configure interrupt and callback to receive data */
+	int ret = uart_irq_callback_user_data_set(uart_tr->uart, serial_cb, uart_tr);
+
+	if (ret < 0) {
+		if (ret == -ENOTSUP) {
+			LOG_ERR("Interrupt-driven UART API support not enabled\n");
+		} else if (ret == -ENOSYS) {
+			LOG_ERR("UART device does not support interrupt-driven API\n");
+		} else {
+			LOG_ERR("Error setting UART callback: %d\n", ret);
+		}
+	}
+
+	return ret;
+}
+
+static int uart_rx_start(struct nrf_rpc_uart *uart_tr)
+{
+	uart_irq_rx_enable(uart_tr->uart);
+
+	return 0;
+}
+#endif /* CONFIG_NRF_RPC_UART_ASYNC_API */
+
 static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t receive_cb,
 		void *context)
 {
 	struct nrf_rpc_uart *uart_tr = transport->ctx;
+	int ret;
 
 	if (uart_tr->transport != NULL) {
 		LOG_DBG("init not needed");
@@ -194,17 +412,7 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 		return -NRF_ENOENT;
 	}
 
-	/* configure interrupt and callback to receive data */
-	int ret = uart_irq_callback_user_data_set(uart_tr->uart, serial_cb, uart_tr);
-
-	if (ret < 0) {
-		if (ret == -ENOTSUP) {
-			LOG_ERR("Interrupt-driven UART API support not enabled\n");
-		} else if (ret == -ENOSYS) {
-			LOG_ERR("UART device does not support interrupt-driven API\n");
-		} else {
-			LOG_ERR("Error setting UART callback: %d\n", ret);
-		}
+	if (uart_setup(uart_tr) < 0) {
 		return 0;
 	}
 
@@ -219,23 +427,91 @@ static int init(const struct nrf_rpc_tr *transport, nrf_rpc_tr_receive_handler_t
 
 	uart_tr->hdlc_state = HDLC_STATE_UNSYNC;
 	uart_tr->rx_packet_len = 0;
-	uart_irq_rx_enable(uart_tr->uart);
+
+	ret = uart_rx_start(uart_tr);
+	if (ret < 0) {
+		LOG_ERR("Failed to enable UART RX: %d", ret);
+		return -NRF_EIO;
+	}
 
 	return 0;
 }
 
-static void send_byte(const struct device *dev, uint8_t byte)
+#ifdef CONFIG_NRF_RPC_UART_ASYNC_API
+static void tx_flush(struct nrf_rpc_uart *uart_tr)
 {
-	if (byte == HDLC_CHAR_DELIMITER || byte == HDLC_CHAR_ESCAPE) {
-		uart_poll_out(dev, HDLC_CHAR_ESCAPE);
-		byte ^= 0x20;
+	int err;
+
+	if (uart_tr->tx_dbuf_len == 0) {
+		return;
 	}
 
-	uart_poll_out(dev, byte);
+	/* Wait until the other buffer is released by the driver. */
+	k_sem_take(&uart_tr->tx_done, K_FOREVER);
+
+	err = uart_tx(uart_tr->uart, uart_tr->tx_dbuf[uart_tr->tx_dbuf_idx], uart_tr->tx_dbuf_len,
+		      SYS_FOREVER_US);
+	if (err) {
+		LOG_ERR("UART TX failed (%d)", err);
+		k_sem_give(&uart_tr->tx_done);
+	}
+
+	uart_tr->tx_dbuf_idx ^= 1;
+	uart_tr->tx_dbuf_len = 0;
+}
+
+static void tx_write(struct nrf_rpc_uart *uart_tr, const uint8_t *data, size_t length)
+{
+	while (length > 0) {
+		size_t chunk = MIN(length, sizeof(uart_tr->tx_dbuf[0]) - uart_tr->tx_dbuf_len);
+
+		memcpy(&uart_tr->tx_dbuf[uart_tr->tx_dbuf_idx][uart_tr->tx_dbuf_len], data, chunk);
+		uart_tr->tx_dbuf_len += chunk;
+		data += chunk;
+		length -= chunk;
+
+		if (uart_tr->tx_dbuf_len == sizeof(uart_tr->tx_dbuf[0])) {
+			tx_flush(uart_tr);
+		}
+	}
+}
+#else
+static void tx_flush(struct nrf_rpc_uart *uart_tr)
+{
+	ARG_UNUSED(uart_tr);
+}
+
+static void tx_write(struct nrf_rpc_uart *uart_tr, const uint8_t *data, size_t length)
+{
+	for (size_t i = 0; i < length; i++) {
+		uart_poll_out(uart_tr->uart, data[i]);
+	}
+}
+#endif /* CONFIG_NRF_RPC_UART_ASYNC_API */
+
+static void hdlc_encode(struct nrf_rpc_uart *uart_tr, const uint8_t *data, size_t length)
+{
+	uint8_t escaped[2] = {HDLC_CHAR_ESCAPE};
+
+	while (length > 0) {
+		size_t run = hdlc_plain_run_len(data, length);
+
+		tx_write(uart_tr, data, run);
+		data += run;
+		length -= run;
+
+		if (length > 0) {
+			escaped[1] = *data ^ 0x20;
+			tx_write(uart_tr, escaped, sizeof(escaped));
+			data++;
+			length--;
+		}
+	}
 }
 
 static int send(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t length)
 {
+	const uint8_t delimiter = HDLC_CHAR_DELIMITER;
 	uint8_t crc[2];
 	struct nrf_rpc_uart *uart_tr = transport->ctx;
 
@@ -243,17 +519,14 @@ static int send(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t
 
 	k_mutex_lock(&uart_tr->tx_lock, K_FOREVER);
 
-	uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
-
-	for (size_t i = 0; i < length; i++) {
-		send_byte(uart_tr->uart, data[i]);
-	}
+	tx_write(uart_tr, &delimiter, 1);
+	hdlc_encode(uart_tr, data, length);
 
 	sys_put_le16(crc16_ccitt(0xffff, data, length), crc);
-	send_byte(uart_tr->uart, crc[0]);
-	send_byte(uart_tr->uart, crc[1]);
+	hdlc_encode(uart_tr, crc, sizeof(crc));
 
-	uart_poll_out(uart_tr->uart, HDLC_CHAR_DELIMITER);
+	tx_write(uart_tr, &delimiter, 1);
+	tx_flush(uart_tr);
 
 	k_free((void *)data);
 
@@ -309,3 +582,4 @@ const struct nrf_rpc_tr_api nrf_rpc_uart_service_api = {
 	};
 
 DT_FOREACH_STATUS_OKAY(nordic_nrf_uarte, NRF_RPC_UART_TRANSPORT_DEFINE);
+DT_FOREACH_STATUS_OKAY(zephyr_uart_emul, NRF_RPC_UART_TRANSPORT_DEFINE);
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <mbedtls/platform_util.h>
+
+#include "aead_key_cache.h"
+
+#define INVALID_UID 0U
+
+struct key_cache_entry {
+	psa_storage_uid_t uid;
+	/* Uptime after which the key must be derived again */
+	int64_t expiry;
+	uint8_t key[AEAD_KEY_SIZE];
+};
+
+static struct key_cache_entry key_cache[CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_CACHE_SIZE];
+
+static K_MUTEX_DEFINE(key_cache_mutex);
+
+static void key_cache_entry_clear(struct key_cache_entry *entry)
+{
+	mbedtls_platform_zeroize(entry, sizeof(*entry));
+}
+
+psa_status_t trusted_storage_key_cache_get(psa_storage_uid_t uid, uint8_t *key_buf,
+					   size_t key_length)
+{
+	psa_status_t status;
+	struct key_cache_entry *entry = NULL;
+	struct key_cache_entry *victim = &key_cache[0];
+	int64_t now;
+
+	if (key_length < AEAD_KEY_SIZE) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	k_mutex_lock(&key_cache_mutex, K_FOREVER);
+
+	now = k_uptime_get();
+
+	for (size_t i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		if (key_cache[i].uid != INVALID_UID && key_cache[i].expiry <= now) {
+			key_cache_entry_clear(&key_cache[i]);
+		}
+
+		if (key_cache[i].uid == uid) {
+			entry = &key_cache[i];
+			break;
+		}
+
+		/* Replace a free entry or the one expiring first */
+		if (victim->uid != INVALID_UID &&
+		    (key_cache[i].uid == INVALID_UID || key_cache[i].expiry < victim->expiry)) {
+			victim = &key_cache[i];
+		}
+	}
+
+	if (entry == NULL) {
+		key_cache_entry_clear(victim);
+
+		status = trusted_storage_get_key(uid, victim->key, sizeof(victim->key));
+		if (status != PSA_SUCCESS) {
+			key_cache_entry_clear(victim);
+			k_mutex_unlock(&key_cache_mutex);
+			return status;
+		}
+
+		victim->uid = uid;
+		victim->expiry = now + CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_CACHE_LIFETIME_MS;
+		entry = victim;
+	}
+
+	memcpy(key_buf, entry->key, AEAD_KEY_SIZE);
+
+	k_mutex_unlock(&key_cache_mutex);
+
+	return PSA_SUCCESS;
+}
+
+void trusted_storage_key_cache_evict(psa_storage_uid_t uid)
+{
+	k_mutex_lock(&key_cache_mutex, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(key_cache); i++) {
+		if (key_cache[i].uid == uid) {
+			key_cache_entry_clear(&key_cache[i]);
+		}
+	}
+
+	k_mutex_unlock(&key_cache_mutex);
+}
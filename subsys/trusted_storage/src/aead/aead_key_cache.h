@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef __TRUSTED_STORAGE_AEAD_KEY_CACHE_H_
+#define __TRUSTED_STORAGE_AEAD_KEY_CACHE_H_
+
+#include <psa/error.h>
+#include <psa/storage_common.h>
+
+#include "aead_key.h"
+
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_CACHE)
+
+/* Gets the AEAD key of the UID from the cache, deriving it on a miss */
+psa_status_t trusted_storage_key_cache_get(psa_storage_uid_t uid, uint8_t *key_buf,
+					   size_t key_length);
+
+/* Erases the cached key of the UID */
+void trusted_storage_key_cache_evict(psa_storage_uid_t uid);
+
+#else
+
+static inline psa_status_t trusted_storage_key_cache_get(psa_storage_uid_t uid, uint8_t *key_buf,
+							 size_t key_length)
+{
+	return trusted_storage_get_key(uid, key_buf, key_length);
+}
+
+static inline void trusted_storage_key_cache_evict(psa_storage_uid_t uid)
+{
+}
+
+#endif /* CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_CACHE */
+
+#endif /* __TRUSTED_STORAGE_AEAD_KEY_CACHE_H_ */
@@ -13,7 +13,7 @@ LOG_MODULE_REGISTER(internal_trusted_aead, CONFIG_TRUSTED_STORAGE_LOG_LEVEL);
 
 #include "../trusted_storage_backend.h"
 #include "../storage_backend.h"
-#include "aead_key.h"
+#include "aead_key_cache.h"
 #include "aead_nonce.h"
 #include "aead_crypt.h"
 
@@ -93,7 +93,7 @@ psa_status_t trusted_get(const psa_storage_uid_t uid, const char *prefix, size_t
 	}
 
 	/* Get AEAD key */
-	status = trusted_storage_get_key(uid, key_buf, AEAD_KEY_SIZE);
+	status = trusted_storage_key_cache_get(uid, key_buf, AEAD_KEY_SIZE);
 	if (status != PSA_SUCCESS) {
 		return status;
 	}
@@ -173,7 +173,7 @@ psa_status_t trusted_set(const psa_storage_uid_t uid, const char *prefix, size_t
 	}
 
 	/* Get AEAD key */
-	status = trusted_storage_get_key(uid, key_buf, AEAD_KEY_SIZE);
+	status = trusted_storage_key_cache_get(uid, key_buf, AEAD_KEY_SIZE);
 	if (status != PSA_SUCCESS) {
 		goto cleanup_objects;
 	}
@@ -238,6 +238,8 @@ psa_status_t trusted_remove(const psa_storage_uid_t uid, const char *prefix)
 		return PSA_ERROR_NOT_PERMITTED;
 	}
 
+	trusted_storage_key_cache_evict(uid);
+
 	return storage_remove_object(uid, prefix);
 }
 
@@ -246,20 +248,22 @@ uint32_t trusted_get_support(void)
 	return 0;
 }
 
-psa_status_t trusted_create(const psa_storage_uid_t uid, size_t capacity,
+psa_status_t trusted_create(const psa_storage_uid_t uid, const char *prefix, size_t capacity,
 			    psa_storage_create_flags_t create_flags)
 {
 
 	ARG_UNUSED(uid);
+	ARG_UNUSED(prefix);
 	ARG_UNUSED(capacity);
 	ARG_UNUSED(create_flags);
 	return PSA_ERROR_NOT_SUPPORTED;
 }
 
-psa_status_t trusted_set_extended(const psa_storage_uid_t uid, size_t data_offset,
-				  size_t data_length, const void *p_data)
+psa_status_t trusted_set_extended(const psa_storage_uid_t uid, const char *prefix,
+				  size_t data_offset, size_t data_length, const void *p_data)
 {
 	ARG_UNUSED(uid);
+	ARG_UNUSED(prefix);
 	ARG_UNUSED(data_offset);
 	ARG_UNUSED(data_length);
 	ARG_UNUSED(p_data);
@@ -0,0 +1,681 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/sys/util.h>
+#include <zephyr/logging/log.h>
+#include <mbedtls/platform_util.h>
+#include <psa/crypto.h>
+LOG_MODULE_REGISTER(internal_trusted_aead, CONFIG_TRUSTED_STORAGE_LOG_LEVEL);
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../trusted_storage_backend.h"
+#include "../storage_backend.h"
+#include "aead_key_cache.h"
+#include "aead_nonce.h"
+#include "aead_crypt.h"
+
+/*
+ * AEAD based Authenticated Encrypted trust implementation with segmented assets
+ *
+ * Actual implementation uses:
+ * - Asset data split into segments of SEGMENT_SIZE bytes, each stored as a separate
+ *   object with the segment index and one of two slot numbers appended to the prefix.
+ * - Segment index as additional parameter of each segment.
+ * - A manifest stored as the asset object, with Flags+Size+Capacity+Slots as additional
+ *   parameter and the tags of all segments as encrypted data.
+ * - Nonce is a number that is incremented for each encryption.
+ * - Tag is left at the end of output data
+ *
+ * A segment is only accepted if its tag matches the one in the manifest, so old segments
+ * cannot be replayed and segments cannot be moved between assets or positions.
+ *
+ * An update writes each changed segment to the slot that is not in use, then writes the
+ * manifest and only after that removes the old segments. If the update is interrupted
+ * before the manifest is written, the previous content of the asset stays valid.
+ */
+
+#define AEAD_NONCE_SIZE 12
+#define AEAD_TAG_SIZE	16
+
+#define STORAGE_MAX_ASSET_SIZE CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_MAX_DATA_SIZE
+#define SEGMENT_SIZE	       CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_SEGMENT_SIZE
+#define SEGMENT_COUNT_MAX      DIV_ROUND_UP(STORAGE_MAX_ASSET_SIZE, SEGMENT_SIZE)
+
+#define SEGMENT_SLOTS_SIZE     DIV_ROUND_UP(SEGMENT_COUNT_MAX, 8)
+
+/* Segment prefix pattern: asset prefix, segment index, slot */
+#define SEGMENT_PREFIX_PATTERN	  "%s.%u.%u"
+#define SEGMENT_PREFIX_MAX_LENGTH 32
+
+#define INVALID_UID 0U
+
+/** Header of stored manifest. Supplied as additional data when encrypting. */
+typedef struct stored_object_header {
+	psa_storage_create_flags_t create_flags;
+	size_t data_size;
+	size_t capacity;
+	/* Slot holding each segment, one bit per segment */
+	uint8_t segment_slots[SEGMENT_SLOTS_SIZE];
+} stored_object_header;
+
+typedef struct stored_manifest {
+	stored_object_header header;
+	uint8_t nonce[AEAD_NONCE_SIZE];
+	uint8_t data[SEGMENT_COUNT_MAX * AEAD_TAG_SIZE + AEAD_TAG_SIZE];
+} stored_manifest;
+
+typedef struct stored_segment {
+	uint8_t nonce[AEAD_NONCE_SIZE];
+	uint8_t data[SEGMENT_SIZE + AEAD_TAG_SIZE];
+} stored_segment;
+
+/** Decrypted manifest. */
+struct manifest {
+	stored_object_header header;
+	uint8_t segment_tags[SEGMENT_COUNT_MAX][AEAD_TAG_SIZE];
+};
+
+static size_t segment_count(size_t data_size)
+{
+	return DIV_ROUND_UP(data_size, SEGMENT_SIZE);
+}
+
+static size_t segment_length(size_t data_size, size_t index)
+{
+	return MIN(SEGMENT_SIZE, data_size - index * SEGMENT_SIZE);
+}
+
+static uint8_t segment_slot_get(const uint8_t *segment_slots, size_t index)
+{
+	return (segment_slots[index / 8] >> (index % 8)) & 1;
+}
+
+static void segment_slot_set(uint8_t *segment_slots, size_t index, uint8_t slot)
+{
+	WRITE_BIT(segment_slots[index / 8], index % 8, slot);
+}
+
+static psa_status_t segment_prefix_get(char *segment_prefix, const char *prefix, size_t index,
+				       uint8_t slot)
+{
+	int ret;
+
+	ret = snprintf(segment_prefix, SEGMENT_PREFIX_MAX_LENGTH + 1, SEGMENT_PREFIX_PATTERN,
+		       prefix, (unsigned int)index, (unsigned int)slot);
+	if (ret < 0 || ret > SEGMENT_PREFIX_MAX_LENGTH) {
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+
+	return PSA_SUCCESS;
+}
+
+static psa_status_t manifest_get(const psa_storage_uid_t uid, const char *prefix,
+				 const uint8_t *key_buf, struct manifest *manifest)
+{
+	psa_status_t status;
+	size_t out_length;
+	stored_manifest manifest_data;
+
+	status = storage_get_object(uid, prefix, (void *)&manifest_data, sizeof(manifest_data),
+				    &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (out_length < offsetof(stored_manifest, data) + AEAD_TAG_SIZE) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	status = trusted_storage_aead_decrypt(
+		key_buf, AEAD_KEY_SIZE, manifest_data.nonce, AEAD_NONCE_SIZE,
+		(void *)&manifest_data.header, sizeof(manifest_data.header), manifest_data.data,
+		out_length - offsetof(stored_manifest, data), manifest->segment_tags,
+		sizeof(manifest->segment_tags), &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	manifest->header = manifest_data.header;
+
+	if (manifest->header.capacity > STORAGE_MAX_ASSET_SIZE ||
+	    manifest->header.data_size > manifest->header.capacity ||
+	    out_length != segment_count(manifest->header.data_size) * AEAD_TAG_SIZE) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	return PSA_SUCCESS;
+}
+
+static psa_status_t manifest_set(const psa_storage_uid_t uid, const char *prefix,
+				 const uint8_t *key_buf, const struct manifest *manifest)
+{
+	psa_status_t status;
+	size_t out_length;
+	stored_manifest manifest_data;
+
+	manifest_data.header = manifest->header;
+
+	/* Get new nonce at each set */
+	status = trusted_storage_get_nonce(manifest_data.nonce, AEAD_NONCE_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = trusted_storage_aead_encrypt(
+		key_buf, AEAD_KEY_SIZE, manifest_data.nonce, AEAD_NONCE_SIZE,
+		(void *)&manifest_data.header, sizeof(manifest_data.header),
+		manifest->segment_tags, segment_count(manifest->header.data_size) * AEAD_TAG_SIZE,
+		manifest_data.data, sizeof(manifest_data.data), &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	return storage_set_object(uid, prefix, &manifest_data,
+				  offsetof(stored_manifest, data) + out_length);
+}
+
+/* Reads and decrypts a segment of the given length into segment_buf */
+static psa_status_t segment_get(const psa_storage_uid_t uid, const char *prefix,
+				const uint8_t *key_buf, const struct manifest *manifest,
+				size_t index, size_t length, uint8_t *segment_buf)
+{
+	psa_status_t status;
+	char segment_prefix[SEGMENT_PREFIX_MAX_LENGTH + 1];
+	size_t out_length;
+	uint32_t segment_index = index;
+	stored_segment segment_data;
+
+	status = segment_prefix_get(segment_prefix, prefix, index,
+				    segment_slot_get(manifest->header.segment_slots, index));
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = storage_get_object(uid, segment_prefix, (void *)&segment_data,
+				    sizeof(segment_data), &out_length);
+	if (status == PSA_ERROR_DOES_NOT_EXIST) {
+		/* The manifest refers to the segment, so it must exist */
+		return PSA_ERROR_DATA_CORRUPT;
+	} else if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (out_length != offsetof(stored_segment, data) + length + AEAD_TAG_SIZE) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	if (memcmp(segment_data.data + length, manifest->segment_tags[index], AEAD_TAG_SIZE) !=
+	    0) {
+		return PSA_ERROR_INVALID_SIGNATURE;
+	}
+
+	status = trusted_storage_aead_decrypt(
+		key_buf, AEAD_KEY_SIZE, segment_data.nonce, AEAD_NONCE_SIZE,
+		(void *)&segment_index, sizeof(segment_index), segment_data.data,
+		length + AEAD_TAG_SIZE, segment_buf, SEGMENT_SIZE, &out_length);
+
+	mbedtls_platform_zeroize(&segment_data, sizeof(segment_data));
+
+	return status;
+}
+
+/* Encrypts and writes a segment to the slot given in the manifest, and records its tag there */
+static psa_status_t segment_set(const psa_storage_uid_t uid, const char *prefix,
+				const uint8_t *key_buf, struct manifest *manifest, size_t index,
+				const uint8_t *segment_buf, size_t length)
+{
+	psa_status_t status;
+	char segment_prefix[SEGMENT_PREFIX_MAX_LENGTH + 1];
+	size_t out_length;
+	uint32_t segment_index = index;
+	stored_segment segment_data;
+
+	status = segment_prefix_get(segment_prefix, prefix, index,
+				    segment_slot_get(manifest->header.segment_slots, index));
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	/* Get new nonce at each set */
+	status = trusted_storage_get_nonce(segment_data.nonce, AEAD_NONCE_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = trusted_storage_aead_encrypt(
+		key_buf, AEAD_KEY_SIZE, segment_data.nonce, AEAD_NONCE_SIZE,
+		(void *)&segment_index, sizeof(segment_index), segment_buf, length,
+		segment_data.data, sizeof(segment_data.data), &out_length);
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	memcpy(manifest->segment_tags[index], segment_data.data + length, AEAD_TAG_SIZE);
+
+	status = storage_set_object(uid, segment_prefix, &segment_data,
+				    offsetof(stored_segment, data) + out_length);
+
+cleanup:
+	mbedtls_platform_zeroize(&segment_data, sizeof(segment_data));
+
+	return status;
+}
+
+static void segment_remove(const psa_storage_uid_t uid, const char *prefix, size_t index,
+			   uint8_t slot)
+{
+	char segment_prefix[SEGMENT_PREFIX_MAX_LENGTH + 1];
+
+	if (segment_prefix_get(segment_prefix, prefix, index, slot) == PSA_SUCCESS) {
+		storage_remove_object(uid, segment_prefix);
+	}
+}
+
+/* Removes the segments in range [first, last) from the given slots */
+static void segments_remove(const psa_storage_uid_t uid, const char *prefix,
+			    const uint8_t *segment_slots, size_t first, size_t last)
+{
+	for (size_t i = first; i < last; i++) {
+		segment_remove(uid, prefix, i, segment_slot_get(segment_slots, i));
+	}
+}
+
+/* Removes the segments in range [first, last) from the slots other than the given ones */
+static void segments_remove_other(const psa_storage_uid_t uid, const char *prefix,
+				  const uint8_t *segment_slots, size_t first, size_t last)
+{
+	for (size_t i = first; i < last; i++) {
+		segment_remove(uid, prefix, i, !segment_slot_get(segment_slots, i));
+	}
+}
+
+psa_status_t trusted_get_info(const psa_storage_uid_t uid, const char *prefix,
+			      struct psa_storage_info_t *p_info)
+{
+	psa_status_t status;
+	size_t out_length;
+	stored_object_header header;
+
+	if (p_info == NULL || uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	/* Get size, capacity & flags */
+	status = storage_get_object(uid, prefix, (void *)&header, sizeof(header), &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	p_info->capacity = header.capacity;
+	p_info->size = header.data_size;
+	p_info->flags = header.create_flags;
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t trusted_get(const psa_storage_uid_t uid, const char *prefix, size_t data_offset,
+			 size_t data_length, void *p_data, size_t *p_data_length)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	uint8_t segment_buf[SEGMENT_SIZE];
+	struct manifest manifest;
+	size_t out_length;
+	size_t copied = 0;
+
+	if ((p_data == NULL && data_length != 0) || p_data_length == NULL || uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (data_length == 0) {
+		*p_data_length = 0;
+		return PSA_SUCCESS;
+	}
+
+	if ((data_offset + data_length) > STORAGE_MAX_ASSET_SIZE) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	/* Get AEAD key */
+	status = trusted_storage_key_cache_get(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = manifest_get(uid, prefix, key_buf, &manifest);
+	if (status != PSA_SUCCESS) {
+		goto clean_up;
+	}
+
+	if (data_offset > manifest.header.data_size) {
+		*p_data_length = 0;
+		status = PSA_ERROR_INVALID_ARGUMENT;
+		goto clean_up;
+	}
+
+	out_length = MIN(data_length, manifest.header.data_size - data_offset);
+
+	/* Only decrypt the segments overlapping the requested range */
+	while (copied < out_length) {
+		size_t position = data_offset + copied;
+		size_t index = position / SEGMENT_SIZE;
+		size_t segment_offset = position % SEGMENT_SIZE;
+		size_t chunk = MIN(SEGMENT_SIZE - segment_offset, out_length - copied);
+
+		status = segment_get(uid, prefix, key_buf, &manifest, index,
+				     segment_length(manifest.header.data_size, index),
+				     segment_buf);
+		if (status != PSA_SUCCESS) {
+			goto clean_up;
+		}
+
+		memcpy((uint8_t *)p_data + copied, segment_buf + segment_offset, chunk);
+		copied += chunk;
+	}
+
+	*p_data_length = out_length;
+
+clean_up:
+	/* Clean up */
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+	mbedtls_platform_zeroize(segment_buf, sizeof(segment_buf));
+
+	return status;
+}
+
+psa_status_t trusted_set(const psa_storage_uid_t uid, const char *prefix, size_t data_length,
+			 const void *p_data, psa_storage_create_flags_t create_flags)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	stored_object_header old_header;
+	struct manifest manifest;
+	size_t out_length = 0;
+	size_t old_segment_count = 0;
+	size_t new_segment_count = segment_count(data_length);
+	size_t written;
+
+	if (uid == INVALID_UID || (p_data == NULL && data_length != 0)) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (create_flags != PSA_STORAGE_FLAG_NONE && create_flags != PSA_STORAGE_FLAG_WRITE_ONCE) {
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+
+	if (data_length > STORAGE_MAX_ASSET_SIZE) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	/* Get flags and slots */
+	memset(&old_header, 0, sizeof(old_header));
+	status = storage_get_object(uid, prefix, (void *)&old_header, sizeof(old_header),
+				    &out_length);
+
+	if (status != PSA_SUCCESS && status != PSA_ERROR_DOES_NOT_EXIST) {
+		return status;
+	}
+
+	if (status == PSA_SUCCESS) {
+		/* Do not allow to write new values if WRITE_ONCE flag is set */
+		if ((old_header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
+			return PSA_ERROR_NOT_PERMITTED;
+		}
+
+		old_segment_count = MIN(segment_count(old_header.data_size), SEGMENT_COUNT_MAX);
+	}
+
+	/* Get AEAD key */
+	status = trusted_storage_key_cache_get(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	/* The header is the additional data of the manifest, so it must not contain garbage */
+	memset(&manifest.header, 0, sizeof(manifest.header));
+	manifest.header.create_flags = create_flags;
+	manifest.header.data_size = data_length;
+	manifest.header.capacity = data_length;
+
+	/* Write the new segments next to the old ones */
+	for (size_t i = 0; i < new_segment_count; i++) {
+		segment_slot_set(manifest.header.segment_slots, i,
+				 (i < old_segment_count) ?
+				 !segment_slot_get(old_header.segment_slots, i) : 0);
+	}
+
+	for (written = 0; written < new_segment_count; written++) {
+		status = segment_set(uid, prefix, key_buf, &manifest, written,
+				     (const uint8_t *)p_data + written * SEGMENT_SIZE,
+				     segment_length(data_length, written));
+		if (status != PSA_SUCCESS) {
+			/* The failed segment may have been written partially */
+			written++;
+			goto cleanup_segments;
+		}
+	}
+
+	/* The manifest is written last, the new segments are not valid before that */
+	status = manifest_set(uid, prefix, key_buf, &manifest);
+	if (status != PSA_SUCCESS) {
+		goto cleanup_segments;
+	}
+
+	segments_remove(uid, prefix, old_header.segment_slots, 0, old_segment_count);
+
+	goto cleanup;
+
+cleanup_segments:
+	/* Remove the new segments if an error occurs, the previous content stays valid */
+	LOG_DBG("trusted_set cleanup. status %d", status);
+	segments_remove(uid, prefix, manifest.header.segment_slots, 0, written);
+
+cleanup:
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+
+	return status;
+}
+
+psa_status_t trusted_remove(const psa_storage_uid_t uid, const char *prefix)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	size_t out_length;
+	stored_object_header header;
+
+	if (uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	/* Get flags */
+	status = storage_get_object(uid, prefix, (void *)&header, sizeof(header), &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if ((header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
+		return PSA_ERROR_NOT_PERMITTED;
+	}
+
+	trusted_storage_key_cache_evict(uid);
+
+	/* Remove the manifest first so that the asset disappears at once */
+	status = storage_remove_object(uid, prefix);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	/* Also remove the segments left over by an interrupted update */
+	segments_remove(uid, prefix, header.segment_slots, 0,
+			MIN(segment_count(header.data_size), SEGMENT_COUNT_MAX));
+	segments_remove_other(uid, prefix, header.segment_slots, 0,
+			      MIN(segment_count(header.data_size), SEGMENT_COUNT_MAX));
+
+	return PSA_SUCCESS;
+}
+
+uint32_t trusted_get_support(void)
+{
+	return PSA_STORAGE_SUPPORT_SET_EXTENDED;
+}
+
+psa_status_t trusted_create(const psa_storage_uid_t uid, const char *prefix, size_t capacity,
+			    psa_storage_create_flags_t create_flags)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	struct manifest manifest;
+	size_t out_length;
+
+	if (uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (create_flags != PSA_STORAGE_FLAG_NONE && create_flags != PSA_STORAGE_FLAG_WRITE_ONCE) {
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+
+	if (capacity > STORAGE_MAX_ASSET_SIZE) {
+		return PSA_ERROR_INSUFFICIENT_STORAGE;
+	}
+
+	status = storage_get_object(uid, prefix, (void *)&manifest.header,
+				    sizeof(manifest.header), &out_length);
+	if (status == PSA_SUCCESS) {
+		return PSA_ERROR_ALREADY_EXISTS;
+	} else if (status != PSA_ERROR_DOES_NOT_EXIST) {
+		return status;
+	}
+
+	/* Get AEAD key */
+	status = trusted_storage_key_cache_get(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	memset(&manifest.header, 0, sizeof(manifest.header));
+	manifest.header.create_flags = create_flags;
+	manifest.header.data_size = 0;
+	manifest.header.capacity = capacity;
+
+	status = manifest_set(uid, prefix, key_buf, &manifest);
+
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+
+	return status;
+}
+
+psa_status_t trusted_set_extended(const psa_storage_uid_t uid, const char *prefix,
+				  size_t data_offset, size_t data_length, const void *p_data)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	uint8_t segment_buf[SEGMENT_SIZE];
+	uint8_t old_segment_slots[SEGMENT_SLOTS_SIZE];
+	struct manifest manifest;
+	size_t old_size;
+	size_t data_end;
+	size_t first;
+	size_t last;
+	size_t i;
+
+	if (uid == INVALID_UID || (p_data == NULL && data_length != 0)) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	/* Get AEAD key */
+	status = trusted_storage_key_cache_get(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = manifest_get(uid, prefix, key_buf, &manifest);
+	if (status != PSA_SUCCESS) {
+		goto clean_up;
+	}
+
+	if ((manifest.header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
+		status = PSA_ERROR_NOT_PERMITTED;
+		goto clean_up;
+	}
+
+	/* No gaps and no growing beyond the capacity */
+	if (data_offset > manifest.header.data_size ||
+	    data_length > manifest.header.capacity - data_offset) {
+		status = PSA_ERROR_INVALID_ARGUMENT;
+		goto clean_up;
+	}
+
+	if (data_length == 0) {
+		status = PSA_SUCCESS;
+		goto clean_up;
+	}
+
+	old_size = manifest.header.data_size;
+	data_end = data_offset + data_length;
+	manifest.header.data_size = MAX(old_size, data_end);
+
+	first = data_offset / SEGMENT_SIZE;
+	last = (data_end - 1) / SEGMENT_SIZE;
+
+	memcpy(old_segment_slots, manifest.header.segment_slots, sizeof(old_segment_slots));
+
+	/* Only rewrite the segments overlapping the written range */
+	for (i = first; i <= last; i++) {
+		size_t segment_start = i * SEGMENT_SIZE;
+		size_t old_length = (segment_start < old_size) ? segment_length(old_size, i) : 0;
+		size_t write_start = MAX(data_offset, segment_start);
+		size_t write_end = MIN(data_end, segment_start + SEGMENT_SIZE);
+
+		/* Old content is only needed if the segment is not fully overwritten */
+		if (old_length > 0 &&
+		    (write_start > segment_start || write_end < segment_start + old_length)) {
+			status = segment_get(uid, prefix, key_buf, &manifest, i, old_length,
+					     segment_buf);
+			if (status != PSA_SUCCESS) {
+				goto cleanup_segments;
+			}
+		}
+
+		memcpy(segment_buf + (write_start - segment_start),
+		       (const uint8_t *)p_data + (write_start - data_offset),
+		       write_end - write_start);
+
+		/* Write the new segment next to the old one */
+		segment_slot_set(manifest.header.segment_slots, i,
+				 !segment_slot_get(old_segment_slots, i));
+
+		status = segment_set(uid, prefix, key_buf, &manifest, i, segment_buf,
+				     segment_length(manifest.header.data_size, i));
+		if (status != PSA_SUCCESS) {
+			/* The failed segment may have been written partially */
+			i++;
+			goto cleanup_segments;
+		}
+	}
+
+	/* The manifest is written last, the new segments are not valid before that */
+	status = manifest_set(uid, prefix, key_buf, &manifest);
+	if (status != PSA_SUCCESS) {
+		goto cleanup_segments;
+	}
+
+	segments_remove(uid, prefix, old_segment_slots, first, last + 1);
+
+	goto clean_up;
+
+cleanup_segments:
+	/* Remove the new segments if an error occurs, the previous content stays valid */
+	LOG_DBG("trusted_set_extended cleanup. status %d", status);
+	segments_remove_other(uid, prefix, old_segment_slots, first, i);
+
+clean_up:
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+	mbedtls_platform_zeroize(segment_buf, sizeof(segment_buf));
+
+	return status;
+}
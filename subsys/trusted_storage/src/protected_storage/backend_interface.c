@@ -40,11 +40,12 @@ uint32_t psa_ps_get_support(void)
 psa_status_t psa_ps_create(psa_storage_uid_t uid, size_t capacity,
 			   psa_storage_create_flags_t create_flags)
 {
-	return trusted_create(uid, capacity, create_flags);
+	return trusted_create(uid, CONFIG_PSA_PROTECTED_STORAGE_PREFIX, capacity, create_flags);
 }
 
 psa_status_t psa_ps_set_extended(psa_storage_uid_t uid, size_t data_offset, size_t data_length,
 				 const void *p_data)
 {
-	return trusted_set_extended(uid, data_offset, data_length, p_data);
+	return trusted_set_extended(uid, CONFIG_PSA_PROTECTED_STORAGE_PREFIX, data_offset,
+				    data_length, p_data);
 }
@@ -65,9 +65,38 @@ static int cmd_zb_resume(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
+/**@brief Print statistics of the queue passing application callbacks
+ *        and alarms to the Zigbee scheduler
+ *
+ * @code
+ * zscheduler stats
+ * @endcode
+ *
+ */
+static int cmd_zb_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	struct zigbee_app_cb_queue_stats stats;
+
+	zigbee_debug_get_app_cb_queue_stats(&stats);
+
+	shell_print(shell, "App callback queue depth: %u/%u (max: %u)",
+		    stats.depth, stats.capacity, stats.max_depth);
+	shell_print(shell, "Processed: %u (max per iteration: %u)",
+		    stats.processed, stats.max_batch);
+	shell_print(shell, "Overflows: %u", stats.overflows);
+	zb_shell_print_done(shell, ZB_FALSE);
+
+	return 0;
+}
+
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_zigbee,
 	SHELL_CMD_ARG(resume, NULL, "Suspend Zigbee scheduler processing.",
 		      cmd_zb_resume, 1, 0),
+	SHELL_CMD_ARG(stats, NULL, "Print application callback queue statistics.",
+		      cmd_zb_stats, 1, 0),
 	SHELL_CMD_ARG(suspend, NULL, "Suspend Zigbee scheduler processing.",
 		      cmd_zb_suspend, 1, 0),
 	SHELL_SUBCMD_SET_END);
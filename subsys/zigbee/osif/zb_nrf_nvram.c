@@ -5,6 +5,7 @@
  */
 
 #include <pm_config.h>
+#include <zephyr/kernel.h>
 #include <zephyr/storage/flash_map.h>
 #include <zephyr/logging/log.h>
 
@@ -31,6 +32,163 @@ static const struct flash_area *fa; /* ZBOSS nvram */
 static const struct flash_area *fa_pc; /* production config */
 #endif
 
+#ifdef CONFIG_ZIGBEE_NVRAM_WRITE_CACHE
+/* Pending writes to a logical NVRAM page, combined into a single range. */
+struct nvram_write_cache {
+	/* Flash area offset of the range, aligned to the write block size. */
+	uint32_t offset;
+	/* Length of the range, zero if nothing is pending. */
+	uint32_t len;
+	uint8_t data[CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_SIZE] __aligned(4);
+};
+
+static struct nvram_write_cache write_cache[CONFIG_ZIGBEE_NVRAM_PAGE_COUNT];
+static uint32_t write_block_size;
+static bool write_cache_enabled;
+static K_MUTEX_DEFINE(write_cache_mutex);
+
+static void write_cache_flush_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(write_cache_flush_work, write_cache_flush_work_handler);
+
+static void write_cache_init(void)
+{
+	write_block_size = flash_area_align(fa);
+
+	if (write_block_size == 0 ||
+	    (CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_SIZE % write_block_size) != 0) {
+		LOG_WRN("Write cache size is not a multiple of write block size %u, "
+			"writing directly", write_block_size);
+		return;
+	}
+
+	write_cache_enabled = true;
+}
+
+/* Must be called with write_cache_mutex locked. */
+static int write_cache_page_flush(struct nvram_write_cache *cache)
+{
+	uint32_t write_len = ROUND_UP(cache->len, write_block_size);
+	int err;
+
+	if (cache->len == 0) {
+		return 0;
+	}
+
+	/* Pad the range to whole write blocks with the data already in flash. */
+	if (write_len > cache->len) {
+		err = flash_area_read(fa, cache->offset + cache->len, &cache->data[cache->len],
+				      write_len - cache->len);
+		if (err) {
+			LOG_ERR("Read error: %d", err);
+			return err;
+		}
+	}
+
+	LOG_DBG("Flushing %u bytes at 0x%x", write_len, cache->offset);
+
+	cache->len = 0;
+
+	err = flash_area_write(fa, cache->offset, cache->data, write_len);
+	if (err) {
+		LOG_ERR("Write error: %d", err);
+	}
+
+	return err;
+}
+
+/* Must be called with write_cache_mutex locked. */
+static int write_cache_flush(void)
+{
+	int ret = 0;
+
+	for (int page = 0; page < ARRAY_SIZE(write_cache); page++) {
+		int err = write_cache_page_flush(&write_cache[page]);
+
+		if (err) {
+			ret = err;
+		}
+	}
+
+	return ret;
+}
+
+static void write_cache_flush_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&write_cache_mutex, K_FOREVER);
+	(void)write_cache_flush();
+	k_mutex_unlock(&write_cache_mutex);
+}
+
+static int write_cache_write(zb_uint8_t page, uint32_t flash_addr, const uint8_t *buf,
+			     uint32_t len)
+{
+	struct nvram_write_cache *cache = &write_cache[page];
+	uint32_t end = flash_addr + len;
+	int err;
+
+	k_mutex_lock(&write_cache_mutex, K_FOREVER);
+
+	/* Flush the pending range unless the write continues or overlaps it. */
+	if (cache->len > 0 &&
+	    (flash_addr < cache->offset || flash_addr > cache->offset + cache->len ||
+	     end - cache->offset > sizeof(cache->data))) {
+		err = write_cache_page_flush(cache);
+		if (err) {
+			goto out;
+		}
+	}
+
+	if (cache->len == 0) {
+		uint32_t offset = ROUND_DOWN(flash_addr, write_block_size);
+
+		if (end - offset > sizeof(cache->data)) {
+			/* Too long to be buffered. */
+			err = flash_area_write(fa, flash_addr, buf, len);
+			goto out;
+		}
+
+		/* Fill the start of the first write block with the data already in flash. */
+		if (flash_addr > offset) {
+			err = flash_area_read(fa, offset, cache->data, flash_addr - offset);
+			if (err) {
+				goto out;
+			}
+		}
+
+		cache->offset = offset;
+		cache->len = flash_addr - offset;
+	}
+
+	memcpy(&cache->data[flash_addr - cache->offset], buf, len);
+	cache->len = MAX(cache->len, end - cache->offset);
+	err = 0;
+
+	/* The deadline is counted from the first buffered write. */
+	k_work_schedule(&write_cache_flush_work,
+			K_MSEC(CONFIG_ZIGBEE_NVRAM_WRITE_CACHE_FLUSH_DELAY_MS));
+
+out:
+	k_mutex_unlock(&write_cache_mutex);
+
+	return err;
+}
+
+/* Must be called with write_cache_mutex locked. */
+static void write_cache_read(zb_uint8_t page, uint32_t flash_addr, uint8_t *buf, uint32_t len)
+{
+	const struct nvram_write_cache *cache = &write_cache[page];
+	uint32_t start = MAX(flash_addr, cache->offset);
+	uint32_t end = MIN(flash_addr + len, cache->offset + cache->len);
+
+	if (cache->len > 0 && start < end) {
+		memcpy(&buf[start - flash_addr], &cache->data[start - cache->offset],
+		       end - start);
+	}
+}
+#endif /* CONFIG_ZIGBEE_NVRAM_WRITE_CACHE */
+
 void zb_osif_nvram_init(const zb_char_t *name)
 {
 	ARG_UNUSED(name);
@@ -41,6 +199,12 @@ void zb_osif_nvram_init(const zb_char_t *name)
 		LOG_ERR("Can't open ZBOSS NVRAM flash area");
 	}
 
+#ifdef CONFIG_ZIGBEE_NVRAM_WRITE_CACHE
+	if (!ret) {
+		write_cache_init();
+	}
+#endif
+
 #ifdef ZB_PRODUCTION_CONFIG
 	ret = flash_area_open(PM_ZBOSS_PRODUCT_CONFIG_ID, &fa_pc);
 	if (ret) {
@@ -87,8 +251,20 @@ zb_ret_t zb_osif_nvram_read(zb_uint8_t page, zb_uint32_t pos, zb_uint8_t *buf,
 
 	uint32_t flash_addr = get_page_base_offset(page) + pos;
 
+#ifdef CONFIG_ZIGBEE_NVRAM_WRITE_CACHE
+	k_mutex_lock(&write_cache_mutex, K_FOREVER);
+#endif
+
 	int err = flash_area_read(fa, flash_addr, buf, len);
 
+#ifdef CONFIG_ZIGBEE_NVRAM_WRITE_CACHE
+	if (!err && write_cache_enabled) {
+		/* Data not written to flash yet takes precedence. */
+		write_cache_read(page, flash_addr, buf, len);
+	}
+	k_mutex_unlock(&write_cache_mutex);
+#endif
+
 	if (err) {
 		LOG_ERR("Read error: %d", err);
 		return RET_ERROR;
@@ -124,7 +300,12 @@ zb_ret_t zb_osif_nvram_write(zb_uint8_t page, zb_uint32_t pos, void *buf,
 	LOG_DBG("Function: %s, page: %d, pos: %d, len: %d",
 		__func__, page, pos, len);
 
+#ifdef CONFIG_ZIGBEE_NVRAM_WRITE_CACHE
+	int err = write_cache_enabled ? write_cache_write(page, flash_addr, buf, len) :
+					flash_area_write(fa, flash_addr, buf, len);
+#else
 	int err = flash_area_write(fa, flash_addr, buf, len);
+#endif
 
 	if (err) {
 		LOG_ERR("Write error: %d", err);
@@ -139,12 +320,32 @@ zb_ret_t zb_osif_nvram_erase_async(zb_uint8_t page)
 	zb_ret_t ret = RET_OK;
 
 	if (page < zb_get_nvram_page_count()) {
-		int err = flash_area_erase(fa, get_page_base_offset(page),
-					   zb_get_nvram_page_length());
+		int err = 0;
+
+#ifdef CONFIG_ZIGBEE_NVRAM_WRITE_CACHE
+		k_mutex_lock(&write_cache_mutex, K_FOREVER);
+		/* Pending writes to the page are erased anyway. */
+		write_cache[page].len = 0;
+		/* ZBOSS erases the old page after migrating its data to another page.
+		 * The migrated data must be in flash before the old copy is lost.
+		 */
+		err = write_cache_flush();
 		if (err) {
-			LOG_ERR("Erase error: %d", err);
+			LOG_ERR("Flush before erase failed: %d", err);
 			ret = RET_ERROR;
 		}
+#endif
+		if (!err) {
+			err = flash_area_erase(fa, get_page_base_offset(page),
+					       zb_get_nvram_page_length());
+			if (err) {
+				LOG_ERR("Erase error: %d", err);
+				ret = RET_ERROR;
+			}
+		}
+#ifdef CONFIG_ZIGBEE_NVRAM_WRITE_CACHE
+		k_mutex_unlock(&write_cache_mutex);
+#endif
 	}
 	zb_nvram_erase_finished(page);
 	return ret;
@@ -157,7 +358,14 @@ void zb_osif_nvram_wait_for_last_op(void)
 
 void zb_osif_nvram_flush(void)
 {
+#ifdef CONFIG_ZIGBEE_NVRAM_WRITE_CACHE
+	k_mutex_lock(&write_cache_mutex, K_FOREVER);
+	(void)write_cache_flush();
+	k_mutex_unlock(&write_cache_mutex);
+	(void)k_work_cancel_delayable(&write_cache_flush_work);
+#else
 	/* empty for synchronous erase and write */
+#endif
 }
 
 
@@ -76,23 +76,40 @@ static struct k_poll_signal zigbee_sig = K_POLL_SIGNAL_INITIALIZER(zigbee_sig);
  */
 static K_MUTEX_DEFINE(zigbee_mutex);
 
-/**
- * Message queue, that is used to pass ZBOSS callbacks and alarms from
- * ISR and other threads to ZBOSS main loop context.
- */
-K_MSGQ_DEFINE(zb_app_cb_msgq, sizeof(zb_app_cb_t),
-	      CONFIG_ZIGBEE_APP_CB_QUEUE_LENGTH, 4);
+/* Number of slots in the application callback ring, a power of two not lower than 2. */
+#define ZB_APP_CB_RING_SIZE BIT(LOG2CEIL(MAX(CONFIG_ZIGBEE_APP_CB_QUEUE_LENGTH, 2)))
+#define ZB_APP_CB_RING_MASK (ZB_APP_CB_RING_SIZE - 1)
 
 /**
- * Work queue that will schedule processing of callbacks from the message queue.
+ * Slot of the application callback ring.
+ *
+ * The sequence number tells the state of the slot for a given ring position:
+ * it equals the position when the slot is free, the position + 1 when the
+ * callback is ready to be processed. It is stored relative to the slot index,
+ * so that the zero-initialized ring is empty.
  */
-static struct k_work zb_app_cb_work;
+struct zb_app_cb_slot {
+	atomic_t seq;
+	zb_app_cb_t app_cb;
+};
 
 /**
- * Atomic flag, indicating that the processing callback is still scheduled for
- * execution,
+ * Multi-producer, single-consumer ring, that is used to pass ZBOSS callbacks
+ * and alarms from ISR and other threads to ZBOSS main loop context.
+ * Producers claim slots with a compare-and-swap on the head position,
+ * the ZBOSS thread drains the ring before each main loop iteration.
  */
-volatile atomic_t zb_app_cb_process_scheduled = ATOMIC_INIT(0);
+static struct zb_app_cb_slot zb_app_cb_ring[ZB_APP_CB_RING_SIZE];
+/* Position of the next slot to be claimed by a producer. */
+static atomic_t zb_app_cb_head;
+/* Position of the next slot to be processed by the ZBOSS thread. */
+static atomic_t zb_app_cb_tail;
+
+/* Application callback queue statistics. */
+static atomic_t zb_app_cb_max_depth;
+static atomic_t zb_app_cb_processed;
+static atomic_t zb_app_cb_overflows;
+static atomic_t zb_app_cb_max_batch;
 
 K_THREAD_STACK_DEFINE(zboss_stack_area, CONFIG_ZBOSS_DEFAULT_THREAD_STACK_SIZE);
 static struct k_thread zboss_thread_data;
@@ -136,6 +153,20 @@ bool zigbee_is_zboss_thread_suspended(void)
 	}
 	return true;
 }
+
+/**@brief Function for getting the statistics of the application callback queue.
+ */
+void zigbee_debug_get_app_cb_queue_stats(struct zigbee_app_cb_queue_stats *stats)
+{
+	uint32_t tail = (uint32_t)atomic_get(&zb_app_cb_tail);
+
+	stats->capacity = ZB_APP_CB_RING_SIZE;
+	stats->depth = (uint32_t)atomic_get(&zb_app_cb_head) - tail;
+	stats->max_depth = (uint32_t)atomic_get(&zb_app_cb_max_depth);
+	stats->processed = (uint32_t)atomic_get(&zb_app_cb_processed);
+	stats->overflows = (uint32_t)atomic_get(&zb_app_cb_overflows);
+	stats->max_batch = (uint32_t)atomic_get(&zb_app_cb_max_batch);
+}
 #endif /* defined(CONFIG_ZIGBEE_DEBUG_FUNCTIONS) */
 
 /**@brief Function for checking if the Zigbee stack has been started.
@@ -148,133 +179,149 @@ bool zigbee_is_stack_started(void)
 	return stack_is_started;
 }
 
-static void zb_app_cb_process(zb_bufid_t bufid)
+static uint32_t zb_app_cb_slot_seq(const struct zb_app_cb_slot *slot)
 {
-	zb_ret_t ret_code = RET_OK;
-	zb_app_cb_t new_app_cb;
+	return (uint32_t)atomic_get((atomic_t *)&slot->seq) + (slot - zb_app_cb_ring);
+}
 
-	/* Mark the processing callback as non-scheduled. */
-	(void)atomic_set((atomic_t *)&zb_app_cb_process_scheduled, 0);
+static void zb_app_cb_slot_seq_set(struct zb_app_cb_slot *slot, uint32_t seq)
+{
+	(void)atomic_set(&slot->seq, (atomic_val_t)(seq - (slot - zb_app_cb_ring)));
+}
 
-	/**
-	 * From ZBOSS main loop context: process all requests.
-	 *
-	 * Note: the ZB_SCHEDULE_APP_ALARM is not thread-safe.
-	 */
-	while (!k_msgq_peek(&zb_app_cb_msgq, &new_app_cb)) {
-		switch (new_app_cb.type) {
-		case ZB_CALLBACK_TYPE_SINGLE_PARAM:
-			ret_code = zb_schedule_app_callback(
-					new_app_cb.func,
-					(zb_uint8_t)new_app_cb.param);
-			break;
-		case ZB_CALLBACK_TYPE_TWO_PARAMS:
-			ret_code = zb_schedule_app_callback2(
-					new_app_cb.func2,
-					(zb_uint8_t)new_app_cb.param,
-					new_app_cb.user_param);
-			break;
-		case ZB_CALLBACK_TYPE_ALARM_SET:
-		{
-			/**
-			 * Check if the timeout already passed. If so, use the
-			 * lowest value that schedules an alarm, so the user
-			 * is still able to cancel the alarm.
-			 */
-			zb_time_t delay =
-				(k_uptime_get() > new_app_cb.alarm_timestamp ?
-					1 :
-					ZB_MILLISECONDS_TO_BEACON_INTERVAL(
-						new_app_cb.alarm_timestamp -
-						k_uptime_get())
-				);
-			ret_code = zb_schedule_app_alarm(
-					new_app_cb.func,
-					(zb_uint8_t)new_app_cb.param,
-					delay);
-			break;
-		}
-		case ZB_CALLBACK_TYPE_ALARM_CANCEL:
-			ret_code = zb_schedule_alarm_cancel(
-					new_app_cb.func,
-					(zb_uint8_t)new_app_cb.param,
-					NULL);
-			break;
-		case ZB_GET_OUT_BUF_DELAYED:
-			ret_code = zb_buf_get_out_delayed_func(
-				TRACE_CALL(new_app_cb.func));
-			break;
-		case ZB_GET_IN_BUF_DELAYED:
-			ret_code = zb_buf_get_in_delayed_func(
-				TRACE_CALL(new_app_cb.func));
-			break;
-		case ZB_GET_OUT_BUF_DELAYED_EXT:
-			ret_code = zb_buf_get_out_delayed_ext_func(
-					TRACE_CALL(new_app_cb.func2),
-					new_app_cb.user_param,
-					new_app_cb.param);
-			break;
-		case ZB_GET_IN_BUF_DELAYED_EXT:
-			ret_code = zb_buf_get_in_delayed_ext_func(
-					TRACE_CALL(new_app_cb.func2),
-					new_app_cb.user_param,
-					new_app_cb.param);
-			break;
-		default:
-			break;
-		}
+static void zb_app_cb_stat_max_update(atomic_t *max, uint32_t value)
+{
+	atomic_val_t old_value = atomic_get(max);
 
-		/* Check for ZBOSS scheduler queue overflow. */
-		if (ret_code == RET_OVERFLOW) {
-			break;
+	while (value > (uint32_t)old_value && !atomic_cas(max, old_value, value)) {
+		old_value = atomic_get(max);
+	}
+}
+
+static zb_ret_t zb_app_cb_put(const zb_app_cb_t *app_cb)
+{
+	struct zb_app_cb_slot *slot;
+	uint32_t pos = (uint32_t)atomic_get(&zb_app_cb_head);
+
+	/* Claim the slot at the head position. */
+	while (true) {
+		slot = &zb_app_cb_ring[pos & ZB_APP_CB_RING_MASK];
+
+		int32_t diff = (int32_t)(zb_app_cb_slot_seq(slot) - pos);
+
+		if (diff == 0) {
+			if (atomic_cas(&zb_app_cb_head, pos, pos + 1)) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* The slot still holds a callback from the previous lap. */
+			(void)atomic_inc(&zb_app_cb_overflows);
+			return RET_OVERFLOW;
 		}
 
-		/* Flush the element from the message queue. */
-		k_msgq_get(&zb_app_cb_msgq, &new_app_cb, K_NO_WAIT);
+		/* Another producer claimed the slot, try again with the new head. */
+		pos = (uint32_t)atomic_get(&zb_app_cb_head);
 	}
 
-	/**
-	 * In case of overflow error - reschedule the processing callback
-	 * to process remaining requests later.
-	 */
-	if (ret_code == RET_OVERFLOW) {
-		k_work_submit(&zb_app_cb_work);
-	}
+	slot->app_cb = *app_cb;
+	zb_app_cb_slot_seq_set(slot, pos + 1);
+
+	zb_app_cb_stat_max_update(&zb_app_cb_max_depth,
+				  pos + 1 - (uint32_t)atomic_get(&zb_app_cb_tail));
+
+	zigbee_event_notify(ZIGBEE_EVENT_APP);
+
+	return RET_OK;
 }
 
-static void zb_app_cb_process_schedule(struct k_work *item)
+static zb_ret_t zb_app_cb_execute(const zb_app_cb_t *app_cb, int64_t *now)
 {
-	zb_app_cb_t new_app_cb;
+	switch (app_cb->type) {
+	case ZB_CALLBACK_TYPE_SINGLE_PARAM:
+		return zb_schedule_app_callback(app_cb->func, (zb_uint8_t)app_cb->param);
+	case ZB_CALLBACK_TYPE_TWO_PARAMS:
+		return zb_schedule_app_callback2(app_cb->func2, (zb_uint8_t)app_cb->param,
+						 app_cb->user_param);
+	case ZB_CALLBACK_TYPE_ALARM_SET:
+	{
+		/* Read the uptime once per batch. */
+		if (*now < 0) {
+			*now = k_uptime_get();
+		}
 
-	if (k_msgq_peek(&zb_app_cb_msgq, &new_app_cb)) {
-		return;
-	}
-
-	/* Check if processing callback is already scheduled. */
-	if (atomic_set((atomic_t *)&zb_app_cb_process_scheduled, 1) == 1) {
-		return;
-	}
+		/**
+		 * Check if the timeout already passed. If so, use the
+		 * lowest value that schedules an alarm, so the user
+		 * is still able to cancel the alarm.
+		 */
+		zb_time_t delay =
+			(*now > app_cb->alarm_timestamp ?
+				1 :
+				ZB_MILLISECONDS_TO_BEACON_INTERVAL(app_cb->alarm_timestamp - *now));
+
+		return zb_schedule_app_alarm(app_cb->func, (zb_uint8_t)app_cb->param, delay);
+	}
+	case ZB_CALLBACK_TYPE_ALARM_CANCEL:
+		return zb_schedule_alarm_cancel(app_cb->func, (zb_uint8_t)app_cb->param, NULL);
+	case ZB_GET_OUT_BUF_DELAYED:
+		return zb_buf_get_out_delayed_func(TRACE_CALL(app_cb->func));
+	case ZB_GET_IN_BUF_DELAYED:
+		return zb_buf_get_in_delayed_func(TRACE_CALL(app_cb->func));
+	case ZB_GET_OUT_BUF_DELAYED_EXT:
+		return zb_buf_get_out_delayed_ext_func(TRACE_CALL(app_cb->func2),
+						       app_cb->user_param, app_cb->param);
+	case ZB_GET_IN_BUF_DELAYED_EXT:
+		return zb_buf_get_in_delayed_ext_func(TRACE_CALL(app_cb->func2),
+						      app_cb->user_param, app_cb->param);
+	default:
+		return RET_OK;
+	}
+}
+
+static void zb_app_cb_process(void)
+{
+	struct zb_app_cb_slot *slot;
+	uint32_t tail = (uint32_t)atomic_get(&zb_app_cb_tail);
+	uint32_t batch = 0;
+	int64_t now = -1;
 
 	/**
-	 * From working thread, non-ISR context: schedule processing callback.
-	 * Repeat endlessly, because the user was already informed that the
-	 * request will be handled.
+	 * From ZBOSS main loop context: process the requests that are ready,
+	 * at most one ring length per main loop iteration.
 	 *
-	 * Note: the ZB_SCHEDULE_APP_CALLBACK is thread-safe.
+	 * Note: the ZB_SCHEDULE_APP_ALARM is not thread-safe.
 	 */
-	while (zb_schedule_app_callback(zb_app_cb_process, 0) != RET_OK) {
-		k_sleep(K_MSEC(1000));
+	while (batch < ZB_APP_CB_RING_SIZE) {
+		slot = &zb_app_cb_ring[tail & ZB_APP_CB_RING_MASK];
+
+		if (zb_app_cb_slot_seq(slot) != tail + 1) {
+			/* Empty, or the producer has not finished writing the slot. */
+			break;
+		}
+
+		/**
+		 * In case of ZBOSS scheduler queue overflow, leave the request
+		 * in the ring and retry in the next main loop iteration.
+		 */
+		if (zb_app_cb_execute(&slot->app_cb, &now) == RET_OVERFLOW) {
+			break;
+		}
+
+		/* Release the slot for the next lap. */
+		zb_app_cb_slot_seq_set(slot, tail + ZB_APP_CB_RING_SIZE);
+		tail++;
+		(void)atomic_set(&zb_app_cb_tail, tail);
+		batch++;
 	}
-	zigbee_event_notify(ZIGBEE_EVENT_APP);
 
-	(void)item;
+	if (batch > 0) {
+		(void)atomic_add(&zb_app_cb_processed, batch);
+		zb_app_cb_stat_max_update(&zb_app_cb_max_batch, batch);
+	}
 }
 
 int zigbee_init(void)
 {
-	/* Initialise work queue for processing app callback and alarms. */
-	k_work_init(&zb_app_cb_work, zb_app_cb_process_schedule);
-
 #if ZB_TRACE_LEVEL
 	/* Set Zigbee stack logging level and traffic dump subsystem. */
 	ZB_SET_TRACE_LEVEL(CONFIG_ZBOSS_TRACE_LOG_LEVEL);
@@ -355,6 +402,7 @@ static void zboss_thread(void *arg1, void *arg2, void *arg3)
 #endif /* defined(CONFIG_ZIGBEE_SHELL) */
 
 	while (1) {
+		zb_app_cb_process();
 		zboss_main_loop_iteration();
 	}
 }
@@ -390,12 +438,7 @@ zb_ret_t zigbee_schedule_callback(zb_callback_t func, zb_uint8_t param)
 		.param = param,
 	};
 
-	if (k_msgq_put(&zb_app_cb_msgq, &new_app_cb, K_NO_WAIT)) {
-		return RET_OVERFLOW;
-	}
-
-	k_work_submit(&zb_app_cb_work);
-	return RET_OK;
+	return zb_app_cb_put(&new_app_cb);
 }
 
 zb_ret_t zigbee_schedule_callback2(zb_callback2_t func,
@@ -413,12 +456,7 @@ zb_ret_t zigbee_schedule_callback2(zb_callback2_t func,
 		.user_param = user_param,
 	};
 
-	if (k_msgq_put(&zb_app_cb_msgq, &new_app_cb, K_NO_WAIT)) {
-		return RET_OVERFLOW;
-	}
-
-	k_work_submit(&zb_app_cb_work);
-	return RET_OK;
+	return zb_app_cb_put(&new_app_cb);
 }
 
 zb_ret_t zigbee_schedule_alarm(zb_callback_t func,
@@ -437,12 +475,7 @@ zb_ret_t zigbee_schedule_alarm(zb_callback_t func,
 				   ZB_TIME_BEACON_INTERVAL_TO_MSEC(run_after),
 	};
 
-	if (k_msgq_put(&zb_app_cb_msgq, &new_app_cb, K_NO_WAIT)) {
-		return RET_OVERFLOW;
-	}
-
-	k_work_submit(&zb_app_cb_work);
-	return RET_OK;
+	return zb_app_cb_put(&new_app_cb);
 }
 
 zb_ret_t zigbee_schedule_alarm_cancel(zb_callback_t func, zb_uint8_t param)
@@ -457,12 +490,7 @@ zb_ret_t zigbee_schedule_alarm_cancel(zb_callback_t func, zb_uint8_t param)
 		.param = param,
 	};
 
-	if (k_msgq_put(&zb_app_cb_msgq, &new_app_cb, K_NO_WAIT)) {
-		return RET_OVERFLOW;
-	}
-
-	k_work_submit(&zb_app_cb_work);
-	return RET_OK;
+	return zb_app_cb_put(&new_app_cb);
 }
 
 zb_ret_t zigbee_get_out_buf_delayed(zb_callback_t func)
@@ -476,12 +504,7 @@ zb_ret_t zigbee_get_out_buf_delayed(zb_callback_t func)
 		.func = func,
 	};
 
-	if (k_msgq_put(&zb_app_cb_msgq, &new_app_cb, K_NO_WAIT)) {
-		return RET_OVERFLOW;
-	}
-
-	k_work_submit(&zb_app_cb_work);
-	return RET_OK;
+	return zb_app_cb_put(&new_app_cb);
 }
 
 zb_ret_t zigbee_get_in_buf_delayed(zb_callback_t func)
@@ -495,12 +518,7 @@ zb_ret_t zigbee_get_in_buf_delayed(zb_callback_t func)
 		.func = func,
 	};
 
-	if (k_msgq_put(&zb_app_cb_msgq, &new_app_cb, K_NO_WAIT)) {
-		return RET_OVERFLOW;
-	}
-
-	k_work_submit(&zb_app_cb_work);
-	return RET_OK;
+	return zb_app_cb_put(&new_app_cb);
 }
 
 zb_ret_t zigbee_get_out_buf_delayed_ext(zb_callback2_t func, zb_uint16_t param,
@@ -517,12 +535,7 @@ zb_ret_t zigbee_get_out_buf_delayed_ext(zb_callback2_t func, zb_uint16_t param,
 		.param = max_size,
 	};
 
-	if (k_msgq_put(&zb_app_cb_msgq, &new_app_cb, K_NO_WAIT)) {
-		return RET_OVERFLOW;
-	}
-
-	k_work_submit(&zb_app_cb_work);
-	return RET_OK;
+	return zb_app_cb_put(&new_app_cb);
 }
 
 zb_ret_t zigbee_get_in_buf_delayed_ext(zb_callback2_t func, zb_uint16_t param,
@@ -539,12 +552,7 @@ zb_ret_t zigbee_get_in_buf_delayed_ext(zb_callback2_t func, zb_uint16_t param,
 		.param = max_size,
 	};
 
-	if (k_msgq_put(&zb_app_cb_msgq, &new_app_cb, K_NO_WAIT)) {
-		return RET_OVERFLOW;
-	}
-
-	k_work_submit(&zb_app_cb_work);
-	return RET_OK;
+	return zb_app_cb_put(&new_app_cb);
 }
 
 /**@brief SoC general initialization. */
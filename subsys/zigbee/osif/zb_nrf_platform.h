@@ -38,6 +38,24 @@ bool zigbee_is_stack_started(void);
 void zigbee_enable(void);
 
 #ifdef CONFIG_ZIGBEE_DEBUG_FUNCTIONS
+/**@brief Statistics of the queue passing application callbacks and alarms
+ *        to the ZBOSS thread.
+ */
+struct zigbee_app_cb_queue_stats {
+	/** Number of queue slots. */
+	uint32_t capacity;
+	/** Number of requests in the queue. */
+	uint32_t depth;
+	/** Highest number of requests in the queue. */
+	uint32_t max_depth;
+	/** Number of requests passed to the ZBOSS scheduler. */
+	uint32_t processed;
+	/** Number of requests rejected because the queue was full. */
+	uint32_t overflows;
+	/** Highest number of requests processed in one ZBOSS main loop iteration. */
+	uint32_t max_batch;
+};
+
 /**@brief Function for checking if the ZBOSS thread has been created.
  */
 bool zigbee_debug_zboss_thread_is_created(void);
@@ -59,6 +77,12 @@ void zigbee_debug_resume_zboss_thread(void);
  *                is created.
  */
 bool zigbee_is_zboss_thread_suspended(void);
+
+/**@brief Function for getting the statistics of the application callback queue.
+ *
+ * @param[out] stats  Pointer to the structure to fill.
+ */
+void zigbee_debug_get_app_cb_queue_stats(struct zigbee_app_cb_queue_stats *stats);
 #endif /* defined(CONFIG_ZIGBEE_DEBUG_FUNCTIONS) */
 
 /**
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CLOCK_BOTTOM_H_
+#define CLOCK_BOTTOM_H_
+
+#include <stdint.h>
+
+/* Host monotonic time in nanoseconds. Simulated time does not advance while
+ * the benchmark runs, so the host clock is used instead.
+ */
+uint64_t nwb_benchmark_host_time_ns(void);
+
+#endif /* CLOCK_BOTTOM_H_ */
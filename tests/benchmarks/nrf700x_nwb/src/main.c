@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(wifi_nrf, LOG_LEVEL_INF);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "shim.h"
+#include "nwb.h"
+#include "clock_bottom.h"
+
+/* Test configuration: */
+#define ITERATIONS  10000
+/* Default CONFIG_NRF700X_RX_MAX_DATA_SIZE of the driver */
+#define RX_BUF_SIZE 1600
+
+static const size_t frame_sizes[] = {64, 256, 512, 1024, 1500};
+
+static uint8_t frame[NET_ETH_MTU];
+
+static int bench_if_send(const struct device *dev, struct net_pkt *pkt)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static void bench_if_init(struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+}
+
+static const struct dummy_api bench_if_api = {
+	.iface_api.init = bench_if_init,
+	.send = bench_if_send,
+};
+
+NET_DEVICE_INIT(bench_if, "bench_if", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &bench_if_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_ETH_MTU);
+
+/* Throughput in Mbit/s of ITERATIONS frames of the given size. */
+static uint32_t throughput_mbps(size_t size, uint64_t elapsed_ns)
+{
+	return (uint32_t)((uint64_t)size * ITERATIONS * 8 * 1000 / MAX(elapsed_ns, 1));
+}
+
+/* Zero copy is used only for a single fragment with the headroom the driver needs. */
+static bool tx_zero_copy_expected(struct net_pkt *pkt)
+{
+	return IS_ENABLED(CONFIG_NRF700X_TX_ZERO_COPY) && !pkt->buffer->frags &&
+	       (net_buf_headroom(pkt->buffer) >= NWB_TX_HEADROOM);
+}
+
+static int tx_benchmark(struct net_if *iface, size_t size, size_t headroom,
+			uint64_t *elapsed_ns)
+{
+	struct net_pkt *pkt;
+	uint64_t start;
+	void *nbuf;
+	int err = 0;
+
+	pkt = net_pkt_alloc_with_buffer(iface, headroom + size, AF_UNSPEC, 0, K_NO_WAIT);
+	if (!pkt) {
+		LOG_ERR("Failed to allocate TX packet");
+		return -ENOMEM;
+	}
+
+	net_buf_reserve(pkt->buffer, headroom);
+
+	if (net_pkt_write(pkt, frame, size)) {
+		LOG_ERR("Failed to write TX packet");
+		err = -ENOBUFS;
+		goto out;
+	}
+
+	start = nwb_benchmark_host_time_ns();
+	for (int i = 0; i < ITERATIONS; i++) {
+		net_pkt_cursor_init(pkt);
+
+		nbuf = net_pkt_to_nbuf(pkt);
+		if (!nbuf) {
+			LOG_ERR("net_pkt_to_nbuf failed");
+			err = -ENOMEM;
+			goto out;
+		}
+
+		if ((i == 0) &&
+		    ((zep_shim_nbuf_data_size(nbuf) != size) ||
+		     memcmp(zep_shim_nbuf_data_get(nbuf), frame, size))) {
+			LOG_ERR("TX data does not match");
+			zep_shim_nbuf_free(nbuf);
+			err = -EIO;
+			goto out;
+		}
+
+		if ((i == 0) &&
+		    ((zep_shim_nbuf_headroom_get(nbuf) < NWB_TX_HEADROOM) ||
+		     ((zep_shim_nbuf_data_get(nbuf) == pkt->buffer->data) !=
+		      tx_zero_copy_expected(pkt)))) {
+			LOG_ERR("TX buffer without the headroom of %d bytes", NWB_TX_HEADROOM);
+			zep_shim_nbuf_free(nbuf);
+			err = -EIO;
+			goto out;
+		}
+
+		/* Done by the driver when the transmission completes. */
+		zep_shim_nbuf_free(nbuf);
+	}
+	*elapsed_ns = nwb_benchmark_host_time_ns() - start;
+
+out:
+	net_pkt_unref(pkt);
+
+	return err;
+}
+
+static int rx_benchmark(struct net_if *iface, size_t size, uint64_t *elapsed_ns)
+{
+	struct net_pkt *pkt;
+	uint8_t buf[16];
+	uint64_t start;
+	void *nbuf;
+
+	start = nwb_benchmark_host_time_ns();
+	for (int i = 0; i < ITERATIONS; i++) {
+		/* RX buffer provided to the nRF700x and filled with a received frame. */
+		nbuf = zep_shim_nbuf_alloc(RX_BUF_SIZE);
+		if (!nbuf) {
+			LOG_ERR("zep_shim_nbuf_alloc failed");
+			return -ENOMEM;
+		}
+
+		memcpy(zep_shim_nbuf_data_put(nbuf, size), frame, size);
+
+		pkt = net_pkt_from_nbuf(iface, nbuf);
+		if (!pkt) {
+			LOG_ERR("net_pkt_from_nbuf failed");
+			return -ENOMEM;
+		}
+
+		net_pkt_cursor_init(pkt);
+
+		if ((i == 0) &&
+		    ((net_pkt_get_len(pkt) != size) ||
+		     net_pkt_read(pkt, buf, sizeof(buf)) ||
+		     memcmp(buf, frame, sizeof(buf)))) {
+			LOG_ERR("RX data does not match");
+			net_pkt_unref(pkt);
+			return -EIO;
+		}
+
+		/* Done by the networking stack when the packet is consumed. */
+		net_pkt_unref(pkt);
+	}
+	*elapsed_ns = nwb_benchmark_host_time_ns() - start;
+
+	return 0;
+}
+
+int main(void)
+{
+	struct net_if *iface = net_if_get_default();
+	uint64_t tx_ns;
+	uint64_t tx_no_headroom_ns;
+	uint64_t rx_ns;
+	int err;
+
+	for (size_t i = 0; i < sizeof(frame); i++) {
+		frame[i] = i;
+	}
+
+	LOG_INF("Pool: %s, TX zero copy: %s",
+		IS_ENABLED(CONFIG_NRF700X_NWB_POOL) ? "yes" : "no",
+		IS_ENABLED(CONFIG_NRF700X_TX_ZERO_COPY) ? "yes" : "no");
+	/* TX packets are sent with the headroom the driver needs, and without any
+	 * headroom, which makes the driver copy them even with zero copy enabled.
+	 */
+	LOG_INF("size  TX [ns] TX [Mbit/s] TX no headroom [ns]  RX [ns] RX [Mbit/s]");
+
+	for (size_t i = 0; i < ARRAY_SIZE(frame_sizes); i++) {
+		err = tx_benchmark(iface, frame_sizes[i], NWB_TX_HEADROOM, &tx_ns);
+		if (err) {
+			return 0;
+		}
+
+		err = tx_benchmark(iface, frame_sizes[i], 0, &tx_no_headroom_ns);
+		if (err) {
+			return 0;
+		}
+
+		err = rx_benchmark(iface, frame_sizes[i], &rx_ns);
+		if (err) {
+			return 0;
+		}
+
+		LOG_INF("%4zu %8u %11u %19u %8u %11u", frame_sizes[i],
+			(uint32_t)(tx_ns / ITERATIONS), throughput_mbps(frame_sizes[i], tx_ns),
+			(uint32_t)(tx_no_headroom_ns / ITERATIONS),
+			(uint32_t)(rx_ns / ITERATIONS), throughput_mbps(frame_sizes[i], rx_ns));
+	}
+
+	LOG_INF("Benchmark finished");
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(app, LOG_LEVEL_INF);
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <psa/crypto.h>
+#include <psa/internal_trusted_storage.h>
+#include <psa/protected_storage.h>
+
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_DERIVE_FROM_HUK)
+#include <hw_unique_key.h>
+#endif
+
+/* Test configuration: */
+#define ITERATIONS  100
+#define ACCESS_SIZE 16
+#define ASSET_UID   0x5EB0
+
+static const size_t asset_sizes[] = {16, 64, 128, 256, 512, 1024};
+
+static uint8_t asset_data[CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_MAX_DATA_SIZE];
+
+static uint32_t average_us(uint32_t start, uint32_t end)
+{
+	return k_cyc_to_us_floor32(end - start) / ITERATIONS;
+}
+
+static int read_benchmark(size_t asset_size, uint32_t *latency_us)
+{
+	uint8_t buf[ACCESS_SIZE];
+	size_t offset = (asset_size - ACCESS_SIZE) / 2;
+	size_t length;
+	psa_status_t status;
+	uint32_t start;
+
+	status = psa_its_set(ASSET_UID, asset_size, asset_data, PSA_STORAGE_FLAG_NONE);
+	if (status != PSA_SUCCESS) {
+		LOG_ERR("psa_its_set failed, status %d", status);
+		return -EIO;
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		status = psa_its_get(ASSET_UID, offset, sizeof(buf), buf, &length);
+		if (status != PSA_SUCCESS || length != sizeof(buf)) {
+			LOG_ERR("psa_its_get failed, status %d", status);
+			return -EIO;
+		}
+	}
+	*latency_us = average_us(start, k_cycle_get_32());
+
+	if (memcmp(buf, asset_data + offset, sizeof(buf)) != 0) {
+		LOG_ERR("Read data does not match");
+		return -EIO;
+	}
+
+	psa_its_remove(ASSET_UID);
+
+	return 0;
+}
+
+static int write_benchmark(size_t asset_size, uint32_t *latency_us)
+{
+	size_t offset = (asset_size - ACCESS_SIZE) / 2;
+	psa_status_t status;
+	uint32_t start;
+
+	status = psa_ps_set(ASSET_UID, asset_size, asset_data, PSA_STORAGE_FLAG_NONE);
+	if (status != PSA_SUCCESS) {
+		LOG_ERR("psa_ps_set failed, status %d", status);
+		return -EIO;
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		status = psa_ps_set_extended(ASSET_UID, offset, ACCESS_SIZE, asset_data + offset);
+		if (status != PSA_SUCCESS) {
+			LOG_ERR("psa_ps_set_extended failed, status %d", status);
+			return -EIO;
+		}
+	}
+	*latency_us = average_us(start, k_cycle_get_32());
+
+	psa_ps_remove(ASSET_UID);
+
+	return 0;
+}
+
+int main(void)
+{
+	bool set_extended = (psa_ps_get_support() & PSA_STORAGE_SUPPORT_SET_EXTENDED) != 0;
+	uint32_t read_us;
+	uint32_t write_us;
+	int err;
+
+	err = settings_subsys_init();
+	if (err) {
+		LOG_ERR("settings_subsys_init failed, err %d", err);
+		return 0;
+	}
+
+	if (psa_crypto_init() != PSA_SUCCESS) {
+		LOG_ERR("psa_crypto_init failed");
+		return 0;
+	}
+
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_KEY_DERIVE_FROM_HUK)
+	if (!hw_unique_key_are_any_written()) {
+		err = hw_unique_key_write_random();
+		if (err != HW_UNIQUE_KEY_SUCCESS) {
+			LOG_ERR("hw_unique_key_write_random failed, err %d", err);
+			return 0;
+		}
+	}
+#endif
+
+	for (size_t i = 0; i < sizeof(asset_data); i++) {
+		asset_data[i] = i;
+	}
+
+	LOG_INF("size  read [us] write [us]");
+
+	for (size_t i = 0; i < ARRAY_SIZE(asset_sizes); i++) {
+		if (asset_sizes[i] > sizeof(asset_data)) {
+			break;
+		}
+
+		err = read_benchmark(asset_sizes[i], &read_us);
+		if (err) {
+			return 0;
+		}
+
+		if (set_extended) {
+			err = write_benchmark(asset_sizes[i], &write_us);
+			if (err) {
+				return 0;
+			}
+			LOG_INF("%4zu %9u %10u", asset_sizes[i], read_us, write_us);
+		} else {
+			LOG_INF("%4zu %9u          -", asset_sizes[i], read_us);
+		}
+	}
+
+	LOG_INF("Benchmark finished");
+
+	return 0;
+}
@@ -7,11 +7,36 @@
 #include <zephyr/ztest.h>
 #include <ei_run_classifier.h>
 
+#define SLICE_SIZE (EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE / EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW)
+
 static size_t prediction_idx;
 
+/* Input window rebuilt from slices passed to the continuous classifier. */
+static float window_buf[EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE];
+static size_t slices_fed;
+static size_t slice_cnt;
+
 void ei_run_classifier_mock_init(void)
 {
 	prediction_idx = 0;
+	slices_fed = 0;
+	slice_cnt = 0;
+}
+
+size_t ei_run_classifier_mock_slice_cnt(void)
+{
+	return slice_cnt;
+}
+
+static void verify_window(const float *data, size_t data_size, const size_t prediction_idx)
+{
+	float value = EI_MOCK_GEN_FIRST_INPUT(prediction_idx);
+
+	for (size_t off = 0; off < data_size; off++) {
+		zassert_within(data[off], value, FLOAT_CMP_EPSILON,
+			       "Input data error");
+		value++;
+	}
 }
 
 /* Input data must be ascending sequence of floats. Difference between
@@ -37,28 +62,11 @@ static void verify_data_read(signal_t *signal, const size_t prediction_idx,
 		zassert_ok(err, "get_data returned an error");
 	}
 
-	float value = EI_MOCK_GEN_FIRST_INPUT(prediction_idx);;
-
-	for (size_t off = 0; off < data_size; off++) {
-		zassert_within(data_buf[off], value, FLOAT_CMP_EPSILON,
-			       "Input data error");
-		value++;
-	}
+	verify_window(data_buf, data_size, prediction_idx);
 }
 
-EI_IMPULSE_ERROR run_classifier(signal_t *signal,
-				ei_impulse_result_t *result,
-				bool debug)
+static EI_IMPULSE_ERROR result_fill(ei_impulse_result_t *result)
 {
-	ARG_UNUSED(debug);
-
-	/* Test getting data. */
-	verify_data_read(signal, prediction_idx, 1);
-	verify_data_read(signal, prediction_idx,
-			 EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME);
-	verify_data_read(signal, prediction_idx,
-			 EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE);
-
 	/* Busy wait for predefined amount of time to simulate calculations. */
 	k_busy_wait(EI_MOCK_BUSY_WAIT_TIME);
 
@@ -91,3 +99,68 @@ EI_IMPULSE_ERROR run_classifier(signal_t *signal,
 
 	return EI_IMPULSE_OK;
 }
+
+EI_IMPULSE_ERROR run_classifier(signal_t *signal,
+				ei_impulse_result_t *result,
+				bool debug)
+{
+	ARG_UNUSED(debug);
+
+	zassert_equal(signal->total_length, EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE,
+		      "Wrong signal length");
+
+	/* Test getting data. */
+	verify_data_read(signal, prediction_idx, 1);
+	verify_data_read(signal, prediction_idx,
+			 EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME);
+	verify_data_read(signal, prediction_idx,
+			 EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE);
+
+	return result_fill(result);
+}
+
+void run_classifier_init(void)
+{
+	slices_fed = 0;
+}
+
+EI_IMPULSE_ERROR run_classifier_continuous(signal_t *signal,
+					   ei_impulse_result_t *result,
+					   bool debug,
+					   bool enable_maf)
+{
+	ARG_UNUSED(debug);
+	ARG_UNUSED(enable_maf);
+
+	static float slice_buf[SLICE_SIZE];
+	float *slice_dst = &window_buf[ARRAY_SIZE(window_buf) - SLICE_SIZE];
+
+	zassert_equal(signal->total_length, SLICE_SIZE, "Wrong signal length");
+
+	memmove(window_buf, &window_buf[SLICE_SIZE],
+		(ARRAY_SIZE(window_buf) - SLICE_SIZE) * sizeof(window_buf[0]));
+
+	/* Test getting data, the slice must be the same for every chunk size. */
+	for (size_t off = 0; off < SLICE_SIZE; off++) {
+		zassert_ok(signal->get_data(off, 1, &slice_dst[off]), "get_data returned an error");
+	}
+
+	zassert_ok(signal->get_data(0, SLICE_SIZE, slice_buf), "get_data returned an error");
+	zassert_mem_equal(slice_buf, slice_dst, sizeof(slice_buf), "Wrong slice data");
+
+	slice_cnt++;
+	slices_fed++;
+
+	/* Like the library, run the classifier only when features of the whole window
+	 * are available. DSP time is reported only for the classified window to keep
+	 * the expected timing independent of the number of computed slices.
+	 */
+	if (slices_fed < EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW) {
+		memset(result, 0, sizeof(*result));
+		return EI_IMPULSE_OK;
+	}
+
+	verify_window(window_buf, ARRAY_SIZE(window_buf), prediction_idx);
+
+	return result_fill(result);
+}
@@ -19,6 +19,11 @@
 #define EI_CLASSIFIER_HAS_ANOMALY		1
 #define EI_CLASSIFIER_FREQUENCY			60
 
+/* Continuous classification splits the input window into slices. */
+#ifndef EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW
+#define EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW	4
+#endif
+
 /* Mocked results. */
 static const char * const ei_classifier_inferencing_categories[] = {
 	"label1", "label2", "label3", "label4"
@@ -347,6 +347,50 @@ ZTEST(suite0, test_sliding_window)
 	}
 }
 
+ZTEST(suite0, test_continuous_feature_cache)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_EI_WRAPPER_CONTINUOUS);
+
+	const static size_t slice_size = EI_CLASSIFIER_DSP_INPUT_FRAME_SIZE /
+					 EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW;
+	const static size_t loop_cnt = 50;
+	int err;
+
+	/* The mocked library expects the window to move by a frame between predictions. */
+	zassert_equal(slice_size, EI_CLASSIFIER_RAW_SAMPLES_PER_FRAME,
+		      "Slice must be a single frame for this test");
+
+	err = add_input_data(prediction_idx, loop_cnt);
+	zassert_ok(err, "Cannot add input data");
+
+	for (size_t i = 0; i <= loop_cnt; i++) {
+		size_t frame_shift = (i == 0) ? (0) : (1);
+
+		err = ei_wrapper_start_prediction(0, frame_shift);
+		zassert_ok(err, "Cannot start prediction");
+		err = k_sem_take(&test_sem, EI_TEST_SEM_TIMEOUT);
+		zassert_ok(err, "Cannot take semaphore");
+	}
+
+	/* Features of the whole window are computed once, then only for the new slice. */
+	zassert_equal(ei_run_classifier_mock_slice_cnt(),
+		      EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW + loop_cnt,
+		      "Cached features were not reused");
+
+	/* Shift by more than one slice computes features of all slices. */
+	err = add_input_data(prediction_idx, 0);
+	zassert_ok(err, "Cannot add input data");
+
+	err = ei_wrapper_start_prediction(1, 0);
+	zassert_ok(err, "Cannot start prediction");
+	err = k_sem_take(&test_sem, EI_TEST_SEM_TIMEOUT);
+	zassert_ok(err, "Cannot take semaphore");
+
+	zassert_equal(ei_run_classifier_mock_slice_cnt(),
+		      2 * EI_CLASSIFIER_SLICES_PER_MODEL_WINDOW + loop_cnt,
+		      "Features not computed for all slices");
+}
+
 ZTEST(suite0, test_data_after_start)
 {
 	static const size_t loop_cnt = 10;
@@ -986,6 +986,112 @@ void test_location_cellular(void)
 #endif
 }
 
+/* Test that a stationary device gets the previous location from the cache. */
+void test_location_cache_stationary(void)
+{
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR};
+
+	location_cache_clear();
+	location_cache_stationary_set(true);
+
+	location_config_defaults_set(&config, 1, methods);
+
+	config.methods[0].cellular.cell_count = 1;
+	config.cache_max_age = 60;
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+#endif
+
+#if defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_CLOUD_LOCATION_EXT_REQUEST;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+#endif
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_LOCATION;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	test_location_event_data[location_cb_expected].location.latitude = 61.50375;
+	test_location_event_data[location_cb_expected].location.longitude = 23.896979;
+	test_location_event_data[location_cb_expected].location.accuracy = 750.0;
+	test_location_event_data[location_cb_expected].location.datetime.valid = false;
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	test_location_event_data[location_cb_expected].location.details.cellular.ncells_count = 1;
+#endif
+	location_cb_expected++;
+
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+#if !defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+	__cmock_nrf_modem_at_cmd_ExpectAndReturn(NULL, 0, "AT+CGACT?", 0);
+	__cmock_nrf_modem_at_cmd_IgnoreArg_buf();
+	__cmock_nrf_modem_at_cmd_IgnoreArg_len();
+	__cmock_nrf_modem_at_cmd_ReturnArrayThruPtr_buf(
+		(char *)cgact_resp_active, sizeof(cgact_resp_active));
+
+	cellular_rest_req_resp_handle(location_cb_expected - 1);
+
+	rest_req_ctx.url = "here.api";
+	rest_req_ctx.sec_tag = CONFIG_LOCATION_SERVICE_HERE_TLS_SEC_TAG;
+	rest_req_ctx.port = HTTPS_PORT;
+	rest_req_ctx.host = CONFIG_LOCATION_SERVICE_HERE_HOSTNAME;
+#endif
+	/* Nothing cached yet so the location is acquired normally */
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+	k_sleep(K_MSEC(1));
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	/* Wait for LOCATION_EVT_STARTED */
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+#endif
+
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+	k_sleep(K_MSEC(1));
+
+#if defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	struct location_data location_data = {
+		.latitude = 61.50375,
+		.longitude = 23.896979,
+		.accuracy = 750.0,
+		.datetime.valid = false
+	};
+
+	location_cloud_location_ext_result_set(LOCATION_EXT_RESULT_SUCCESS, &location_data);
+	k_sleep(K_MSEC(1));
+#endif
+
+	/* Wait for LOCATION_EVT_LOCATION */
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	/* The device has not moved so the same location is given without any scanning */
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_LOCATION;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	test_location_event_data[location_cb_expected].location.latitude = 61.50375;
+	test_location_event_data[location_cb_expected].location.longitude = 23.896979;
+	test_location_event_data[location_cb_expected].location.accuracy = 750.0;
+	test_location_event_data[location_cb_expected].location.datetime.valid = false;
+	location_cb_expected++;
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+
+	location_cache_stationary_set(false);
+	location_cache_clear();
+}
+
 /* Test cancelling cellular location request during NCELLMEAS. */
 void test_location_cellular_cancel_during_ncellmeas(void)
 {
@@ -1370,6 +1476,53 @@ void test_error_wifi_cellular_method(void)
 	TEST_ASSERT_EQUAL(-EINVAL, err);
 }
 
+/* Test parallel location request with the same method twice. */
+void test_error_parallel_duplicate_method(void)
+{
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_GNSS, LOCATION_METHOD_GNSS};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_PARALLEL;
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+}
+
+/* Test parallel location request with negative accuracy. */
+void test_error_parallel_negative_accuracy(void)
+{
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_GNSS, LOCATION_METHOD_CELLULAR};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_PARALLEL;
+	config.parallel_accuracy = -1;
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+}
+
+/* Test parallel location request with different services for Wi-Fi and cellular. */
+void test_error_parallel_different_services(void)
+{
+#if defined(CONFIG_LOCATION_METHOD_WIFI)
+	int err;
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_WIFI, LOCATION_METHOD_CELLULAR};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_PARALLEL;
+	config.methods[0].wifi.service = LOCATION_SERVICE_HERE;
+	config.methods[1].cellular.service = LOCATION_SERVICE_NRF_CLOUD;
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(-EINVAL, err);
+#endif
+}
+
 /* Test cancelling location request when there is no pending location request. */
 void test_error_cancel_no_operation(void)
 {
@@ -1805,6 +1958,314 @@ void test_location_request_mode_all_cellular_error_gnss_timeout(void)
 	k_sleep(K_MSEC(1));
 }
 
+/* Test parallel location request:
+ * - Use cellular and GNSS positioning and error and timeout occurs, respectively
+ * - Both methods are started at the same time
+ * - Only one event is sent and it is the result of cellular, which has the higher priority
+ */
+void test_location_request_mode_parallel_cellular_error_gnss_timeout(void)
+{
+	int err;
+
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR, LOCATION_METHOD_GNSS};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_PARALLEL;
+	config.methods[0].cellular.cell_count = 1;
+	config.methods[1].gnss.timeout = 100;
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_GNSS;
+	location_cb_expected++;
+#endif
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_ERROR;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+
+	/***** Cellular positioning *****/
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", -EFAULT);
+
+	/***** GNSS positioning *****/
+	__cmock_nrf_modem_gnss_event_handler_set_ExpectAndReturn(&method_gnss_event_handler, 0);
+
+#if defined(CONFIG_LOCATION_TEST_AGNSS)
+	struct nrf_modem_gnss_agnss_expiry agnss_expiry = {
+		.data_flags = 0,
+		.utc_expiry = 0xffff,
+		.klob_expiry = 0xffff,
+		.neq_expiry = 0xffff,
+		.integrity_expiry = 0xffff,
+		.position_expiry = 0xffff };
+
+	__cmock_nrf_modem_gnss_agnss_expiry_get_ExpectAndReturn(NULL, 0);
+	__cmock_nrf_modem_gnss_agnss_expiry_get_IgnoreArg_agnss_expiry();
+	__cmock_nrf_modem_gnss_agnss_expiry_get_ReturnMemThruPtr_agnss_expiry(
+		&agnss_expiry, sizeof(agnss_expiry));
+#endif
+	__cmock_nrf_modem_gnss_fix_interval_set_ExpectAndReturn(1, 0);
+	__cmock_nrf_modem_gnss_use_case_set_ExpectAndReturn(
+		NRF_MODEM_GNSS_USE_CASE_MULTIPLE_HOT_START, 0);
+	__cmock_nrf_modem_gnss_start_ExpectAndReturn(0);
+
+	/* TODO: Cannot determine the used system mode but it's set as zero by default in lte_lc */
+	__mock_nrf_modem_at_scanf_ExpectAndReturn(
+		"AT%XSYSTEMMODE?", "%%XSYSTEMMODE: %d,%d,%d,%d", 4);
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* LTE-M support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* NB-IoT support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* GNSS support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(0); /* LTE preference */
+
+#if !defined(CONFIG_LOCATION_TEST_AGNSS)
+	__cmock_nrf_modem_at_cmd_ExpectAndReturn(NULL, 0, "AT%%XMONITOR", 0);
+	__cmock_nrf_modem_at_cmd_IgnoreArg_buf();
+	__cmock_nrf_modem_at_cmd_IgnoreArg_len();
+	__cmock_nrf_modem_at_cmd_ReturnArrayThruPtr_buf(
+		(char *)xmonitor_resp, sizeof(xmonitor_resp));
+#endif
+	__cmock_nrf_modem_gnss_stop_ExpectAndReturn(0);
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	/* Wait for LOCATION_EVT_STARTED events, which are sent when starting the methods */
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+#endif
+
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+}
+
+/* Set the PVT data reported by GNSS in parallel location request tests and
+ * the location event it results in.
+ */
+static void parallel_gnss_location_set(int test_event_data_index)
+{
+	struct location_event_data *expected = &test_location_event_data[test_event_data_index];
+
+	test_pvt_data.flags = NRF_MODEM_GNSS_PVT_FLAG_FIX_VALID;
+	test_pvt_data.latitude = 61.005;
+	test_pvt_data.longitude = -45.997;
+	test_pvt_data.accuracy = 15.83;
+	test_pvt_data.datetime.year = 2021;
+	test_pvt_data.datetime.month = 8;
+	test_pvt_data.datetime.day = 13;
+	test_pvt_data.datetime.hour = 12;
+	test_pvt_data.datetime.minute = 34;
+	test_pvt_data.datetime.seconds = 56;
+	test_pvt_data.datetime.ms = 789;
+
+	expected->id = LOCATION_EVT_LOCATION;
+	expected->method = LOCATION_METHOD_GNSS;
+	expected->location.latitude = 61.005;
+	expected->location.longitude = -45.997;
+	expected->location.accuracy = 15.83;
+	expected->location.datetime.valid = true;
+	expected->location.datetime.year = 2021;
+	expected->location.datetime.month = 8;
+	expected->location.datetime.day = 13;
+	expected->location.datetime.hour = 12;
+	expected->location.datetime.minute = 34;
+	expected->location.datetime.second = 56;
+	expected->location.datetime.ms = 789;
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	expected->location.details.gnss.pvt_data = test_pvt_data;
+#endif
+}
+
+/* Set the expectations for starting GNSS in parallel location request tests.
+ * GNSS starts right away without A-GNSS request and after RRC idle without PSM.
+ */
+static void parallel_gnss_start_expect(void)
+{
+	__cmock_nrf_modem_gnss_event_handler_set_ExpectAndReturn(&method_gnss_event_handler, 0);
+
+#if defined(CONFIG_LOCATION_TEST_AGNSS)
+	static struct nrf_modem_gnss_agnss_expiry agnss_expiry = {
+		.data_flags = 0,
+		.utc_expiry = 0xffff,
+		.klob_expiry = 0xffff,
+		.neq_expiry = 0xffff,
+		.integrity_expiry = 0xffff,
+		.position_expiry = 0xffff };
+
+	__cmock_nrf_modem_gnss_agnss_expiry_get_ExpectAndReturn(NULL, 0);
+	__cmock_nrf_modem_gnss_agnss_expiry_get_IgnoreArg_agnss_expiry();
+	__cmock_nrf_modem_gnss_agnss_expiry_get_ReturnMemThruPtr_agnss_expiry(
+		&agnss_expiry, sizeof(agnss_expiry));
+#endif
+	__cmock_nrf_modem_gnss_fix_interval_set_ExpectAndReturn(1, 0);
+	__cmock_nrf_modem_gnss_use_case_set_ExpectAndReturn(
+		NRF_MODEM_GNSS_USE_CASE_MULTIPLE_HOT_START, 0);
+	__cmock_nrf_modem_gnss_start_ExpectAndReturn(0);
+
+	/* TODO: Cannot determine the used system mode but it's set as zero by default in lte_lc */
+	__mock_nrf_modem_at_scanf_ExpectAndReturn(
+		"AT%XSYSTEMMODE?", "%%XSYSTEMMODE: %d,%d,%d,%d", 4);
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* LTE-M support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* NB-IoT support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(1); /* GNSS support */
+	__mock_nrf_modem_at_scanf_ReturnVarg_int(0); /* LTE preference */
+
+#if !defined(CONFIG_LOCATION_TEST_AGNSS)
+	__cmock_nrf_modem_at_cmd_ExpectAndReturn(NULL, 0, "AT%%XMONITOR", 0);
+	__cmock_nrf_modem_at_cmd_IgnoreArg_buf();
+	__cmock_nrf_modem_at_cmd_IgnoreArg_len();
+	__cmock_nrf_modem_at_cmd_ReturnArrayThruPtr_buf(
+		(char *)xmonitor_resp, sizeof(xmonitor_resp));
+#endif
+}
+
+/* Send a GNSS fix in parallel location request tests. */
+static void parallel_gnss_pvt_send(void)
+{
+	__cmock_nrf_modem_gnss_read_ExpectAndReturn(
+		NULL, sizeof(test_pvt_data), NRF_MODEM_GNSS_DATA_PVT, 0);
+	__cmock_nrf_modem_gnss_read_IgnoreArg_buf();
+	__cmock_nrf_modem_gnss_read_ReturnMemThruPtr_buf(&test_pvt_data, sizeof(test_pvt_data));
+	__cmock_nrf_modem_gnss_stop_ExpectAndReturn(0);
+	method_gnss_event_handler(NRF_MODEM_GNSS_EVT_PVT);
+	k_sleep(K_MSEC(1));
+}
+
+/* Test parallel location request:
+ * - Use cellular and GNSS positioning
+ * - GNSS location is within the parallel accuracy and completes the request
+ * - Cellular positioning, which is still running, is cancelled
+ */
+void test_location_request_mode_parallel_gnss_location_cellular_cancelled(void)
+{
+	int err;
+
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR, LOCATION_METHOD_GNSS};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_PARALLEL;
+	config.parallel_accuracy = 20;
+	config.methods[0].cellular.cell_count = 1;
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_GNSS;
+	location_cb_expected++;
+#endif
+	parallel_gnss_location_set(location_cb_expected);
+	location_cb_expected++;
+
+	/***** Cellular positioning *****/
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+	/***** GNSS positioning *****/
+	parallel_gnss_start_expect();
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	/* Wait for LOCATION_EVT_STARTED events, which are sent when starting the methods */
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+#endif
+
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+
+	/* Completing the request cancels the ongoing NCELLMEAS */
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEASSTOP", 0);
+
+	parallel_gnss_pvt_send();
+}
+
+/* Test parallel location request:
+ * - Use cellular and GNSS positioning
+ * - GNSS location is less accurate than the parallel accuracy so the request continues
+ * - Cellular location is less accurate than the GNSS location
+ * - Request completes once both methods are done and the GNSS location is reported
+ */
+void test_location_request_mode_parallel_accuracy_not_reached(void)
+{
+#if !defined(CONFIG_LOCATION_SERVICE_EXTERNAL)
+	int err;
+
+	struct location_config config = { 0 };
+	enum location_method methods[] = {LOCATION_METHOD_CELLULAR, LOCATION_METHOD_GNSS};
+
+	location_config_defaults_set(&config, 2, methods);
+	config.mode = LOCATION_REQ_MODE_PARALLEL;
+	config.parallel_accuracy = 10;
+	config.methods[0].cellular.cell_count = 1;
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_CELLULAR;
+	location_cb_expected++;
+
+	test_location_event_data[location_cb_expected].id = LOCATION_EVT_STARTED;
+	test_location_event_data[location_cb_expected].method = LOCATION_METHOD_GNSS;
+	location_cb_expected++;
+#endif
+	parallel_gnss_location_set(location_cb_expected);
+	location_cb_expected++;
+
+	/* Cellular location is not reported, so it is composed after the expected events */
+	test_location_event_data[location_cb_expected].location.latitude = 61.50375;
+	test_location_event_data[location_cb_expected].location.longitude = 23.896979;
+	test_location_event_data[location_cb_expected].location.accuracy = 750.0;
+
+	/***** Cellular positioning *****/
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS=1", 0);
+
+	/***** GNSS positioning *****/
+	parallel_gnss_start_expect();
+
+	err = location_request(&config);
+	TEST_ASSERT_EQUAL(0, err);
+
+#if defined(CONFIG_LOCATION_DATA_DETAILS)
+	/* Wait for LOCATION_EVT_STARTED events, which are sent when starting the methods */
+	err = k_sem_take(&event_handler_called_sem, K_SECONDS(3));
+	TEST_ASSERT_EQUAL(0, err);
+#endif
+
+	at_monitor_dispatch("+CSCON: 0");
+	k_sleep(K_MSEC(1));
+
+	/* GNSS location does not complete the request */
+	parallel_gnss_pvt_send();
+	TEST_ASSERT_EQUAL(location_cb_expected - 1, location_cb_occurred);
+
+	__cmock_nrf_modem_at_cmd_ExpectAndReturn(NULL, 0, "AT+CGACT?", 0);
+	__cmock_nrf_modem_at_cmd_IgnoreArg_buf();
+	__cmock_nrf_modem_at_cmd_IgnoreArg_len();
+	__cmock_nrf_modem_at_cmd_ReturnArrayThruPtr_buf(
+		(char *)cgact_resp_active, sizeof(cgact_resp_active));
+
+	cellular_rest_req_resp_handle(location_cb_expected);
+
+	/* Select cellular service to be used */
+	rest_req_ctx.url = "here.api"; /* Needs a fix once rest_req_ctx is verified */
+	rest_req_ctx.sec_tag = CONFIG_LOCATION_SERVICE_HERE_TLS_SEC_TAG;
+	rest_req_ctx.port = HTTPS_PORT;
+	rest_req_ctx.host = CONFIG_LOCATION_SERVICE_HERE_HOSTNAME;
+
+	/* Cellular location completes the request */
+	at_monitor_dispatch(ncellmeas_resp_pci1);
+	k_sleep(K_MSEC(1));
+#endif
+}
+
 /********* TESTS PERIODIC POSITIONING REQUESTS ***********************/
 
 /* Test periodic location request and cancel it once some iterations are done. */
@@ -273,6 +273,53 @@ void test_parse_xmodemsleep(void)
 
 }
 
+void test_parse_ncellmeas(void)
+{
+	int err;
+	struct lte_lc_ncell ncells[CONFIG_LTE_NEIGHBOR_CELLS_MAX];
+	struct lte_lc_cells_info cells = {
+		.neighbor_cells = ncells,
+	};
+	char *at_response_ta_meas_time =
+		"%NCELLMEAS: 0,\"00112233\",\"98712\",\"0AB9\",4800,7,63,31,"
+		"456,4800,8,60,29,4,3500,9,99,18,5,5300,11\r\n";
+	char *at_response_no_ta_meas_time =
+		"%NCELLMEAS: 0,\"00112233\",\"98712\",\"0AB9\",4800,7,63,31,"
+		"456,4800,8,60,29,4,3500\r\n";
+	char *at_response_malformed =
+		"%NCELLMEAS: 0,\"00112233\",\"98712\",\"0AB9\",4800,7,63,31,"
+		"456,4800,8,60,29,4,3500,\"11\"\r\n";
+
+	err = parse_ncellmeas(at_response_ta_meas_time, &cells);
+	TEST_ASSERT_EQUAL(0, err);
+	TEST_ASSERT_EQUAL(0x00112233, cells.current_cell.id);
+	TEST_ASSERT_EQUAL(987, cells.current_cell.mcc);
+	TEST_ASSERT_EQUAL(12, cells.current_cell.mnc);
+	TEST_ASSERT_EQUAL(0x0AB9, cells.current_cell.tac);
+	TEST_ASSERT_EQUAL(4800, cells.current_cell.measurement_time);
+	TEST_ASSERT_EQUAL(11, cells.current_cell.timing_advance_meas_time);
+	TEST_ASSERT_EQUAL(2, cells.ncells_count);
+	TEST_ASSERT_EQUAL(8, ncells[0].earfcn);
+	TEST_ASSERT_EQUAL(60, ncells[0].phys_cell_id);
+	TEST_ASSERT_EQUAL(29, ncells[0].rsrp);
+	TEST_ASSERT_EQUAL(4, ncells[0].rsrq);
+	TEST_ASSERT_EQUAL(3500, ncells[0].time_diff);
+	TEST_ASSERT_EQUAL(9, ncells[1].earfcn);
+	TEST_ASSERT_EQUAL(99, ncells[1].phys_cell_id);
+	TEST_ASSERT_EQUAL(18, ncells[1].rsrp);
+	TEST_ASSERT_EQUAL(5, ncells[1].rsrq);
+	TEST_ASSERT_EQUAL(5300, ncells[1].time_diff);
+
+	err = parse_ncellmeas(at_response_no_ta_meas_time, &cells);
+	TEST_ASSERT_EQUAL(0, err);
+	TEST_ASSERT_EQUAL(0, cells.current_cell.timing_advance_meas_time);
+	TEST_ASSERT_EQUAL(1, cells.ncells_count);
+	TEST_ASSERT_EQUAL(3500, ncells[0].time_diff);
+
+	err = parse_ncellmeas(at_response_malformed, &cells);
+	TEST_ASSERT_NOT_EQUAL(0, err);
+}
+
 void test_parse_rrc_mode(void)
 {
 	int err;
@@ -249,6 +249,15 @@ void tearDown(void)
 {
 	int ret;
 
+	/* With CONFIG_LTE_LC_EVENT_QUEUE, events are delivered after the notification
+	 * has been handled.
+	 */
+	while (lte_lc_callback_count_occurred < lte_lc_callback_count_expected) {
+		if (k_sem_take(&event_handler_called_sem, K_SECONDS(1)) != 0) {
+			break;
+		}
+	}
+
 	TEST_ASSERT_EQUAL(lte_lc_callback_count_expected, lte_lc_callback_count_occurred);
 
 	ret = lte_lc_deregister_handler(lte_lc_event_handler);
@@ -266,6 +275,7 @@ static int sys_init_helper(void)
 }
 
 extern void on_modem_init(int err, void *ctx);
+extern struct k_sem ncellmeas_idle_sem;
 extern void lte_lc_on_modem_cfun(int mode, void *ctx);
 
 void test_lte_lc_on_modem_init_success(void)
@@ -2152,6 +2162,50 @@ void test_lte_lc_cscon(void)
 	at_monitor_dispatch(at_notif);
 }
 
+#if defined(CONFIG_LTE_LC_EVENT_QUEUE)
+static k_tid_t lte_lc_event_handler_thread;
+
+static void lte_lc_event_handler_thread_save(const struct lte_lc_evt *const evt)
+{
+	ARG_UNUSED(evt);
+
+	lte_lc_event_handler_thread = k_current_get();
+}
+#endif
+
+/* Events are delivered from the event queue of the library, not from the context in which
+ * the AT notification is handled.
+ */
+void test_lte_lc_event_queue_context(void)
+{
+#if defined(CONFIG_LTE_LC_EVENT_QUEUE)
+	int ret;
+
+	lte_lc_callback_count_expected = 1;
+
+	test_event_data[0].type = LTE_LC_EVT_RRC_UPDATE;
+	test_event_data[0].rrc_mode = LTE_LC_RRC_MODE_CONNECTED;
+
+	lte_lc_event_handler_thread = NULL;
+	lte_lc_register_handler(lte_lc_event_handler_thread_save);
+
+	strcpy(at_notif, "+CSCON: 1\r\n");
+	at_monitor_dispatch(at_notif);
+	TEST_ASSERT_EQUAL(0, lte_lc_callback_count_occurred);
+
+	ret = k_sem_take(&event_handler_called_sem, K_SECONDS(1));
+	TEST_ASSERT_EQUAL(0, ret);
+	/* Let the other handler run as well */
+	k_sleep(K_MSEC(1));
+
+	TEST_ASSERT_NOT_NULL(lte_lc_event_handler_thread);
+	TEST_ASSERT_NOT_EQUAL(k_current_get(), lte_lc_event_handler_thread);
+
+	ret = lte_lc_deregister_handler(lte_lc_event_handler_thread_save);
+	TEST_ASSERT_EQUAL(EXIT_SUCCESS, ret);
+#endif
+}
+
 void test_lte_lc_xt3412(void)
 {
 	lte_lc_callback_count_expected = 1;
@@ -3115,6 +3169,67 @@ void test_lte_lc_neighbor_cell_measurement_cancel(void)
 	TEST_ASSERT_EQUAL(-EFAULT, ret);
 }
 
+/* Cancelling must not allow a new measurement while the results of the previous one are
+ * waiting in the event queue, because the queued event refers to the cell buffers.
+ */
+void test_lte_lc_neighbor_cell_measurement_cancel_while_queued(void)
+{
+#if defined(CONFIG_LTE_LC_EVENT_QUEUE)
+	int ret;
+
+	strcpy(at_notif,
+	       "%NCELLMEAS: 0,\"00112233\",\"98712\",\"0AB9\",4800,7,63,31,456,4800,"
+	       "8,60,29,4,3500\r\n");
+
+	lte_lc_callback_count_expected = 1;
+
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS", EXIT_SUCCESS);
+	ret = lte_lc_neighbor_cell_measurement(NULL);
+	TEST_ASSERT_EQUAL(EXIT_SUCCESS, ret);
+
+	test_event_data[0].type = LTE_LC_EVT_NEIGHBOR_CELL_MEAS;
+	test_event_data[0].cells_info.current_cell.mcc = 987;
+	test_event_data[0].cells_info.current_cell.mnc = 12;
+	test_event_data[0].cells_info.current_cell.id = 0x00112233;
+	test_event_data[0].cells_info.current_cell.tac = 0x0AB9;
+	test_event_data[0].cells_info.current_cell.earfcn = 7;
+	test_event_data[0].cells_info.current_cell.timing_advance = 4800;
+	test_event_data[0].cells_info.current_cell.measurement_time = 4800;
+	test_event_data[0].cells_info.current_cell.phys_cell_id = 63;
+	test_event_data[0].cells_info.current_cell.rsrp = 31;
+	test_event_data[0].cells_info.current_cell.rsrq = 456;
+	test_event_data[0].cells_info.ncells_count = 1;
+	test_event_data[0].cells_info.gci_cells_count = 0;
+	test_neighbor_cells[0].earfcn = 8;
+	test_neighbor_cells[0].time_diff = 3500;
+	test_neighbor_cells[0].phys_cell_id = 60;
+	test_neighbor_cells[0].rsrp = 29;
+	test_neighbor_cells[0].rsrq = 4;
+
+	at_monitor_dispatch(at_notif);
+	TEST_ASSERT_EQUAL(0, lte_lc_callback_count_occurred);
+
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEASSTOP", EXIT_SUCCESS);
+	ret = lte_lc_neighbor_cell_measurement_cancel();
+	TEST_ASSERT_EQUAL(EXIT_SUCCESS, ret);
+
+	/* The measurement is still ongoing until the queued event has been delivered */
+	TEST_ASSERT_EQUAL(0, k_sem_count_get(&ncellmeas_idle_sem));
+
+	/* A new measurement waits until the results have been delivered */
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEAS", EXIT_SUCCESS);
+	ret = lte_lc_neighbor_cell_measurement(NULL);
+	TEST_ASSERT_EQUAL(EXIT_SUCCESS, ret);
+	TEST_ASSERT_EQUAL(1, lte_lc_callback_count_occurred);
+
+	/* Without queued results, cancelling ends the measurement */
+	__mock_nrf_modem_at_printf_ExpectAndReturn("AT%NCELLMEASSTOP", EXIT_SUCCESS);
+	ret = lte_lc_neighbor_cell_measurement_cancel();
+	TEST_ASSERT_EQUAL(EXIT_SUCCESS, ret);
+	TEST_ASSERT_EQUAL(1, k_sem_count_get(&ncellmeas_idle_sem));
+#endif
+}
+
 void test_lte_lc_neighbor_cell_measurement_normal_invalid_field_format_fail(void)
 {
 	int ret;
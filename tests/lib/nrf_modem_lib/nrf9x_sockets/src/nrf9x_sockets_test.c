@@ -73,6 +73,34 @@ static void nrf_freeaddrinfo_stub(struct nrf_addrinfo *p_res, int cmock_num_call
 	}
 }
 
+/* Allocate all of the system heap memory, so that k_malloc() fails. */
+static size_t heap_exhaust(void **blocks, size_t max_cnt)
+{
+	size_t cnt = 0;
+
+	for (size_t size = CONFIG_HEAP_MEM_POOL_SIZE; size > 0; size /= 2) {
+		while (cnt < max_cnt) {
+			void *block = k_malloc(size);
+
+			if (!block) {
+				break;
+			}
+			blocks[cnt++] = block;
+		}
+	}
+
+	TEST_ASSERT_LESS_THAN(max_cnt, cnt);
+
+	return cnt;
+}
+
+static void heap_release(void **blocks, size_t cnt)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		k_free(blocks[i]);
+	}
+}
+
 static ssize_t nrf_recvfrom_stub(int zsock_socket, void *buffer, size_t length,
 				 int flags, struct nrf_sockaddr *address,
 				 nrf_socklen_t *address_len,
@@ -1564,7 +1592,7 @@ void test_nrf9x_socket_offload_sendmsg_fits_buf(void)
 	TEST_ASSERT_EQUAL(ret, 0);
 }
 
-void test_nrf9x_socket_offload_sendmsg_not_fits_buf(void)
+void test_nrf9x_socket_offload_sendmsg_heap_buf(void)
 {
 	int ret;
 	int fd;
@@ -1602,7 +1630,70 @@ void test_nrf9x_socket_offload_sendmsg_not_fits_buf(void)
 	msg.msg_iov = chunks;
 	msg.msg_iovlen = 3;
 
-	/* First send doesn't send all data of the first chunk */
+	/* The chunks are gathered into a heap buffer and sent at once.
+	 * First send doesn't send all data.
+	 */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, NULL, 3 * sizeof(int),
+					   NRF_MSG_DONTWAIT,
+					   NULL, 0, 3 * sizeof(int) - 1);
+	__cmock_nrf_sendto_IgnoreArg_message();
+	/* Second send will send the remaining byte */
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, NULL, 1,
+					   NRF_MSG_DONTWAIT,
+					   NULL, 0, 1);
+	__cmock_nrf_sendto_IgnoreArg_message();
+
+	ret = zsock_sendmsg(fd, &msg, flags);
+
+	TEST_ASSERT_EQUAL(ret, 3 * sizeof(int));
+
+	__cmock_nrf_close_ExpectAndReturn(nrf_fd, 0);
+
+	ret = zsock_close(fd);
+
+	TEST_ASSERT_EQUAL(ret, 0);
+}
+
+void test_nrf9x_socket_offload_sendmsg_no_heap(void)
+{
+	int ret;
+	int fd;
+	int nrf_fd = 2;
+	int family = AF_INET;
+	int type = SOCK_STREAM;
+	int proto = IPPROTO_TCP;
+	int flags = ZSOCK_MSG_DONTWAIT;
+	struct msghdr msg = { 0 };
+	struct iovec chunks[3] = { 0 };
+	void *heap_blocks[64];
+	size_t heap_block_cnt;
+
+	/* 3 ints do not fit into the intermediate buffer */
+	int chunk_1 = 42;
+	int chunk_2 = 43;
+	int chunk_3 = 44;
+
+	__cmock_nrf_socket_ExpectAndReturn(NRF_AF_INET, NRF_SOCK_STREAM, NRF_IPPROTO_TCP, nrf_fd);
+
+	fd = zsock_socket(family, type, proto);
+
+	TEST_ASSERT_EQUAL(fd, 0);
+
+	chunks[0].iov_base = &chunk_1;
+	chunks[0].iov_len = sizeof(int);
+	chunks[1].iov_base = &chunk_2;
+	chunks[1].iov_len = sizeof(int);
+	chunks[2].iov_base = &chunk_3;
+	chunks[2].iov_len = sizeof(int);
+	msg.msg_iov = chunks;
+	msg.msg_iovlen = 3;
+
+	heap_block_cnt = heap_exhaust(heap_blocks, ARRAY_SIZE(heap_blocks));
+	TEST_ASSERT_NULL(k_malloc(3 * sizeof(int)));
+
+	/* Without heap memory, the chunks are sent separately.
+	 * First send doesn't send all data of the first chunk.
+	 */
 	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, &chunk_1, sizeof(int),
 					   NRF_MSG_DONTWAIT,
 					   NULL, 0, sizeof(int) - 1);
@@ -1616,10 +1707,11 @@ void test_nrf9x_socket_offload_sendmsg_not_fits_buf(void)
 	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, &chunk_3, sizeof(int),
 					   NRF_MSG_DONTWAIT,
 					   NULL, 0, sizeof(int));
-	__cmock_nrf_sendto_IgnoreArg_message();
 
 	ret = zsock_sendmsg(fd, &msg, flags);
 
+	heap_release(heap_blocks, heap_block_cnt);
+
 	TEST_ASSERT_EQUAL(ret, 3 * sizeof(int));
 
 	__cmock_nrf_close_ExpectAndReturn(nrf_fd, 0);
@@ -1629,6 +1721,46 @@ void test_nrf9x_socket_offload_sendmsg_not_fits_buf(void)
 	TEST_ASSERT_EQUAL(ret, 0);
 }
 
+void test_nrf9x_socket_offload_sendmsg_single_chunk(void)
+{
+	int ret;
+	int fd;
+	int nrf_fd = 2;
+	int family = AF_INET;
+	int type = SOCK_STREAM;
+	int proto = IPPROTO_TCP;
+	int flags = ZSOCK_MSG_DONTWAIT;
+	struct msghdr msg = { 0 };
+	struct iovec chunks[3] = { 0 };
+	int chunk[3] = { 42, 43, 44 };
+
+	__cmock_nrf_socket_ExpectAndReturn(NRF_AF_INET, NRF_SOCK_STREAM, NRF_IPPROTO_TCP, nrf_fd);
+
+	fd = zsock_socket(family, type, proto);
+
+	TEST_ASSERT_EQUAL(fd, 0);
+
+	/* Only one chunk carries data, it is passed without copying. */
+	chunks[1].iov_base = chunk;
+	chunks[1].iov_len = sizeof(chunk);
+	msg.msg_iov = chunks;
+	msg.msg_iovlen = 3;
+
+	__cmock_nrf_sendto_ExpectAndReturn(nrf_fd, chunk, sizeof(chunk),
+					   NRF_MSG_DONTWAIT,
+					   NULL, 0, sizeof(chunk));
+
+	ret = zsock_sendmsg(fd, &msg, flags);
+
+	TEST_ASSERT_EQUAL(ret, sizeof(chunk));
+
+	__cmock_nrf_close_ExpectAndReturn(nrf_fd, 0);
+
+	ret = zsock_close(fd);
+
+	TEST_ASSERT_EQUAL(ret, 0);
+}
+
 void test_nrf9x_socket_offload_fcntl_einval(void)
 {
 	int ret;
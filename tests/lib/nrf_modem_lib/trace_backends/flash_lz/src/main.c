@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <unity.h>
+#include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
+
+#include "trace_lz.h"
+
+#define BLOCK_SIZE 1024
+
+static uint8_t src[BLOCK_SIZE];
+static uint8_t compressed[TRACE_LZ_BOUND(BLOCK_SIZE)];
+static uint8_t decompressed[BLOCK_SIZE];
+
+/* It is required to be added to each test. That is because unity's
+ * main may return nonzero, while zephyr's main currently must
+ * return 0 in all cases (other values are reserved).
+ */
+extern int unity_main(void);
+
+void setUp(void)
+{
+	memset(compressed, 0, sizeof(compressed));
+	memset(decompressed, 0, sizeof(decompressed));
+}
+
+static size_t roundtrip(size_t len)
+{
+	size_t compressed_len;
+	int ret;
+
+	compressed_len = trace_lz_compress(src, len, compressed, sizeof(compressed));
+	TEST_ASSERT_TRUE(compressed_len > 0 || len == 0);
+	TEST_ASSERT_LESS_OR_EQUAL(TRACE_LZ_BOUND(len), compressed_len);
+
+	ret = trace_lz_decompress(compressed, compressed_len, decompressed, sizeof(decompressed));
+	TEST_ASSERT_EQUAL(len, ret);
+	TEST_ASSERT_EQUAL_MEMORY(src, decompressed, len);
+
+	return compressed_len;
+}
+
+void test_trace_lz_empty(void)
+{
+	TEST_ASSERT_EQUAL(0, roundtrip(0));
+}
+
+void test_trace_lz_random_data(void)
+{
+	sys_rand_get(src, sizeof(src));
+
+	for (size_t len = 1; len <= sizeof(src); len += 61) {
+		roundtrip(len);
+	}
+	roundtrip(sizeof(src));
+}
+
+void test_trace_lz_repetitive_data(void)
+{
+	size_t compressed_len;
+
+	/* Trace-like data: repeated headers with a varying counter. */
+	for (size_t i = 0; i < sizeof(src); i++) {
+		src[i] = (i % 16 == 15) ? (i / 16) : (i % 16);
+	}
+
+	compressed_len = roundtrip(sizeof(src));
+	TEST_ASSERT_LESS_THAN(sizeof(src) / 2, compressed_len);
+}
+
+void test_trace_lz_overlapping_match(void)
+{
+	memset(src, 0xab, sizeof(src));
+
+	TEST_ASSERT_LESS_THAN(sizeof(src) / 20, roundtrip(sizeof(src)));
+}
+
+void test_trace_lz_output_too_small(void)
+{
+	sys_rand_get(src, sizeof(src));
+
+	TEST_ASSERT_EQUAL(0, trace_lz_compress(src, sizeof(src), compressed, sizeof(src) / 2));
+}
+
+void test_trace_lz_corrupted_block(void)
+{
+	/* A match referring to data before the start of the output. */
+	const uint8_t block[] = { 0x00, 0x42, 0x80, 0x10, 0x00 };
+	/* A literal run longer than the block. */
+	const uint8_t truncated[] = { 0x10, 0x42 };
+
+	TEST_ASSERT_EQUAL(-EBADMSG,
+			  trace_lz_decompress(block, sizeof(block), decompressed,
+					      sizeof(decompressed)));
+	TEST_ASSERT_EQUAL(-EBADMSG,
+			  trace_lz_decompress(truncated, sizeof(truncated), decompressed,
+					      sizeof(decompressed)));
+}
+
+int main(void)
+{
+	(void)unity_main();
+
+	return 0;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "hid_keymap.h"
+#include <caf/key_id.h>
+
+/* This configuration file is included only once from hid_state module and holds
+ * information about mapping between buttons and generated reports.
+ */
+
+/* This structure enforces the header file is included only once in the build.
+ * Violating this requirement triggers a multiple definition error at link time.
+ */
+const struct {} hid_keymap_def_include_once;
+
+/*
+ * HID keymap. The Consumer Control keys are defined in section 15 of
+ * the HID Usage Tables document under the following URL:
+ * https://www.usb.org/sites/default/files/hut1_12.pdf
+ */
+static const struct hid_keymap hid_keymap[] = {
+	{ KEY_ID(0x00, 0x00), 0x04, REPORT_ID_KEYBOARD_KEYS }, /* A */
+	{ KEY_ID(0x00, 0x01), 0x05, REPORT_ID_KEYBOARD_KEYS }, /* B */
+	{ KEY_ID(0x00, 0x02), 0x06, REPORT_ID_KEYBOARD_KEYS }, /* C */
+	{ KEY_ID(0x00, 0x03), 0x07, REPORT_ID_KEYBOARD_KEYS }, /* D */
+	{ KEY_ID(0x00, 0x04), 0x08, REPORT_ID_KEYBOARD_KEYS }, /* E */
+	{ KEY_ID(0x00, 0x05), 0x09, REPORT_ID_KEYBOARD_KEYS }, /* F */
+	/* Usage outside of the keyboard report range, it does not change the report. */
+	{ KEY_ID(0x00, 0x06), 0x70, REPORT_ID_KEYBOARD_KEYS },
+};
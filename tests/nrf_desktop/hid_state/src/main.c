@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <app_event_manager.h>
+#include <caf/events/button_event.h>
+#include <caf/key_id.h>
+
+#include "hid_event.h"
+#include "motion_event.h"
+#include "hid_report_desc.h"
+
+#define MODULE main
+#include <caf/events/module_state_event.h>
+
+/* Number of zero motion reports that must be sent in a row. */
+#define ZERO_MOTION_REPORT_CNT	100
+#define REPORT_TIMEOUT		K_SECONDS(1)
+#define NO_REPORT_TIMEOUT	K_MSEC(100)
+
+/* Keys defined in the test HID keymap. */
+#define KEY_A			KEY_ID(0x00, 0x00)
+#define KEY_B			KEY_ID(0x00, 0x01)
+#define KEY_C			KEY_ID(0x00, 0x02)
+#define KEY_D			KEY_ID(0x00, 0x03)
+#define KEY_E			KEY_ID(0x00, 0x04)
+#define KEY_F			KEY_ID(0x00, 0x05)
+#define KEY_UNDEFINED		KEY_ID(0x00, 0x06)
+
+#define USAGE_A			0x04
+#define USAGE_B			0x05
+#define USAGE_C			0x06
+#define USAGE_D			0x07
+#define USAGE_E			0x08
+#define USAGE_F			0x09
+
+#define KEYBOARD_REPORT_SIZE	(sizeof(uint8_t) + REPORT_SIZE_KEYBOARD_KEYS)
+#define KEYBOARD_KEYS_OFFSET	3
+
+struct keyboard_report {
+	uint8_t data[KEYBOARD_REPORT_SIZE];
+};
+
+static const int subscriber_id;
+static bool keyboard_subscribed;
+static K_SEM_DEFINE(report_sent_sem, 0, 1);
+K_MSGQ_DEFINE(keyboard_reports, sizeof(struct keyboard_report),
+	      CONFIG_DESKTOP_HID_EVENT_QUEUE_SIZE + 2, 4);
+
+static void motion_submit(int16_t dx, int16_t dy)
+{
+	struct motion_event *event = new_motion_event();
+
+	event->dx = dx;
+	event->dy = dy;
+	APP_EVENT_SUBMIT(event);
+}
+
+static void button_submit(uint16_t key_id, bool pressed)
+{
+	struct button_event *event = new_button_event();
+
+	event->key_id = key_id;
+	event->pressed = pressed;
+	APP_EVENT_SUBMIT(event);
+}
+
+static void report_sent_submit(uint8_t report_id)
+{
+	struct hid_report_sent_event *event = new_hid_report_sent_event();
+
+	event->subscriber = &subscriber_id;
+	event->report_id = report_id;
+	event->error = false;
+	APP_EVENT_SUBMIT(event);
+}
+
+static void subscriber_connect(void)
+{
+	struct hid_report_subscriber_event *event = new_hid_report_subscriber_event();
+
+	event->subscriber = &subscriber_id;
+	event->params.priority = 1;
+	event->params.pipeline_size = 1;
+	event->params.report_max = 1;
+	event->connected = true;
+	APP_EVENT_SUBMIT(event);
+}
+
+static void report_subscribe(uint8_t report_id, bool enabled)
+{
+	struct hid_report_subscription_event *event = new_hid_report_subscription_event();
+
+	event->subscriber = &subscriber_id;
+	event->report_id = report_id;
+	event->enabled = enabled;
+	APP_EVENT_SUBMIT(event);
+
+	if (report_id == REPORT_ID_KEYBOARD_KEYS) {
+		keyboard_subscribed = enabled;
+	}
+}
+
+/* Check the next keyboard report. Keys are reported in descending order of usage IDs. */
+static void keyboard_report_check(const uint8_t *keys, size_t key_cnt)
+{
+	struct keyboard_report report;
+	uint8_t expected_keys[KEYBOARD_REPORT_KEY_COUNT_MAX] = {0};
+
+	zassert_true(key_cnt <= ARRAY_SIZE(expected_keys), "Too many keys");
+	if (key_cnt > 0) {
+		memcpy(expected_keys, keys, key_cnt);
+	}
+
+	zassert_ok(k_msgq_get(&keyboard_reports, &report, REPORT_TIMEOUT),
+		   "Keyboard report not sent");
+	zassert_equal(report.data[0], REPORT_ID_KEYBOARD_KEYS, "Invalid report ID");
+	zassert_equal(report.data[1], 0, "Invalid modifiers");
+	zassert_mem_equal(&report.data[KEYBOARD_KEYS_OFFSET], expected_keys,
+			  sizeof(expected_keys), "Invalid keys");
+}
+
+#define KEYBOARD_REPORT_CHECK(...)							\
+	keyboard_report_check((const uint8_t []){__VA_ARGS__},				\
+			      sizeof((const uint8_t []){__VA_ARGS__}))
+
+static void keyboard_report_empty_check(void)
+{
+	keyboard_report_check(NULL, 0);
+}
+
+static void keyboard_report_none_check(void)
+{
+	struct keyboard_report report;
+
+	zassert_equal(k_msgq_get(&keyboard_reports, &report, NO_REPORT_TIMEOUT), -EAGAIN,
+		      "Unexpected keyboard report");
+}
+
+static void *hid_state_setup(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+	module_set_state(MODULE_STATE_READY);
+	subscriber_connect();
+	report_subscribe(REPORT_ID_MOUSE, true);
+
+	/* The first report is sent on subscription. */
+	zassert_ok(k_sem_take(&report_sent_sem, REPORT_TIMEOUT), "Initial report not sent");
+
+	return NULL;
+}
+
+static void hid_state_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Unsubscribing clears the keyboard state and the queue. */
+	if (keyboard_subscribed) {
+		report_subscribe(REPORT_ID_KEYBOARD_KEYS, false);
+		k_sleep(NO_REPORT_TIMEOUT);
+	}
+	k_msgq_purge(&keyboard_reports);
+}
+
+ZTEST(hid_state, test_zero_motion_sampling)
+{
+	/* Like the motion sources, the test samples the next motion only after the previous
+	 * mouse report is sent. Motion that does not change the report must not stop sampling.
+	 * The processing time is logged by the module every 100 motion events.
+	 */
+	for (size_t i = 0; i < ZERO_MOTION_REPORT_CNT; i++) {
+		motion_submit(0, 0);
+		zassert_ok(k_sem_take(&report_sent_sem, REPORT_TIMEOUT),
+			   "Motion sampling stopped after %zu zero motion reports", i);
+	}
+}
+
+ZTEST(hid_state, test_keys_out_of_order)
+{
+	report_subscribe(REPORT_ID_KEYBOARD_KEYS, true);
+	keyboard_report_empty_check();
+
+	/* Keys are pressed and released out of the usage ID order. */
+	button_submit(KEY_C, true);
+	KEYBOARD_REPORT_CHECK(USAGE_C);
+	button_submit(KEY_A, true);
+	KEYBOARD_REPORT_CHECK(USAGE_C, USAGE_A);
+	button_submit(KEY_B, true);
+	KEYBOARD_REPORT_CHECK(USAGE_C, USAGE_B, USAGE_A);
+	button_submit(KEY_F, true);
+	KEYBOARD_REPORT_CHECK(USAGE_F, USAGE_C, USAGE_B, USAGE_A);
+
+	button_submit(KEY_B, false);
+	KEYBOARD_REPORT_CHECK(USAGE_F, USAGE_C, USAGE_A);
+	button_submit(KEY_F, false);
+	KEYBOARD_REPORT_CHECK(USAGE_C, USAGE_A);
+	button_submit(KEY_A, false);
+	KEYBOARD_REPORT_CHECK(USAGE_C);
+	button_submit(KEY_C, false);
+	keyboard_report_empty_check();
+
+	/* Unpaired key release does not change the state. */
+	button_submit(KEY_D, false);
+	keyboard_report_none_check();
+}
+
+ZTEST(hid_state, test_unchanged_keyboard_report)
+{
+	report_subscribe(REPORT_ID_KEYBOARD_KEYS, true);
+	keyboard_report_empty_check();
+
+	button_submit(KEY_A, true);
+	KEYBOARD_REPORT_CHECK(USAGE_A);
+
+	/* The usage is recorded, but it does not change the report sent to the host. */
+	button_submit(KEY_UNDEFINED, true);
+	keyboard_report_none_check();
+
+	button_submit(KEY_B, true);
+	KEYBOARD_REPORT_CHECK(USAGE_B, USAGE_A);
+
+	button_submit(KEY_UNDEFINED, false);
+	keyboard_report_none_check();
+
+	button_submit(KEY_B, false);
+	KEYBOARD_REPORT_CHECK(USAGE_A);
+	button_submit(KEY_A, false);
+	keyboard_report_empty_check();
+}
+
+ZTEST(hid_state, test_queue_expiration)
+{
+	/* Key A is pressed and released, key B is pressed while disconnected. */
+	button_submit(KEY_A, true);
+	button_submit(KEY_A, false);
+	button_submit(KEY_B, true);
+	k_sleep(K_MSEC(CONFIG_DESKTOP_HID_REPORT_EXPIRATION + 100));
+
+	button_submit(KEY_C, true);
+	button_submit(KEY_C, false);
+
+	/* Expired key A events are dropped from the queue. Expired key B press is kept until
+	 * it is released, and key C events did not expire yet.
+	 */
+	report_subscribe(REPORT_ID_KEYBOARD_KEYS, true);
+	KEYBOARD_REPORT_CHECK(USAGE_B);
+	KEYBOARD_REPORT_CHECK(USAGE_C, USAGE_B);
+	KEYBOARD_REPORT_CHECK(USAGE_B);
+	keyboard_report_none_check();
+
+	button_submit(KEY_B, false);
+	keyboard_report_empty_check();
+}
+
+ZTEST(hid_state, test_queue_wraparound)
+{
+	/* Fill the queue while disconnected. Key B stays pressed. */
+	button_submit(KEY_A, true);
+	button_submit(KEY_A, false);
+	button_submit(KEY_B, true);
+	for (size_t i = 0; i < (CONFIG_DESKTOP_HID_EVENT_QUEUE_SIZE - 4) / 2; i++) {
+		button_submit(KEY_C, true);
+		button_submit(KEY_C, false);
+	}
+	button_submit(KEY_E, true);
+
+	/* The queue is full. The oldest events with no pressed key are dropped, and new events
+	 * are stored at the beginning of the ring buffer.
+	 */
+	button_submit(KEY_F, true);
+	button_submit(KEY_F, false);
+
+	report_subscribe(REPORT_ID_KEYBOARD_KEYS, true);
+	KEYBOARD_REPORT_CHECK(USAGE_B);
+	for (size_t i = 0; i < (CONFIG_DESKTOP_HID_EVENT_QUEUE_SIZE - 4) / 2; i++) {
+		KEYBOARD_REPORT_CHECK(USAGE_C, USAGE_B);
+		KEYBOARD_REPORT_CHECK(USAGE_B);
+	}
+	KEYBOARD_REPORT_CHECK(USAGE_E, USAGE_B);
+	KEYBOARD_REPORT_CHECK(USAGE_F, USAGE_E, USAGE_B);
+	KEYBOARD_REPORT_CHECK(USAGE_E, USAGE_B);
+	keyboard_report_none_check();
+
+	button_submit(KEY_B, false);
+	KEYBOARD_REPORT_CHECK(USAGE_E);
+	button_submit(KEY_E, false);
+	keyboard_report_empty_check();
+}
+
+ZTEST(hid_state, test_queue_overflow)
+{
+	/* Fill the queue with presses of a key that is never released. */
+	for (size_t i = 0; i < CONFIG_DESKTOP_HID_EVENT_QUEUE_SIZE; i++) {
+		button_submit(KEY_A, true);
+	}
+
+	/* No event can be dropped from the full queue without breaking the key state,
+	 * so all of the enqueued events are dropped.
+	 */
+	button_submit(KEY_D, true);
+
+	report_subscribe(REPORT_ID_KEYBOARD_KEYS, true);
+	KEYBOARD_REPORT_CHECK(USAGE_D);
+	keyboard_report_none_check();
+
+	button_submit(KEY_D, false);
+	keyboard_report_empty_check();
+}
+
+static bool handle_hid_report_event(const struct hid_report_event *event)
+{
+	const uint8_t *data = event->dyndata.data;
+
+	zassert_equal_ptr(event->subscriber, &subscriber_id, "Invalid subscriber");
+
+	if (data[0] == REPORT_ID_KEYBOARD_KEYS) {
+		struct keyboard_report report;
+
+		zassert_equal(event->dyndata.size, sizeof(report.data), "Invalid report size");
+		memcpy(report.data, data, sizeof(report.data));
+		zassert_ok(k_msgq_put(&keyboard_reports, &report, K_NO_WAIT),
+			   "Too many keyboard reports");
+	} else {
+		zassert_equal(data[0], REPORT_ID_MOUSE, "Invalid report ID");
+	}
+
+	/* Act as a HID transport. */
+	report_sent_submit(data[0]);
+
+	return false;
+}
+
+static bool handle_hid_report_sent_event(const struct hid_report_sent_event *event)
+{
+	if (event->report_id == REPORT_ID_MOUSE) {
+		k_sem_give(&report_sent_sem);
+	}
+
+	return false;
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_hid_report_event(aeh)) {
+		return handle_hid_report_event(cast_hid_report_event(aeh));
+	}
+
+	if (is_hid_report_sent_event(aeh)) {
+		return handle_hid_report_sent_event(cast_hid_report_sent_event(aeh));
+	}
+
+	/* If event is unhandled, unsubscribe. */
+	__ASSERT_NO_MSG(false);
+
+	return false;
+}
+
+APP_EVENT_LISTENER(test, app_event_handler);
+APP_EVENT_SUBSCRIBE(test, hid_report_event);
+APP_EVENT_SUBSCRIBE(test, hid_report_sent_event);
+
+ZTEST_SUITE(hid_state, NULL, hid_state_setup, NULL, NULL, hid_state_after);
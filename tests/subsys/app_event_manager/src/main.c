@@ -184,6 +184,65 @@ ZTEST(suite0, test_name_style_events_sorting)
 	test_start(TEST_NAME_STYLE_SORTING);
 }
 
+ZTEST(suite0, test_event_type_find)
+{
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		zassert_equal_ptr(app_event_manager_event_type_find(et->name), et,
+				  "Event type %s not found", et->name);
+	}
+
+	zassert_equal_ptr(app_event_manager_event_type_find("test_start_event"),
+			  &__event_type_test_start_event);
+	zassert_is_null(app_event_manager_event_type_find(""));
+	zassert_is_null(app_event_manager_event_type_find("test_start"));
+	zassert_is_null(app_event_manager_event_type_find("test_start_event_"));
+	zassert_is_null(app_event_manager_event_type_find("zzz_not_existing_event"));
+}
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_NOTIFY_HOOKS)
+static size_t start_event_notify_cnt;
+static bool start_event_notify_unexpected;
+
+static void notify_hook(const struct app_event_header *aeh, const struct event_subscriber *es,
+			uint32_t cycles)
+{
+	const struct event_type *et = aeh->type_id;
+
+	if (!is_test_start_event(aeh)) {
+		return;
+	}
+
+	if ((es < et->subs_start) || (es >= et->subs_stop) ||
+	    (k_cycle_get_32() - aeh->submit_time < cycles)) {
+		start_event_notify_unexpected = true;
+	}
+
+	start_event_notify_cnt++;
+}
+
+APP_EVENT_HOOK_NOTIFY_REGISTER(notify_hook);
+#endif /* CONFIG_APP_EVENT_MANAGER_NOTIFY_HOOKS */
+
+ZTEST(suite0, test_notify_hook)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_APP_EVENT_MANAGER_NOTIFY_HOOKS);
+	Z_TEST_SKIP_IFNDEF(CONFIG_APP_EVENT_MANAGER_SUBMIT_TIMESTAMP);
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_NOTIFY_HOOKS)
+	const struct event_type *et = APP_EVENT_ID(test_start_event);
+
+	start_event_notify_cnt = 0;
+	start_event_notify_unexpected = false;
+
+	test_start(TEST_BASIC);
+
+	/* None of the test listeners consumes the test start event. */
+	zassert_equal(start_event_notify_cnt, et->subs_stop - et->subs_start,
+		      "Notify hook not called for every listener");
+	zassert_false(start_event_notify_unexpected, "Unexpected notify hook arguments");
+#endif
+}
+
 ZTEST_SUITE(suite0, NULL, test_init, NULL, NULL, NULL);
 
 static bool app_event_handler(const struct app_event_header *aeh)
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/shell/shell_dummy.h>
+
+/* Included to access the histograms. */
+#include "app_event_manager_profiler_tracer_latency.c"
+
+#define TEST_EVENT_CNT		10
+#define EVENT_PROCESS_TIMEOUT	K_MSEC(100)
+
+struct latency_test_event {
+	struct app_event_header header;
+};
+
+APP_EVENT_TYPE_DECLARE(latency_test_event);
+APP_EVENT_TYPE_DEFINE(latency_test_event, NULL, NULL, APP_EVENT_FLAGS_CREATE());
+
+static uint32_t handled_cnt;
+
+static const struct latency_hist *queue_hist_get(void)
+{
+	return &queue_hist[APP_EVENT_ID(latency_test_event) - _event_type_list_start];
+}
+
+static const struct latency_hist *test_listener_hist_get(void)
+{
+	const struct event_type *et = APP_EVENT_ID(latency_test_event);
+
+	for (const struct event_subscriber *es = et->subs_start; es != et->subs_stop; es++) {
+		if (!strcmp(es->listener->name, "test")) {
+			return subscriber_hist_get(es);
+		}
+	}
+
+	return NULL;
+}
+
+static void events_submit(size_t cnt)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		APP_EVENT_SUBMIT(new_latency_test_event());
+	}
+
+	k_sleep(EVENT_PROCESS_TIMEOUT);
+	zassert_equal(handled_cnt, cnt, "Events not processed");
+}
+
+static void shell_cmd_execute(const char *cmd)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+
+	shell_backend_dummy_clear_output(sh);
+	zassert_ok(shell_execute_cmd(sh, cmd), "Command failed: %s", cmd);
+}
+
+static void *latency_setup(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+
+	return NULL;
+}
+
+static void latency_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Reset the histograms from the workqueue that updates them. */
+	(void)k_work_submit(&latency_reset);
+	k_sleep(EVENT_PROCESS_TIMEOUT);
+
+	handled_cnt = 0;
+}
+
+ZTEST(latency, test_bucket_placement)
+{
+	static const struct {
+		uint32_t cycles;
+		size_t bucket;
+	} samples[] = {
+		{0, 0},
+		{1, 1},
+		{2, 2},
+		{3, 2},
+		{4, 3},
+		{7, 3},
+		{8, 4},
+		{BIT(LATENCY_BUCKETS - 2) - 1, LATENCY_BUCKETS - 2},
+		{BIT(LATENCY_BUCKETS - 2), LATENCY_BUCKETS - 1},
+		/* Longer durations are counted in the last bucket. */
+		{BIT(LATENCY_BUCKETS - 1), LATENCY_BUCKETS - 1},
+		{UINT32_MAX, LATENCY_BUCKETS - 1},
+	};
+	struct latency_hist hist;
+
+	for (size_t i = 0; i < ARRAY_SIZE(samples); i++) {
+		memset(&hist, 0, sizeof(hist));
+		hist_add(&hist, samples[i].cycles);
+
+		zassert_equal(hist_count(&hist), 1, "Invalid sample count");
+		zassert_equal(hist.buckets[samples[i].bucket], 1, "%u cycles not in bucket %zu",
+			      samples[i].cycles, samples[i].bucket);
+		zassert_equal(hist.max, samples[i].cycles, "Invalid max");
+	}
+}
+
+ZTEST(latency, test_percentiles)
+{
+	struct latency_hist hist = {0};
+
+	zassert_equal(hist_percentile_us(&hist, 0, 500), 0, "Invalid p50 of empty histogram");
+
+	/* 98 samples in bucket 3, and one sample in buckets 7 and 10. */
+	for (size_t i = 0; i < 98; i++) {
+		hist_add(&hist, 5);
+	}
+	hist_add(&hist, 100);
+	hist_add(&hist, 1000);
+
+	zassert_equal(hist_count(&hist), 100, "Invalid sample count");
+
+	/* Percentiles are the upper bounds of the buckets, capped at the max. */
+	zassert_equal(hist_percentile_us(&hist, 100, 500), k_cyc_to_us_ceil32(7),
+		      "Invalid p50");
+	zassert_equal(hist_percentile_us(&hist, 100, 980), k_cyc_to_us_ceil32(7),
+		      "Invalid p98");
+	zassert_equal(hist_percentile_us(&hist, 100, 990), k_cyc_to_us_ceil32(127),
+		      "Invalid p99");
+	zassert_equal(hist_percentile_us(&hist, 100, 1000), k_cyc_to_us_ceil32(1000),
+		      "Invalid p100");
+	zassert_equal(k_cyc_to_us_ceil32(hist.max), k_cyc_to_us_ceil32(1000), "Invalid max");
+
+	/* The last bucket is bounded by the max only. */
+	memset(&hist, 0, sizeof(hist));
+	hist_add(&hist, UINT32_MAX - 1);
+
+	zassert_equal(hist_percentile_us(&hist, 1, 500), k_cyc_to_us_ceil32(UINT32_MAX - 1),
+		      "Invalid p50 in the last bucket");
+}
+
+ZTEST(latency, test_event_latency_recorded)
+{
+	const struct latency_hist *listener_hist = test_listener_hist_get();
+	const char *output;
+	size_t output_len;
+
+	zassert_not_null(listener_hist, "Test listener not tracked");
+
+	events_submit(TEST_EVENT_CNT);
+
+	zassert_equal(hist_count(queue_hist_get()), TEST_EVENT_CNT, "Queue wait not recorded");
+	zassert_equal(hist_count(listener_hist), TEST_EVENT_CNT, "Handler time not recorded");
+
+	shell_cmd_execute("app_event_manager latency show latency_test_event");
+	output = shell_backend_dummy_get_output(shell_backend_dummy_get_ptr(), &output_len);
+	zassert_not_null(strstr(output, "n=" STRINGIFY(TEST_EVENT_CNT)), "Statistics not shown");
+}
+
+ZTEST(latency, test_reset)
+{
+	events_submit(TEST_EVENT_CNT);
+	zassert_equal(hist_count(queue_hist_get()), TEST_EVENT_CNT, "Queue wait not recorded");
+
+	shell_cmd_execute("app_event_manager latency reset");
+	k_sleep(EVENT_PROCESS_TIMEOUT);
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		const struct latency_hist *hist = &queue_hist[et - _event_type_list_start];
+
+		zassert_equal(hist_count(hist), 0, "Queue histogram of %s not reset", et->name);
+		zassert_equal(hist->max, 0, "Queue max of %s not reset", et->name);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(handler_hist); i++) {
+		zassert_equal(hist_count(&handler_hist[i]), 0, "Handler histogram not reset");
+		zassert_equal(handler_hist[i].max, 0, "Handler max not reset");
+	}
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_latency_test_event(aeh)) {
+		handled_cnt++;
+		return false;
+	}
+
+	/* If event is unhandled, unsubscribe. */
+	__ASSERT_NO_MSG(false);
+
+	return false;
+}
+
+APP_EVENT_LISTENER(test, app_event_handler);
+APP_EVENT_SUBSCRIBE(test, latency_test_event);
+
+ZTEST_SUITE(latency, NULL, latency_setup, latency_before, NULL, NULL);
@@ -178,6 +178,78 @@ ZTEST(bl_crypto_test, test_sha256)
 	test_sha256_string(hash_in, 65, hash_res65, true);
 }
 
+struct stream_source {
+	const uint8_t *data;
+	uint32_t len;
+	uint32_t reads;
+	int err;
+};
+
+static int stream_read(void *ctx, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+	struct stream_source *source = ctx;
+
+	zassert_true(offset + len <= source->len, "read out of bounds");
+	zassert_equal(0, (uint32_t)buf % 4, "buffer not word aligned");
+
+	if (source->err) {
+		return source->err;
+	}
+
+	memcpy(buf, source->data + offset, len);
+	source->reads++;
+
+	return 0;
+}
+
+void test_sha256_stream_string(const uint8_t *input, uint32_t input_len,
+			       const uint8_t *test_vector)
+{
+	struct stream_source source = {.data = input, .len = input_len};
+	uint8_t output[32] = {0};
+	int rc;
+
+	rc = bl_sha256_stream(stream_read, &source, input_len, output);
+	zassert_equal(0, rc, "bl_sha256_stream failed retval was: %d", rc);
+	zassert_mem_equal(test_vector, output, sizeof(output), "wrong digest");
+	zassert_equal(DIV_ROUND_UP(input_len, CONFIG_SB_CRYPTO_STREAM_CHUNK_LEN),
+		      source.reads, "unexpected number of reads: %d", source.reads);
+
+	rc = bl_sha256_verify_stream(stream_read, &source, input_len, test_vector);
+	zassert_equal(0, rc, "bl_sha256_verify_stream returned %d", rc);
+}
+
+ZTEST(bl_crypto_test, test_sha256_stream)
+{
+	struct stream_source source = {.data = hash_in2, .len = 3};
+	uint8_t output[32];
+	int rc;
+
+	test_sha256_stream_string(NULL, 0, sha256_empty_string);
+	test_sha256_stream_string(hash_in2, 3, hash_res2);
+	test_sha256_stream_string(hash_in, 55, hash_res55);
+	test_sha256_stream_string(hash_in, 64, hash_res64);
+	test_sha256_stream_string(hash_in, 65, hash_res65);
+	test_sha256_stream_string(mcuboot_key, ARRAY_SIZE(mcuboot_key), mcuboot_key_hash);
+
+	/* Spans several chunks. */
+#if CONFIG_FLASH_SIZE > 300
+	test_sha256_stream_string(long_input, ARRAY_SIZE(long_input), long_input_hash);
+#endif
+
+	/* Digest mismatch. */
+	rc = bl_sha256_verify_stream(stream_read, &source, 3, sha256_test_vector_string);
+	zassert_equal(-EHASHINV, rc, "bl_sha256_verify_stream returned %d", rc);
+
+	/* Read error is returned as is. */
+	source.err = -EIO;
+	rc = bl_sha256_stream(stream_read, &source, 3, output);
+	zassert_equal(-EIO, rc, "bl_sha256_stream returned %d", rc);
+
+	rc = bl_sha256_stream(NULL, &source, 3, output);
+	zassert_equal(-EINVAL, rc, "bl_sha256_stream returned %d", rc);
+}
+
 ZTEST(bl_crypto_test, test_bl_root_of_trust_verify)
 {
 
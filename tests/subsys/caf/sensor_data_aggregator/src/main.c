@@ -11,6 +11,7 @@
 #include <caf/events/sensor_event.h>
 #include "test_config.h"
 #include <zephyr/drivers/sensor.h>
+#include <caf/sensor_data_aggregator.h>
 
 static enum test_id cur_test_id;
 static K_SEM_DEFINE(test_end_sem, 0, 1);
@@ -101,6 +102,51 @@ ZTEST(caf_sensor_aggregator_tests, test_status)
 	test_start(TEST_STATUS);
 }
 
+ZTEST(caf_sensor_aggregator_tests, test_direct)
+{
+	struct sensor_value *slot;
+	size_t sample_cnt;
+	int val = 0;
+
+	cur_test_id = TEST_DIRECT;
+	struct test_start_event *ts = new_test_start_event();
+
+	zassert_not_null(ts, "Failed to allocate event");
+	ts->test_id = cur_test_id;
+	APP_EVENT_SUBMIT(ts);
+
+	zassert_equal(sensor_data_aggregator_sample_size_get(DIRECT_TEST_AGG_DESCR), 1);
+	zassert_equal(sensor_data_aggregator_sample_size_get("void_unknown_sensor"), -ENOENT);
+
+	/* Partial claim. */
+	sample_cnt = DIRECT_TEST_FIRST_CLAIM;
+	slot = sensor_data_aggregator_claim(DIRECT_TEST_AGG_DESCR, &sample_cnt);
+	zassert_not_null(slot, "No free buffer");
+	zassert_equal(sample_cnt, DIRECT_TEST_FIRST_CLAIM);
+
+	for (size_t i = 0; i < sample_cnt; i++) {
+		slot[i].val1 = val++;
+	}
+	zassert_ok(sensor_data_aggregator_commit(DIRECT_TEST_AGG_DESCR, sample_cnt));
+
+	sensor_data_aggregator_drop(DIRECT_TEST_AGG_DESCR, DIRECT_TEST_DROPPED);
+
+	/* Claim more than fits, the claim is limited to the space left in the buffer. */
+	sample_cnt = 2 * SAMPLES_IN_AGG_BUF;
+	slot = sensor_data_aggregator_claim(DIRECT_TEST_AGG_DESCR, &sample_cnt);
+	zassert_not_null(slot, "No free buffer");
+	zassert_equal(sample_cnt, SAMPLES_IN_AGG_BUF - DIRECT_TEST_FIRST_CLAIM);
+
+	for (size_t i = 0; i < sample_cnt; i++) {
+		slot[i].val1 = val++;
+	}
+	zassert_ok(sensor_data_aggregator_commit(DIRECT_TEST_AGG_DESCR, sample_cnt));
+
+	int err = k_sem_take(&test_end_sem, K_SECONDS(30));
+
+	zassert_ok(err, "Test execution hanged");
+}
+
 static bool app_event_handler(const struct app_event_header *aeh)
 {
 	if (is_test_end_event(aeh)) {
@@ -82,6 +82,22 @@ static bool app_event_handler(const struct app_event_header *aeh)
 
 			struct test_end_event *te = new_test_end_event();
 
+			zassert_not_null(te, "Failed to allocate event");
+			te->test_id = cur_test_id;
+			APP_EVENT_SUBMIT(te);
+		} else if (strcmp(event->sensor_descr, DIRECT_TEST_AGG_DESCR) == 0) {
+
+			zassert_equal(event->sample_cnt, SAMPLES_IN_AGG_BUF,
+				      "Incorrect number of samples");
+			zassert_equal(event->dropped_cnt, DIRECT_TEST_DROPPED,
+				      "Incorrect number of dropped samples");
+
+			for (int k = 0; k < SAMPLES_IN_AGG_BUF; k++) {
+				zassert_equal(event->samples[k].val1, k, "Incorrect sample data");
+			}
+
+			struct test_end_event *te = new_test_end_event();
+
 			zassert_not_null(te, "Failed to allocate event");
 			te->test_id = cur_test_id;
 			APP_EVENT_SUBMIT(te);
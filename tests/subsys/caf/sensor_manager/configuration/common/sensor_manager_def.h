@@ -31,6 +31,21 @@ static const struct caf_sampled_channel accel_chan[] = {
 	},
 };
 
+#ifdef CONFIG_CAF_SENSOR_MANAGER_BATCH
+/* Simulated sensor with a FIFO, defined by the test. */
+DEVICE_DECLARE(fifo_sensor);
+
+static const struct sensor_trigger fifo_watermark = {
+	.type = SENSOR_TRIG_FIFO_WATERMARK,
+	.chan = SENSOR_CHAN_ACCEL_XYZ,
+};
+
+static const struct sm_batch fifo_batch = {
+	.sample_cnt = 4,
+	.watermark = &fifo_watermark,
+};
+#endif
+
 static const struct sm_sensor_config sensor_configs[] = {
 	{
 		.dev = DEVICE_DT_GET(DT_NODELABEL(sensor_sim_1)),
@@ -56,4 +71,15 @@ static const struct sm_sensor_config sensor_configs[] = {
 		.sampling_period_ms = 33000,
 		.active_events_limit = 3,
 	},
+#ifdef CONFIG_CAF_SENSOR_MANAGER_BATCH
+	{
+		.dev = DEVICE_GET(fifo_sensor),
+		.event_descr = "FIFO sensor",
+		.chans = accel_chan,
+		.chan_cnt = ARRAY_SIZE(accel_chan),
+		.sampling_period_ms = 10,
+		.active_events_limit = 3,
+		.batch = &fifo_batch,
+	},
+#endif
 };
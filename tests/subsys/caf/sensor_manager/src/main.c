@@ -16,12 +16,32 @@
 
 #include <caf/events/module_state_event.h>
 
+#ifdef CONFIG_CAF_SENSOR_MANAGER_BATCH
+#include <caf/sensor_manager.h>
+#include "fifo_sensor.h"
+#endif
+
 LOG_MODULE_REGISTER(MODULE);
 
 #define PRE_CHANGE_SAMPLING_PERIOD 20
 #define SAMPLING_PERIOD 40
 #define SAMPLING_PERIOD_LONG 33000
 
+/* Configuration of the simulated FIFO sensor, see sensor_manager_def.h. */
+#define FIFO_SENSOR_DESCR "FIFO sensor"
+#define FIFO_SAMPLING_PERIOD 10
+#define FIFO_BATCH_SIZE 4
+#define ACCEL_CHAN_CNT 3
+
+struct batch {
+	size_t data_cnt;
+	int64_t timestamp_us;
+	uint32_t sample_period_us;
+	struct sensor_value data[FIFO_BATCH_SIZE * ACCEL_CHAN_CNT];
+};
+
+static struct batch received_batch;
+
 static enum test_id cur_test_id;
 static K_SEM_DEFINE(test_end_sem, 0, 1);
 static K_SEM_DEFINE(test_init_sem, 0, 1);
@@ -122,6 +142,93 @@ ZTEST(caf_sensor_manager_tests, test_multiple_sensors)
 	test_start(TEST_MULTIPLE_SENSORS);
 }
 
+#ifdef CONFIG_CAF_SENSOR_MANAGER_BATCH
+static void batch_read(struct batch *batch)
+{
+	cur_test_id = TEST_BATCH;
+	fifo_sensor_watermark_fire();
+
+	int err = k_sem_take(&test_end_sem, K_SECONDS(1));
+
+	zassert_ok(err, "Batch not received");
+	*batch = received_batch;
+}
+
+static int64_t batch_last_timestamp(const struct batch *batch)
+{
+	return batch->timestamp_us + (int64_t)batch->sample_period_us * (FIFO_BATCH_SIZE - 1);
+}
+
+static void batch_verify_data(const struct batch *batch, uint32_t first_sample)
+{
+	zassert_equal(batch->data_cnt, FIFO_BATCH_SIZE * ACCEL_CHAN_CNT,
+		      "Wrong number of values in the event");
+
+	for (size_t i = 0; i < FIFO_BATCH_SIZE; i++) {
+		for (size_t j = 0; j < ACCEL_CHAN_CNT; j++) {
+			const struct sensor_value *val = &batch->data[i * ACCEL_CHAN_CNT + j];
+
+			zassert_equal(val->val1, first_sample + i, "Wrong sample order");
+			zassert_equal(val->val2, j, "Wrong channel order");
+		}
+	}
+}
+
+ZTEST(caf_sensor_manager_tests, test_batch)
+{
+	struct batch first;
+	struct batch second;
+	struct sm_bus_stats stats_before;
+	struct sm_bus_stats stats;
+	uint32_t fetch_cnt = fifo_sensor_fetch_cnt_get();
+
+	zassert_equal(sensor_manager_bus_stats_get("Unknown sensor", &stats), -ENOENT,
+		      "Statistics of unknown sensor");
+	zassert_ok(sensor_manager_bus_stats_get(FIFO_SENSOR_DESCR, &stats_before),
+		   "Cannot get bus statistics");
+
+	batch_read(&first);
+	batch_verify_data(&first, fetch_cnt);
+
+	if (fetch_cnt == 0) {
+		/* No previous wake up, the configured sampling period is used. */
+		zassert_equal(first.sample_period_us, FIFO_SAMPLING_PERIOD * USEC_PER_MSEC,
+			      "Wrong period of the first batch");
+	}
+
+	k_sleep(K_MSEC(FIFO_BATCH_SIZE * FIFO_SAMPLING_PERIOD));
+
+	batch_read(&second);
+	batch_verify_data(&second, fetch_cnt + FIFO_BATCH_SIZE);
+
+	/* Samples are evenly spread between the last samples of consecutive batches. */
+	int64_t interval_us = batch_last_timestamp(&second) - batch_last_timestamp(&first);
+
+	zassert_true(interval_us >= FIFO_BATCH_SIZE * FIFO_SAMPLING_PERIOD * USEC_PER_MSEC,
+		     "Batch interval too short");
+	zassert_equal(second.sample_period_us, interval_us / FIFO_BATCH_SIZE,
+		      "Wrong interpolated sample period");
+	zassert_between_inclusive(second.timestamp_us - batch_last_timestamp(&first),
+				  second.sample_period_us,
+				  second.sample_period_us + FIFO_BATCH_SIZE - 1,
+				  "Wrong timestamp of the first sample");
+
+	zassert_equal(fifo_sensor_fetch_cnt_get(), fetch_cnt + 2 * FIFO_BATCH_SIZE,
+		      "Wrong number of fetched samples");
+
+	zassert_ok(sensor_manager_bus_stats_get(FIFO_SENSOR_DESCR, &stats),
+		   "Cannot get bus statistics");
+	zassert_equal(stats.read_cnt - stats_before.read_cnt, 2, "Wrong read count");
+	zassert_equal(stats.sample_cnt - stats_before.sample_cnt, 2 * FIFO_BATCH_SIZE,
+		      "Wrong sample count");
+	zassert_true(stats.total_us - stats_before.total_us >=
+		     2 * FIFO_BATCH_SIZE * FIFO_SENSOR_FETCH_TIME_US, "Bus time too short");
+	zassert_true(stats.max_us >= FIFO_BATCH_SIZE * FIFO_SENSOR_FETCH_TIME_US,
+		     "Longest read too short");
+	zassert_true(stats.max_us <= stats.total_us, "Longest read above total time");
+}
+#endif
+
 static bool app_event_handler(const struct app_event_header *aeh)
 {
 	if (is_test_end_event(aeh)) {
@@ -217,6 +324,23 @@ static bool app_event_handler(const struct app_event_header *aeh)
 			}
 
 			zassert_unreachable("Expected sensor event from different sensor");
+			break;
+
+		case TEST_BATCH:
+			if (strcmp(ev->descr, FIFO_SENSOR_DESCR)) {
+				break;
+			}
+
+			received_batch.data_cnt = sensor_event_get_data_cnt(ev);
+			zassert_true(received_batch.data_cnt <= ARRAY_SIZE(received_batch.data),
+				     "Too many values in the event");
+			memcpy(received_batch.data, sensor_event_get_data_ptr(ev),
+			       received_batch.data_cnt * sizeof(received_batch.data[0]));
+			received_batch.timestamp_us = ev->timestamp_us;
+			received_batch.sample_period_us = ev->sample_period_us;
+			cur_test_id = TEST_IDLE;
+			k_sem_give(&test_end_sem);
+			break;
 
 		default:
 			break;
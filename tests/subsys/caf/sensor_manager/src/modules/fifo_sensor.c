@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/sensor.h>
+
+#include "fifo_sensor.h"
+
+/* Simulated sensor with a FIFO. Every fetch reads the next sample from the FIFO. */
+
+static const struct sensor_trigger *watermark_trigger;
+static sensor_trigger_handler_t watermark_handler;
+static uint32_t fetch_cnt;
+static uint32_t sample;
+
+static int fifo_sensor_sample_fetch(const struct device *dev, enum sensor_channel chan)
+{
+	k_busy_wait(FIFO_SENSOR_FETCH_TIME_US);
+	sample = fetch_cnt++;
+
+	return 0;
+}
+
+static int fifo_sensor_channel_get(const struct device *dev, enum sensor_channel chan,
+				   struct sensor_value *val)
+{
+	switch (chan) {
+	case SENSOR_CHAN_ACCEL_X:
+	case SENSOR_CHAN_ACCEL_Y:
+	case SENSOR_CHAN_ACCEL_Z:
+		val->val1 = sample;
+		val->val2 = chan - SENSOR_CHAN_ACCEL_X;
+		return 0;
+
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static int fifo_sensor_trigger_set(const struct device *dev, const struct sensor_trigger *trig,
+				   sensor_trigger_handler_t handler)
+{
+	if (trig->type != SENSOR_TRIG_FIFO_WATERMARK) {
+		return -ENOTSUP;
+	}
+
+	watermark_trigger = trig;
+	watermark_handler = handler;
+
+	return 0;
+}
+
+void fifo_sensor_watermark_fire(void)
+{
+	__ASSERT_NO_MSG(watermark_handler);
+	watermark_handler(DEVICE_GET(fifo_sensor), watermark_trigger);
+}
+
+uint32_t fifo_sensor_fetch_cnt_get(void)
+{
+	return fetch_cnt;
+}
+
+static int fifo_sensor_init(const struct device *dev)
+{
+	return 0;
+}
+
+static const struct sensor_driver_api fifo_sensor_api = {
+	.sample_fetch = fifo_sensor_sample_fetch,
+	.channel_get = fifo_sensor_channel_get,
+	.trigger_set = fifo_sensor_trigger_set,
+};
+
+DEVICE_DEFINE(fifo_sensor, "fifo_sensor", fifo_sensor_init, NULL, NULL, NULL, POST_KERNEL,
+	      CONFIG_SENSOR_INIT_PRIORITY, &fifo_sensor_api);
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _FIFO_SENSOR_H_
+#define _FIFO_SENSOR_H_
+
+#include <zephyr/device.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Time spent on fetching a single sample from the simulated FIFO. */
+#define FIFO_SENSOR_FETCH_TIME_US 100
+
+DEVICE_DECLARE(fifo_sensor);
+
+/* Fire the FIFO watermark trigger of the simulated sensor. */
+void fifo_sensor_watermark_fire(void);
+
+/* Number of samples fetched from the simulated sensor. Sample n has the value n
+ * in the integer part of every channel and the channel index in the fractional part.
+ */
+uint32_t fifo_sensor_fetch_cnt_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _FIFO_SENSOR_H_ */
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <debug/cpu_load.h>
+
+#define SAMPLE_INTERVAL CONFIG_CPU_LOAD_PROFILER_SAMPLE_INTERVAL_MS
+#define WINDOW_SAMPLES  CONFIG_CPU_LOAD_PROFILER_WINDOW_SAMPLES
+
+#define BUSY_WAIT_US 50000
+
+/* ISR_NEST_MAX of the profiler */
+#define ISR_NEST_MAX 8
+
+/* Tracing hooks of the profiler */
+void sys_trace_isr_enter_user(int nested_interrupts);
+void sys_trace_isr_exit_user(int nested_interrupts);
+
+struct ctx_find {
+	const struct k_thread *thread;
+	struct cpu_load_profiler_ctx ctx;
+	bool found;
+	bool idle_found;
+	uint64_t isr_busy_us;
+};
+
+static void ctx_find_cb(const struct cpu_load_profiler_ctx *ctx, void *user_data)
+{
+	struct ctx_find *find = user_data;
+
+	if (ctx->idle) {
+		find->idle_found = true;
+	}
+
+	if (ctx->isr) {
+		find->isr_busy_us += ctx->busy_us;
+	}
+
+	if (ctx->thread == find->thread) {
+		find->ctx = *ctx;
+		find->found = true;
+	}
+}
+
+static struct ctx_find ctx_find(const struct k_thread *thread)
+{
+	struct ctx_find find = {
+		.thread = thread,
+	};
+
+	cpu_load_profiler_ctx_foreach(ctx_find_cb, &find);
+
+	return find;
+}
+
+ZTEST(cpu_load_profiler, test_thread_busy_time)
+{
+	struct ctx_find find;
+
+	cpu_load_profiler_reset();
+	k_busy_wait(BUSY_WAIT_US);
+
+	find = ctx_find(k_current_get());
+	zassert_true(find.found, "Test thread not reported");
+	zassert_false(find.ctx.isr, "Test thread reported as ISR");
+	zassert_false(find.ctx.idle, "Test thread reported as idle");
+	zassert_true(find.ctx.busy_us >= BUSY_WAIT_US, "Busy time too short: %llu",
+		     find.ctx.busy_us);
+	zassert_true(find.ctx.max_run_us >= BUSY_WAIT_US, "Run time too short: %u",
+		     find.ctx.max_run_us);
+
+	/* Sleeping does not add to the busy time of the thread. */
+	k_msleep(2 * SAMPLE_INTERVAL);
+
+	find = ctx_find(k_current_get());
+	zassert_true(find.idle_found, "Idle thread not reported");
+	zassert_true(find.ctx.busy_us < 2 * BUSY_WAIT_US, "Sleep counted as busy: %llu",
+		     find.ctx.busy_us);
+}
+
+ZTEST(cpu_load_profiler, test_window)
+{
+	struct cpu_load_profiler_window w;
+
+	cpu_load_profiler_reset();
+	cpu_load_profiler_window_get(&w);
+	zassert_equal(w.samples, 0, "Window not reset");
+
+	/* Busy wait blocks the sampling work, so the whole wait ends up in a single sample. */
+	k_busy_wait(BUSY_WAIT_US);
+	k_msleep(SAMPLE_INTERVAL / 2);
+
+	cpu_load_profiler_window_get(&w);
+	zassert_true(w.samples >= 1, "No samples");
+	zassert_true(w.max >= 90, "Max load too low: %u", w.max);
+	zassert_true(w.max_burst_us >= BUSY_WAIT_US, "Busy burst too short: %u",
+		     w.max_burst_us);
+
+	/* Push the busy sample out of the window. */
+	k_msleep(2 * WINDOW_SAMPLES * SAMPLE_INTERVAL);
+
+	cpu_load_profiler_window_get(&w);
+	zassert_equal(w.samples, WINDOW_SAMPLES, "Window not full");
+	zassert_true(w.p50 <= w.p90, "Invalid percentiles");
+	zassert_true(w.p90 <= w.p99, "Invalid percentiles");
+	zassert_true(w.p99 <= w.max, "Invalid percentiles");
+	zassert_true(w.max < 50, "Idle load too high: %u", w.max);
+	zassert_true(w.max_burst_us >= BUSY_WAIT_US, "Busy burst lost");
+}
+
+ZTEST(cpu_load_profiler, test_reset)
+{
+	struct cpu_load_profiler_window w;
+	struct ctx_find find;
+
+	k_busy_wait(BUSY_WAIT_US);
+	k_msleep(2 * SAMPLE_INTERVAL);
+	cpu_load_profiler_reset();
+
+	find = ctx_find(k_current_get());
+	zassert_true(find.found, "Test thread not reported");
+	zassert_true(find.ctx.busy_us < BUSY_WAIT_US, "Busy time not reset");
+	zassert_true(find.ctx.max_run_us < BUSY_WAIT_US, "Run time not reset");
+
+	cpu_load_profiler_window_get(&w);
+	zassert_equal(w.samples, 0, "Window not reset");
+	zassert_true(w.max_burst_us < BUSY_WAIT_US, "Busy burst not reset");
+}
+
+ZTEST(cpu_load_profiler, test_isr_nesting_overflow)
+{
+	struct ctx_find find;
+	unsigned int key;
+
+	cpu_load_profiler_reset();
+
+	/* Nest one ISR level more than the profiler tracks. */
+	key = irq_lock();
+	for (int i = 0; i <= ISR_NEST_MAX; i++) {
+		sys_trace_isr_enter_user(i);
+	}
+
+	/* The untracked level exits, the outer ISRs still run. */
+	sys_trace_isr_exit_user(ISR_NEST_MAX);
+	k_busy_wait(BUSY_WAIT_US);
+
+	for (int i = ISR_NEST_MAX - 1; i >= 0; i--) {
+		sys_trace_isr_exit_user(i);
+	}
+	irq_unlock(key);
+
+	find = ctx_find(k_current_get());
+	zassert_true(find.found, "Test thread not reported");
+	zassert_true(find.ctx.busy_us < BUSY_WAIT_US, "ISR time counted for the thread: %llu",
+		     find.ctx.busy_us);
+	zassert_true(find.isr_busy_us >= BUSY_WAIT_US, "ISR time too short: %llu",
+		     find.isr_busy_us);
+
+	/* The thread is tracked again after the last ISR exits. */
+	k_busy_wait(BUSY_WAIT_US);
+
+	find = ctx_find(k_current_get());
+	zassert_true(find.ctx.busy_us >= BUSY_WAIT_US, "Thread time not counted: %llu",
+		     find.ctx.busy_us);
+}
+
+ZTEST_SUITE(cpu_load_profiler, NULL, NULL, NULL, NULL, NULL);
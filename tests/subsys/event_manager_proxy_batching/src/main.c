@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/ipc/ipc_service_backend.h>
+
+/* Included to access the batch state. */
+#include "event_manager_proxy.c"
+
+#define REMOTE_EVENT_ID		((const struct event_type *)0x1000)
+#define STUB_TX_BUF_SIZE	CONFIG_EVENT_MANAGER_PROXY_BATCH_SIZE
+#define EVENT_PROCESS_TIMEOUT	K_MSEC(10)
+#define EVENT_DROP_TIMEOUT	K_MSEC(CONFIG_EVENT_MANAGER_PROXY_BATCH_SEND_TIMEOUT_MS + 50)
+
+struct batch_test_event {
+	struct app_event_header header;
+	uint32_t val;
+};
+
+APP_EVENT_TYPE_DECLARE(batch_test_event);
+APP_EVENT_TYPE_DEFINE(batch_test_event, NULL, NULL, APP_EVENT_FLAGS_CREATE());
+
+#define EVENT_REC_SIZE ROUND_UP(EMP_BATCH_REC_HDR_SIZE + sizeof(struct batch_test_event), \
+				sizeof(uint32_t))
+
+/** @brief IPC backend that provides a single no-copy TX buffer of a limited size. */
+static struct {
+	const struct ipc_ept_cfg *cfg;
+	uint32_t max_tx_size;
+	bool tx_buf_used;
+	uint32_t tx_buf_drop_cnt;
+	uint32_t batch_cnt;
+	uint32_t event_cnt;
+	uint32_t last_val;
+	uint32_t tx_buf[STUB_TX_BUF_SIZE / sizeof(uint32_t)];
+} stub;
+
+static int stub_open_instance(const struct device *instance)
+{
+	return 0;
+}
+
+static int stub_register_endpoint(const struct device *instance, void **token,
+				  const struct ipc_ept_cfg *cfg)
+{
+	stub.cfg = cfg;
+	*token = &stub;
+	cfg->cb.bound(cfg->priv);
+
+	return 0;
+}
+
+static int stub_send(const struct device *instance, void *token, const void *data, size_t len)
+{
+	/* Commands sent to the remote are not checked. */
+	return len;
+}
+
+static int stub_get_tx_buffer(const struct device *instance, void *token, void **data,
+			      uint32_t *len, k_timeout_t wait)
+{
+	if (stub.tx_buf_used) {
+		return -ENOBUFS;
+	}
+
+	if (*len > stub.max_tx_size) {
+		*len = stub.max_tx_size;
+		return -ENOMEM;
+	}
+
+	stub.tx_buf_used = true;
+	*data = stub.tx_buf;
+
+	return 0;
+}
+
+static int stub_drop_tx_buffer(const struct device *instance, void *token, const void *data)
+{
+	zassert_equal_ptr(data, stub.tx_buf, "Unknown TX buffer dropped");
+	zassert_true(stub.tx_buf_used, "TX buffer dropped twice");
+
+	stub.tx_buf_used = false;
+	stub.tx_buf_drop_cnt++;
+
+	return 0;
+}
+
+static int stub_send_nocopy(const struct device *instance, void *token, const void *data,
+			    size_t len)
+{
+	const uint8_t *rec = data;
+
+	zassert_equal_ptr(data, stub.tx_buf, "Unknown TX buffer sent");
+	zassert_true(stub.tx_buf_used, "TX buffer sent twice");
+	zassert_true(len <= stub.max_tx_size, "Batch of %zu bytes exceeds the TX buffer", len);
+
+	while (len > 0) {
+		struct batch_test_event event;
+
+		zassert_equal(sys_get_le32(rec), sizeof(event), "Invalid event record length");
+		zassert_true(len >= EVENT_REC_SIZE, "Truncated event record");
+
+		memcpy(&event, rec + EMP_BATCH_REC_HDR_SIZE, sizeof(event));
+		zassert_equal_ptr(event.header.type_id, REMOTE_EVENT_ID, "Event type not mapped");
+		zassert_equal(event.val, stub.last_val + 1, "Event %u lost", stub.last_val + 1);
+
+		stub.last_val = event.val;
+		stub.event_cnt++;
+		rec += EVENT_REC_SIZE;
+		len -= EVENT_REC_SIZE;
+	}
+
+	stub.tx_buf_used = false;
+	stub.batch_cnt++;
+
+	return rec - (const uint8_t *)data;
+}
+
+static const struct ipc_service_backend stub_backend_api = {
+	.open_instance = stub_open_instance,
+	.register_endpoint = stub_register_endpoint,
+	.send = stub_send,
+	.get_tx_buffer = stub_get_tx_buffer,
+	.drop_tx_buffer = stub_drop_tx_buffer,
+	.send_nocopy = stub_send_nocopy,
+};
+
+DEVICE_DEFINE(stub_ipc, "stub_ipc", NULL, NULL, NULL, NULL, POST_KERNEL,
+	      CONFIG_KERNEL_INIT_PRIORITY_DEVICE, &stub_backend_api);
+
+static void remote_msg_receive(const void *data, size_t len)
+{
+	stub.cfg->cb.received(data, len, stub.cfg->priv);
+}
+
+static void events_submit(size_t cnt)
+{
+	static uint32_t val;
+
+	for (size_t i = 0; i < cnt; i++) {
+		struct batch_test_event *event = new_batch_test_event();
+
+		event->val = ++val;
+		APP_EVENT_SUBMIT(event);
+	}
+}
+
+static void *batching_setup(void)
+{
+	static const char remote_name[] = "batch_test_event";
+	size_t size = sizeof(struct emp_cmd_subscribe) + sizeof(remote_name);
+	uint32_t buffer[DIV_ROUND_UP(size, sizeof(uint32_t))];
+	struct emp_cmd_subscribe *cmd = (struct emp_cmd_subscribe *)buffer;
+	const struct emp_cmd start = {.code = EMP_CMD_START};
+
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+	zassert_ok(event_manager_proxy_add_remote(DEVICE_GET(stub_ipc)), "Cannot add remote");
+
+	/* The remote subscribes to the test event. */
+	cmd->code = EMP_CMD_SUBSCRIBE;
+	cmd->id = REMOTE_EVENT_ID;
+	strcpy(cmd->name, remote_name);
+	remote_msg_receive(buffer, sizeof(buffer));
+
+	zassert_ok(event_manager_proxy_start(), "Cannot start proxy");
+	remote_msg_receive(&start, sizeof(start));
+	zassert_ok(event_manager_proxy_wait_for_remotes(K_NO_WAIT), "Remote not started");
+
+	return NULL;
+}
+
+static void batching_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	stub.max_tx_size = sizeof(stub.tx_buf);
+	stub.tx_buf_drop_cnt = 0;
+	stub.batch_cnt = 0;
+	stub.event_cnt = 0;
+	emp_ipc_data[0].batch.dropped = 0;
+}
+
+ZTEST(batching, test_batch_nocopy)
+{
+	size_t event_cnt = sizeof(stub.tx_buf) / EVENT_REC_SIZE;
+
+	/* All events fit into a single message. */
+	events_submit(event_cnt);
+	k_sleep(EVENT_PROCESS_TIMEOUT);
+
+	zassert_equal(stub.event_cnt, event_cnt, "Events not sent");
+	zassert_equal(stub.batch_cnt, 1, "Events not sent in a single batch");
+	zassert_false(stub.tx_buf_used, "TX buffer not released");
+}
+
+ZTEST(batching, test_tx_buffer_limited)
+{
+	const size_t event_cnt = 5;
+
+	/* The backend provides smaller buffers than requested. */
+	stub.max_tx_size = 2 * EVENT_REC_SIZE;
+
+	events_submit(event_cnt);
+	k_sleep(EVENT_PROCESS_TIMEOUT);
+
+	zassert_equal(stub.event_cnt, event_cnt, "Events not sent");
+	zassert_equal(stub.batch_cnt, DIV_ROUND_UP(event_cnt, 2), "Invalid batch count");
+	zassert_equal(emp_ipc_data[0].batch.dropped, 0, "Events dropped");
+}
+
+ZTEST(batching, test_tx_buffer_smaller_than_event)
+{
+	/* An event cannot fit into any TX buffer. */
+	stub.max_tx_size = EVENT_REC_SIZE - sizeof(uint32_t);
+
+	events_submit(1);
+	k_sleep(EVENT_DROP_TIMEOUT);
+
+	zassert_equal(emp_ipc_data[0].batch.dropped, 1, "Event not dropped after the timeout");
+	zassert_equal(stub.batch_cnt, 0, "Event sent");
+	zassert_true(stub.tx_buf_drop_cnt > 0, "Too small TX buffer not dropped");
+	zassert_false(stub.tx_buf_used, "TX buffer not released");
+
+	/* The next event is sent when the backend provides big enough buffers. */
+	stub.max_tx_size = sizeof(stub.tx_buf);
+	stub.last_val++;
+
+	events_submit(1);
+	k_sleep(EVENT_PROCESS_TIMEOUT);
+
+	zassert_equal(stub.event_cnt, 1, "Event not sent");
+	zassert_equal(emp_ipc_data[0].batch.dropped, 1, "Event dropped");
+}
+
+ZTEST_SUITE(batching, NULL, batching_setup, batching_before, NULL, NULL);
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <nfc/ndef/record.h>
+#include <nfc/ndef/record_parser.h>
+#include <nfc/ndef/msg_parser.h>
+
+/* Record header flags */
+#define MB 0x80
+#define ME 0x40
+#define CF 0x20
+#define SR 0x10
+#define IL 0x08
+
+/* Short record with an ID: well-known type 'U', ID "ab", payload of 3 bytes. */
+static const uint8_t short_record[] = {
+	MB | ME | SR | IL | TNF_WELL_KNOWN, 1, 3, 2,
+	'U',
+	'a', 'b',
+	0x01, 'x', 'y',
+};
+
+/* Long record: well-known type 'T', payload of 3 bytes. */
+static const uint8_t long_record[] = {
+	MB | ME | TNF_WELL_KNOWN, 1, 0x00, 0x00, 0x00, 0x03,
+	'T',
+	0x02, 'e', 'n',
+};
+
+/* Message of three short records. */
+static const uint8_t msg_three_records[] = {
+	MB | SR | TNF_WELL_KNOWN, 1, 1, 'U', 0x01,
+	SR | TNF_MEDIA_TYPE, 1, 2, 'm', 0x02, 0x03,
+	ME | SR | TNF_EMPTY, 0, 0,
+};
+
+/* Message with a payload in three chunks. */
+static const uint8_t msg_chunked[] = {
+	MB | CF | SR | TNF_WELL_KNOWN, 1, 2, 'T', 'a', 'b',
+	CF | SR | TNF_UNCHANGED, 0, 2, 'c', 'd',
+	ME | SR | TNF_UNCHANGED, 0, 1, 'e',
+};
+
+/* Message with an ID in the continuation chunk. */
+static const uint8_t msg_chunk_id[] = {
+	MB | CF | SR | TNF_WELL_KNOWN, 1, 1, 'T', 'a',
+	ME | SR | IL | TNF_UNCHANGED, 0, 1, 1, 'i', 'b',
+};
+
+static void iter_check_error(const uint8_t *data, uint32_t len, uint32_t valid_records,
+			     int expected_err)
+{
+	struct nfc_ndef_msg_iter iter;
+	struct nfc_ndef_record_view view;
+	int err;
+
+	nfc_ndef_msg_iter_init(&iter, data, len);
+
+	for (uint32_t i = 0; i < valid_records; i++) {
+		err = nfc_ndef_msg_iter_next(&iter, &view);
+		zassert_ok(err, "Record %u not parsed: %d", i, err);
+	}
+
+	err = nfc_ndef_msg_iter_next(&iter, &view);
+	zassert_equal(err, expected_err, "Unexpected result: %d", err);
+}
+
+ZTEST(nfc_ndef_parser, test_record_view_short)
+{
+	struct nfc_ndef_record_view view;
+	uint8_t data[sizeof(short_record) + 4];
+	uint32_t len = sizeof(data);
+	int err;
+
+	/* Data after the record is not part of it. */
+	memset(data, 0xFF, sizeof(data));
+	memcpy(data, short_record, sizeof(short_record));
+
+	err = nfc_ndef_record_view_parse(&view, data, &len);
+	zassert_ok(err, "Parsing failed: %d", err);
+	zassert_equal(len, sizeof(short_record), "Invalid record length");
+
+	zassert_equal(view.tnf, TNF_WELL_KNOWN);
+	zassert_equal(view.location, NDEF_LONE_RECORD);
+	zassert_false(view.chunk);
+	zassert_equal(view.type_length, 1);
+	zassert_equal_ptr(view.type, &data[4]);
+	zassert_equal(view.id_length, 2);
+	zassert_equal_ptr(view.id, &data[5]);
+	zassert_equal(view.payload_length, 3);
+	zassert_equal_ptr(view.payload, &data[7]);
+}
+
+ZTEST(nfc_ndef_parser, test_record_view_long)
+{
+	struct nfc_ndef_record_view view;
+	uint32_t len = sizeof(long_record);
+	int err;
+
+	err = nfc_ndef_record_view_parse(&view, long_record, &len);
+	zassert_ok(err, "Parsing failed: %d", err);
+	zassert_equal(len, sizeof(long_record), "Invalid record length");
+
+	zassert_equal(view.type_length, 1);
+	zassert_equal_ptr(view.type, &long_record[6]);
+	zassert_equal(view.id_length, 0);
+	zassert_is_null(view.id);
+	zassert_equal(view.payload_length, 3);
+	zassert_equal_ptr(view.payload, &long_record[7]);
+}
+
+ZTEST(nfc_ndef_parser, test_record_view_reserved_tnf)
+{
+	static const uint8_t record[] = {MB | ME | SR | TNF_RESERVED, 0, 0};
+	struct nfc_ndef_record_view view;
+	uint32_t len = sizeof(record);
+	int err;
+
+	/* Unsupported TNF is treated as Unknown. */
+	err = nfc_ndef_record_view_parse(&view, record, &len);
+	zassert_ok(err, "Parsing failed: %d", err);
+	zassert_equal(view.tnf, TNF_UNKNOWN_TYPE);
+	zassert_is_null(view.type);
+	zassert_is_null(view.payload);
+}
+
+ZTEST(nfc_ndef_parser, test_record_view_truncated)
+{
+	struct nfc_ndef_record_view view;
+	uint32_t len;
+	int err;
+
+	/* Truncated in the header and in the fields, for both record formats. */
+	for (uint32_t i = 0; i < sizeof(short_record); i++) {
+		len = i;
+		err = nfc_ndef_record_view_parse(&view, short_record, &len);
+		zassert_equal(err, -EAGAIN, "Short record truncated to %u parsed: %d", i, err);
+		zassert_equal(len, i, "Length modified on error");
+	}
+
+	for (uint32_t i = 0; i < sizeof(long_record); i++) {
+		len = i;
+		err = nfc_ndef_record_view_parse(&view, long_record, &len);
+		zassert_equal(err, -EAGAIN, "Long record truncated to %u parsed: %d", i, err);
+		zassert_equal(len, i, "Length modified on error");
+	}
+}
+
+ZTEST(nfc_ndef_parser, test_record_view_payload_length_overflow)
+{
+	/* Payload lengths which overflow the record length in 32 bits. */
+	static const uint32_t payload_lengths[] = {
+		UINT32_MAX,
+		UINT32_MAX - 6,
+		UINT32_MAX - 5,
+	};
+	uint8_t record[64] = {
+		MB | ME | TNF_WELL_KNOWN, 1, 0, 0, 0, 0,
+		'T',
+	};
+	struct nfc_ndef_record_view view;
+	uint32_t len;
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(payload_lengths); i++) {
+		sys_put_be32(payload_lengths[i], &record[2]);
+		len = sizeof(record);
+
+		err = nfc_ndef_record_view_parse(&view, record, &len);
+		zassert_equal(err, -EAGAIN, "Payload length 0x%08x accepted",
+			      payload_lengths[i]);
+	}
+
+	/* The largest payload that fits in the data. */
+	sys_put_be32(sizeof(record) - 7, &record[2]);
+	len = sizeof(record);
+
+	err = nfc_ndef_record_view_parse(&view, record, &len);
+	zassert_ok(err, "Parsing failed: %d", err);
+	zassert_equal(len, sizeof(record), "Invalid record length");
+}
+
+ZTEST(nfc_ndef_parser, test_msg_iter)
+{
+	struct nfc_ndef_msg_iter iter;
+	struct nfc_ndef_record_view view;
+	int err;
+
+	nfc_ndef_msg_iter_init(&iter, msg_three_records, sizeof(msg_three_records));
+
+	err = nfc_ndef_msg_iter_next(&iter, &view);
+	zassert_ok(err, "Parsing failed: %d", err);
+	zassert_equal(view.location, NDEF_FIRST_RECORD);
+	zassert_equal(view.tnf, TNF_WELL_KNOWN);
+	zassert_equal_ptr(view.payload, &msg_three_records[4]);
+
+	err = nfc_ndef_msg_iter_next(&iter, &view);
+	zassert_ok(err, "Parsing failed: %d", err);
+	zassert_equal(view.location, NDEF_MIDDLE_RECORD);
+	zassert_equal(view.tnf, TNF_MEDIA_TYPE);
+	zassert_equal(view.payload_length, 2);
+	zassert_equal_ptr(view.payload, &msg_three_records[9]);
+
+	err = nfc_ndef_msg_iter_next(&iter, &view);
+	zassert_ok(err, "Parsing failed: %d", err);
+	zassert_equal(view.location, NDEF_LAST_RECORD);
+	zassert_equal(view.tnf, TNF_EMPTY);
+	zassert_is_null(view.payload);
+
+	zassert_equal(iter.record_count, 3);
+	zassert_equal(iter.offset, sizeof(msg_three_records));
+
+	err = nfc_ndef_msg_iter_next(&iter, &view);
+	zassert_equal(err, -ENODATA, "Record after the Message End flag: %d", err);
+}
+
+ZTEST(nfc_ndef_parser, test_msg_iter_location_flags)
+{
+	uint8_t msg[sizeof(msg_three_records)];
+
+	/* No Message Begin flag in the first record. */
+	memcpy(msg, msg_three_records, sizeof(msg));
+	msg[0] &= ~MB;
+	iter_check_error(msg, sizeof(msg), 0, -EFAULT);
+
+	/* Message Begin flag in the second record. */
+	memcpy(msg, msg_three_records, sizeof(msg));
+	msg[5] |= MB;
+	iter_check_error(msg, sizeof(msg), 1, -EFAULT);
+
+	/* No Message End flag: the iterator waits for more records. */
+	memcpy(msg, msg_three_records, sizeof(msg));
+	msg[11] &= ~ME;
+	iter_check_error(msg, sizeof(msg), 3, -EAGAIN);
+
+	/* Message End flag in the second record: the third record is ignored. */
+	memcpy(msg, msg_three_records, sizeof(msg));
+	msg[5] |= ME;
+	iter_check_error(msg, sizeof(msg), 2, -ENODATA);
+}
+
+ZTEST(nfc_ndef_parser, test_msg_iter_chunked)
+{
+	struct nfc_ndef_msg_iter iter;
+	struct nfc_ndef_record_view view;
+	uint8_t msg[sizeof(msg_chunked)];
+	int err;
+
+	nfc_ndef_msg_iter_init(&iter, msg_chunked, sizeof(msg_chunked));
+
+	err = nfc_ndef_msg_iter_next(&iter, &view);
+	zassert_ok(err, "Parsing failed: %d", err);
+	zassert_true(view.chunk);
+	zassert_equal(view.tnf, TNF_WELL_KNOWN);
+
+	err = nfc_ndef_msg_iter_next(&iter, &view);
+	zassert_ok(err, "Parsing failed: %d", err);
+	zassert_true(view.chunk);
+	zassert_equal(view.tnf, TNF_UNCHANGED);
+	zassert_equal_ptr(view.payload, &msg_chunked[9]);
+
+	err = nfc_ndef_msg_iter_next(&iter, &view);
+	zassert_ok(err, "Parsing failed: %d", err);
+	zassert_false(view.chunk);
+	zassert_equal(view.tnf, TNF_UNCHANGED);
+	zassert_equal(view.payload_length, 1);
+
+	err = nfc_ndef_msg_iter_next(&iter, &view);
+	zassert_equal(err, -ENODATA, "Record after the Message End flag: %d", err);
+
+	/* Continuation chunk with a TNF other than Unchanged. */
+	memcpy(msg, msg_chunked, sizeof(msg));
+	msg[6] = CF | SR | TNF_WELL_KNOWN;
+	iter_check_error(msg, sizeof(msg), 1, -EFAULT);
+
+	/* Continuation chunk with a type. */
+	memcpy(msg, msg_chunked, sizeof(msg));
+	msg[7] = 1;
+	msg[8] = 1;
+	iter_check_error(msg, sizeof(msg), 1, -EFAULT);
+
+	/* Continuation chunk with an ID. */
+	iter_check_error(msg_chunk_id, sizeof(msg_chunk_id), 1, -EFAULT);
+
+	/* Unchanged TNF outside of a chunked payload. */
+	memcpy(msg, msg_chunked, sizeof(msg));
+	msg[0] = MB | SR | TNF_UNCHANGED;
+	iter_check_error(msg, sizeof(msg), 0, -EFAULT);
+
+	/* Chunked payload not finished before the end of the message. */
+	memcpy(msg, msg_chunked, sizeof(msg));
+	msg[6] |= ME;
+	iter_check_error(msg, sizeof(msg), 1, -EFAULT);
+}
+
+ZTEST(nfc_ndef_parser, test_msg_iter_incremental)
+{
+	struct nfc_ndef_msg_iter iter;
+	struct nfc_ndef_record_view view;
+	uint8_t buf[sizeof(msg_three_records)];
+	uint32_t record_ends[] = {5, 11, sizeof(msg_three_records)};
+	uint32_t record = 0;
+	int err;
+
+	/* The data arrives byte by byte into the same buffer. */
+	memset(buf, 0, sizeof(buf));
+	nfc_ndef_msg_iter_init(&iter, buf, 0);
+
+	for (uint32_t len = 0; len <= sizeof(buf); len++) {
+		if (len > 0) {
+			buf[len - 1] = msg_three_records[len - 1];
+			nfc_ndef_msg_iter_extend(&iter, len);
+		}
+
+		err = nfc_ndef_msg_iter_next(&iter, &view);
+		if (len < record_ends[record]) {
+			zassert_equal(err, -EAGAIN, "Record %u parsed with %u bytes: %d",
+				      record, len, err);
+			zassert_equal(iter.record_count, record, "Iterator advanced");
+			continue;
+		}
+
+		zassert_ok(err, "Record %u not parsed with %u bytes: %d", record, len, err);
+		zassert_equal(iter.offset, record_ends[record], "Invalid offset");
+		record++;
+	}
+
+	zassert_equal(record, ARRAY_SIZE(record_ends), "Not all records parsed");
+
+	err = nfc_ndef_msg_iter_next(&iter, &view);
+	zassert_equal(err, -ENODATA, "Record after the Message End flag: %d", err);
+}
+
+ZTEST_SUITE(nfc_ndef_parser, NULL, NULL, NULL, NULL, NULL);
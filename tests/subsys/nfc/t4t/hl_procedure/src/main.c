@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+#include <nfc/t4t/apdu.h>
+#include <nfc/t4t/cc_file.h>
+#include <nfc/t4t/hl_procedure.h>
+
+#define CC_FILE_ID 0xE103
+#define NDEF_FILE_ID 0xE104
+#define NDEF_FILE_MAX_SIZE 4096
+#define NDEF_FILE_NLEN_SIZE 2
+#define CC_FILE_LEN 15
+
+#define RAPDU_STATUS_SIZE 2
+#define RAPDU_STATUS_FILE_NOT_FOUND 0x6A82
+#define RAPDU_STATUS_WRONG_LENGTH 0x6700
+#define RAPDU_STATUS_WRONG_PARAMS 0x6B00
+
+/* Header of a single long NDEF record with the well-known type 'U'. */
+#define NDEF_RECORD_HEADER_SIZE 7
+
+#define MAX_TLV_BLOCKS 2
+
+NFC_T4T_CC_DESC_DEF(t4t_cc, MAX_TLV_BLOCKS);
+
+/* Simulated Type 4 Tag. */
+static struct {
+	uint16_t mle;
+	uint16_t mlc;
+	uint8_t cc_file[CC_FILE_LEN];
+	uint8_t ndef_file[NDEF_FILE_MAX_SIZE];
+	uint16_t selected_file;
+	uint8_t rapdu[NDEF_FILE_MAX_SIZE + RAPDU_STATUS_SIZE];
+	size_t rapdu_len;
+	bool rapdu_pending;
+	uint32_t exchanges;
+	uint32_t max_capdu_data;
+	uint32_t max_rapdu_data;
+} tag;
+
+/* Reader side ISO-DEP receive buffer. */
+static uint8_t rx_buf[NDEF_FILE_MAX_SIZE + RAPDU_STATUS_SIZE];
+static uint8_t ndef_buf[NDEF_FILE_MAX_SIZE];
+
+static struct {
+	enum nfc_t4t_hl_procedure_select selected;
+	bool cc_read;
+	size_t ndef_read_len;
+	bool ndef_updated;
+} hl_result;
+
+static void hl_selected(enum nfc_t4t_hl_procedure_select type)
+{
+	hl_result.selected = type;
+}
+
+static void hl_cc_read(struct nfc_t4t_cc_file *cc)
+{
+	hl_result.cc_read = true;
+}
+
+static void hl_ndef_read(uint16_t file_id, const uint8_t *data, size_t len)
+{
+	zassert_equal(file_id, NDEF_FILE_ID);
+	hl_result.ndef_read_len = len;
+}
+
+static void hl_ndef_updated(uint16_t file_id)
+{
+	zassert_equal(file_id, NDEF_FILE_ID);
+	hl_result.ndef_updated = true;
+}
+
+static const struct nfc_t4t_hl_procedure_cb hl_cb = {
+	.selected = hl_selected,
+	.cc_read = hl_cc_read,
+	.ndef_read = hl_ndef_read,
+	.ndef_updated = hl_ndef_updated,
+};
+
+static void tag_status_set(uint16_t status)
+{
+	sys_put_be16(status, &tag.rapdu[tag.rapdu_len]);
+	tag.rapdu_len += RAPDU_STATUS_SIZE;
+}
+
+static uint8_t *tag_file_get(size_t *size)
+{
+	switch (tag.selected_file) {
+	case CC_FILE_ID:
+		*size = sizeof(tag.cc_file);
+		return tag.cc_file;
+	case NDEF_FILE_ID:
+		*size = sizeof(tag.ndef_file);
+		return tag.ndef_file;
+	default:
+		return NULL;
+	}
+}
+
+static void tag_select(uint16_t p1p2, const uint8_t *data, uint32_t lc)
+{
+	static const uint8_t app_name[] = {0xD2, 0x76, 0x00, 0x00, 0x85, 0x01, 0x01};
+
+	if (p1p2 == NFC_T4T_APDU_SELECT_BY_NAME) {
+		if ((lc == sizeof(app_name)) && !memcmp(data, app_name, lc)) {
+			tag_status_set(NFC_T4T_APDU_RAPDU_STATUS_CMD_COMPLETED);
+		} else {
+			tag_status_set(RAPDU_STATUS_FILE_NOT_FOUND);
+		}
+		return;
+	}
+
+	uint16_t file_id = (lc == sizeof(uint16_t)) ? sys_get_be16(data) : 0;
+
+	if ((file_id == CC_FILE_ID) || (file_id == NDEF_FILE_ID)) {
+		tag.selected_file = file_id;
+		tag_status_set(NFC_T4T_APDU_RAPDU_STATUS_CMD_COMPLETED);
+	} else {
+		tag_status_set(RAPDU_STATUS_FILE_NOT_FOUND);
+	}
+}
+
+static void tag_read(uint16_t offset, uint32_t le)
+{
+	size_t file_size;
+	const uint8_t *file = tag_file_get(&file_size);
+
+	zassert_not_null(file, "No file selected");
+	zassert_true(le <= tag.mle, "Le %u above MLe %u", le, tag.mle);
+
+	if (offset > file_size) {
+		tag_status_set(RAPDU_STATUS_WRONG_PARAMS);
+		return;
+	}
+
+	tag.rapdu_len = MIN(le, file_size - offset);
+	memcpy(tag.rapdu, &file[offset], tag.rapdu_len);
+	tag.max_rapdu_data = MAX(tag.max_rapdu_data, tag.rapdu_len);
+
+	tag_status_set(NFC_T4T_APDU_RAPDU_STATUS_CMD_COMPLETED);
+}
+
+static void tag_update(uint16_t offset, const uint8_t *data, uint32_t lc)
+{
+	size_t file_size;
+	uint8_t *file = tag_file_get(&file_size);
+
+	zassert_not_null(file, "No file selected");
+	zassert_true(lc <= tag.mlc, "Lc %u above MLc %u", lc, tag.mlc);
+
+	if (offset + lc > file_size) {
+		tag_status_set(RAPDU_STATUS_WRONG_PARAMS);
+		return;
+	}
+
+	memcpy(&file[offset], data, lc);
+	tag.max_capdu_data = MAX(tag.max_capdu_data, lc);
+
+	tag_status_set(NFC_T4T_APDU_RAPDU_STATUS_CMD_COMPLETED);
+}
+
+/* Decode the C-APDU body in short or extended length format, see ISO/IEC 7816-4, 5.1. */
+static int capdu_body_decode(const uint8_t *body, size_t len, const uint8_t **data,
+			     uint32_t *lc, uint32_t *le)
+{
+	*data = NULL;
+	*lc = 0;
+	*le = 0;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	if (len == 1) {
+		*le = body[0] ? body[0] : 256;
+		return 0;
+	}
+
+	if (body[0] != 0) {
+		*lc = body[0];
+		*data = &body[1];
+
+		if (len == 1 + *lc) {
+			return 0;
+		}
+		if (len == 2 + *lc) {
+			*le = body[len - 1] ? body[len - 1] : 256;
+			return 0;
+		}
+
+		return -EINVAL;
+	}
+
+	if (len == 3) {
+		*le = sys_get_be16(&body[1]) ? sys_get_be16(&body[1]) : 65536;
+		return 0;
+	}
+
+	*lc = sys_get_be16(&body[1]);
+	*data = &body[3];
+
+	if (len == 3 + *lc) {
+		return 0;
+	}
+	if (len == 5 + *lc) {
+		*le = sys_get_be16(&body[len - 2]) ? sys_get_be16(&body[len - 2]) : 65536;
+		return 0;
+	}
+
+	return -EINVAL;
+}
+
+int __wrap_nfc_t4t_isodep_transmit(const uint8_t *data, size_t data_len)
+{
+	const uint8_t *capdu_data;
+	uint32_t lc;
+	uint32_t le;
+	uint16_t p1p2;
+
+	zassert_false(tag.rapdu_pending, "C-APDU sent before R-APDU was received");
+	zassert_true(data_len >= 4, "C-APDU too short");
+
+	tag.exchanges++;
+	tag.rapdu_len = 0;
+	tag.rapdu_pending = true;
+
+	p1p2 = sys_get_be16(&data[2]);
+
+	if (capdu_body_decode(&data[4], data_len - 4, &capdu_data, &lc, &le)) {
+		tag_status_set(RAPDU_STATUS_WRONG_LENGTH);
+		return 0;
+	}
+
+	switch (data[1]) {
+	case NFC_T4T_APDU_COMM_INS_SELECT:
+		tag_select(p1p2, capdu_data, lc);
+		break;
+	case NFC_T4T_APDU_COMM_INS_READ:
+		tag_read(p1p2, le);
+		break;
+	case NFC_T4T_APDU_COMM_INS_UPDATE:
+		tag_update(p1p2, capdu_data, lc);
+		break;
+	default:
+		zassert_unreachable("Unexpected instruction 0x%02X", data[1]);
+	}
+
+	return 0;
+}
+
+/* Deliver the R-APDUs to the HL procedure until the tag has no response pending. */
+static int exchanges_run(void)
+{
+	int err = 0;
+
+	while (tag.rapdu_pending) {
+		size_t len = tag.rapdu_len;
+
+		memcpy(rx_buf, tag.rapdu, len);
+		tag.rapdu_pending = false;
+
+		err = nfc_t4t_hl_procedure_on_data_received(rx_buf, len);
+		if (err) {
+			break;
+		}
+	}
+
+	return err;
+}
+
+static void tag_init(uint16_t mle, uint16_t mlc, uint16_t nlen)
+{
+	uint8_t *cc = tag.cc_file;
+
+	memset(&tag, 0, sizeof(tag));
+
+	tag.mle = mle;
+	tag.mlc = mlc;
+
+	/* CC file with a single NDEF File Control TLV. */
+	sys_put_be16(CC_FILE_LEN, &cc[0]);
+	cc[2] = 0x20;
+	sys_put_be16(mle, &cc[3]);
+	sys_put_be16(mlc, &cc[5]);
+	cc[7] = 0x04;
+	cc[8] = 0x06;
+	sys_put_be16(NDEF_FILE_ID, &cc[9]);
+	sys_put_be16(NDEF_FILE_MAX_SIZE, &cc[11]);
+	cc[13] = 0x00;
+	cc[14] = 0x00;
+
+	/* NDEF message with a single long record. */
+	uint8_t *msg = &tag.ndef_file[NDEF_FILE_NLEN_SIZE];
+
+	sys_put_be16(nlen, tag.ndef_file);
+
+	if (nlen < NDEF_RECORD_HEADER_SIZE) {
+		return;
+	}
+
+	msg[0] = 0xC1;
+	msg[1] = 1;
+	sys_put_be32(nlen - NDEF_RECORD_HEADER_SIZE, &msg[2]);
+	msg[6] = 'U';
+
+	for (size_t i = NDEF_RECORD_HEADER_SIZE; i < nlen; i++) {
+		msg[i] = (uint8_t)i;
+	}
+}
+
+static void tag_detect(void)
+{
+	int err;
+
+	memset(&hl_result, 0, sizeof(hl_result));
+	memset(&NFC_T4T_CC_DESC(t4t_cc), 0, sizeof(NFC_T4T_CC_DESC(t4t_cc)));
+	NFC_T4T_CC_DESC(t4t_cc).tlv_block_array = t4t_cc_tlv_block_array;
+	NFC_T4T_CC_DESC(t4t_cc).max_tlv_blocks = MAX_TLV_BLOCKS;
+
+	err = nfc_t4t_hl_procedure_ndef_tag_app_select();
+	zassert_ok(err);
+	zassert_ok(exchanges_run());
+	zassert_equal(hl_result.selected, NFC_T4T_HL_PROCEDURE_NDEF_APP_SELECT);
+
+	err = nfc_t4t_hl_procedure_cc_select();
+	zassert_ok(err);
+	zassert_ok(exchanges_run());
+	zassert_equal(hl_result.selected, NFC_T4T_HL_PROCEDURE_CC_SELECT);
+
+	err = nfc_t4t_hl_procedure_cc_read(&NFC_T4T_CC_DESC(t4t_cc));
+	zassert_ok(err);
+	zassert_ok(exchanges_run());
+	zassert_true(hl_result.cc_read);
+
+	err = nfc_t4t_hl_procedure_ndef_file_select(NDEF_FILE_ID);
+	zassert_ok(err);
+	zassert_ok(exchanges_run());
+	zassert_equal(hl_result.selected, NFC_T4T_HL_PROCEDURE_NDEF_FILE_SELECT);
+
+	tag.exchanges = 0;
+}
+
+static uint32_t ndef_read_run(uint16_t mle, uint16_t nlen)
+{
+	int err;
+
+	tag_init(mle, 0xFF, nlen);
+	tag_detect();
+
+	memset(ndef_buf, 0, sizeof(ndef_buf));
+
+	err = nfc_t4t_hl_procedure_ndef_read(&NFC_T4T_CC_DESC(t4t_cc), ndef_buf,
+					     sizeof(ndef_buf));
+	zassert_ok(err);
+	zassert_ok(exchanges_run());
+
+	zassert_equal(hl_result.ndef_read_len, nlen + NDEF_FILE_NLEN_SIZE);
+	zassert_mem_equal(ndef_buf, tag.ndef_file, nlen + NDEF_FILE_NLEN_SIZE);
+
+	TC_PRINT("MLe %u: %u bytes read in %u exchanges\n", mle,
+		 nlen + NDEF_FILE_NLEN_SIZE, tag.exchanges);
+
+	return tag.exchanges;
+}
+
+static void *suite_setup(void)
+{
+	zassert_ok(nfc_t4t_hl_procedure_cb_register(&hl_cb));
+
+	return NULL;
+}
+
+ZTEST_SUITE(nfc_t4t_hl_procedure, NULL, suite_setup, NULL, NULL, NULL);
+
+ZTEST(nfc_t4t_hl_procedure, test_apdu_encode_extended)
+{
+	struct nfc_t4t_apdu_comm comm;
+	uint8_t data[300] = {0};
+	uint8_t buf[320];
+	uint16_t len;
+
+	/* Short Le, 256 encoded as 0x00. */
+	nfc_t4t_apdu_comm_clear(&comm);
+	comm.instruction = NFC_T4T_APDU_COMM_INS_READ;
+	comm.parameter = 0x0102;
+	comm.resp_len = 256;
+	len = sizeof(buf);
+	zassert_ok(nfc_t4t_apdu_comm_encode(&comm, buf, &len));
+	zassert_equal(len, 5);
+	zassert_equal(buf[4], 0x00);
+
+	/* Extended Le without data field starts with a zero byte. */
+	comm.resp_len = 0x0400;
+	len = sizeof(buf);
+	zassert_ok(nfc_t4t_apdu_comm_encode(&comm, buf, &len));
+	zassert_equal(len, 7);
+	zassert_mem_equal(&buf[4], ((uint8_t []){0x00, 0x04, 0x00}), 3);
+
+	/* Extended Lc. */
+	nfc_t4t_apdu_comm_clear(&comm);
+	comm.instruction = NFC_T4T_APDU_COMM_INS_UPDATE;
+	comm.data.buff = data;
+	comm.data.len = sizeof(data);
+	len = sizeof(buf);
+	zassert_ok(nfc_t4t_apdu_comm_encode(&comm, buf, &len));
+	zassert_equal(len, 4 + 3 + sizeof(data));
+	zassert_mem_equal(&buf[4], ((uint8_t []){0x00, 0x01, 0x2C}), 3);
+
+	/* Extended Le makes the Lc field extended too. */
+	nfc_t4t_apdu_comm_clear(&comm);
+	comm.instruction = NFC_T4T_APDU_COMM_INS_SELECT;
+	comm.data.buff = data;
+	comm.data.len = 2;
+	comm.resp_len = 0x0200;
+	len = sizeof(buf);
+	zassert_ok(nfc_t4t_apdu_comm_encode(&comm, buf, &len));
+	zassert_equal(len, 4 + 3 + 2 + 2);
+	zassert_mem_equal(&buf[4], ((uint8_t []){0x00, 0x00, 0x02, 0x00, 0x00, 0x02, 0x00}), 7);
+
+	/* Buffer too small. */
+	len = 10;
+	zassert_equal(nfc_t4t_apdu_comm_encode(&comm, buf, &len), -ENOMEM);
+}
+
+ZTEST(nfc_t4t_hl_procedure, test_ndef_read_throughput)
+{
+	const uint16_t nlen = 3000;
+	uint32_t exchanges;
+
+	/* NLEN read and chunks limited by MLe. */
+	exchanges = ndef_read_run(0x3B, nlen);
+	zassert_equal(exchanges, 1 + DIV_ROUND_UP(nlen, 0x3B));
+	zassert_equal(tag.max_rapdu_data, 0x3B);
+
+	/* Short APDUs. */
+	exchanges = ndef_read_run(0xFF, nlen);
+	zassert_equal(exchanges, 1 + DIV_ROUND_UP(nlen, 0xFF));
+
+	/* Extended APDUs, limited by CONFIG_NFC_T4T_HL_PROCEDURE_RAPDU_MAX_SIZE. */
+	exchanges = ndef_read_run(0xFFFF, nlen);
+	zassert_equal(exchanges, 1 + DIV_ROUND_UP(nlen, CONFIG_NFC_T4T_HL_PROCEDURE_RAPDU_MAX_SIZE));
+	zassert_equal(tag.max_rapdu_data, CONFIG_NFC_T4T_HL_PROCEDURE_RAPDU_MAX_SIZE);
+}
+
+ZTEST(nfc_t4t_hl_procedure, test_ndef_update_throughput)
+{
+	const uint16_t nlen = 3000;
+	const uint16_t mlc[] = {0x40, 0xFF, 0x0800};
+	int err;
+
+	for (size_t i = 0; i < ARRAY_SIZE(mlc); i++) {
+		uint32_t chunk = MIN(mlc[i], CONFIG_NFC_T4T_HL_PROCEDURE_APDU_BUF_SIZE - 7);
+
+		tag_init(0xFF, mlc[i], 0);
+		tag_detect();
+
+		/* New NDEF file content from another tag. */
+		tag_init(0xFF, mlc[i], nlen);
+		memcpy(ndef_buf, tag.ndef_file, nlen + NDEF_FILE_NLEN_SIZE);
+		tag_init(0xFF, mlc[i], 0);
+		tag.selected_file = NDEF_FILE_ID;
+
+		err = nfc_t4t_hl_procedure_ndef_update(&NFC_T4T_CC_DESC(t4t_cc), ndef_buf,
+						       nlen + NDEF_FILE_NLEN_SIZE);
+		zassert_ok(err);
+		zassert_ok(exchanges_run());
+		zassert_true(hl_result.ndef_updated);
+		zassert_mem_equal(tag.ndef_file, ndef_buf, nlen + NDEF_FILE_NLEN_SIZE);
+
+		/* NLEN clear, data chunks and NLEN update. */
+		zassert_equal(tag.exchanges, 2 + DIV_ROUND_UP(nlen, chunk));
+		zassert_equal(tag.max_capdu_data, chunk);
+
+		TC_PRINT("MLc %u: %u bytes written in %u exchanges\n", mlc[i],
+			 nlen + NDEF_FILE_NLEN_SIZE, tag.exchanges);
+	}
+}
+
+ZTEST(nfc_t4t_hl_procedure, test_ndef_read_invalid_message)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_NFC_T4T_HL_PROCEDURE_NDEF_VALIDATE);
+
+	int err;
+
+	tag_init(0x40, 0xFF, 1000);
+
+	/* Record continuing after the end of the message. */
+	sys_put_be32(2000, &tag.ndef_file[NDEF_FILE_NLEN_SIZE + 2]);
+
+	tag_detect();
+
+	err = nfc_t4t_hl_procedure_ndef_read(&NFC_T4T_CC_DESC(t4t_cc), ndef_buf,
+					     sizeof(ndef_buf));
+	zassert_ok(err);
+	zassert_equal(exchanges_run(), -EINVAL);
+	zassert_equal(hl_result.ndef_read_len, 0);
+
+	/* Message Begin flag missing in the first record, which fits in the first chunk. */
+	tag_init(0x40, 0xFF, 1000);
+	tag.ndef_file[NDEF_FILE_NLEN_SIZE] &= ~0x80;
+	sys_put_be32(16, &tag.ndef_file[NDEF_FILE_NLEN_SIZE + 2]);
+
+	tag_detect();
+
+	err = nfc_t4t_hl_procedure_ndef_read(&NFC_T4T_CC_DESC(t4t_cc), ndef_buf,
+					     sizeof(ndef_buf));
+	zassert_ok(err);
+	zassert_equal(exchanges_run(), -EFAULT);
+
+	/* The next chunk is not requested after the validation fails. */
+	zassert_false(tag.rapdu_pending);
+	zassert_equal(hl_result.ndef_read_len, 0);
+	zassert_equal(tag.exchanges, 2);
+}
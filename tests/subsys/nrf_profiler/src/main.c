@@ -8,6 +8,9 @@
 #include <nrf_profiler.h>
 
 #define PROFILED_EVENTS_NB 100
+/* Rounds of profiling big events that do not fit in the event ring buffer together. */
+#define OVERFLOW_ROUNDS_NB \
+	DIV_ROUND_UP(CONFIG_NRF_PROFILER_NORDIC_RING_BUFFER_SIZE / 16, PROFILED_EVENTS_NB)
 #define U_VALUE_START 0
 #define S_VALUE_START -50
 #define EXAMPLE_STRING "example string"
@@ -120,4 +123,33 @@ ZTEST(suite_nrf_profiler, test_performance_03)
 	       "Elapsed time [us]: %d\n", PROFILED_EVENTS_NB, elapsed_time_us);
 }
 
+ZTEST(suite_nrf_profiler, test_stats)
+{
+	struct nrf_profiler_stats before;
+	struct nrf_profiler_stats after;
+
+	/* Let the events profiled by the previous tests be passed to the backend. */
+	k_sleep(K_MSEC(100));
+	zassert_ok(nrf_profiler_stats_get(&before));
+
+	/* The test thread is cooperative, so the ring buffer is not drained in the meantime. */
+	for (size_t i = 0; i < OVERFLOW_ROUNDS_NB; i++) {
+		(void)test_performance_core(profile_big_event, big_event_id);
+	}
+
+	zassert_ok(nrf_profiler_stats_get(&after));
+	zassert_true(after.events_dropped > before.events_dropped, "No events dropped");
+
+	printk("Dropped %u events\n", after.events_dropped - before.events_dropped);
+
+	if (IS_ENABLED(CONFIG_NRF_PROFILER_NORDIC_BACKEND_FILE)) {
+		/* Wait until the file backend receives the stored events. */
+		k_sleep(K_MSEC(100));
+		zassert_ok(nrf_profiler_stats_get(&after));
+		zassert_equal((after.events_sent - before.events_sent) +
+			      (after.events_dropped - before.events_dropped),
+			      PROFILED_EVENTS_NB * OVERFLOW_ROUNDS_NB);
+	}
+}
+
 ZTEST_SUITE(suite_nrf_profiler, NULL, test_init, NULL, NULL, NULL);
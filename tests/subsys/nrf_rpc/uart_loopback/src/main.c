@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <nrf_rpc/nrf_rpc_uart.h>
+
+#define RPC_UART_NODE DT_CHOSEN(nordic_rpc_uart)
+
+#define FRAME_SIZE    256
+#define FRAME_COUNT   200
+#define FRAME_TIMEOUT K_MSEC(100)
+
+static const struct nrf_rpc_tr *tr = &NRF_RPC_UART_TRANSPORT(RPC_UART_NODE);
+
+static K_SEM_DEFINE(rx_sem, 0, 1);
+static const uint8_t *expected_data;
+static size_t expected_len;
+static size_t rx_frames;
+static size_t rx_errors;
+
+static void receive_handler(const struct nrf_rpc_tr *transport, const uint8_t *data, size_t len,
+			    void *context)
+{
+	if (len != expected_len || memcmp(data, expected_data, len) != 0) {
+		rx_errors++;
+	}
+
+	rx_frames++;
+	k_sem_give(&rx_sem);
+}
+
+static int frame_send(const uint8_t *data, size_t len)
+{
+	size_t size = len;
+	uint8_t *buf = tr->api->tx_buf_alloc(tr, &size);
+
+	memcpy(buf, data, len);
+
+	/* The transport takes ownership of the buffer. */
+	return tr->api->send(tr, buf, len);
+}
+
+static void *setup(void)
+{
+	zassert_ok(tr->api->init(tr, receive_handler, NULL));
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	k_sem_reset(&rx_sem);
+	rx_frames = 0;
+	rx_errors = 0;
+}
+
+ZTEST(nrf_rpc_uart_loopback, test_escaped_frame)
+{
+	static uint8_t frame[FRAME_SIZE];
+
+	/* Every byte value, including the HDLC delimiter and escape characters. */
+	for (size_t i = 0; i < sizeof(frame); i++) {
+		frame[i] = i;
+	}
+
+	expected_data = frame;
+	expected_len = sizeof(frame);
+
+	zassert_ok(frame_send(frame, sizeof(frame)));
+	zassert_ok(k_sem_take(&rx_sem, FRAME_TIMEOUT));
+	zassert_equal(rx_errors, 0);
+}
+
+ZTEST(nrf_rpc_uart_loopback, test_control_chars_only)
+{
+	static uint8_t frame[64];
+
+	for (size_t i = 0; i < sizeof(frame); i++) {
+		frame[i] = (i & 1) ? 0x7d : 0x7e;
+	}
+
+	expected_data = frame;
+	expected_len = sizeof(frame);
+
+	zassert_ok(frame_send(frame, sizeof(frame)));
+	zassert_ok(k_sem_take(&rx_sem, FRAME_TIMEOUT));
+	zassert_equal(rx_errors, 0);
+}
+
+ZTEST(nrf_rpc_uart_loopback, test_max_size_frame)
+{
+	static uint8_t frame[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE];
+
+	for (size_t i = 0; i < sizeof(frame); i++) {
+		frame[i] = i * 13 + 5;
+	}
+
+	expected_data = frame;
+	expected_len = sizeof(frame);
+
+	zassert_ok(frame_send(frame, sizeof(frame)));
+	zassert_ok(k_sem_take(&rx_sem, FRAME_TIMEOUT), "Frame of maximum size dropped");
+	zassert_equal(rx_errors, 0);
+}
+
+ZTEST(nrf_rpc_uart_loopback, test_oversized_frame_dropped)
+{
+	static uint8_t big_frame[CONFIG_NRF_RPC_UART_MAX_PACKET_SIZE + 16];
+	static const uint8_t frame[] = {0x01, 0x7e, 0x02, 0x7d, 0x03};
+
+	memset(big_frame, 0xaa, sizeof(big_frame));
+
+	expected_data = frame;
+	expected_len = sizeof(frame);
+
+	zassert_ok(frame_send(big_frame, sizeof(big_frame)));
+	zassert_equal(k_sem_take(&rx_sem, FRAME_TIMEOUT), -EAGAIN,
+		      "Oversized frame should be dropped");
+
+	/* The decoder must resynchronize on the next frame. */
+	zassert_ok(frame_send(frame, sizeof(frame)));
+	zassert_ok(k_sem_take(&rx_sem, FRAME_TIMEOUT));
+	zassert_equal(rx_frames, 1);
+	zassert_equal(rx_errors, 0);
+}
+
+ZTEST(nrf_rpc_uart_loopback, test_throughput)
+{
+	static uint8_t frame[FRAME_SIZE];
+	int64_t start;
+	uint64_t elapsed_us;
+
+	for (size_t i = 0; i < sizeof(frame); i++) {
+		frame[i] = i * 31 + 7;
+	}
+
+	expected_data = frame;
+	expected_len = sizeof(frame);
+
+	start = k_uptime_ticks();
+
+	for (size_t i = 0; i < FRAME_COUNT; i++) {
+		zassert_ok(frame_send(frame, sizeof(frame)));
+		zassert_ok(k_sem_take(&rx_sem, FRAME_TIMEOUT), "Frame %u lost", i);
+	}
+
+	elapsed_us = k_ticks_to_us_ceil64(k_uptime_ticks() - start);
+
+	zassert_equal(rx_frames, FRAME_COUNT);
+	zassert_equal(rx_errors, 0);
+
+	TC_PRINT("%u frames of %u bytes in %llu us (%llu kbit/s)\n", FRAME_COUNT, FRAME_SIZE,
+		 elapsed_us, (uint64_t)FRAME_COUNT * FRAME_SIZE * 8 * 1000 / MAX(elapsed_us, 1));
+}
+
+ZTEST_SUITE(nrf_rpc_uart_loopback, NULL, setup, before, NULL, NULL);
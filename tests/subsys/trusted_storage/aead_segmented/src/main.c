@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <psa/protected_storage.h>
+
+#include "storage_backend.h"
+#include "storage_backend_ram.h"
+
+#define ASSET_UID     0x5EB1
+#define ASSET_SIZE    100
+#define SEGMENT_SIZE  CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_SEGMENT_SIZE
+#define SEGMENT_COUNT DIV_ROUND_UP(ASSET_SIZE, SEGMENT_SIZE)
+
+/* Layout of a stored segment: nonce, encrypted data, tag */
+#define AEAD_NONCE_SIZE	 12
+#define AEAD_TAG_SIZE	 16
+#define SEGMENT_MAX_SIZE (AEAD_NONCE_SIZE + SEGMENT_SIZE + AEAD_TAG_SIZE)
+
+#define SEGMENT_PREFIX_MAX_LENGTH 32
+
+static uint8_t data_v1[ASSET_SIZE];
+static uint8_t data_v2[ASSET_SIZE];
+
+struct stored_segment {
+	uint8_t data[SEGMENT_MAX_SIZE];
+	size_t length;
+};
+
+static void segment_prefix_get(char *segment_prefix, size_t index, unsigned int slot)
+{
+	snprintf(segment_prefix, SEGMENT_PREFIX_MAX_LENGTH + 1, "%s.%u.%u",
+		 CONFIG_PSA_PROTECTED_STORAGE_PREFIX, (unsigned int)index, slot);
+}
+
+/* Returns the slot holding the segment, which must be stored in exactly one slot */
+static unsigned int segment_slot_find(size_t index)
+{
+	char segment_prefix[SEGMENT_PREFIX_MAX_LENGTH + 1];
+	struct stored_segment segment;
+	unsigned int slot = 0;
+	int found = 0;
+
+	for (unsigned int i = 0; i < 2; i++) {
+		segment_prefix_get(segment_prefix, index, i);
+		if (storage_get_object(ASSET_UID, segment_prefix, segment.data,
+				       sizeof(segment.data), &segment.length) == PSA_SUCCESS) {
+			slot = i;
+			found++;
+		}
+	}
+
+	zassert_equal(found, 1, "Segment %zu stored in %d slots", index, found);
+
+	return slot;
+}
+
+static void segment_read(size_t index, unsigned int slot, struct stored_segment *segment)
+{
+	char segment_prefix[SEGMENT_PREFIX_MAX_LENGTH + 1];
+	psa_status_t status;
+
+	segment_prefix_get(segment_prefix, index, slot);
+	status = storage_get_object(ASSET_UID, segment_prefix, segment->data,
+				    sizeof(segment->data), &segment->length);
+	zassert_equal(status, PSA_SUCCESS, "Reading segment failed: %d", status);
+}
+
+static void segment_write(size_t index, unsigned int slot, const struct stored_segment *segment)
+{
+	char segment_prefix[SEGMENT_PREFIX_MAX_LENGTH + 1];
+	psa_status_t status;
+
+	segment_prefix_get(segment_prefix, index, slot);
+	status = storage_set_object(ASSET_UID, segment_prefix, segment->data, segment->length);
+	zassert_equal(status, PSA_SUCCESS, "Writing segment failed: %d", status);
+}
+
+static void asset_check(const uint8_t *expected, size_t size)
+{
+	uint8_t buf[ASSET_SIZE];
+	size_t length;
+	psa_status_t status;
+
+	status = psa_ps_get(ASSET_UID, 0, sizeof(buf), buf, &length);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_get failed: %d", status);
+	zassert_equal(length, size, "Invalid asset size");
+	zassert_mem_equal(buf, expected, size, "Invalid asset data");
+}
+
+static psa_status_t range_get(size_t offset, size_t length)
+{
+	uint8_t buf[ASSET_SIZE];
+	size_t out_length;
+
+	return psa_ps_get(ASSET_UID, offset, length, buf, &out_length);
+}
+
+ZTEST(trusted_storage_aead_segmented, test_partial_get)
+{
+	static const struct {
+		size_t offset;
+		size_t length;
+	} ranges[] = {
+		{0, ASSET_SIZE},
+		{0, 1},
+		{SEGMENT_SIZE - 1, 2},
+		{SEGMENT_SIZE, SEGMENT_SIZE},
+		{SEGMENT_SIZE + 3, 2 * SEGMENT_SIZE},
+		{ASSET_SIZE - 1, 1},
+		/* Clipped to the end of the asset */
+		{ASSET_SIZE - 5, 20},
+	};
+	uint8_t buf[ASSET_SIZE];
+	size_t length;
+	psa_status_t status;
+
+	status = psa_ps_set(ASSET_UID, ASSET_SIZE, data_v1, PSA_STORAGE_FLAG_NONE);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_set failed: %d", status);
+	zassert_equal(storage_ram_object_count(), 1 + SEGMENT_COUNT, "Invalid object count");
+
+	for (size_t i = 0; i < ARRAY_SIZE(ranges); i++) {
+		size_t expected_length = MIN(ranges[i].length, ASSET_SIZE - ranges[i].offset);
+
+		memset(buf, 0, sizeof(buf));
+		status = psa_ps_get(ASSET_UID, ranges[i].offset, MIN(ranges[i].length, sizeof(buf)),
+				    buf, &length);
+		zassert_equal(status, PSA_SUCCESS, "psa_ps_get failed for range %zu: %d", i,
+			      status);
+		zassert_equal(length, expected_length, "Invalid length for range %zu", i);
+		zassert_mem_equal(buf, data_v1 + ranges[i].offset, expected_length,
+				  "Invalid data for range %zu", i);
+	}
+
+	status = psa_ps_get(ASSET_UID, ASSET_SIZE + 1, 1, buf, &length);
+	zassert_equal(status, PSA_ERROR_INVALID_ARGUMENT, "Read beyond the asset allowed");
+}
+
+ZTEST(trusted_storage_aead_segmented, test_set_extended)
+{
+	uint8_t expected[ASSET_SIZE] = {0};
+	struct psa_storage_info_t info;
+	psa_status_t status;
+
+	status = psa_ps_create(ASSET_UID, ASSET_SIZE, PSA_STORAGE_FLAG_NONE);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_create failed: %d", status);
+
+	status = psa_ps_create(ASSET_UID, ASSET_SIZE, PSA_STORAGE_FLAG_NONE);
+	zassert_equal(status, PSA_ERROR_ALREADY_EXISTS, "Asset created twice");
+
+	/* Grow the asset in two steps */
+	status = psa_ps_set_extended(ASSET_UID, 0, 40, data_v1);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_set_extended failed: %d", status);
+	status = psa_ps_set_extended(ASSET_UID, 40, ASSET_SIZE - 40, data_v1 + 40);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_set_extended failed: %d", status);
+	memcpy(expected, data_v1, ASSET_SIZE);
+	asset_check(expected, ASSET_SIZE);
+
+	/* Overwrite a range crossing a segment boundary */
+	status = psa_ps_set_extended(ASSET_UID, SEGMENT_SIZE - 2, SEGMENT_SIZE + 4, data_v2);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_set_extended failed: %d", status);
+	memcpy(expected + SEGMENT_SIZE - 2, data_v2, SEGMENT_SIZE + 4);
+	asset_check(expected, ASSET_SIZE);
+
+	/* Old segments are removed */
+	zassert_equal(storage_ram_object_count(), 1 + SEGMENT_COUNT, "Invalid object count");
+
+	/* No growing beyond the capacity and no gaps */
+	status = psa_ps_set_extended(ASSET_UID, ASSET_SIZE - 1, 2, data_v2);
+	zassert_equal(status, PSA_ERROR_INVALID_ARGUMENT, "Write beyond the capacity allowed");
+	asset_check(expected, ASSET_SIZE);
+
+	status = psa_ps_get_info(ASSET_UID, &info);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_get_info failed: %d", status);
+	zassert_equal(info.size, ASSET_SIZE, "Invalid size");
+	zassert_equal(info.capacity, ASSET_SIZE, "Invalid capacity");
+
+	status = psa_ps_remove(ASSET_UID);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_remove failed: %d", status);
+	zassert_equal(storage_ram_object_count(), 0, "Objects left after removal");
+}
+
+ZTEST(trusted_storage_aead_segmented, test_tamper_segment)
+{
+	struct stored_segment segment;
+	unsigned int slot;
+	psa_status_t status;
+
+	status = psa_ps_set(ASSET_UID, ASSET_SIZE, data_v1, PSA_STORAGE_FLAG_NONE);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_set failed: %d", status);
+
+	/* Modify the encrypted data of the 3rd segment */
+	slot = segment_slot_find(2);
+	segment_read(2, slot, &segment);
+	segment.data[AEAD_NONCE_SIZE] ^= 0x01;
+	segment_write(2, slot, &segment);
+
+	status = range_get(2 * SEGMENT_SIZE, 1);
+	zassert_equal(status, PSA_ERROR_INVALID_SIGNATURE, "Modified data accepted: %d", status);
+
+	/* Modify the tag of the 2nd segment */
+	slot = segment_slot_find(1);
+	segment_read(1, slot, &segment);
+	segment.data[segment.length - 1] ^= 0x01;
+	segment_write(1, slot, &segment);
+
+	status = range_get(SEGMENT_SIZE, 1);
+	zassert_equal(status, PSA_ERROR_INVALID_SIGNATURE, "Modified tag accepted: %d", status);
+
+	/* The other segments are still valid */
+	status = range_get(0, SEGMENT_SIZE);
+	zassert_equal(status, PSA_SUCCESS, "Valid segment rejected: %d", status);
+	status = range_get(3 * SEGMENT_SIZE, ASSET_SIZE - 3 * SEGMENT_SIZE);
+	zassert_equal(status, PSA_SUCCESS, "Valid segment rejected: %d", status);
+
+	/* A segment cannot be moved to another position */
+	segment_read(3, segment_slot_find(3), &segment);
+	segment_write(4, segment_slot_find(4), &segment);
+
+	status = range_get(4 * SEGMENT_SIZE, 1);
+	zassert_equal(status, PSA_ERROR_INVALID_SIGNATURE, "Moved segment accepted: %d", status);
+}
+
+ZTEST(trusted_storage_aead_segmented, test_replay_segment)
+{
+	struct stored_segment old_segment;
+	unsigned int old_slot;
+	unsigned int slot;
+	psa_status_t status;
+
+	status = psa_ps_set(ASSET_UID, ASSET_SIZE, data_v1, PSA_STORAGE_FLAG_NONE);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_set failed: %d", status);
+
+	old_slot = segment_slot_find(1);
+	segment_read(1, old_slot, &old_segment);
+
+	status = psa_ps_set_extended(ASSET_UID, SEGMENT_SIZE, SEGMENT_SIZE, data_v2);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_set_extended failed: %d", status);
+
+	/* The new segment is written to the other slot */
+	slot = segment_slot_find(1);
+	zassert_not_equal(slot, old_slot, "Segment overwritten in place");
+
+	/* The old segment restored to its old slot is ignored */
+	segment_write(1, old_slot, &old_segment);
+	status = range_get(SEGMENT_SIZE, SEGMENT_SIZE);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_get failed: %d", status);
+
+	/* The old segment replayed in place of the new one is rejected */
+	segment_write(1, slot, &old_segment);
+	status = range_get(SEGMENT_SIZE, SEGMENT_SIZE);
+	zassert_equal(status, PSA_ERROR_INVALID_SIGNATURE, "Replayed segment accepted: %d",
+		      status);
+}
+
+ZTEST(trusted_storage_aead_segmented, test_update_failure)
+{
+	uint8_t expected[ASSET_SIZE];
+	size_t object_count;
+	psa_status_t status;
+	int fail_after;
+
+	status = psa_ps_set(ASSET_UID, ASSET_SIZE, data_v1, PSA_STORAGE_FLAG_NONE);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_set failed: %d", status);
+	object_count = storage_ram_object_count();
+
+	/* Fail each write of the update in turn: the segments, then the manifest */
+	for (fail_after = 0; fail_after <= SEGMENT_COUNT; fail_after++) {
+		storage_ram_set_fail_after(fail_after);
+
+		status = psa_ps_set(ASSET_UID, ASSET_SIZE, data_v2, PSA_STORAGE_FLAG_NONE);
+		zassert_not_equal(status, PSA_SUCCESS, "Update succeeded after %d writes",
+				  fail_after);
+
+		asset_check(data_v1, ASSET_SIZE);
+		zassert_equal(storage_ram_object_count(), object_count,
+			      "Objects left after failure after %d writes", fail_after);
+	}
+
+	storage_ram_set_fail_after(-1);
+	status = psa_ps_set(ASSET_UID, ASSET_SIZE, data_v2, PSA_STORAGE_FLAG_NONE);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_set failed: %d", status);
+	asset_check(data_v2, ASSET_SIZE);
+	zassert_equal(storage_ram_object_count(), object_count, "Invalid object count");
+
+	/* Same for a partial update of two segments */
+	memcpy(expected, data_v2, ASSET_SIZE);
+	memcpy(expected + SEGMENT_SIZE - 2, data_v1, 4);
+
+	for (fail_after = 0; fail_after <= 2; fail_after++) {
+		storage_ram_set_fail_after(fail_after);
+
+		status = psa_ps_set_extended(ASSET_UID, SEGMENT_SIZE - 2, 4, data_v1);
+		zassert_not_equal(status, PSA_SUCCESS, "Update succeeded after %d writes",
+				  fail_after);
+
+		asset_check(data_v2, ASSET_SIZE);
+		zassert_equal(storage_ram_object_count(), object_count,
+			      "Objects left after failure after %d writes", fail_after);
+	}
+
+	storage_ram_set_fail_after(-1);
+	status = psa_ps_set_extended(ASSET_UID, SEGMENT_SIZE - 2, 4, data_v1);
+	zassert_equal(status, PSA_SUCCESS, "psa_ps_set_extended failed: %d", status);
+	asset_check(expected, ASSET_SIZE);
+	zassert_equal(storage_ram_object_count(), object_count, "Invalid object count");
+}
+
+static void *trusted_storage_setup(void)
+{
+	for (size_t i = 0; i < ASSET_SIZE; i++) {
+		data_v1[i] = i;
+		data_v2[i] = ~i;
+	}
+
+	return NULL;
+}
+
+static void trusted_storage_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	storage_ram_clear();
+}
+
+ZTEST_SUITE(trusted_storage_aead_segmented, NULL, trusted_storage_setup, trusted_storage_before,
+	    NULL, NULL);
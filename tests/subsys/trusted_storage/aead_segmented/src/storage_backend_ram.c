@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "storage_backend.h"
+#include "storage_backend_ram.h"
+
+/* Same naming as the settings storage backend: prefix, uid high, uid low */
+#define OBJECT_NAME_PATTERN    "%s/%08x%08x"
+#define OBJECT_NAME_MAX_LENGTH 32
+
+#define OBJECT_COUNT	       40
+#define OBJECT_SIZE_MAX	       256
+
+struct object {
+	bool used;
+	char name[OBJECT_NAME_MAX_LENGTH + 1];
+	size_t size;
+	uint8_t data[OBJECT_SIZE_MAX];
+};
+
+static struct object objects[OBJECT_COUNT];
+static int writes_before_fail = -1;
+
+static psa_status_t object_name_get(char *name, const char *prefix, const psa_storage_uid_t uid)
+{
+	int ret;
+
+	ret = snprintf(name, OBJECT_NAME_MAX_LENGTH + 1, OBJECT_NAME_PATTERN, prefix,
+		       (unsigned int)(uid >> 32), (unsigned int)(uid & 0xffffffff));
+	if (ret < 0 || ret > OBJECT_NAME_MAX_LENGTH) {
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+
+	return PSA_SUCCESS;
+}
+
+static struct object *object_find(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(objects); i++) {
+		if (objects[i].used && strcmp(objects[i].name, name) == 0) {
+			return &objects[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct object *object_alloc(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(objects); i++) {
+		if (!objects[i].used) {
+			objects[i].used = true;
+			strcpy(objects[i].name, name);
+			return &objects[i];
+		}
+	}
+
+	return NULL;
+}
+
+psa_status_t storage_get_object(const psa_storage_uid_t uid, const char *prefix, void *object_data,
+				const size_t object_size, size_t *object_length)
+{
+	char name[OBJECT_NAME_MAX_LENGTH + 1];
+	struct object *object;
+	psa_status_t status;
+
+	if (object_size == 0 || object_data == NULL || prefix == NULL) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	status = object_name_get(name, prefix, uid);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	object = object_find(name);
+	if (object == NULL) {
+		return PSA_ERROR_DOES_NOT_EXIST;
+	}
+
+	*object_length = MIN(object_size, object->size);
+	memcpy(object_data, object->data, *object_length);
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t storage_set_object(const psa_storage_uid_t uid, const char *prefix,
+				const void *object_data, const size_t object_size)
+{
+	char name[OBJECT_NAME_MAX_LENGTH + 1];
+	struct object *object;
+	psa_status_t status;
+
+	if (object_size == 0 || object_data == NULL || prefix == NULL) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (object_size > OBJECT_SIZE_MAX) {
+		return PSA_ERROR_INSUFFICIENT_STORAGE;
+	}
+
+	status = object_name_get(name, prefix, uid);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	/* A failed write leaves the previous content of the object, like the settings backend */
+	if (writes_before_fail == 0) {
+		writes_before_fail = -1;
+		return PSA_ERROR_STORAGE_FAILURE;
+	} else if (writes_before_fail > 0) {
+		writes_before_fail--;
+	}
+
+	object = object_find(name);
+	if (object == NULL) {
+		object = object_alloc(name);
+		if (object == NULL) {
+			return PSA_ERROR_INSUFFICIENT_STORAGE;
+		}
+	}
+
+	memcpy(object->data, object_data, object_size);
+	object->size = object_size;
+
+	return PSA_SUCCESS;
+}
+
+psa_status_t storage_remove_object(const psa_storage_uid_t uid, const char *prefix)
+{
+	char name[OBJECT_NAME_MAX_LENGTH + 1];
+	struct object *object;
+	psa_status_t status;
+
+	if (prefix == NULL) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	status = object_name_get(name, prefix, uid);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	object = object_find(name);
+	if (object == NULL) {
+		return PSA_ERROR_DOES_NOT_EXIST;
+	}
+
+	object->used = false;
+
+	return PSA_SUCCESS;
+}
+
+void storage_ram_clear(void)
+{
+	memset(objects, 0, sizeof(objects));
+	writes_before_fail = -1;
+}
+
+size_t storage_ram_object_count(void)
+{
+	size_t count = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(objects); i++) {
+		if (objects[i].used) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+void storage_ram_set_fail_after(int write_count)
+{
+	writes_before_fail = write_count;
+}
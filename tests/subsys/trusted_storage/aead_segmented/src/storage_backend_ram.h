@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef STORAGE_BACKEND_RAM_H_
+#define STORAGE_BACKEND_RAM_H_
+
+#include <stddef.h>
+
+/* Removes all stored objects */
+void storage_ram_clear(void);
+
+/* Returns the number of stored objects */
+size_t storage_ram_object_count(void);
+
+/* Makes the object write following the given number of successful writes fail.
+ * A negative value disables the failure.
+ */
+void storage_ram_set_fail_after(int write_count);
+
+#endif /* STORAGE_BACKEND_RAM_H_ */
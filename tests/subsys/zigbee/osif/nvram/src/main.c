@@ -6,6 +6,7 @@
 
 #include <zephyr/ztest.h>
 #include <pm_config.h>
+#include <zephyr/storage/flash_map.h>
 #include <zboss_api.h>
 #include <zb_errors.h>
 #include <zb_osif.h>
@@ -109,3 +110,90 @@ ZTEST(osif_test, test_zb_nvram_write)
 		}
 	}
 }
+
+ZTEST(osif_test, test_zb_nvram_write_cache)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_ZIGBEE_NVRAM_WRITE_CACHE);
+
+	const struct flash_area *fa;
+	uint8_t record[8];
+	uint8_t raw[4 * sizeof(record)];
+	int ret;
+
+	ret = flash_area_open(PM_ZBOSS_NVRAM_ID, &fa);
+	zassert_equal(ret, 0, "Can't open flash area");
+
+	/* Small adjacent writes, the last one overwriting part of the previous */
+	for (int i = 0; i < 4; i++) {
+		memset(record, i + 1, sizeof(record));
+		ret = zb_osif_nvram_write(0, i * sizeof(record), record, sizeof(record));
+		zassert_true(ret == RET_OK, "writing failed");
+	}
+	memset(record, 0x55, sizeof(record));
+	ret = zb_osif_nvram_write(0, 3 * sizeof(record) - 4, record, sizeof(record));
+	zassert_true(ret == RET_OK, "writing failed");
+
+	/* Buffered data is read back before it is written to flash */
+	zb_osif_nvram_read(0, 0, zb_nvram_buf, sizeof(raw));
+	for (int i = 0; i < sizeof(raw); i++) {
+		uint8_t expected = (i >= 3 * sizeof(record) - 4 && i < 4 * sizeof(record) - 4) ?
+					   0x55 : (i / sizeof(record)) + 1;
+
+		zassert_equal(zb_nvram_buf[i], expected, "wrong data at %d", i);
+	}
+
+	ret = flash_area_read(fa, 0, raw, sizeof(raw));
+	zassert_equal(ret, 0, "reading failed");
+	for (int i = 0; i < sizeof(raw); i++) {
+		zassert_equal(raw[i], 0xFF, "data written before flush");
+	}
+
+	zb_osif_nvram_flush();
+
+	ret = flash_area_read(fa, 0, raw, sizeof(raw));
+	zassert_equal(ret, 0, "reading failed");
+	zassert_mem_equal(raw, zb_nvram_buf, sizeof(raw), "data not written on flush");
+
+	flash_area_close(fa);
+}
+
+ZTEST(osif_test, test_zb_nvram_write_cache_erase)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_ZIGBEE_NVRAM_WRITE_CACHE);
+
+	const struct flash_area *fa;
+	uint8_t record[8];
+	uint8_t raw[sizeof(record)];
+	int ret;
+
+	ret = flash_area_open(PM_ZBOSS_NVRAM_ID, &fa);
+	zassert_equal(ret, 0, "Can't open flash area");
+
+	/* Data migrated to page 0 must reach flash before the old page 1 is erased */
+	memset(record, 0xA5, sizeof(record));
+	ret = zb_osif_nvram_write(0, 0, record, sizeof(record));
+	zassert_true(ret == RET_OK, "writing failed");
+
+	/* Pending writes to the erased page are dropped */
+	ret = zb_osif_nvram_write(1, 0, record, sizeof(record));
+	zassert_true(ret == RET_OK, "writing failed");
+
+	ret = zb_osif_nvram_erase_async(1);
+	zassert_true(ret == RET_OK, "Erasing failed");
+
+	ret = flash_area_read(fa, 0, raw, sizeof(raw));
+	zassert_equal(ret, 0, "reading failed");
+	zassert_mem_equal(raw, record, sizeof(raw), "data not written before erase");
+
+	ret = zb_osif_nvram_read(0, 0, zb_nvram_buf, sizeof(record));
+	zassert_true(ret == RET_OK, "reading failed");
+	zassert_mem_equal(zb_nvram_buf, record, sizeof(record), "wrong data read back");
+
+	ret = zb_osif_nvram_read(1, 0, zb_nvram_buf, sizeof(record));
+	zassert_true(ret == RET_OK, "reading failed");
+	for (int i = 0; i < sizeof(record); i++) {
+		zassert_equal(zb_nvram_buf[i], 0xFF, "erased page not empty");
+	}
+
+	flash_area_close(fa);
+}